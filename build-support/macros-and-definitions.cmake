@@ -565,6 +565,25 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_BLAS False)
+  if(${NS3_BLAS})
+    if(NOT ${ENABLE_EIGEN})
+      set(ENABLE_BLAS_REASON "BLAS support requires Eigen")
+    else()
+      disable_cmake_warnings()
+      find_package(BLAS QUIET)
+      enable_cmake_warnings()
+
+      if(${BLAS_FOUND})
+        set(ENABLE_BLAS True)
+        # Eigen forwards its large matrix products to the BLAS library
+        add_definitions(-DEIGEN_USE_BLAS)
+      else()
+        set(ENABLE_BLAS_REASON "BLAS was not found")
+      endif()
+    endif()
+  endif()
+
   # GTK3 Don't search for it if you don't have it installed, as it take an
   # insane amount of time
   set(GTK3_FOUND FALSE)
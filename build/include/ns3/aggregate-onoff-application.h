@@ -0,0 +1 @@
+#include "/root/repo/src/applications/model/aggregate-onoff-application.h"
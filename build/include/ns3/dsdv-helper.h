@@ -0,0 +1 @@
+#include "/root/repo/src/dsdv/helper/dsdv-helper.h"
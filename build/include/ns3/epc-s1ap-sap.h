@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/epc-s1ap-sap.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/model/ism-spectrum-value-helper.h"
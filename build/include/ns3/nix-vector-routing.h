@@ -0,0 +1 @@
+#include "/root/repo/src/nix-vector-routing/model/nix-vector-routing.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/model/spectrum-value.h"
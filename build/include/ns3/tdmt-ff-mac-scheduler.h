@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/tdmt-ff-mac-scheduler.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/threshold-preamble-detection-model.h"
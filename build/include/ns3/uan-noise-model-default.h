@@ -0,0 +1 @@
+#include "/root/repo/src/uan/model/uan-noise-model-default.h"
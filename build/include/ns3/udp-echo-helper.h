@@ -0,0 +1 @@
+#include "/root/repo/src/applications/helper/udp-echo-helper.h"
@@ -120,6 +120,63 @@ PhasedArrayModel::GetSteeringVector(Angles a) const
     return steeringVector;
 }
 
+ComplexMatrixArray
+PhasedArrayModel::GetSteeringMatrix(const std::vector<Angles>& angles) const
+{
+    NS_LOG_FUNCTION(this << angles.size());
+    size_t numElems = GetNumElems();
+    std::vector<double> locX(numElems);
+    std::vector<double> locY(numElems);
+    std::vector<double> locZ(numElems);
+    for (size_t i = 0; i < numElems; i++)
+    {
+        Vector loc = GetElementLocation(i);
+        locX[i] = loc.x;
+        locY[i] = loc.y;
+        locZ[i] = loc.z;
+    }
+
+    // compute the phases of the elements for all the directions first, as the
+    // loop over the elements has no dependency and can be vectorized
+    size_t numAngles = angles.size();
+    std::vector<double> phases(numAngles * numElems);
+    for (size_t k = 0; k < numAngles; k++)
+    {
+        double sinCos = sin(angles[k].GetInclination()) * cos(angles[k].GetAzimuth());
+        double sinSin = sin(angles[k].GetInclination()) * sin(angles[k].GetAzimuth());
+        double cosIncl = cos(angles[k].GetInclination());
+        double* phase = &phases[k * numElems];
+        for (size_t i = 0; i < numElems; i++)
+        {
+            phase[i] = -2 * M_PI * (sinCos * locX[i] + sinSin * locY[i] + cosIncl * locZ[i]);
+        }
+    }
+
+    ComplexMatrixArray steeringMatrix(numAngles, numElems);
+    for (size_t k = 0; k < numAngles; k++)
+    {
+        for (size_t i = 0; i < numElems; i++)
+        {
+            steeringMatrix(k, i) = std::polar<double>(1.0, phases[k * numElems + i]);
+        }
+    }
+    return steeringMatrix;
+}
+
+std::vector<std::pair<double, double>>
+PhasedArrayModel::GetElementFieldPatterns(const std::vector<Angles>& angles,
+                                          uint8_t polIndex) const
+{
+    NS_LOG_FUNCTION(this << angles.size() << +polIndex);
+    std::vector<std::pair<double, double>> fieldPatterns;
+    fieldPatterns.reserve(angles.size());
+    for (const auto& a : angles)
+    {
+        fieldPatterns.emplace_back(GetElementFieldPattern(a, polIndex));
+    }
+    return fieldPatterns;
+}
+
 void
 PhasedArrayModel::SetAntennaElement(Ptr<AntennaModel> antennaElement)
 {
@@ -15,6 +15,7 @@
 #include "ns3/symmetric-adjacency-matrix.h"
 
 #include <complex>
+#include <vector>
 
 namespace ns3
 {
@@ -88,6 +89,20 @@ class PhasedArrayModel : public Object
     virtual std::pair<double, double> GetElementFieldPattern(Angles a,
                                                              uint8_t polIndex = 0) const = 0;
 
+    /**
+     * @brief Returns the horizontal and vertical components of the antenna element field
+     * pattern at several directions, e.g., at all the rays of a channel.
+     * The default implementation calls GetElementFieldPattern for each direction.
+     * @param angles the directions
+     * @param polIndex the index of the polarization for which will be retrieved the field
+     * pattern
+     * @return the field patterns, in the order of the directions, as returned by
+     * GetElementFieldPattern
+     */
+    virtual std::vector<std::pair<double, double>> GetElementFieldPatterns(
+        const std::vector<Angles>& angles,
+        uint8_t polIndex = 0) const;
+
     /**
      * @brief Set the vertical number of ports
      * @param nPorts the vertical number of ports
@@ -226,6 +241,18 @@ class PhasedArrayModel : public Object
      */
     ComplexVector GetSteeringVector(Angles a) const;
 
+    /**
+     * Returns the steering vectors that point toward several directions.
+     * The element locations and the direction cosines are computed only once, and the
+     * phases of all the elements are then computed in a loop over contiguous arrays which
+     * the compiler can vectorize.
+     * @param angles the steering angles
+     * @return a matrix with one row per direction and one column per antenna element,
+     * whose row i is equal to GetSteeringVector(angles[i]), so that the values of an
+     * element for all the directions are contiguous
+     */
+    ComplexMatrixArray GetSteeringMatrix(const std::vector<Angles>& angles) const;
+
     /**
      * Sets the antenna model to be used
      * @param antennaElement the antenna model
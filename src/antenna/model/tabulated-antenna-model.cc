@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "tabulated-antenna-model.h"
+
+#include "isotropic-antenna-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TabulatedAntennaModel");
+
+NS_OBJECT_ENSURE_REGISTERED(TabulatedAntennaModel);
+
+TypeId
+TabulatedAntennaModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TabulatedAntennaModel")
+            .SetParent<AntennaModel>()
+            .SetGroupName("Antenna")
+            .AddConstructor<TabulatedAntennaModel>()
+            .AddAttribute("Antenna",
+                          "The antenna model whose radiation pattern is interpolated",
+                          PointerValue(CreateObject<IsotropicAntennaModel>()),
+                          MakePointerAccessor(&TabulatedAntennaModel::SetAntenna,
+                                              &TabulatedAntennaModel::GetAntenna),
+                          MakePointerChecker<AntennaModel>())
+            .AddAttribute("AzimuthStep",
+                          "The step (degrees) of the grid of azimuth angles",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&TabulatedAntennaModel::SetAzimuthStep,
+                                             &TabulatedAntennaModel::GetAzimuthStep),
+                          MakeDoubleChecker<double>(0.01, 180))
+            .AddAttribute("InclinationStep",
+                          "The step (degrees) of the grid of inclination angles",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&TabulatedAntennaModel::SetInclinationStep,
+                                             &TabulatedAntennaModel::GetInclinationStep),
+                          MakeDoubleChecker<double>(0.01, 180));
+    return tid;
+}
+
+TabulatedAntennaModel::TabulatedAntennaModel()
+    : m_azimuthStepDegrees(1.0),
+      m_inclinationStepDegrees(1.0),
+      m_numAzimuths(0),
+      m_numInclinations(0),
+      m_azimuthStep(0),
+      m_inclinationStep(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TabulatedAntennaModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_antenna = nullptr;
+    m_table.clear();
+    AntennaModel::DoDispose();
+}
+
+void
+TabulatedAntennaModel::SetAntenna(Ptr<AntennaModel> antenna)
+{
+    NS_LOG_FUNCTION(this << antenna);
+    m_antenna = antenna;
+    m_table.clear();
+}
+
+Ptr<AntennaModel>
+TabulatedAntennaModel::GetAntenna() const
+{
+    return m_antenna;
+}
+
+void
+TabulatedAntennaModel::SetAzimuthStep(double stepDegrees)
+{
+    NS_LOG_FUNCTION(this << stepDegrees);
+    m_azimuthStepDegrees = stepDegrees;
+    m_table.clear();
+}
+
+double
+TabulatedAntennaModel::GetAzimuthStep() const
+{
+    return m_azimuthStepDegrees;
+}
+
+void
+TabulatedAntennaModel::SetInclinationStep(double stepDegrees)
+{
+    NS_LOG_FUNCTION(this << stepDegrees);
+    m_inclinationStepDegrees = stepDegrees;
+    m_table.clear();
+}
+
+double
+TabulatedAntennaModel::GetInclinationStep() const
+{
+    return m_inclinationStepDegrees;
+}
+
+void
+TabulatedAntennaModel::BuildTable()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_antenna, "TabulatedAntennaModel: no antenna model to interpolate");
+
+    m_numAzimuths = static_cast<size_t>(std::ceil(360 / m_azimuthStepDegrees - 1e-9)) + 1;
+    m_numInclinations = static_cast<size_t>(std::ceil(180 / m_inclinationStepDegrees - 1e-9)) + 1;
+    m_azimuthStep = 2 * M_PI / (m_numAzimuths - 1);
+    m_inclinationStep = M_PI / (m_numInclinations - 1);
+
+    m_table.resize(m_numAzimuths * m_numInclinations);
+    for (size_t i = 0; i < m_numAzimuths; i++)
+    {
+        // the last azimuth of the grid is wrapped to -pi by Angles, hence it is
+        // sampled just before pi
+        double azimuth = std::min(-M_PI + i * m_azimuthStep, std::nextafter(M_PI, 0.0));
+        for (size_t j = 0; j < m_numInclinations; j++)
+        {
+            double gainDb = m_antenna->GetGainDb(Angles(azimuth, j * m_inclinationStep));
+            m_table[i * m_numInclinations + j] = std::max(gainDb, MIN_GAIN_DB);
+        }
+    }
+    NS_LOG_LOGIC("Sampled " << m_numAzimuths << " x " << m_numInclinations << " angles");
+}
+
+double
+TabulatedAntennaModel::GetGainDb(Angles a)
+{
+    NS_LOG_FUNCTION(this << a);
+    if (m_table.empty())
+    {
+        BuildTable();
+    }
+
+    double u = std::max(0.0, (a.GetAzimuth() + M_PI) / m_azimuthStep);
+    size_t i = std::min(static_cast<size_t>(u), m_numAzimuths - 2);
+    double fu = u - i;
+    double v = std::max(0.0, a.GetInclination() / m_inclinationStep);
+    size_t j = std::min(static_cast<size_t>(v), m_numInclinations - 2);
+    double fv = v - j;
+
+    const double* low = &m_table[i * m_numInclinations + j];
+    const double* high = low + m_numInclinations;
+    double gainDb = (1 - fu) * ((1 - fv) * low[0] + fv * low[1]) +
+                    fu * ((1 - fv) * high[0] + fv * high[1]);
+
+    NS_LOG_LOGIC("gain = " << gainDb);
+    return gainDb;
+}
+
+} // namespace ns3
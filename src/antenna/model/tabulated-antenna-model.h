@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TABULATED_ANTENNA_MODEL_H
+#define TABULATED_ANTENNA_MODEL_H
+
+#include "antenna-model.h"
+
+#include "ns3/object.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup antenna
+ *
+ * @brief Antenna model which interpolates the radiation pattern of another antenna model
+ *
+ * The gain of the wrapped antenna model, set through the attribute "Antenna", is sampled
+ * once on a regular grid of azimuth and inclination angles, and the gain toward any
+ * direction is then obtained by bilinear interpolation of the gains in dB at the four
+ * closest points of the grid. This replaces the evaluation of the pattern, which usually
+ * involves several trigonometric and power functions, with a few multiplications, at
+ * the cost of an approximation error which depends on the steps of the grid.
+ *
+ * The grid covers azimuth angles from -180 to 180 degrees and inclination angles from 0
+ * to 180 degrees. The steps are rounded down so that they divide these ranges evenly.
+ * The grid is sampled at the first call to GetGainDb, hence the wrapped antenna model
+ * should not be modified afterwards.
+ */
+class TabulatedAntennaModel : public AntennaModel
+{
+  public:
+    TabulatedAntennaModel();
+
+    /**
+     * @brief Get the type ID.
+     * @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    // inherited from AntennaModel
+    double GetGainDb(Angles a) override;
+
+    /**
+     * Set the antenna model whose radiation pattern is interpolated
+     * @param antenna the antenna model
+     */
+    void SetAntenna(Ptr<AntennaModel> antenna);
+
+    /**
+     * Get the antenna model whose radiation pattern is interpolated
+     * @return the antenna model
+     */
+    Ptr<AntennaModel> GetAntenna() const;
+
+    /**
+     * Set the step of the grid in the azimuth direction
+     * @param stepDegrees the step in degrees
+     */
+    void SetAzimuthStep(double stepDegrees);
+
+    /**
+     * Get the step of the grid in the azimuth direction
+     * @return the step in degrees
+     */
+    double GetAzimuthStep() const;
+
+    /**
+     * Set the step of the grid in the inclination direction
+     * @param stepDegrees the step in degrees
+     */
+    void SetInclinationStep(double stepDegrees);
+
+    /**
+     * Get the step of the grid in the inclination direction
+     * @return the step in degrees
+     */
+    double GetInclinationStep() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * Sample the gain of the wrapped antenna model on the grid
+     */
+    void BuildTable();
+
+    /// Gain stored in the table for the nulls of the pattern, to keep the interpolation finite
+    static constexpr double MIN_GAIN_DB = -300;
+
+    Ptr<AntennaModel> m_antenna;     //!< the antenna model whose pattern is interpolated
+    double m_azimuthStepDegrees;     //!< the requested step of the grid in azimuth
+    double m_inclinationStepDegrees; //!< the requested step of the grid in inclination
+    size_t m_numAzimuths;            //!< the number of azimuth angles of the grid
+    size_t m_numInclinations;        //!< the number of inclination angles of the grid
+    double m_azimuthStep;            //!< the step of the grid in azimuth, in radians
+    double m_inclinationStep;        //!< the step of the grid in inclination, in radians
+    std::vector<double> m_table;     //!< the gains in dB, by azimuth then inclination index
+};
+
+} // namespace ns3
+
+#endif // TABULATED_ANTENNA_MODEL_H
@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/cosine-antenna-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/tabulated-antenna-model.h"
+#include "ns3/test.h"
+#include "ns3/three-gpp-antenna-model.h"
+
+#include <cmath>
+#include <string>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TestTabulatedAntennaModel");
+
+/**
+ * @ingroup antenna-tests
+ *
+ * @brief TabulatedAntennaModel Test
+ *
+ * Checks that the interpolated gain is equal to the gain of the wrapped antenna
+ * model on the points of the grid, and close to it between them.
+ */
+class TabulatedAntennaModelTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param antenna the antenna model to interpolate
+     * @param step the step of the grid in degrees
+     * @param tolerance the maximum interpolation error in dB
+     * @param name the test case name
+     */
+    TabulatedAntennaModelTestCase(Ptr<AntennaModel> antenna,
+                                  double step,
+                                  double tolerance,
+                                  std::string name);
+
+  private:
+    void DoRun() override;
+
+    Ptr<AntennaModel> m_antenna; //!< the antenna model to interpolate
+    double m_step;               //!< the step of the grid in degrees
+    double m_tolerance;          //!< the maximum interpolation error in dB
+};
+
+TabulatedAntennaModelTestCase::TabulatedAntennaModelTestCase(Ptr<AntennaModel> antenna,
+                                                             double step,
+                                                             double tolerance,
+                                                             std::string name)
+    : TestCase(name),
+      m_antenna(antenna),
+      m_step(step),
+      m_tolerance(tolerance)
+{
+}
+
+void
+TabulatedAntennaModelTestCase::DoRun()
+{
+    Ptr<TabulatedAntennaModel> tabulated = CreateObject<TabulatedAntennaModel>();
+    tabulated->SetAttribute("Antenna", PointerValue(m_antenna));
+    tabulated->SetAttribute("AzimuthStep", DoubleValue(m_step));
+    tabulated->SetAttribute("InclinationStep", DoubleValue(m_step));
+
+    // points of the grid
+    for (double azimuth = -180; azimuth < 180; azimuth += 10 * m_step)
+    {
+        for (double inclination = 0; inclination <= 180; inclination += 10 * m_step)
+        {
+            Angles a(DegreesToRadians(azimuth), DegreesToRadians(inclination));
+            double expected = m_antenna->GetGainDb(a);
+            if (expected > -100)
+            {
+                NS_TEST_EXPECT_MSG_EQ_TOL(tabulated->GetGainDb(a),
+                                          expected,
+                                          1e-6,
+                                          "Wrong gain on the grid at " << a);
+            }
+        }
+    }
+
+    // points between the grid, away from the nulls of the pattern
+    for (double azimuth = -179.3; azimuth < 180; azimuth += 3.7)
+    {
+        for (double inclination = 0.4; inclination < 180; inclination += 4.3)
+        {
+            Angles a(DegreesToRadians(azimuth), DegreesToRadians(inclination));
+            double expected = m_antenna->GetGainDb(a);
+            double gain = tabulated->GetGainDb(a);
+            NS_TEST_EXPECT_MSG_EQ(std::isnan(gain), false, "Gain is NaN at " << a);
+            if (expected > -20)
+            {
+                NS_TEST_EXPECT_MSG_EQ_TOL(gain,
+                                          expected,
+                                          m_tolerance,
+                                          "Wrong interpolated gain at " << a);
+            }
+        }
+    }
+}
+
+/**
+ * @ingroup antenna-tests
+ *
+ * @brief TabulatedAntennaModel Test Suite
+ */
+class TabulatedAntennaModelTestSuite : public TestSuite
+{
+  public:
+    TabulatedAntennaModelTestSuite();
+};
+
+TabulatedAntennaModelTestSuite::TabulatedAntennaModelTestSuite()
+    : TestSuite("tabulated-antenna-model", Type::UNIT)
+{
+    Ptr<CosineAntennaModel> cosine = CreateObject<CosineAntennaModel>();
+    cosine->SetAttribute("VerticalBeamwidth", DoubleValue(60));
+    cosine->SetAttribute("HorizontalBeamwidth", DoubleValue(90));
+    cosine->SetAttribute("MaxGain", DoubleValue(10));
+
+    AddTestCase(new TabulatedAntennaModelTestCase(CreateObject<ThreeGppAntennaModel>(),
+                                                  1,
+                                                  0.05,
+                                                  "3GPP antenna element, 1 degree step"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TabulatedAntennaModelTestCase(cosine, 1, 0.05, "Cosine antenna, 1 degree step"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TabulatedAntennaModelTestCase(cosine, 5, 0.5, "Cosine antenna, 5 degree step"),
+                TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static TabulatedAntennaModelTestSuite g_staticTabulatedAntennaModelTestSuiteInstance;
@@ -9,6 +9,7 @@
 #include "sstream"
 #include "string"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/isotropic-antenna-model.h"
 #include "ns3/log.h"
@@ -263,6 +264,84 @@ UpdateOnChangeTestCase::DoRun()
                           "Expecting update, antenna parameter changed");
 }
 
+/**
+ * @ingroup antenna-tests
+ *
+ * @brief Batched evaluation Test Case
+ *
+ * Checks that the steering matrix and the field patterns computed for several
+ * directions at once are equal to the ones computed for each direction.
+ */
+class BatchedEvaluationTestCase : public TestCase
+{
+  public:
+    /**
+     * The constructor of the test case
+     * @param element the antenna element
+     * @param name the test case name
+     */
+    BatchedEvaluationTestCase(Ptr<AntennaModel> element, std::string name)
+        : TestCase(name),
+          m_element(element)
+    {
+    }
+
+  private:
+    /**
+     * Run the test
+     */
+    void DoRun() override;
+    Ptr<AntennaModel> m_element; //!< the antenna element
+};
+
+void
+BatchedEvaluationTestCase::DoRun()
+{
+    Ptr<UniformPlanarArray> ant = CreateObject<UniformPlanarArray>();
+    ant->SetAttribute("AntennaElement", PointerValue(m_element));
+    ant->SetAttribute("NumRows", UintegerValue(4));
+    ant->SetAttribute("NumColumns", UintegerValue(8));
+    ant->SetAttribute("IsDualPolarized", BooleanValue(true));
+    ant->SetAttribute("BearingAngle", DoubleValue(DegreesToRadians(30)));
+    ant->SetAttribute("DowntiltAngle", DoubleValue(DegreesToRadians(10)));
+
+    std::vector<Angles> angles;
+    for (double azimuth = -170; azimuth < 180; azimuth += 35)
+    {
+        for (double inclination = 5; inclination < 180; inclination += 25)
+        {
+            angles.emplace_back(DegreesToRadians(azimuth), DegreesToRadians(inclination));
+        }
+    }
+
+    ComplexMatrixArray steeringMatrix = ant->GetSteeringMatrix(angles);
+    NS_TEST_ASSERT_MSG_EQ(steeringMatrix.GetNumRows(), angles.size(), "One row per direction");
+    NS_TEST_ASSERT_MSG_EQ(steeringMatrix.GetNumCols(),
+                          ant->GetNumElems(),
+                          "One column per element");
+    for (uint8_t polIndex = 0; polIndex < ant->GetNumPols(); polIndex++)
+    {
+        auto fieldPatterns = ant->GetElementFieldPatterns(angles, polIndex);
+        NS_TEST_ASSERT_MSG_EQ(fieldPatterns.size(), angles.size(), "One pattern per direction");
+        for (size_t k = 0; k < angles.size(); k++)
+        {
+            auto expected = ant->GetElementFieldPattern(angles[k], polIndex);
+            NS_TEST_EXPECT_MSG_EQ(fieldPatterns[k].first, expected.first, "Wrong field pattern");
+            NS_TEST_EXPECT_MSG_EQ(fieldPatterns[k].second, expected.second, "Wrong field pattern");
+        }
+    }
+    for (size_t k = 0; k < angles.size(); k++)
+    {
+        PhasedArrayModel::ComplexVector steeringVector = ant->GetSteeringVector(angles[k]);
+        for (size_t i = 0; i < ant->GetNumElems(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(steeringMatrix(k, i),
+                                  steeringVector[i],
+                                  "Wrong steering vector for " << angles[k]);
+        }
+    }
+}
+
 /**
  * @ingroup antenna-tests
  *
@@ -452,6 +531,11 @@ UniformPlanarArrayTestSuite::UniformPlanarArrayTestSuite()
                                            "Test IsChannelOutOfDate() and InvalidateChannels() for "
                                            "UniformPlanarArray with 3GPP antenna element"),
                 TestCase::Duration::QUICK);
+    AddTestCase(new BatchedEvaluationTestCase(tgpp,
+                                              "Test GetSteeringMatrix() and "
+                                              "GetElementFieldPatterns() for UniformPlanarArray "
+                                              "with 3GPP antenna element"),
+                TestCase::Duration::QUICK);
 }
 
 static UniformPlanarArrayTestSuite staticUniformPlanarArrayTestSuiteInstance;
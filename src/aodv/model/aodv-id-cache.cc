@@ -15,8 +15,6 @@
  */
 #include "aodv-id-cache.h"
 
-#include <algorithm>
-
 namespace ns3
 {
 namespace aodv
@@ -25,22 +23,27 @@ bool
 IdCache::IsDuplicate(Ipv4Address addr, uint32_t id)
 {
     Purge();
-    for (auto i = m_idCache.begin(); i != m_idCache.end(); ++i)
+    uint64_t key = GetKey(addr, id);
+    if (m_idCache.find(key) != m_idCache.end())
     {
-        if (i->m_context == addr && i->m_id == id)
-        {
-            return true;
-        }
+        return true;
     }
-    UniqueId uniqueId = {addr, id, m_lifetime + Simulator::Now()};
-    m_idCache.push_back(uniqueId);
+    Time expire = m_lifetime + Simulator::Now();
+    m_idCache.emplace(key, expire);
+    m_expiries.Schedule(key, expire);
     return false;
 }
 
 void
 IdCache::Purge()
 {
-    m_idCache.erase(remove_if(m_idCache.begin(), m_idCache.end(), IsExpired()), m_idCache.end());
+    m_expiries.Expire(Simulator::Now(), [this](uint64_t key, Time expire) {
+        auto i = m_idCache.find(key);
+        if (i != m_idCache.end() && i->second == expire)
+        {
+            m_idCache.erase(i);
+        }
+    });
 }
 
 uint32_t
@@ -258,6 +258,7 @@ RoutingTable::DeleteRoute(Ipv4Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
     Purge();
+    m_scheduled.erase(dst);
     if (m_ipv4AddressEntry.erase(dst) != 0)
     {
         NS_LOG_LOGIC("Route deletion to " << dst << " successful");
@@ -277,6 +278,10 @@ RoutingTable::AddRoute(RoutingTableEntry& rt)
         rt.SetRreqCnt(0);
     }
     auto result = m_ipv4AddressEntry.insert(std::make_pair(rt.GetDestination(), rt));
+    if (result.second)
+    {
+        ScheduleExpiry(rt.GetDestination(), rt);
+    }
     return result.second;
 }
 
@@ -296,6 +301,7 @@ RoutingTable::Update(RoutingTableEntry& rt)
         NS_LOG_LOGIC("Route update to " << rt.GetDestination() << " set RreqCnt to 0");
         i->second.SetRreqCnt(0);
     }
+    ScheduleExpiry(i->first, i->second);
     return true;
 }
 
@@ -311,6 +317,7 @@ RoutingTable::SetEntryState(Ipv4Address id, RouteFlags state)
     }
     i->second.SetFlag(state);
     i->second.SetRreqCnt(0);
+    ScheduleExpiry(i->first, i->second);
     NS_LOG_LOGIC("Route set entry state to " << id << ": new state is " << state);
     return true;
 }
@@ -337,15 +344,14 @@ RoutingTable::InvalidateRoutesWithDst(const std::map<Ipv4Address, uint32_t>& unr
 {
     NS_LOG_FUNCTION(this);
     Purge();
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end(); ++i)
+    for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
     {
-        for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
+        auto i = m_ipv4AddressEntry.find(j->first);
+        if (i != m_ipv4AddressEntry.end() && i->second.GetFlag() == VALID)
         {
-            if ((i->first == j->first) && (i->second.GetFlag() == VALID))
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-            }
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            i->second.Invalidate(m_badLinkLifetime);
+            ScheduleExpiry(i->first, i->second);
         }
     }
 }
@@ -362,9 +368,8 @@ RoutingTable::DeleteAllRoutesFromInterface(Ipv4InterfaceAddress iface)
     {
         if (i->second.GetInterface() == iface)
         {
-            auto tmp = i;
-            ++i;
-            m_ipv4AddressEntry.erase(tmp);
+            m_scheduled.erase(i->first);
+            i = m_ipv4AddressEntry.erase(i);
         }
         else
         {
@@ -381,31 +386,55 @@ RoutingTable::Purge()
     {
         return;
     }
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
+    m_expiries.Expire(Simulator::Now(),
+                      [this](Ipv4Address dst, Time expiry) { Expire(dst, expiry); });
+}
+
+void
+RoutingTable::ScheduleExpiry(Ipv4Address dst, const RoutingTableEntry& rt)
+{
+    Time expiry = rt.GetLifeTime() + Simulator::Now();
+    auto [s, inserted] = m_scheduled.insert(std::make_pair(dst, expiry));
+    if (inserted || expiry < s->second)
     {
-        if (i->second.GetLifeTime().IsStrictlyNegative())
-        {
-            if (i->second.GetFlag() == INVALID)
-            {
-                auto tmp = i;
-                ++i;
-                m_ipv4AddressEntry.erase(tmp);
-            }
-            else if (i->second.GetFlag() == VALID)
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-                ++i;
-            }
-            else
-            {
-                ++i;
-            }
-        }
-        else
-        {
-            ++i;
-        }
+        s->second = expiry;
+        m_expiries.Schedule(dst, expiry);
+    }
+}
+
+void
+RoutingTable::Expire(Ipv4Address dst, Time expiry)
+{
+    auto s = m_scheduled.find(dst);
+    if (s == m_scheduled.end() || s->second != expiry)
+    {
+        // The entry was deleted, or scheduled earlier since
+        return;
+    }
+    auto i = m_ipv4AddressEntry.find(dst);
+    NS_ASSERT(i != m_ipv4AddressEntry.end());
+    if (!i->second.GetLifeTime().IsStrictlyNegative())
+    {
+        // The lifetime was extended
+        s->second = i->second.GetLifeTime() + Simulator::Now();
+        m_expiries.Schedule(dst, s->second);
+    }
+    else if (i->second.GetFlag() == INVALID)
+    {
+        m_scheduled.erase(s);
+        m_ipv4AddressEntry.erase(i);
+    }
+    else if (i->second.GetFlag() == VALID)
+    {
+        NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+        i->second.Invalidate(m_badLinkLifetime);
+        s->second = i->second.GetLifeTime() + Simulator::Now();
+        m_expiries.Schedule(dst, s->second);
+    }
+    else
+    {
+        // Routes in search are kept; they are scheduled again when updated
+        m_scheduled.erase(s);
     }
 }
 
@@ -465,7 +494,8 @@ RoutingTable::MarkLinkAsUnidirectional(Ipv4Address neighbor, Time blacklistTimeo
 void
 RoutingTable::Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit /* = Time::S */) const
 {
-    std::map<Ipv4Address, RoutingTableEntry> table = m_ipv4AddressEntry;
+    std::map<Ipv4Address, RoutingTableEntry> table(m_ipv4AddressEntry.begin(),
+                                                   m_ipv4AddressEntry.end());
     Purge(table);
     std::ostream* os = stream->GetStream();
     // Copy the current ostream state
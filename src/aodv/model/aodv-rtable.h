@@ -16,6 +16,7 @@
 #ifndef AODV_RTABLE_H
 #define AODV_RTABLE_H
 
+#include "ns3/expiry-wheel.h"
 #include "ns3/ipv4-route.h"
 #include "ns3/ipv4.h"
 #include "ns3/net-device.h"
@@ -26,6 +27,7 @@
 #include <map>
 #include <stdint.h>
 #include <sys/types.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -507,6 +509,8 @@ class RoutingTable
     void Clear()
     {
         m_ipv4AddressEntry.clear();
+        m_scheduled.clear();
+        m_expiries.Clear();
     }
 
     /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
@@ -526,8 +530,27 @@ class RoutingTable
     void Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
 
   private:
+    /**
+     * Make sure that an entry is in the expiry wheel, no later than its lifetime.
+     * Entries whose lifetime is extended are left in place, and scheduled
+     * again when they come out of the wheel.
+     * @param dst the destination of the entry
+     * @param rt the entry
+     */
+    void ScheduleExpiry(Ipv4Address dst, const RoutingTableEntry& rt);
+    /**
+     * Handle an entry coming out of the expiry wheel
+     * @param dst the destination of the entry
+     * @param expiry the time for which the entry was scheduled
+     */
+    void Expire(Ipv4Address dst, Time expiry);
+
     /// The routing table
-    std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
+    std::unordered_map<Ipv4Address, RoutingTableEntry, Ipv4AddressHash> m_ipv4AddressEntry;
+    /// Time for which each entry is scheduled in the expiry wheel
+    std::unordered_map<Ipv4Address, Time, Ipv4AddressHash> m_scheduled;
+    /// Entries by lifetime, to purge them without scanning the table
+    ExpiryWheel<Ipv4Address> m_expiries;
     /// Deletion time for invalid routes
     Time m_badLinkLifetime;
     /**
@@ -719,6 +719,83 @@ struct AodvRtableTest : public TestCase
     }
 };
 
+/**
+ * @ingroup aodv-test
+ *
+ * @brief Unit test for the expiry of the entries of RoutingTable
+ */
+class AodvRtableLifetimeTest : public TestCase
+{
+  public:
+    AodvRtableLifetimeTest()
+        : TestCase("Rtable lifetime"),
+          m_rtable(Seconds(3))
+    {
+    }
+
+    void DoRun() override
+    {
+        Ptr<NetDevice> dev;
+        Ipv4InterfaceAddress iface;
+        for (uint32_t i = 1; i <= 3; ++i)
+        {
+            RoutingTableEntry rt(/*output device*/ dev,
+                                 /*dst*/ Ipv4Address(i),
+                                 /*validSeqNo*/ true,
+                                 /*seqNo*/ 10,
+                                 /*interface*/ iface,
+                                 /*hop*/ 1,
+                                 /*next hop*/ Ipv4Address(i),
+                                 /*lifetime*/ Seconds(1));
+            m_rtable.AddRoute(rt);
+        }
+
+        // 0.0.0.2 lifetime is extended, 0.0.0.3 is searched for
+        RoutingTableEntry rt;
+        m_rtable.LookupRoute(Ipv4Address(2), rt);
+        rt.SetLifeTime(Seconds(10));
+        m_rtable.Update(rt);
+        m_rtable.SetEntryState(Ipv4Address(3), IN_SEARCH);
+
+        Simulator::Schedule(Seconds(2), &AodvRtableLifetimeTest::Check, this, INVALID, VALID, true);
+        Simulator::Schedule(Seconds(6), &AodvRtableLifetimeTest::Check, this, -1, VALID, true);
+        Simulator::Schedule(Seconds(11), &AodvRtableLifetimeTest::Check, this, -1, INVALID, true);
+        Simulator::Schedule(Seconds(12),
+                            &RoutingTable::SetEntryState,
+                            &m_rtable,
+                            Ipv4Address(3),
+                            INVALID);
+        Simulator::Schedule(Seconds(15), &AodvRtableLifetimeTest::Check, this, -1, -1, false);
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+
+  private:
+    /**
+     * Check the entries of the table
+     * @param flag1 expected flag of 0.0.0.1, -1 if it should not exist
+     * @param flag2 expected flag of 0.0.0.2, -1 if it should not exist
+     * @param exists3 whether 0.0.0.3 should exist
+     */
+    void Check(int flag1, int flag2, bool exists3)
+    {
+        RoutingTableEntry rt;
+        NS_TEST_EXPECT_MSG_EQ(m_rtable.LookupRoute(Ipv4Address(1), rt), (flag1 >= 0), "0.0.0.1");
+        if (flag1 >= 0)
+        {
+            NS_TEST_EXPECT_MSG_EQ(rt.GetFlag(), flag1, "0.0.0.1 flag");
+        }
+        NS_TEST_EXPECT_MSG_EQ(m_rtable.LookupRoute(Ipv4Address(2), rt), (flag2 >= 0), "0.0.0.2");
+        if (flag2 >= 0)
+        {
+            NS_TEST_EXPECT_MSG_EQ(rt.GetFlag(), flag2, "0.0.0.2 flag");
+        }
+        NS_TEST_EXPECT_MSG_EQ(m_rtable.LookupRoute(Ipv4Address(3), rt), exists3, "0.0.0.3");
+    }
+
+    RoutingTable m_rtable; //!< The routing table
+};
+
 /**
  * @ingroup aodv-test
  *
@@ -740,6 +817,7 @@ class AodvTestSuite : public TestSuite
         AddTestCase(new AodvRqueueTest, TestCase::Duration::QUICK);
         AddTestCase(new AodvRtableEntryTest, TestCase::Duration::QUICK);
         AddTestCase(new AodvRtableTest, TestCase::Duration::QUICK);
+        AddTestCase(new AodvRtableLifetimeTest, TestCase::Duration::QUICK);
     }
 } g_aodvTestSuite; ///< the test suite
 
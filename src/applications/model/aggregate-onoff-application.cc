@@ -0,0 +1,380 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "aggregate-onoff-application.h"
+
+#include "ns3/boolean.h"
+#include "ns3/flow-id-tag.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/packet-socket-address.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AggregateOnOffApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(AggregateOnOffApplication);
+
+TypeId
+AggregateOnOffApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::AggregateOnOffApplication")
+            .SetParent<SourceApplication>()
+            .SetGroupName("Applications")
+            .AddConstructor<AggregateOnOffApplication>()
+            .AddAttribute("NumClients",
+                          "The number of On/Off clients.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&AggregateOnOffApplication::m_nClients),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("DataRate",
+                          "The data rate of each client in on state.",
+                          DataRateValue(DataRate("500kb/s")),
+                          MakeDataRateAccessor(&AggregateOnOffApplication::m_cbrRate),
+                          MakeDataRateChecker())
+            .AddAttribute("PacketSize",
+                          "The size of packets sent in on state",
+                          UintegerValue(512),
+                          MakeUintegerAccessor(&AggregateOnOffApplication::m_pktSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("OnTime",
+                          "A RandomVariableStream used to pick the duration of the 'On' state.",
+                          StringValue("ns3::ConstantRandomVariable[Constant=1.0]"),
+                          MakePointerAccessor(&AggregateOnOffApplication::m_onTime),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("OffTime",
+                          "A RandomVariableStream used to pick the duration of the 'Off' state.",
+                          StringValue("ns3::ConstantRandomVariable[Constant=1.0]"),
+                          MakePointerAccessor(&AggregateOnOffApplication::m_offTime),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("MaxBytes",
+                          "The total number of bytes to send by each client. Once these bytes "
+                          "are sent, the client does not send any packet again. The value zero "
+                          "means that there is no limit.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&AggregateOnOffApplication::m_maxBytes),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("Protocol",
+                          "The type of protocol to use. This should be "
+                          "a subclass of ns3::SocketFactory",
+                          TypeIdValue(UdpSocketFactory::GetTypeId()),
+                          MakeTypeIdAccessor(&AggregateOnOffApplication::m_tid),
+                          // This should check for SocketFactory as a parent
+                          MakeTypeIdChecker())
+            .AddAttribute("FlowIdTag",
+                          "Tag each packet with the index of the client which sent it.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&AggregateOnOffApplication::m_flowIdTag),
+                          MakeBooleanChecker())
+            .AddTraceSource("Tx",
+                            "A new packet is created and is sent",
+                            MakeTraceSourceAccessor(&AggregateOnOffApplication::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource(
+                "TxWithAddresses",
+                "A new packet is created and is sent",
+                MakeTraceSourceAccessor(&AggregateOnOffApplication::m_txTraceWithAddresses),
+                "ns3::Packet::TwoAddressTracedCallback");
+    return tid;
+}
+
+AggregateOnOffApplication::AggregateOnOffApplication()
+    : m_socket(nullptr),
+      m_uid(0),
+      m_nOnClients(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+AggregateOnOffApplication::~AggregateOnOffApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ptr<Socket>
+AggregateOnOffApplication::GetSocket() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_socket;
+}
+
+uint64_t
+AggregateOnOffApplication::GetTotalBytes(uint32_t client) const
+{
+    return client < m_clients.size() ? m_clients[client].totBytes : 0;
+}
+
+uint32_t
+AggregateOnOffApplication::GetNOnClients() const
+{
+    return m_nOnClients;
+}
+
+int64_t
+AggregateOnOffApplication::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    auto currentStream = stream;
+    m_onTime->SetStream(currentStream++);
+    m_offTime->SetStream(currentStream++);
+    currentStream += Application::AssignStreams(currentStream);
+    return (currentStream - stream);
+}
+
+void
+AggregateOnOffApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    Simulator::Cancel(m_event);
+    m_events = {};
+    m_clients.clear();
+    m_socket = nullptr;
+    // chain up
+    Application::DoDispose();
+}
+
+// Application Methods
+void
+AggregateOnOffApplication::StartApplication() // Called at time specified by Start
+{
+    NS_LOG_FUNCTION(this);
+
+    // Create the socket if not already
+    if (!m_socket)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), m_tid);
+        int ret = -1;
+
+        NS_ABORT_MSG_IF(m_peer.IsInvalid(), "'Remote' attribute not properly set");
+
+        if (!m_local.IsInvalid())
+        {
+            NS_ABORT_MSG_IF((Inet6SocketAddress::IsMatchingType(m_peer) &&
+                             InetSocketAddress::IsMatchingType(m_local)) ||
+                                (InetSocketAddress::IsMatchingType(m_peer) &&
+                                 Inet6SocketAddress::IsMatchingType(m_local)),
+                            "Incompatible peer and local address IP version");
+            ret = m_socket->Bind(m_local);
+        }
+        else
+        {
+            if (Inet6SocketAddress::IsMatchingType(m_peer))
+            {
+                ret = m_socket->Bind6();
+            }
+            else if (InetSocketAddress::IsMatchingType(m_peer) ||
+                     PacketSocketAddress::IsMatchingType(m_peer))
+            {
+                ret = m_socket->Bind();
+            }
+        }
+
+        if (ret == -1)
+        {
+            NS_FATAL_ERROR("Failed to bind socket");
+        }
+
+        if (InetSocketAddress::IsMatchingType(m_peer))
+        {
+            m_socket->SetIpTos(m_tos); // Affects only IPv4 sockets.
+        }
+        m_socket->Connect(m_peer);
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+    }
+
+    // Each client starts with an Off period, as an OnOffApplication
+    m_clients.resize(m_nClients);
+    for (uint32_t client = 0; client < m_nClients; ++client)
+    {
+        CancelEvents(client);
+        Push(client, Seconds(m_offTime->GetValue()), START);
+    }
+    ScheduleNext();
+}
+
+void
+AggregateOnOffApplication::StopApplication() // Called at time specified by Stop
+{
+    NS_LOG_FUNCTION(this);
+
+    for (uint32_t client = 0; client < m_clients.size(); ++client)
+    {
+        CancelEvents(client);
+    }
+    m_events = {};
+    Simulator::Cancel(m_event);
+    if (m_socket)
+    {
+        m_socket->Close();
+    }
+    else
+    {
+        NS_LOG_WARN("AggregateOnOffApplication found null socket to close in StopApplication");
+    }
+}
+
+void
+AggregateOnOffApplication::Push(uint32_t client, Time delay, EventType type)
+{
+    Time time = Simulator::Now() + delay;
+    m_events.push({time.GetTimeStep(), m_uid++, client, m_clients[client].generation, type});
+}
+
+void
+AggregateOnOffApplication::ScheduleNext()
+{
+    Simulator::Cancel(m_event);
+    if (!m_events.empty())
+    {
+        Time delay = TimeStep(m_events.top().time) - Simulator::Now();
+        m_event = Simulator::Schedule(delay, &AggregateOnOffApplication::RunEvents, this);
+    }
+}
+
+void
+AggregateOnOffApplication::RunEvents()
+{
+    NS_LOG_FUNCTION(this);
+
+    int64_t now = Simulator::Now().GetTimeStep();
+    while (!m_events.empty() && m_events.top().time <= now)
+    {
+        Event event = m_events.top();
+        m_events.pop();
+        if (event.generation != m_clients[event.client].generation)
+        {
+            // Cancelled
+            continue;
+        }
+        switch (event.type)
+        {
+        case START:
+            StartSending(event.client);
+            break;
+        case STOP:
+            StopSending(event.client);
+            break;
+        case SEND:
+            SendPacket(event.client);
+            break;
+        }
+    }
+    ScheduleNext();
+}
+
+void
+AggregateOnOffApplication::CancelEvents(uint32_t client)
+{
+    Client& c = m_clients[client];
+    if (c.sendPending)
+    { // Calculate residual bits since last packet sent
+        Time delta(Simulator::Now() - c.lastStartTime);
+        int64x64_t bits = delta.To(Time::S) * m_cbrRate.GetBitRate();
+        c.residualBits += bits.GetHigh();
+    }
+    c.sendPending = false;
+    if (c.on)
+    {
+        c.on = false;
+        m_nOnClients--;
+    }
+    c.generation++;
+}
+
+// Event handlers
+void
+AggregateOnOffApplication::StartSending(uint32_t client)
+{
+    NS_LOG_FUNCTION(this << client);
+    Client& c = m_clients[client];
+    c.lastStartTime = Simulator::Now();
+    c.on = true;
+    m_nOnClients++;
+    ScheduleNextTx(client);
+    if (c.on)
+    {
+        Push(client, Seconds(m_onTime->GetValue()), STOP);
+    }
+}
+
+void
+AggregateOnOffApplication::StopSending(uint32_t client)
+{
+    NS_LOG_FUNCTION(this << client);
+    CancelEvents(client);
+    Push(client, Seconds(m_offTime->GetValue()), START);
+}
+
+void
+AggregateOnOffApplication::ScheduleNextTx(uint32_t client)
+{
+    Client& c = m_clients[client];
+    if (m_maxBytes == 0 || c.totBytes < m_maxBytes)
+    {
+        NS_ABORT_MSG_IF(c.residualBits > m_pktSize * 8,
+                        "Calculation to compute next send time will overflow");
+        uint32_t bits = m_pktSize * 8 - c.residualBits;
+        Time nextTime(
+            Seconds(bits / static_cast<double>(m_cbrRate.GetBitRate()))); // Time till next packet
+        Push(client, nextTime, SEND);
+        c.sendPending = true;
+    }
+    else
+    { // All done, discard the pending events of the client
+        NS_LOG_LOGIC("client " << client << " done");
+        CancelEvents(client);
+    }
+}
+
+void
+AggregateOnOffApplication::SendPacket(uint32_t client)
+{
+    NS_LOG_FUNCTION(this << client);
+
+    Client& c = m_clients[client];
+    Ptr<Packet> packet = Create<Packet>(m_pktSize);
+    if (m_flowIdTag)
+    {
+        packet->AddPacketTag(FlowIdTag(client));
+    }
+
+    int actual = m_socket->Send(packet);
+    if ((unsigned)actual == m_pktSize)
+    {
+        m_txTrace(packet);
+        c.totBytes += m_pktSize;
+        if (!m_txTraceWithAddresses.IsEmpty())
+        {
+            Address localAddress;
+            m_socket->GetSockName(localAddress);
+            m_txTraceWithAddresses(packet, localAddress, m_peer);
+        }
+    }
+    else
+    {
+        NS_LOG_DEBUG("Unable to send packet of client " << client << "; actual " << actual
+                                                        << " size " << m_pktSize);
+    }
+    c.residualBits = 0;
+    c.lastStartTime = Simulator::Now();
+    ScheduleNextTx(client);
+}
+
+} // namespace ns3
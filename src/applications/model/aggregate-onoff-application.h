@@ -0,0 +1,206 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef AGGREGATE_ONOFF_APPLICATION_H
+#define AGGREGATE_ONOFF_APPLICATION_H
+
+#include "source-application.h"
+
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace ns3
+{
+
+class RandomVariableStream;
+class Socket;
+
+/**
+ * @ingroup onoff
+ *
+ * @brief Generate the traffic of many On/Off clients, to a single
+ *        destination, from a single object.
+ *
+ * This application behaves as a set of \c NumClients independent
+ * OnOffApplication instances with the same attributes, installed on the
+ * same node: each logical client alternates "Off" and "On" periods, the
+ * duration of which is drawn from the \c OffTime and \c OnTime random
+ * variables, and sends packets of \c PacketSize bytes at \c DataRate
+ * during its "On" periods, starting with an "Off" period.  As with
+ * OnOffApplication, the time to the next packet left when an "On" period
+ * ends is used when the next one starts.  The \c MaxBytes limit applies
+ * to each client.
+ *
+ * Unlike separate applications, the clients share a single socket, and
+ * a single pending simulator event: the state of each client takes a few
+ * bytes in an array, and the next events of all the clients are kept in
+ * a binary heap.  This makes it possible to model very large populations,
+ * e.g., the web users behind an aggregation router.
+ *
+ * If \c FlowIdTag is \c true, each packet carries a FlowIdTag packet tag
+ * holding the index of the client that sent it, from 0 to
+ * \c NumClients - 1, so that the flows of the clients can be told apart
+ * at the receiver.  Since the clients share the socket, the packets of
+ * all the clients have the same source port.
+ *
+ * The packets which the socket fails to send are not retried, unlike with
+ * OnOffApplication, which would otherwise need a cached packet per client.
+ */
+class AggregateOnOffApplication : public SourceApplication
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    AggregateOnOffApplication();
+    ~AggregateOnOffApplication() override;
+
+    /**
+     * @brief Return a pointer to associated socket.
+     * @return pointer to associated socket
+     */
+    Ptr<Socket> GetSocket() const;
+
+    /**
+     * @brief Get the number of bytes sent by a client.
+     * @param client the index of the client
+     * @return the number of bytes sent
+     */
+    uint64_t GetTotalBytes(uint32_t client) const;
+
+    /**
+     * @brief Get the number of clients currently in "On" state.
+     * @return the number of clients
+     */
+    uint32_t GetNOnClients() const;
+
+    int64_t AssignStreams(int64_t stream) override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// The kinds of client events.
+    enum EventType : uint8_t
+    {
+        START, //!< Start an "On" period
+        STOP,  //!< Start an "Off" period
+        SEND,  //!< Send a packet
+    };
+
+    /// The state of a logical client.
+    struct Client
+    {
+        Time lastStartTime;       //!< Time the last packet was sent, or the "On" period started
+        uint64_t totBytes{0};     //!< Total bytes sent so far
+        uint32_t residualBits{0}; //!< Number of generated, but not sent, bits
+        uint32_t generation{0};   //!< Incremented to discard the pending events of the client
+        bool on{false};           //!< Whether the client is in "On" state
+        bool sendPending{false};  //!< Whether a packet transmission is scheduled
+    };
+
+    /// A pending client event.
+    struct Event
+    {
+        int64_t time;        //!< Time of the event, in time steps
+        uint64_t uid;        //!< Insertion order, to run simultaneous events in order
+        uint32_t client;     //!< Index of the client
+        uint32_t generation; //!< Generation of the client when the event was scheduled
+        EventType type;      //!< Kind of the event
+
+        /**
+         * Compare the order of two events.
+         * @param other the other event
+         * @return true if this event runs after the other one
+         */
+        bool operator>(const Event& other) const
+        {
+            return time > other.time || (time == other.time && uid > other.uid);
+        }
+    };
+
+    /**
+     * @brief Schedule an event of a client.
+     * @param client the index of the client
+     * @param delay the delay until the event
+     * @param type the kind of the event
+     */
+    void Push(uint32_t client, Time delay, EventType type);
+    /**
+     * @brief Schedule the simulator event of the earliest client event.
+     */
+    void ScheduleNext();
+    /**
+     * @brief Run the client events which are due.
+     */
+    void RunEvents();
+
+    /**
+     * @brief Start an On period of a client
+     * @param client the index of the client
+     */
+    void StartSending(uint32_t client);
+    /**
+     * @brief Start an Off period of a client
+     * @param client the index of the client
+     */
+    void StopSending(uint32_t client);
+    /**
+     * @brief Send a packet of a client
+     * @param client the index of the client
+     */
+    void SendPacket(uint32_t client);
+    /**
+     * @brief Schedule the next packet transmission of a client
+     * @param client the index of the client
+     */
+    void ScheduleNextTx(uint32_t client);
+    /**
+     * @brief Save the bits generated by a client since its last packet, and
+     *        discard its pending events.
+     * @param client the index of the client
+     */
+    void CancelEvents(uint32_t client);
+
+    Ptr<Socket> m_socket;                //!< Associated socket
+    Ptr<RandomVariableStream> m_onTime;  //!< rng for On Time
+    Ptr<RandomVariableStream> m_offTime; //!< rng for Off Time
+    DataRate m_cbrRate;                  //!< Rate that data is generated by each client
+    uint32_t m_pktSize;                  //!< Size of packets
+    uint64_t m_maxBytes;                 //!< Limit of the bytes sent by each client
+    uint32_t m_nClients;                 //!< Number of clients
+    bool m_flowIdTag;                    //!< Whether to tag the packets with the client index
+    TypeId m_tid;                        //!< Type of the socket used
+
+    std::vector<Client> m_clients; //!< State of the clients
+    /// Pending events of the clients, earliest first
+    std::priority_queue<Event, std::vector<Event>, std::greater<>> m_events;
+    uint64_t m_uid;        //!< Insertion order of the next client event
+    EventId m_event;       //!< Simulator event of the earliest client event
+    uint32_t m_nOnClients; //!< Number of clients in "On" state
+
+    /// Traced Callback: transmitted packets.
+    TracedCallback<Ptr<const Packet>> m_txTrace;
+
+    /// Callbacks for tracing the packet Tx events, includes source and destination addresses
+    TracedCallback<Ptr<const Packet>, const Address&, const Address&> m_txTraceWithAddresses;
+};
+
+} // namespace ns3
+
+#endif /* AGGREGATE_ONOFF_APPLICATION_H */
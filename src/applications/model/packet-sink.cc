@@ -24,6 +24,8 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/udp-socket.h"
 
+#include <array>
+
 namespace ns3
 {
 
@@ -227,58 +229,80 @@ void
 PacketSink::HandleRead(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
-    Address from;
-    while (auto packet = socket->RecvFrom(from))
+    std::array<Ptr<Packet>, RX_BATCH_SIZE> packets;
+    std::array<Address, RX_BATCH_SIZE> fromAddresses;
+    bool eof = false;
+    while (!eof)
     {
-        if (packet->GetSize() == 0)
-        { // EOF
+        uint32_t received = socket->RecvBatch(packets, fromAddresses, 0);
+        if (received == 0)
+        {
             break;
         }
-        m_totalRx += packet->GetSize();
-        if (InetSocketAddress::IsMatchingType(from))
+        // process the whole batch, also the packets following the end of the stream
+        for (uint32_t i = 0; i < received; ++i)
+        {
+            if (!HandlePacket(socket, packets[i], fromAddresses[i]))
+            {
+                eof = true;
+            }
+        }
+    }
+}
+
+bool
+PacketSink::HandlePacket(Ptr<Socket> socket, Ptr<Packet> packet, const Address& from)
+{
+    NS_LOG_FUNCTION(this << socket << packet << from);
+    if (packet->GetSize() == 0)
+    { // EOF
+        return false;
+    }
+    m_totalRx += packet->GetSize();
+    if (InetSocketAddress::IsMatchingType(from))
+    {
+        NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
+                               << packet->GetSize() << " bytes from "
+                               << InetSocketAddress::ConvertFrom(from).GetIpv4() << " port "
+                               << InetSocketAddress::ConvertFrom(from).GetPort() << " total Rx "
+                               << m_totalRx << " bytes");
+    }
+    else if (Inet6SocketAddress::IsMatchingType(from))
+    {
+        NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
+                               << packet->GetSize() << " bytes from "
+                               << Inet6SocketAddress::ConvertFrom(from).GetIpv6() << " port "
+                               << Inet6SocketAddress::ConvertFrom(from).GetPort()
+                               << " total Rx " << m_totalRx << " bytes");
+    }
+
+    if (!m_rxTrace.IsEmpty() || !m_rxTraceWithAddresses.IsEmpty() ||
+        (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader))
+    {
+        Address localAddress;
+        Ipv4PacketInfoTag interfaceInfo;
+        Ipv6PacketInfoTag interface6Info;
+        if (packet->RemovePacketTag(interfaceInfo))
+        {
+            localAddress = InetSocketAddress(interfaceInfo.GetAddress(), m_port);
+        }
+        else if (packet->RemovePacketTag(interface6Info))
         {
-            NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
-                                   << packet->GetSize() << " bytes from "
-                                   << InetSocketAddress::ConvertFrom(from).GetIpv4() << " port "
-                                   << InetSocketAddress::ConvertFrom(from).GetPort() << " total Rx "
-                                   << m_totalRx << " bytes");
+            localAddress = Inet6SocketAddress(interface6Info.GetAddress(), m_port);
         }
-        else if (Inet6SocketAddress::IsMatchingType(from))
+        else
         {
-            NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
-                                   << packet->GetSize() << " bytes from "
-                                   << Inet6SocketAddress::ConvertFrom(from).GetIpv6() << " port "
-                                   << Inet6SocketAddress::ConvertFrom(from).GetPort()
-                                   << " total Rx " << m_totalRx << " bytes");
+            socket->GetSockName(localAddress);
         }
+        m_rxTrace(packet, from);
+        m_rxTraceWithAddresses(packet, from, localAddress);
 
-        if (!m_rxTrace.IsEmpty() || !m_rxTraceWithAddresses.IsEmpty() ||
-            (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader))
+        if (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader)
         {
-            Address localAddress;
-            Ipv4PacketInfoTag interfaceInfo;
-            Ipv6PacketInfoTag interface6Info;
-            if (packet->RemovePacketTag(interfaceInfo))
-            {
-                localAddress = InetSocketAddress(interfaceInfo.GetAddress(), m_port);
-            }
-            else if (packet->RemovePacketTag(interface6Info))
-            {
-                localAddress = Inet6SocketAddress(interface6Info.GetAddress(), m_port);
-            }
-            else
-            {
-                socket->GetSockName(localAddress);
-            }
-            m_rxTrace(packet, from);
-            m_rxTraceWithAddresses(packet, from, localAddress);
-
-            if (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader)
-            {
-                PacketReceived(packet, from, localAddress);
-            }
+            PacketReceived(packet, from, localAddress);
         }
     }
+    return true;
 }
 
 void
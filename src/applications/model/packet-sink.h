@@ -110,6 +110,17 @@ class PacketSink : public SinkApplication
      * @param socket the receiving socket
      */
     void HandleRead(Ptr<Socket> socket);
+    /**
+     * @brief Process a packet read from a socket
+     * @param socket the receiving socket
+     * @param packet the packet
+     * @param from the address of the sender
+     * @return false if the packet marks the end of the stream
+     */
+    bool HandlePacket(Ptr<Socket> socket, Ptr<Packet> packet, const Address& from);
+
+    /// Maximum number of packets read from a socket in a single call
+    static constexpr uint32_t RX_BATCH_SIZE{32};
     /**
      * @brief Handle an incoming connection
      * @param socket the incoming connection socket
@@ -20,6 +20,7 @@
 #include "ns3/socket.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 
@@ -73,6 +74,12 @@ UdpClient::GetTypeId()
                           UintegerValue(1024),
                           MakeUintegerAccessor(&UdpClient::m_size),
                           MakeUintegerChecker<uint32_t>(12, 65507))
+            .AddAttribute("BurstSize",
+                          "The number of packets sent back to back at each interval. The "
+                          "packets of a burst are handed to the socket in a single call.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&UdpClient::m_burstSize),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddTraceSource("Tx",
                             "A new packet is created and sent",
                             MakeTraceSourceAccessor(&UdpClient::m_txTrace),
@@ -244,34 +251,50 @@ UdpClient::Send()
 
     Address from;
     Address to;
-    m_socket->GetSockName(from);
-    m_socket->GetPeerName(to);
+    if (!m_txTraceWithAddresses.IsEmpty())
+    {
+        m_socket->GetSockName(from);
+        m_socket->GetPeerName(to);
+    }
     SeqTsHeader seqTs;
-    seqTs.SetSeq(m_sent);
     NS_ABORT_IF(m_size < seqTs.GetSerializedSize());
-    auto p = Create<Packet>(m_size - seqTs.GetSerializedSize());
+    uint32_t burst = m_burstSize;
+    if (m_count != 0)
+    {
+        burst = std::min(burst, m_count - m_sent);
+    }
+    m_burst.clear();
+    for (uint32_t i = 0; i < burst; ++i)
+    {
+        seqTs.SetSeq(m_sent + i);
+        auto p = Create<Packet>(m_size - seqTs.GetSerializedSize());
 
-    // Trace before adding header, for consistency with PacketSink
-    m_txTrace(p);
-    m_txTraceWithAddresses(p, from, to);
+        // Trace before adding header, for consistency with PacketSink
+        m_txTrace(p);
+        m_txTraceWithAddresses(p, from, to);
 
-    p->AddHeader(seqTs);
+        p->AddHeader(seqTs);
+        m_burst.push_back(p);
+    }
 
-    if ((m_socket->Send(p)) >= 0)
+    int sent = m_socket->SendBatch(m_burst, 0);
+    for (int i = 0; i < sent; ++i)
     {
         ++m_sent;
-        m_totalTx += p->GetSize();
+        m_totalTx += m_burst[i]->GetSize();
 #ifdef NS3_LOG_ENABLE
-        NS_LOG_INFO("TraceDelay TX " << m_size << " bytes to " << m_peerString << " Uid: "
-                                     << p->GetUid() << " Time: " << (Simulator::Now()).As(Time::S));
+        NS_LOG_INFO("TraceDelay TX " << m_size << " bytes to " << m_peerString
+                                     << " Uid: " << m_burst[i]->GetUid()
+                                     << " Time: " << (Simulator::Now()).As(Time::S));
 #endif // NS3_LOG_ENABLE
     }
 #ifdef NS3_LOG_ENABLE
-    else
+    if (sent < static_cast<int>(burst))
     {
         NS_LOG_INFO("Error while sending " << m_size << " bytes to " << m_peerString);
     }
 #endif // NS3_LOG_ENABLE
+    m_burst.clear();
 
     if (m_sent < m_count || m_count == 0)
     {
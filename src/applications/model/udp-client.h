@@ -20,6 +20,7 @@
 #include "ns3/traced-callback.h"
 
 #include <optional>
+#include <vector>
 
 namespace ns3
 {
@@ -95,15 +96,17 @@ class UdpClient : public SourceApplication
     /// Callbacks for tracing the packet Tx events, includes source and destination addresses
     TracedCallback<Ptr<const Packet>, const Address&, const Address&> m_txTraceWithAddresses;
 
-    uint32_t m_count; //!< Maximum number of packets the application will send
-    Time m_interval;  //!< Packet inter-send time
-    uint32_t m_size;  //!< Size of the sent packet (including the SeqTsHeader)
+    uint32_t m_count;     //!< Maximum number of packets the application will send
+    Time m_interval;      //!< Packet inter-send time
+    uint32_t m_size;      //!< Size of the sent packet (including the SeqTsHeader)
+    uint32_t m_burstSize; //!< Number of packets sent at each interval
 
     uint32_t m_sent;                    //!< Counter for sent packets
     uint64_t m_totalTx;                 //!< Total bytes sent
     Ptr<Socket> m_socket;               //!< Socket
     std::optional<uint16_t> m_peerPort; //!< Remote peer port (deprecated) // NS_DEPRECATED_3_44
     EventId m_sendEvent;                //!< Event to send the next packet
+    std::vector<Ptr<Packet>> m_burst;   //!< Packets of the burst being sent, kept for reuse
 
 #ifdef NS3_LOG_ENABLE
     std::string m_peerString; //!< Remote peer address string
@@ -378,7 +378,10 @@ UdpEchoClient::Send()
         p = Create<Packet>(m_size);
     }
     Address localAddress;
-    m_socket->GetSockName(localAddress);
+    if (!m_txTraceWithAddresses.IsEmpty())
+    {
+        m_socket->GetSockName(localAddress);
+    }
     // call to the trace sinks before the packet is actually sent,
     // so that tags added to the packet can be sent as well
     m_txTrace(p);
@@ -427,7 +430,10 @@ UdpEchoClient::HandleRead(Ptr<Socket> socket)
                                    << Inet6SocketAddress::ConvertFrom(from).GetPort());
         }
         Address localAddress;
-        socket->GetSockName(localAddress);
+        if (!m_rxTraceWithAddresses.IsEmpty())
+        {
+            socket->GetSockName(localAddress);
+        }
         m_rxTrace(packet);
         m_rxTraceWithAddresses(packet, from, localAddress);
     }
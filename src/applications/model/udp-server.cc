@@ -23,6 +23,8 @@
 #include "ns3/socket.h"
 #include "ns3/uinteger.h"
 
+#include <array>
+
 namespace ns3
 {
 
@@ -170,41 +172,55 @@ void
 UdpServer::HandleRead(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
-    Address from;
-    while (auto packet = socket->RecvFrom(from))
+    Address localAddress;
+    if (!m_rxTraceWithAddresses.IsEmpty())
     {
-        Address localAddress;
         socket->GetSockName(localAddress);
-        m_rxTrace(packet);
-        m_rxTraceWithAddresses(packet, from, localAddress);
-        if (packet->GetSize() > 0)
+    }
+    std::array<Ptr<Packet>, RX_BATCH_SIZE> packets;
+    std::array<Address, RX_BATCH_SIZE> fromAddresses;
+    while (uint32_t received = socket->RecvBatch(packets, fromAddresses, 0))
+    {
+        for (uint32_t i = 0; i < received; ++i)
         {
-            const auto receivedSize = packet->GetSize();
-            SeqTsHeader seqTs;
-            packet->RemoveHeader(seqTs);
-            const auto currentSequenceNumber = seqTs.GetSeq();
-            if (InetSocketAddress::IsMatchingType(from))
-            {
-                NS_LOG_INFO("TraceDelay: RX " << receivedSize << " bytes from "
-                                              << InetSocketAddress::ConvertFrom(from).GetIpv4()
-                                              << " Sequence Number: " << currentSequenceNumber
-                                              << " Uid: " << packet->GetUid() << " TXtime: "
-                                              << seqTs.GetTs() << " RXtime: " << Simulator::Now()
-                                              << " Delay: " << Simulator::Now() - seqTs.GetTs());
-            }
-            else if (Inet6SocketAddress::IsMatchingType(from))
-            {
-                NS_LOG_INFO("TraceDelay: RX " << receivedSize << " bytes from "
-                                              << Inet6SocketAddress::ConvertFrom(from).GetIpv6()
-                                              << " Sequence Number: " << currentSequenceNumber
-                                              << " Uid: " << packet->GetUid() << " TXtime: "
-                                              << seqTs.GetTs() << " RXtime: " << Simulator::Now()
-                                              << " Delay: " << Simulator::Now() - seqTs.GetTs());
-            }
+            HandlePacket(packets[i], fromAddresses[i], localAddress);
+        }
+    }
+}
 
-            m_lossCounter.NotifyReceived(currentSequenceNumber);
-            m_received++;
+void
+UdpServer::HandlePacket(Ptr<Packet> packet, const Address& from, const Address& localAddress)
+{
+    NS_LOG_FUNCTION(this << packet << from);
+    m_rxTrace(packet);
+    m_rxTraceWithAddresses(packet, from, localAddress);
+    if (packet->GetSize() > 0)
+    {
+        const auto receivedSize = packet->GetSize();
+        SeqTsHeader seqTs;
+        packet->RemoveHeader(seqTs);
+        const auto currentSequenceNumber = seqTs.GetSeq();
+        if (InetSocketAddress::IsMatchingType(from))
+        {
+            NS_LOG_INFO("TraceDelay: RX " << receivedSize << " bytes from "
+                                          << InetSocketAddress::ConvertFrom(from).GetIpv4()
+                                          << " Sequence Number: " << currentSequenceNumber
+                                          << " Uid: " << packet->GetUid() << " TXtime: "
+                                          << seqTs.GetTs() << " RXtime: " << Simulator::Now()
+                                          << " Delay: " << Simulator::Now() - seqTs.GetTs());
+        }
+        else if (Inet6SocketAddress::IsMatchingType(from))
+        {
+            NS_LOG_INFO("TraceDelay: RX " << receivedSize << " bytes from "
+                                          << Inet6SocketAddress::ConvertFrom(from).GetIpv6()
+                                          << " Sequence Number: " << currentSequenceNumber
+                                          << " Uid: " << packet->GetUid() << " TXtime: "
+                                          << seqTs.GetTs() << " RXtime: " << Simulator::Now()
+                                          << " Delay: " << Simulator::Now() - seqTs.GetTs());
         }
+
+        m_lossCounter.NotifyReceived(currentSequenceNumber);
+        m_received++;
     }
 }
 
@@ -87,6 +87,18 @@ class UdpServer : public SinkApplication
      */
     void HandleRead(Ptr<Socket> socket);
 
+    /**
+     * @brief Process a received packet.
+     * @param packet the packet
+     * @param from the address of the sender
+     * @param localAddress the address of the socket; only set if the
+     *        RxWithAddresses trace source is connected
+     */
+    void HandlePacket(Ptr<Packet> packet, const Address& from, const Address& localAddress);
+
+    /// Maximum number of packets read from the socket in a single call
+    static constexpr uint32_t RX_BATCH_SIZE{32};
+
     Ptr<Socket> m_socket;            //!< Socket
     Ptr<Socket> m_socket6;           //!< IPv6 Socket (used if only port is specified)
     uint64_t m_received;             //!< Number of received packets
@@ -0,0 +1,258 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/aggregate-onoff-application.h"
+#include "ns3/application-container.h"
+#include "ns3/application-helper.h"
+#include "ns3/data-rate.h"
+#include "ns3/double.h"
+#include "ns3/flow-id-tag.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/node-container.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * Check that the clients of an AggregateOnOffApplication send their packets
+ * at the same times as separate OnOffApplication instances.
+ */
+class AggregateOnOffEquivalenceTestCase : public TestCase
+{
+  public:
+    AggregateOnOffEquivalenceTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Run a simulation and record the times of the packets sent.
+     * @param aggregate whether to use an AggregateOnOffApplication
+     * @return the times of the packets sent, in increasing order
+     */
+    std::vector<Time> RunSources(bool aggregate);
+    /**
+     * Record a packet sent
+     * @param p the packet
+     */
+    void Tx(Ptr<const Packet> p);
+
+    std::vector<Time> m_times;          //!< times of the packets sent
+    std::vector<uint64_t> m_clientSent; //!< bytes sent by each client, from the packet tags
+};
+
+/// Number of clients
+static const uint32_t N_CLIENTS = 20;
+/// Bytes sent by each client
+static const uint64_t MAX_BYTES = 125 * 50;
+
+AggregateOnOffEquivalenceTestCase::AggregateOnOffEquivalenceTestCase()
+    : TestCase("Check that the clients send as separate OnOff applications")
+{
+}
+
+void
+AggregateOnOffEquivalenceTestCase::Tx(Ptr<const Packet> p)
+{
+    m_times.push_back(Simulator::Now());
+    FlowIdTag tag;
+    if (p->PeekPacketTag(tag))
+    {
+        m_clientSent.at(tag.GetFlowId()) += p->GetSize();
+    }
+}
+
+std::vector<Time>
+AggregateOnOffEquivalenceTestCase::RunSources(bool aggregate)
+{
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    ApplicationHelper helper(aggregate ? "ns3::AggregateOnOffApplication"
+                                       : "ns3::OnOffApplication");
+    helper.SetAttribute("Remote", AddressValue(InetSocketAddress(interfaces.GetAddress(1), 9)));
+    helper.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=0.305]"));
+    helper.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0.2]"));
+    helper.SetAttribute("DataRate", DataRateValue(DataRate("100kb/s")));
+    helper.SetAttribute("PacketSize", UintegerValue(125));
+    helper.SetAttribute("MaxBytes", UintegerValue(MAX_BYTES));
+    ApplicationContainer apps;
+    if (aggregate)
+    {
+        helper.SetAttribute("NumClients", UintegerValue(N_CLIENTS));
+        apps = helper.Install(nodes.Get(0));
+    }
+    else
+    {
+        for (uint32_t i = 0; i < N_CLIENTS; ++i)
+        {
+            apps.Add(helper.Install(nodes.Get(0)));
+        }
+    }
+    apps.Start(Seconds(1));
+    apps.Stop(Seconds(10));
+    for (auto app = apps.Begin(); app != apps.End(); ++app)
+    {
+        (*app)->TraceConnectWithoutContext("Tx",
+                                           MakeCallback(&AggregateOnOffEquivalenceTestCase::Tx,
+                                                        this));
+    }
+
+    m_times.clear();
+    m_clientSent.assign(N_CLIENTS, 0);
+    Simulator::Run();
+    if (aggregate)
+    {
+        auto app = DynamicCast<AggregateOnOffApplication>(apps.Get(0));
+        for (uint32_t i = 0; i < N_CLIENTS; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(app->GetTotalBytes(i), MAX_BYTES, "Wrong bytes of client");
+            NS_TEST_EXPECT_MSG_EQ(m_clientSent[i], MAX_BYTES, "Wrong bytes tagged for client");
+        }
+        NS_TEST_EXPECT_MSG_EQ(app->GetNOnClients(), 0U, "No client should be left sending");
+    }
+    Simulator::Destroy();
+    std::sort(m_times.begin(), m_times.end());
+    return m_times;
+}
+
+void
+AggregateOnOffEquivalenceTestCase::DoRun()
+{
+    std::vector<Time> separate = RunSources(false);
+    std::vector<Time> aggregate = RunSources(true);
+    const uint64_t nPackets = N_CLIENTS * MAX_BYTES / 125;
+    NS_TEST_ASSERT_MSG_EQ(separate.size(), nPackets, "Wrong number of packets");
+    NS_TEST_ASSERT_MSG_EQ(aggregate.size(), separate.size(), "Different number of packets");
+    for (std::size_t i = 0; i < separate.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(aggregate[i], separate[i], "Packet " << i << " sent at another time");
+    }
+}
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * Check the fraction of the clients in "On" state, with random On and Off
+ * periods.
+ */
+class AggregateOnOffStatesTestCase : public TestCase
+{
+  public:
+    AggregateOnOffStatesTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Record the number of clients in "On" state
+     * @param app the application
+     */
+    void Sample(Ptr<AggregateOnOffApplication> app);
+
+    std::vector<uint32_t> m_samples; //!< number of clients in "On" state
+};
+
+AggregateOnOffStatesTestCase::AggregateOnOffStatesTestCase()
+    : TestCase("Check the fraction of clients in On state")
+{
+}
+
+void
+AggregateOnOffStatesTestCase::Sample(Ptr<AggregateOnOffApplication> app)
+{
+    m_samples.push_back(app->GetNOnClients());
+}
+
+void
+AggregateOnOffStatesTestCase::DoRun()
+{
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    const uint32_t nClients = 2000;
+    ApplicationHelper helper("ns3::AggregateOnOffApplication");
+    helper.SetAttribute("Remote", AddressValue(InetSocketAddress(interfaces.GetAddress(1), 9)));
+    helper.SetAttribute("NumClients", UintegerValue(nClients));
+    helper.SetAttribute("OnTime", StringValue("ns3::ExponentialRandomVariable[Mean=1]"));
+    helper.SetAttribute("OffTime", StringValue("ns3::ExponentialRandomVariable[Mean=3]"));
+    // a low rate, so that the run time is spent on the state changes, not on the packets
+    helper.SetAttribute("DataRate", DataRateValue(DataRate("800b/s")));
+    helper.SetAttribute("PacketSize", UintegerValue(1000));
+    ApplicationContainer apps = helper.Install(nodes.Get(0));
+    helper.AssignStreams(nodes, 1);
+    apps.Start(Seconds(0));
+    apps.Stop(Seconds(60));
+
+    auto app = DynamicCast<AggregateOnOffApplication>(apps.Get(0));
+    for (uint32_t t = 20; t < 60; ++t)
+    {
+        Simulator::Schedule(Seconds(t), &AggregateOnOffStatesTestCase::Sample, this, app);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // In the steady state, a client is On with a probability of 1 / (1 + 3)
+    double sum = 0;
+    for (auto n : m_samples)
+    {
+        sum += n;
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(sum / m_samples.size() / nClients,
+                              0.25,
+                              0.02,
+                              "Wrong fraction of clients in On state");
+}
+
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * AggregateOnOffApplication TestSuite
+ */
+class AggregateOnOffTestSuite : public TestSuite
+{
+  public:
+    AggregateOnOffTestSuite();
+};
+
+AggregateOnOffTestSuite::AggregateOnOffTestSuite()
+    : TestSuite("applications-aggregate-onoff", Type::UNIT)
+{
+    AddTestCase(new AggregateOnOffEquivalenceTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new AggregateOnOffStatesTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static AggregateOnOffTestSuite g_aggregateOnOffTestSuite;
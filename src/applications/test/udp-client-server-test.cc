@@ -13,7 +13,9 @@
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/log.h"
+#include "ns3/neighbor-cache-helper.h"
 #include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
 #include "ns3/simple-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
@@ -111,6 +113,75 @@ UdpClientServerTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(server->GetReceived(), 8, "Did not receive expected number of packets !");
 }
 
+/**
+ * @ingroup applications-test
+ * @ingroup tests
+ *
+ * Test that the bursts of UDP packets generated by an UdpClient application
+ * are correctly received by an UdpServer application
+ */
+class UdpClientServerBurstTestCase : public TestCase
+{
+  public:
+    UdpClientServerBurstTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+UdpClientServerBurstTestCase::UdpClientServerBurstTestCase()
+    : TestCase("Test that the bursts of udp packets generated by an udpClient application are "
+               "correctly received by an udpServer application")
+{
+}
+
+void
+UdpClientServerBurstTestCase::DoRun()
+{
+    NodeContainer n;
+    n.Create(2);
+
+    InternetStackHelper internet;
+    internet.Install(n);
+
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer d = simpleHelper.Install(n);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer i = ipv4.Assign(d);
+
+    // The ARP pending queue could not hold the first burst
+    NeighborCacheHelper neighborCache;
+    neighborCache.PopulateNeighborCache();
+
+    uint16_t port = 4000;
+    UdpServerHelper serverHelper(port);
+    auto serverApp = serverHelper.Install(n.Get(1));
+    serverApp.Start(Seconds(1));
+    serverApp.Stop(Seconds(10));
+
+    UdpClientHelper clientHelper(InetSocketAddress(i.GetAddress(1), port));
+    clientHelper.SetAttribute("MaxPackets", UintegerValue(25));
+    clientHelper.SetAttribute("Interval", TimeValue(Seconds(1)));
+    clientHelper.SetAttribute("PacketSize", UintegerValue(100));
+    clientHelper.SetAttribute("BurstSize", UintegerValue(4));
+    auto clientApp = clientHelper.Install(n.Get(0));
+    clientApp.Start(Seconds(2));
+    clientApp.Stop(Seconds(10));
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    auto server = DynamicCast<UdpServer>(serverApp.Get(0));
+    auto client = DynamicCast<UdpClient>(clientApp.Get(0));
+    NS_TEST_ASSERT_MSG_EQ(server->GetLost(), 0, "Packets were lost !");
+    NS_TEST_ASSERT_MSG_EQ(server->GetReceived(),
+                          25,
+                          "Did not receive expected number of packets !");
+    NS_TEST_ASSERT_MSG_EQ(client->GetTotalTx(), 2500, "Did not send expected number of bytes !");
+}
+
 /**
  * Test that all the udp packets generated by an udpTraceClient application are
  * correctly received by an udpServer application
@@ -353,6 +424,7 @@ UdpClientServerTestSuite::UdpClientServerTestSuite()
 {
     AddTestCase(new UdpTraceClientServerTestCase, TestCase::Duration::QUICK);
     AddTestCase(new UdpClientServerTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new UdpClientServerBurstTestCase, TestCase::Duration::QUICK);
     AddTestCase(new PacketLossCounterTestCase, TestCase::Duration::QUICK);
     AddTestCase(new UdpEchoClientSetFillTestCase, TestCase::Duration::QUICK);
 }
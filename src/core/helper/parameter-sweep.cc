@@ -0,0 +1,283 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "parameter-sweep.h"
+
+#include "ns3/abort.h"
+#include "ns3/config.h"
+#include "ns3/fatal-error.h"
+#include "ns3/fork-snapshot.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#ifndef __WIN32__
+#include <sys/mman.h>
+#endif
+
+/**
+ * @file
+ * @ingroup core-helpers
+ * ns3::ParameterSweep implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ParameterSweep");
+
+ParameterSweep::ParameterSweep()
+    : m_jobs(0),
+      m_capacity(4096),
+      m_current(0),
+      m_shared(nullptr),
+      m_sharedSize(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ParameterSweep::~ParameterSweep()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+ParameterSweep::AddVariant()
+{
+    NS_LOG_FUNCTION(this);
+    m_variants.emplace_back();
+    return m_variants.size() - 1;
+}
+
+void
+ParameterSweep::Set(uint32_t variant, const std::string& path, const AttributeValue& value)
+{
+    NS_LOG_FUNCTION(this << variant << path << &value);
+    NS_ASSERT_MSG(variant < m_variants.size(), "Invalid variant " << variant);
+    m_variants[variant].config.emplace_back(path, value.Copy());
+}
+
+void
+ParameterSweep::SetRun(uint32_t variant, uint64_t run)
+{
+    NS_LOG_FUNCTION(this << variant << run);
+    NS_ASSERT_MSG(variant < m_variants.size(), "Invalid variant " << variant);
+    m_variants[variant].reseed = true;
+    m_variants[variant].run = run;
+}
+
+void
+ParameterSweep::SetJobs(uint32_t jobs)
+{
+    NS_LOG_FUNCTION(this << jobs);
+    m_jobs = jobs;
+}
+
+void
+ParameterSweep::SetResultCapacity(uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << bytes);
+    NS_ABORT_MSG_IF(bytes < sizeof(uint32_t), "Result capacity too small");
+    m_capacity = bytes;
+}
+
+void
+ParameterSweep::SetReportCallback(Callback<void, uint32_t> cb)
+{
+    NS_LOG_FUNCTION(this << &cb);
+    m_report = cb;
+}
+
+void
+ParameterSweep::Run(Time forkTime, Time duration)
+{
+    NS_LOG_FUNCTION(this << forkTime << duration);
+#ifndef __WIN32__
+    if (m_variants.empty())
+    {
+        return;
+    }
+    uint32_t jobs = m_jobs;
+    if (jobs == 0)
+    {
+        jobs = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    // The result areas must exist before the snapshot, to be shared
+    m_sharedSize = static_cast<std::size_t>(m_capacity) * m_variants.size();
+    void* shared = mmap(nullptr,
+                        m_sharedSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS,
+                        -1,
+                        0);
+    NS_ABORT_MSG_IF(shared == MAP_FAILED, "Cannot map the sweep result areas");
+    m_shared = static_cast<uint8_t*>(shared);
+
+    if (Simulator::Now() < forkTime)
+    {
+        Simulator::Stop(forkTime - Simulator::Now());
+        Simulator::Run();
+    }
+
+    ForkSnapshot snapshot;
+    uint32_t id = snapshot.Take();
+    if (id != 0)
+    {
+        RunVariant(id - 1, duration);
+    }
+
+    std::map<int64_t, uint32_t> running;
+    uint32_t next = 0;
+    while (next < m_variants.size() || !running.empty())
+    {
+        if (next < m_variants.size() && running.size() < jobs)
+        {
+            int64_t pid = snapshot.Restore(next + 1);
+            NS_LOG_LOGIC("Variant " << next << " running in process " << pid);
+            running[pid] = next++;
+            continue;
+        }
+        int status = 0;
+        int64_t pid = snapshot.WaitAny(status);
+        NS_ABORT_MSG_IF(pid < 0, "Lost the variant processes");
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            continue;
+        }
+        Variant& variant = m_variants[it->second];
+        variant.status = status;
+        NS_LOG_LOGIC("Variant " << it->second << " exited with status " << status);
+
+        // Result area: length, then (name length, name, value) records
+        const uint8_t* area = m_shared + static_cast<std::size_t>(m_capacity) * it->second;
+        uint32_t length;
+        std::memcpy(&length, area, sizeof(length));
+        std::size_t offset = sizeof(length);
+        std::size_t end = std::min<std::size_t>(offset + length, m_capacity);
+        while (offset + sizeof(uint32_t) <= end)
+        {
+            uint32_t nameLength;
+            std::memcpy(&nameLength, area + offset, sizeof(nameLength));
+            offset += sizeof(nameLength);
+            if (offset + nameLength + sizeof(double) > end)
+            {
+                break;
+            }
+            std::string name(reinterpret_cast<const char*>(area + offset), nameLength);
+            offset += nameLength;
+            double value;
+            std::memcpy(&value, area + offset, sizeof(value));
+            offset += sizeof(value);
+            variant.results[name] = value;
+        }
+        running.erase(it);
+    }
+    snapshot.Discard();
+
+    munmap(m_shared, m_sharedSize);
+    m_shared = nullptr;
+    m_sharedSize = 0;
+#else
+    NS_FATAL_ERROR("ParameterSweep is not supported on this platform");
+#endif
+}
+
+void
+ParameterSweep::RunVariant(uint32_t variant, Time duration)
+{
+    NS_LOG_FUNCTION(this << variant << duration);
+#ifndef __WIN32__
+    m_current = variant;
+    Variant& v = m_variants[variant];
+    if (v.reseed)
+    {
+        RngSeedManager::SetRun(v.run);
+        RandomVariableStream::ReseedAllStreams();
+    }
+    for (const auto& [path, value] : v.config)
+    {
+        Config::Set(path, *value);
+    }
+
+    Simulator::Stop(duration);
+    Simulator::Run();
+    if (!m_report.IsNull())
+    {
+        m_report(variant);
+    }
+
+    std::string records;
+    for (const auto& [name, value] : v.results)
+    {
+        uint32_t nameLength = name.size();
+        records.append(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        records.append(name);
+        records.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    NS_ABORT_MSG_IF(records.size() + sizeof(uint32_t) > m_capacity,
+                    "Results of variant " << variant << " exceed the result capacity ("
+                                          << m_capacity << " bytes)");
+    uint8_t* area = m_shared + static_cast<std::size_t>(m_capacity) * variant;
+    uint32_t length = records.size();
+    std::memcpy(area + sizeof(length), records.data(), records.size());
+    std::memcpy(area, &length, sizeof(length));
+
+    // Let the objects flush their output before leaving the process
+    Simulator::Destroy();
+    ForkSnapshot::Exit(0);
+#else
+    std::abort();
+#endif
+}
+
+void
+ParameterSweep::Report(const std::string& name, double value)
+{
+    NS_LOG_FUNCTION(this << name << value);
+    m_variants[m_current].results[name] = value;
+}
+
+uint32_t
+ParameterSweep::GetNVariants() const
+{
+    return m_variants.size();
+}
+
+int
+ParameterSweep::GetStatus(uint32_t variant) const
+{
+    NS_ASSERT_MSG(variant < m_variants.size(), "Invalid variant " << variant);
+    return m_variants[variant].status;
+}
+
+const std::map<std::string, double>&
+ParameterSweep::GetResults(uint32_t variant) const
+{
+    NS_ASSERT_MSG(variant < m_variants.size(), "Invalid variant " << variant);
+    return m_variants[variant].results;
+}
+
+double
+ParameterSweep::GetResult(uint32_t variant, const std::string& name) const
+{
+    NS_ASSERT_MSG(variant < m_variants.size(), "Invalid variant " << variant);
+    auto it = m_variants[variant].results.find(name);
+    if (it == m_variants[variant].results.end())
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return it->second;
+}
+
+} // namespace ns3
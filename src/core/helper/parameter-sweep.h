@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include "ns3/attribute.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-helpers
+ * ns3::ParameterSweep declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup core-helpers
+ *
+ * @brief Run variants of a scenario in parallel processes, from a
+ * single warmed-up state.
+ *
+ * The scenario is built, and simulated up to the fork time, only once.
+ * A ForkSnapshot is then taken, from which each variant is
+ * restored in its own process, copy-on-write.  A variant applies its
+ * own attribute values with Config::Set() and, optionally, its own run
+ * number, then simulates the measured interval, and reports its results
+ * through the report callback.  The results are sent back to the
+ * original process in a shared memory area.
+ *
+ * @code
+ *   // Build the scenario
+ *   ParameterSweep sweep;
+ *   for (uint32_t i = 0; i < 100; ++i)
+ *   {
+ *       uint32_t v = sweep.AddVariant();
+ *       sweep.Set(v, "/NodeList/0/ApplicationList/0/$ns3::OnOffApplication/DataRate",
+ *                 DataRateValue(DataRate((i + 1) * 100000)));
+ *       sweep.SetRun(v, 1 + i % 10);
+ *   }
+ *   sweep.SetReportCallback(MakeCallback(&ReportThroughput));
+ *   sweep.Run(Seconds(600), Seconds(60));
+ *   for (uint32_t v = 0; v < sweep.GetNVariants(); ++v)
+ *   {
+ *       std::cout << v << " " << sweep.GetResult(v, "throughput") << std::endl;
+ *   }
+ * @endcode
+ * where \c ReportThroughput(variant) calls \c sweep.Report("throughput", value).
+ *
+ * After Run(), the original process is left at the fork time; it can
+ * carry on with the simulation, or destroy it.  See ForkSnapshot
+ * for the constraints on the scenario, notably about open files.
+ */
+class ParameterSweep
+{
+  public:
+    /** Constructor. */
+    ParameterSweep();
+    /** Destructor. */
+    ~ParameterSweep();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    ParameterSweep(const ParameterSweep&) = delete;
+    ParameterSweep& operator=(const ParameterSweep&) = delete;
+
+    /**
+     * Add a variant, which by default runs the scenario unchanged.
+     * @returns The index of the variant.
+     */
+    uint32_t AddVariant();
+    /**
+     * Set an attribute value in a variant, with Config::Set().
+     *
+     * @param [in] variant The index of the variant.
+     * @param [in] path The attribute path.
+     * @param [in] value The attribute value.
+     */
+    void Set(uint32_t variant, const std::string& path, const AttributeValue& value);
+    /**
+     * Run a variant as another replication.
+     *
+     * All the existing random variable streams are restarted in the
+     * substream of \pname{run}, see RandomVariableStream::ReseedAllStreams().
+     * By default, the variants keep on drawing from the streams as they
+     * were at the fork time, so that they use common random numbers.
+     *
+     * @param [in] variant The index of the variant.
+     * @param [in] run The run number.
+     */
+    void SetRun(uint32_t variant, uint64_t run);
+    /**
+     * Set the maximum number of variants running at the same time.
+     * @param [in] jobs The number of processes; 0, the default, for one per CPU.
+     */
+    void SetJobs(uint32_t jobs);
+    /**
+     * Set the size of the result area of each variant.
+     * @param [in] bytes The size in bytes, 4096 by default.
+     */
+    void SetResultCapacity(uint32_t bytes);
+    /**
+     * Set the callback invoked in each variant process at the end of the
+     * measured interval, to Report() the results of the variant.
+     * @param [in] cb The callback, invoked with the index of the variant.
+     */
+    void SetReportCallback(Callback<void, uint32_t> cb);
+
+    /**
+     * Run the sweep.
+     *
+     * The simulation runs up to \pname{forkTime} in this process, then
+     * each variant runs for \pname{duration} more in its own process.
+     * This returns once all the variants are done.
+     *
+     * @param [in] forkTime The simulation time at which the variants start.
+     * @param [in] duration The duration of the measured interval.
+     */
+    void Run(Time forkTime, Time duration);
+
+    /**
+     * Report a result, from the report callback.
+     * @param [in] name The name of the result.
+     * @param [in] value The value.
+     */
+    void Report(const std::string& name, double value);
+
+    /**
+     * @returns The number of variants.
+     */
+    uint32_t GetNVariants() const;
+    /**
+     * Get the exit status of a variant process.
+     * @param [in] variant The index of the variant.
+     * @returns 0 if the variant completed, as for ForkSnapshot::Wait() otherwise.
+     */
+    int GetStatus(uint32_t variant) const;
+    /**
+     * Get all the results reported by a variant.
+     * @param [in] variant The index of the variant.
+     * @returns The results, by name.
+     */
+    const std::map<std::string, double>& GetResults(uint32_t variant) const;
+    /**
+     * Get a result reported by a variant.
+     * @param [in] variant The index of the variant.
+     * @param [in] name The name of the result.
+     * @returns The value, or NaN if the variant did not report it.
+     */
+    double GetResult(uint32_t variant, const std::string& name) const;
+
+  private:
+    /**
+     * Run a variant, in a restored process, and exit.
+     * @param [in] variant The index of the variant.
+     * @param [in] duration The duration of the measured interval.
+     */
+    [[noreturn]] void RunVariant(uint32_t variant, Time duration);
+
+    /** A variant of the scenario. */
+    struct Variant
+    {
+        /** The attribute values, by path. */
+        std::vector<std::pair<std::string, Ptr<AttributeValue>>> config;
+        bool reseed{false};                    //!< Restart the streams in #run.
+        uint64_t run{0};                       //!< The run number.
+        int status{-1};                        //!< The exit status of the process.
+        std::map<std::string, double> results; //!< The reported results.
+    };
+
+    std::vector<Variant> m_variants;   //!< The variants.
+    uint32_t m_jobs;                   //!< Maximum number of concurrent variants.
+    uint32_t m_capacity;               //!< Size of each result area.
+    Callback<void, uint32_t> m_report; //!< The report callback.
+    uint32_t m_current;                //!< The variant run by this process, if any.
+    uint8_t* m_shared;                 //!< The result areas, shared by all the processes.
+    std::size_t m_sharedSize;          //!< Size of #m_shared.
+};
+
+} // namespace ns3
+
+#endif /* PARAMETER_SWEEP_H */
@@ -0,0 +1,251 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EXPIRY_WHEEL_H
+#define EXPIRY_WHEEL_H
+
+#include "nstime.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::ExpiryWheel declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup timer
+ * @brief Hierarchical timing wheel, to find the expired entries of a table
+ * without scanning it.
+ *
+ * Each scheduled key sits in a slot of the wheel according to its expiry
+ * time: the first level has one slot per tick, and each further level
+ * covers 64 times the span of the previous one.  As time advances, the
+ * slots of the higher levels are spread over the lower ones, so that
+ * scheduling and expiring a key take amortized constant time.
+ *
+ * The wheel does not support cancellation: the owner of the keys checks,
+ * when a key expires, whether its expiry is still current, and schedules
+ * it again otherwise.
+ *
+ * @tparam Key The key type.
+ */
+template <typename Key>
+class ExpiryWheel
+{
+  public:
+    /**
+     * Constructor
+     * @param granularity the duration of a tick
+     */
+    ExpiryWheel(Time granularity = MilliSeconds(1))
+        : m_granularity(granularity.GetTimeStep()),
+          m_current(0),
+          m_size(0)
+    {
+        m_occupied.fill(0);
+    }
+
+    /**
+     * Schedule a key
+     * @param key the key
+     * @param expiry the absolute time at which the key expires
+     */
+    void Schedule(const Key& key, Time expiry)
+    {
+        Insert({key, expiry.GetTimeStep()});
+        m_size++;
+    }
+
+    /**
+     * Remove all the keys which expire strictly before now, calling
+     * expired(key, expiry) for each of them.  The callback can schedule
+     * keys again.
+     *
+     * @tparam F \deduced The callback type.
+     * @param now the current time
+     * @param expired the callback
+     */
+    template <typename F>
+    void Expire(Time now, F expired)
+    {
+        uint64_t target = GetTick(now.GetTimeStep());
+        // All the keys of the ticks before the current one have expired
+        while (m_current < target)
+        {
+            uint32_t slot = m_current & MASK;
+            uint64_t pending = m_occupied[0] >> slot;
+            uint64_t skip =
+                pending == 0 ? SLOTS - slot : static_cast<uint64_t>(std::countr_zero(pending));
+            if (skip > 0)
+            {
+                m_current += std::min(skip, target - m_current);
+            }
+            else
+            {
+                Items items = Take(0, slot);
+                ++m_current;
+                for (const auto& [key, expiry] : items)
+                {
+                    m_size--;
+                    expired(key, Time(expiry));
+                }
+            }
+            if ((m_current & MASK) == 0)
+            {
+                Cascade();
+            }
+        }
+
+        // The keys of the current tick have to be checked one by one
+        uint32_t slot = m_current & MASK;
+        if (m_occupied[0] & (uint64_t{1} << slot))
+        {
+            Items items = Take(0, slot);
+            for (const auto& item : items)
+            {
+                if (item.second < now.GetTimeStep())
+                {
+                    m_size--;
+                    expired(item.first, Time(item.second));
+                }
+                else
+                {
+                    Insert(item);
+                }
+            }
+        }
+    }
+
+    /**
+     * Remove all the keys
+     */
+    void Clear()
+    {
+        for (auto& level : m_slots)
+        {
+            for (auto& slot : level)
+            {
+                slot.clear();
+            }
+        }
+        m_overflow.clear();
+        m_occupied.fill(0);
+        m_size = 0;
+    }
+
+    /**
+     * @returns the number of keys scheduled, including the outdated ones
+     */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+  private:
+    /// A scheduled key and its expiry time, in time steps
+    using Item = std::pair<Key, int64_t>;
+    /// The keys of a slot
+    using Items = std::vector<Item>;
+
+    static constexpr uint32_t BITS = 6;          //!< log2 of the number of slots per level
+    static constexpr uint32_t SLOTS = 1 << BITS; //!< Number of slots per level
+    static constexpr uint32_t MASK = SLOTS - 1;  //!< Mask of a slot index
+    static constexpr uint32_t LEVELS = 4;        //!< Number of levels
+
+    /**
+     * @param timeStep a time, in time steps
+     * @returns the tick of the time
+     */
+    uint64_t GetTick(int64_t timeStep) const
+    {
+        return timeStep < 0 ? 0 : static_cast<uint64_t>(timeStep / m_granularity);
+    }
+
+    /**
+     * Put an item in the slot matching its expiry time
+     * @param item the item
+     */
+    void Insert(const Item& item)
+    {
+        uint64_t tick = GetTick(item.second);
+        // The past ticks are handled as the current one
+        uint64_t delta = tick > m_current ? tick - m_current : 0;
+        if (delta == 0)
+        {
+            tick = m_current;
+        }
+        for (uint32_t level = 0; level < LEVELS; level++)
+        {
+            if (delta < (uint64_t{1} << (BITS * (level + 1))))
+            {
+                uint32_t slot = (tick >> (BITS * level)) & MASK;
+                m_slots[level][slot].push_back(item);
+                m_occupied[level] |= uint64_t{1} << slot;
+                return;
+            }
+        }
+        m_overflow.push_back(item);
+    }
+
+    /**
+     * Empty a slot
+     * @param level the level of the slot
+     * @param slot the index of the slot
+     * @returns the items of the slot
+     */
+    Items Take(uint32_t level, uint32_t slot)
+    {
+        Items items;
+        items.swap(m_slots[level][slot]);
+        m_occupied[level] &= ~(uint64_t{1} << slot);
+        return items;
+    }
+
+    /**
+     * Spread the slots of the higher levels which start at the current tick
+     * over the lower levels.
+     */
+    void Cascade()
+    {
+        for (uint32_t level = 1; level < LEVELS; level++)
+        {
+            uint32_t slot = (m_current >> (BITS * level)) & MASK;
+            for (const auto& item : Take(level, slot))
+            {
+                Insert(item);
+            }
+            if (slot != 0)
+            {
+                return;
+            }
+        }
+        Items overflow;
+        overflow.swap(m_overflow);
+        for (const auto& item : overflow)
+        {
+            Insert(item);
+        }
+    }
+
+    int64_t m_granularity;                                //!< Duration of a tick, in time steps
+    uint64_t m_current;                                   //!< Current tick
+    std::size_t m_size;                                   //!< Number of scheduled keys
+    std::array<std::array<Items, SLOTS>, LEVELS> m_slots; //!< Slots of each level
+    std::array<uint64_t, LEVELS> m_occupied;              //!< Non-empty slots of each level
+    Items m_overflow;                                     //!< Keys beyond the span of the wheel
+};
+
+} // namespace ns3
+
+#endif /* EXPIRY_WHEEL_H */
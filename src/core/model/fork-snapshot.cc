@@ -0,0 +1,325 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fork-snapshot.h"
+
+#include "abort.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifndef __WIN32__
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::ForkSnapshot implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ForkSnapshot");
+
+namespace
+{
+
+/** Requests to the keeper process. */
+enum Op : uint32_t
+{
+    RESTORE = 1,        //!< Fork a restored process; the reply is its pid.
+    WAIT = 2,           //!< Wait for a restored process; the reply is its status.
+    DISCARD = 3,        //!< Terminate the keeper; there is no reply.
+    WAIT_ANY_CHILD = 4, //!< Wait for any restored process; the reply is its pid, then status.
+};
+
+/** A request to the keeper process. */
+struct Message
+{
+    uint32_t op; //!< The request code.
+    int64_t arg; //!< The request argument.
+};
+
+#ifndef __WIN32__
+/**
+ * Read exactly \pname{size} bytes.
+ * @param [in] fd The file descriptor.
+ * @param [out] buffer The buffer.
+ * @param [in] size The number of bytes.
+ * @returns \c false on error or end of file.
+ */
+bool
+ReadAll(int fd, void* buffer, std::size_t size)
+{
+    auto p = static_cast<char*>(buffer);
+    while (size > 0)
+    {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+/**
+ * Write exactly \pname{size} bytes.
+ * @param [in] fd The file descriptor.
+ * @param [in] buffer The buffer.
+ * @param [in] size The number of bytes.
+ * @returns \c false on error.
+ */
+bool
+WriteAll(int fd, const void* buffer, std::size_t size)
+{
+    auto p = static_cast<const char*>(buffer);
+    while (size > 0)
+    {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+/** Flush the output buffers, so that forked processes do not repeat them. */
+void
+FlushOutput()
+{
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+    std::fflush(nullptr);
+}
+#endif
+
+} // unnamed namespace
+
+ForkSnapshot::ForkSnapshot()
+    : m_request(-1),
+      m_reply(-1),
+      m_keeper(-1)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ForkSnapshot::~ForkSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    Discard();
+}
+
+bool
+ForkSnapshot::IsTaken() const
+{
+    return m_keeper != -1;
+}
+
+uint32_t
+ForkSnapshot::Take()
+{
+    NS_LOG_FUNCTION(this);
+#ifndef __WIN32__
+    NS_ABORT_MSG_IF(IsTaken(), "Snapshot already taken");
+    int request[2];
+    int reply[2];
+    NS_ABORT_MSG_IF(pipe(request) != 0 || pipe(reply) != 0,
+                    "Cannot create the snapshot pipes: " << std::strerror(errno));
+    FlushOutput();
+    pid_t pid = fork();
+    NS_ABORT_MSG_IF(pid < 0, "Cannot fork the snapshot process: " << std::strerror(errno));
+    if (pid == 0)
+    {
+        close(request[1]);
+        close(reply[0]);
+        return Serve(request[0], reply[1]);
+    }
+    close(request[0]);
+    close(reply[1]);
+    m_request = request[1];
+    m_reply = reply[0];
+    m_keeper = pid;
+    NS_LOG_LOGIC("Snapshot kept by process " << pid);
+    return 0;
+#else
+    NS_FATAL_ERROR("ForkSnapshot is not supported on this platform");
+    return 0;
+#endif
+}
+
+uint32_t
+ForkSnapshot::Serve(int request, int reply)
+{
+    NS_LOG_FUNCTION(this << request << reply);
+#ifndef __WIN32__
+    Message message;
+    while (ReadAll(request, &message, sizeof(message)))
+    {
+        int64_t result = -1;
+        if (message.op == RESTORE)
+        {
+            FlushOutput();
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                // The restored process owns nothing of this snapshot
+                close(request);
+                close(reply);
+                return static_cast<uint32_t>(message.arg);
+            }
+            result = pid;
+        }
+        else if (message.op == WAIT || message.op == WAIT_ANY_CHILD)
+        {
+            int status = 0;
+            pid_t pid;
+            do
+            {
+                pid = waitpid(message.op == WAIT ? static_cast<pid_t>(message.arg) : -1,
+                              &status,
+                              0);
+            } while (pid < 0 && errno == EINTR);
+            if (pid < 0)
+            {
+                result = -1;
+            }
+            else if (WIFSIGNALED(status))
+            {
+                result = -WTERMSIG(status);
+            }
+            else
+            {
+                result = WEXITSTATUS(status);
+            }
+            if (message.op == WAIT_ANY_CHILD)
+            {
+                int64_t any = pid < 0 ? -1 : pid;
+                if (!WriteAll(reply, &any, sizeof(any)))
+                {
+                    break;
+                }
+            }
+        }
+        else
+        {
+            break;
+        }
+        if (!WriteAll(reply, &result, sizeof(result)))
+        {
+            break;
+        }
+    }
+    // Don't run the destructors of the simulation copied into this process
+    _exit(0);
+#endif
+    return 0;
+}
+
+int64_t
+ForkSnapshot::Request(uint32_t op, int64_t arg)
+{
+    NS_LOG_FUNCTION(this << op << arg);
+#ifndef __WIN32__
+    NS_ABORT_MSG_UNLESS(IsTaken(), "Snapshot not taken");
+    Message message{op, arg};
+    int64_t result;
+    NS_ABORT_MSG_UNLESS(WriteAll(m_request, &message, sizeof(message)) &&
+                            ReadAll(m_reply, &result, sizeof(result)),
+                        "Lost the snapshot process " << m_keeper);
+    return result;
+#else
+    return -1;
+#endif
+}
+
+int64_t
+ForkSnapshot::Restore(uint32_t id)
+{
+    NS_LOG_FUNCTION(this << id);
+    NS_ABORT_MSG_IF(id == 0, "The id of a restored process must be strictly positive");
+    int64_t pid = Request(RESTORE, id);
+    NS_ABORT_MSG_IF(pid < 0, "Cannot restore the snapshot");
+    return pid;
+}
+
+int
+ForkSnapshot::Wait(int64_t pid)
+{
+    NS_LOG_FUNCTION(this << pid);
+    return static_cast<int>(Request(WAIT, pid));
+}
+
+int64_t
+ForkSnapshot::WaitAny(int& status)
+{
+    NS_LOG_FUNCTION(this);
+    int64_t pid = Request(WAIT_ANY_CHILD, 0);
+#ifndef __WIN32__
+    int64_t result;
+    NS_ABORT_MSG_UNLESS(ReadAll(m_reply, &result, sizeof(result)),
+                        "Lost the snapshot process " << m_keeper);
+    status = static_cast<int>(result);
+#endif
+    return pid;
+}
+
+void
+ForkSnapshot::Exit(int status)
+{
+    NS_LOG_FUNCTION(status);
+#ifndef __WIN32__
+    FlushOutput();
+    _exit(status);
+#else
+    std::exit(status);
+#endif
+}
+
+void
+ForkSnapshot::Discard()
+{
+    NS_LOG_FUNCTION(this);
+#ifndef __WIN32__
+    if (!IsTaken())
+    {
+        return;
+    }
+    Message message{DISCARD, 0};
+    WriteAll(m_request, &message, sizeof(message));
+    close(m_request);
+    close(m_reply);
+    while (waitpid(static_cast<pid_t>(m_keeper), nullptr, 0) < 0 && errno == EINTR)
+    {
+    }
+    m_request = -1;
+    m_reply = -1;
+    m_keeper = -1;
+#endif
+}
+
+} // namespace ns3
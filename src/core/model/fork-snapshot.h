@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FORK_SNAPSHOT_H
+#define FORK_SNAPSHOT_H
+
+#include <cstdint>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::ForkSnapshot declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * @brief An in-memory snapshot of a running simulation process, from
+ * which it can be resumed any number of times with \c fork().
+ *
+ * This is not a serialization of the simulation state: nothing is
+ * written to a file, the snapshot can not be reloaded by another
+ * process or on another host, and it is lost when the original process
+ * discards it or exits.  The state of a simulation is spread over the
+ * event queue, whose events hold arbitrary callbacks, the objects of
+ * every model, the random number streams and the packets in flight,
+ * and most of it has no serialized form.  Instead, Take() forks a
+ * "keeper" process, which sits idle while sharing its memory,
+ * copy-on-write, with the calling process.  Each call to Restore()
+ * forks the keeper again, and the new process resumes from the point
+ * where Take() was called, with the exact same state.
+ *
+ * Take() returns twice, like \c fork(): it returns 0 in the calling
+ * process, and the value passed to Restore() in each restored
+ * process.  This value is typically used to select the variant of
+ * the scenario the restored process should run:
+ * @code
+ *   Simulator::Stop(warmup);
+ *   Simulator::Run();
+ *   ForkSnapshot snapshot;
+ *   uint32_t variant = snapshot.Take();
+ *   if (variant == 0)
+ *   {
+ *       // Original process: start the variants, and wait for them
+ *       std::vector<int64_t> pids;
+ *       for (uint32_t i = 1; i <= nVariants; ++i)
+ *       {
+ *           pids.push_back(snapshot.Restore(i));
+ *       }
+ *       for (auto pid : pids)
+ *       {
+ *           snapshot.Wait(pid);
+ *       }
+ *       return 0;
+ *   }
+ *   // Restored process: apply the variant and run the measured interval
+ *   Config::Set(..., variants[variant - 1]);
+ *   Simulator::Stop(duration);
+ *   Simulator::Run();
+ *   Simulator::Destroy();
+ *   ForkSnapshot::Exit(0);
+ * @endcode
+ *
+ * Take() can also be called from an event, during Simulator::Run(); the
+ * restored processes then return from that event and carry on with the
+ * simulation.
+ *
+ * The restored processes do not share anything with the original one,
+ * except for open file descriptors: output files should be opened after
+ * the snapshot, or be different for each restored process.  Only the
+ * calling thread is copied, so the snapshot must not be taken while
+ * other threads are running, as with the multithreaded or distributed
+ * simulators.  This is only available on POSIX systems.
+ */
+class ForkSnapshot
+{
+  public:
+    /** Constructor. */
+    ForkSnapshot();
+    /** Destructor, discards the snapshot. */
+    ~ForkSnapshot();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    ForkSnapshot(const ForkSnapshot&) = delete;
+    ForkSnapshot& operator=(const ForkSnapshot&) = delete;
+
+    /**
+     * Take the snapshot.
+     *
+     * @returns 0 in the calling process, or the id passed to Restore()
+     *          in a process restored from this snapshot.
+     */
+    uint32_t Take();
+    /**
+     * Start a new process from the snapshot.
+     *
+     * @param [in] id The value returned by Take() in the new process;
+     *             must be strictly positive.
+     * @returns The process id of the new process.
+     */
+    int64_t Restore(uint32_t id);
+    /**
+     * Wait for the end of a restored process.
+     *
+     * @param [in] pid A process id returned by Restore().
+     * @returns The exit status of the process, or minus the number of
+     *          the signal which terminated it.
+     */
+    int Wait(int64_t pid);
+    /**
+     * Wait for the end of any restored process.
+     *
+     * @param [out] status The exit status of the process, as for Wait().
+     * @returns The process id of the process, or -1 if there is no
+     *          restored process left to wait for.
+     */
+    int64_t WaitAny(int& status);
+    /**
+     * Release the snapshot.
+     *
+     * The keeper process terminates, and no process can be restored
+     * from this snapshot anymore.  The restored processes which have
+     * not been waited for keep on running.
+     */
+    void Discard();
+    /**
+     * Check if the snapshot has been taken, and not discarded.
+     * @returns \c true if Restore() can be called.
+     */
+    bool IsTaken() const;
+
+    /**
+     * Terminate a restored process.
+     *
+     * The output buffers are flushed, but the destructors of the static
+     * objects are not run: they were copied from the original process,
+     * which still owns the resources they would release.
+     *
+     * @param [in] status The exit status, returned by Wait() in the
+     *             original process.
+     */
+    [[noreturn]] static void Exit(int status);
+
+  private:
+    /**
+     * Serve the requests of the original process, in the keeper process.
+     *
+     * @param [in] request The file descriptor to read the requests from.
+     * @param [in] reply The file descriptor to write the replies to.
+     * @returns The id of the restored process, in the restored processes
+     *          only: the keeper process itself never returns.
+     */
+    uint32_t Serve(int request, int reply);
+    /**
+     * Send a request to the keeper process and wait for its reply.
+     *
+     * @param [in] op The request code.
+     * @param [in] arg The request argument.
+     * @returns The reply.
+     */
+    int64_t Request(uint32_t op, int64_t arg);
+
+    int m_request;    //!< Write end of the request pipe to the keeper.
+    int m_reply;      //!< Read end of the reply pipe from the keeper.
+    int64_t m_keeper; //!< Process id of the keeper, or -1 if not taken.
+};
+
+} // namespace ns3
+
+#endif /* FORK_SNAPSHOT_H */
@@ -0,0 +1,533 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "log-binary-sink.h"
+
+#include "fatal-error.h"
+#include "log.h"
+#include "nstime.h"
+#include "simulator.h"
+
+#include <atomic>
+#include <cstring> // memcmp
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+/**
+ * @file
+ * @ingroup logging
+ * ns3::BinaryLogSink and ns3::BinaryLogRecord implementations.
+ */
+
+/**
+ * @ingroup logging
+ * Unnamed namespace for log-binary-sink.cc
+ */
+namespace
+{
+
+/** File magic, followed by the Time resolution. */
+const char BINARY_LOG_MAGIC[8] = {'N', 'S', '3', 'B', 'L', 'O', 'G', '1'};
+
+/** Record type: site definition. */
+const uint8_t RECORD_SITE = 'S';
+/** Record type: log record. */
+const uint8_t RECORD_LOG = 'R';
+
+/** Flush a thread buffer to the file once it grows past this size. */
+const std::size_t THREAD_BUFFER_SIZE = 64 * 1024;
+
+/** A registered log statement. */
+struct Site
+{
+    std::string component; //!< Log component name.
+    std::string function;  //!< Function name.
+    int32_t level;         //!< LogLevel.
+    bool isFunction;       //!< NS_LOG_FUNCTION statement.
+};
+
+/** Sink state shared by all threads, protected by #Shared::mutex. */
+struct Shared
+{
+    std::mutex mutex;                //!< Protects everything below.
+    std::ofstream file;              //!< The sink file.
+    std::atomic<bool> active{false}; //!< Is the sink open.
+    std::vector<Site> sites;         //!< Registered sites, indexed by id.
+};
+
+/**
+ * Get the shared sink state.
+ * @returns The shared state.
+ */
+Shared&
+GetShared()
+{
+    static Shared shared;
+    return shared;
+}
+
+/**
+ * Append a length-prefixed string to a byte buffer.
+ * @param [in,out] buffer The buffer.
+ * @param [in] str The string.
+ */
+void
+PutString(std::vector<uint8_t>& buffer, const std::string& str)
+{
+    auto len = static_cast<uint32_t>(str.size());
+    auto p = reinterpret_cast<const uint8_t*>(&len);
+    buffer.insert(buffer.end(), p, p + sizeof(len));
+    buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+/**
+ * Write a site definition to the sink file.  Called with the mutex held.
+ * @param [in] shared The shared state.
+ * @param [in] id The site id.
+ */
+void
+WriteSite(Shared& shared, uint32_t id)
+{
+    const Site& site = shared.sites[id];
+    std::vector<uint8_t> buffer;
+    buffer.push_back(RECORD_SITE);
+    auto p = reinterpret_cast<const uint8_t*>(&id);
+    buffer.insert(buffer.end(), p, p + sizeof(id));
+    p = reinterpret_cast<const uint8_t*>(&site.level);
+    buffer.insert(buffer.end(), p, p + sizeof(site.level));
+    buffer.push_back(site.isFunction);
+    PutString(buffer, site.component);
+    PutString(buffer, site.function);
+    shared.file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+/** Per-thread buffer of committed records. */
+struct ThreadBuffer
+{
+    std::vector<uint8_t> committed; //!< Records ready to be written.
+    /**
+     * Scratch buffers for records under construction, one per nesting
+     * depth (formatting an argument may itself log).
+     */
+    std::deque<std::vector<uint8_t>> scratch;
+    std::size_t depth{0}; //!< Number of records under construction.
+
+    /** Write the committed records to the sink file. */
+    void Flush()
+    {
+        if (committed.empty())
+        {
+            return;
+        }
+        Shared& shared = GetShared();
+        std::unique_lock lock{shared.mutex};
+        if (shared.active)
+        {
+            shared.file.write(reinterpret_cast<const char*>(committed.data()), committed.size());
+        }
+        committed.clear();
+    }
+
+    /** Destructor, flushes the records of an exiting thread. */
+    ~ThreadBuffer()
+    {
+        Flush();
+    }
+};
+
+/**
+ * Get the buffer of the calling thread.
+ * @returns The thread buffer.
+ */
+ThreadBuffer&
+GetThreadBuffer()
+{
+    thread_local ThreadBuffer buffer;
+    return buffer;
+}
+
+/**
+ * Read a fixed-size value.
+ * @tparam V \deduced The value type.
+ * @param [in] is The input stream.
+ * @param [out] value The value read.
+ * @returns \c true if the read succeeded.
+ */
+template <typename V>
+bool
+Read(std::istream& is, V& value)
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+/**
+ * Read a length-prefixed string.
+ * @param [in] is The input stream.
+ * @param [out] str The string read.
+ * @returns \c true if the read succeeded.
+ */
+bool
+ReadString(std::istream& is, std::string& str)
+{
+    uint32_t len;
+    if (!Read(is, len))
+    {
+        return false;
+    }
+    str.resize(len);
+    return len == 0 || static_cast<bool>(is.read(str.data(), len));
+}
+
+} // Unnamed namespace
+
+namespace ns3
+{
+
+void
+BinaryLogSink::Open(const std::string& filename)
+{
+    Close();
+    Shared& shared = GetShared();
+    std::unique_lock lock{shared.mutex};
+    shared.file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!shared.file.is_open())
+    {
+        NS_FATAL_ERROR("Unable to open binary log file " << filename);
+    }
+    shared.file.write(BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    auto resolution = static_cast<uint8_t>(Time::GetResolution());
+    shared.file.write(reinterpret_cast<const char*>(&resolution), sizeof(resolution));
+    for (uint32_t id = 0; id < shared.sites.size(); ++id)
+    {
+        WriteSite(shared, id);
+    }
+    shared.active = true;
+}
+
+void
+BinaryLogSink::Close()
+{
+    GetThreadBuffer().Flush();
+    Shared& shared = GetShared();
+    std::unique_lock lock{shared.mutex};
+    if (shared.active)
+    {
+        shared.active = false;
+        shared.file.close();
+    }
+}
+
+bool
+BinaryLogSink::IsActive()
+{
+    return GetShared().active;
+}
+
+uint32_t
+BinaryLogSink::RegisterSite(const std::string& component,
+                            const char* function,
+                            int32_t level,
+                            bool isFunction)
+{
+    Shared& shared = GetShared();
+    std::unique_lock lock{shared.mutex};
+    auto id = static_cast<uint32_t>(shared.sites.size());
+    shared.sites.push_back({component, function, level, isFunction});
+    if (shared.active)
+    {
+        WriteSite(shared, id);
+    }
+    return id;
+}
+
+bool
+BinaryLogSink::Format(std::istream& is, std::ostream& os)
+{
+    char magic[sizeof(BINARY_LOG_MAGIC)];
+    uint8_t resolution;
+    if (!is.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, BINARY_LOG_MAGIC, sizeof(magic)) != 0 || !Read(is, resolution))
+    {
+        return false;
+    }
+
+    // Mimic DefaultTimePrinter, without depending on the current resolution
+    static const std::pair<long double, int> scales[] = {
+        {1.0L / 31536000, 5}, // Y
+        {1.0L / 86400, 5},    // D
+        {1.0L / 3600, 5},     // H
+        {1.0L / 60, 5},       // MIN
+        {1, 5},               // S
+        {1e3L, 5},            // MS
+        {1e6L, 6},            // US
+        {1e9L, 9},            // NS
+        {1e12L, 12},          // PS
+        {1e15L, 15},          // FS
+    };
+    if (resolution >= std::size(scales))
+    {
+        return false;
+    }
+    auto [perSecond, precision] = scales[resolution];
+
+    std::vector<Site> sites;
+    auto flags = os.setf(std::ios_base::boolalpha);
+    uint8_t type;
+    while (Read(is, type))
+    {
+        if (type == RECORD_SITE)
+        {
+            uint32_t id;
+            Site site;
+            uint8_t isFunction;
+            if (!Read(is, id) || !Read(is, site.level) || !Read(is, isFunction) ||
+                !ReadString(is, site.component) || !ReadString(is, site.function))
+            {
+                return false;
+            }
+            site.isFunction = isFunction;
+            if (id >= sites.size())
+            {
+                sites.resize(id + 1);
+            }
+            sites[id] = site;
+            continue;
+        }
+        uint32_t id;
+        int32_t prefixes;
+        if (type != RECORD_LOG || !Read(is, id) || id >= sites.size() || !Read(is, prefixes))
+        {
+            return false;
+        }
+        const Site& site = sites[id];
+
+        if (prefixes & LOG_PREFIX_TIME)
+        {
+            int64_t ts;
+            if (!Read(is, ts))
+            {
+                return false;
+            }
+            std::ios_base::fmtflags ff = os.flags();
+            std::streamsize oldPrecision = os.precision();
+            os << std::fixed << std::setprecision(precision) << std::showpos
+               << (ts / perSecond) << "s ";
+            os.precision(oldPrecision);
+            os.flags(ff);
+        }
+        if (prefixes & LOG_PREFIX_NODE)
+        {
+            uint32_t context;
+            if (!Read(is, context))
+            {
+                return false;
+            }
+            if (context == Simulator::NO_CONTEXT)
+            {
+                os << "-1 ";
+            }
+            else
+            {
+                os << context << " ";
+            }
+        }
+        if (site.isFunction)
+        {
+            os << site.component << ":" << site.function << "(";
+        }
+        else
+        {
+            if (prefixes & LOG_PREFIX_FUNC)
+            {
+                os << site.component << ":" << site.function << "(): ";
+            }
+            if (prefixes & LOG_PREFIX_LEVEL)
+            {
+                os << "[" << LogComponent::GetLevelLabel(static_cast<LogLevel>(site.level))
+                   << "] ";
+            }
+        }
+
+        bool first = true;
+        uint8_t tag;
+        while (Read(is, tag) && tag != END)
+        {
+            if (site.isFunction && !first)
+            {
+                os << ", ";
+            }
+            first = false;
+            switch (tag)
+            {
+            case BOOL: {
+                uint8_t v;
+                Read(is, v);
+                os << static_cast<bool>(v);
+                break;
+            }
+            case CHAR: {
+                char v;
+                Read(is, v);
+                os << v;
+                break;
+            }
+            case SIGNED: {
+                int64_t v;
+                Read(is, v);
+                os << v;
+                break;
+            }
+            case UNSIGNED: {
+                uint64_t v;
+                Read(is, v);
+                os << v;
+                break;
+            }
+            case DOUBLE: {
+                double v;
+                Read(is, v);
+                os << v;
+                break;
+            }
+            case POINTER: {
+                uint64_t v;
+                Read(is, v);
+                os << reinterpret_cast<const void*>(static_cast<uintptr_t>(v));
+                break;
+            }
+            case STRING:
+            case TEXT: {
+                std::string v;
+                if (!ReadString(is, v))
+                {
+                    return false;
+                }
+                if (site.isFunction && tag == STRING)
+                {
+                    os << "\"" << v << "\"";
+                }
+                else
+                {
+                    os << v;
+                }
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        if (!is)
+        {
+            return false;
+        }
+        if (site.isFunction)
+        {
+            os << ")";
+        }
+        os << std::endl;
+    }
+    os.flags(flags);
+    return true;
+}
+
+void
+LogSetBinarySink(const std::string& filename)
+{
+    BinaryLogSink::Open(filename);
+}
+
+void
+LogClearBinarySink()
+{
+    BinaryLogSink::Close();
+}
+
+BinaryLogRecord::BinaryLogRecord(uint32_t site, int32_t prefixes, bool isFunction)
+    : m_buffer([]() -> std::vector<uint8_t>& {
+          ThreadBuffer& tb = GetThreadBuffer();
+          if (tb.scratch.size() <= tb.depth)
+          {
+              tb.scratch.resize(tb.depth + 1);
+          }
+          return tb.scratch[tb.depth++];
+      }()),
+      m_function(isFunction)
+{
+    // As with text logging, there is no prefix until a printer has been set
+    if (!LogGetTimePrinter())
+    {
+        prefixes &= ~LOG_PREFIX_TIME;
+    }
+    if (!LogGetNodePrinter())
+    {
+        prefixes &= ~LOG_PREFIX_NODE;
+    }
+    m_buffer.clear();
+    m_buffer.push_back(RECORD_LOG);
+    Put(&site, sizeof(site));
+    Put(&prefixes, sizeof(prefixes));
+    if (prefixes & LOG_PREFIX_TIME)
+    {
+        int64_t ts = Simulator::Now().GetTimeStep();
+        Put(&ts, sizeof(ts));
+    }
+    if (prefixes & LOG_PREFIX_NODE)
+    {
+        uint32_t context = Simulator::GetContext();
+        Put(&context, sizeof(context));
+    }
+}
+
+BinaryLogRecord::~BinaryLogRecord()
+{
+    if (m_text)
+    {
+        PutString(BinaryLogSink::TEXT, m_text->str());
+    }
+    m_buffer.push_back(BinaryLogSink::END);
+
+    ThreadBuffer& tb = GetThreadBuffer();
+    tb.committed.insert(tb.committed.end(), m_buffer.begin(), m_buffer.end());
+    tb.depth--;
+    if (tb.committed.size() >= THREAD_BUFFER_SIZE)
+    {
+        tb.Flush();
+    }
+}
+
+BinaryLogRecord&
+BinaryLogRecord::operator<<(std::ostream& (*manip)(std::ostream&))
+{
+    Text() << manip;
+    return *this;
+}
+
+void
+BinaryLogRecord::Put(const void* data, std::size_t size)
+{
+    auto p = static_cast<const uint8_t*>(data);
+    m_buffer.insert(m_buffer.end(), p, p + size);
+}
+
+void
+BinaryLogRecord::PutString(BinaryLogSink::ItemTag tag, const std::string& str)
+{
+    Put(&tag, 1);
+    ::PutString(m_buffer, str);
+}
+
+std::ostream&
+BinaryLogRecord::Text()
+{
+    if (!m_text)
+    {
+        m_text = std::make_unique<std::ostringstream>();
+        m_text->setf(std::ios_base::boolalpha);
+    }
+    return *m_text;
+}
+
+} // namespace ns3
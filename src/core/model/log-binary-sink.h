@@ -0,0 +1,346 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NS3_LOG_BINARY_SINK_H
+#define NS3_LOG_BINARY_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup logging
+ * ns3::BinaryLogSink and ns3::BinaryLogRecord declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup logging
+ * Binary, structured destination for the NS_LOG macros.
+ *
+ * When a binary sink is open, enabled log statements are not formatted on
+ * the spot.  Instead, each statement (a "site") is registered once, with
+ * its component, function and level, and is assigned an integer id.  Each
+ * time the statement is executed, a record made of the site id, the raw
+ * simulation time and node context (if the corresponding prefixes are
+ * enabled), and the raw bytes of the arguments is appended to a buffer
+ * local to the calling thread.  The buffers are written to the sink file
+ * when they fill up, when their thread exits and when the sink is closed.
+ *
+ * The file is turned into the usual text log offline with Format(), or
+ * with the \c print-binary-log utility:
+ * @code
+ *   LogSetBinarySink("run.nslog");
+ *   ...
+ *   $ ./ns3 run "print-binary-log run.nslog"
+ * @endcode
+ *
+ * Arithmetic types, pointers and strings are stored raw.  The first
+ * argument of any other type (including stream manipulators) is formatted
+ * immediately, together with all the arguments which follow it in the
+ * same statement, so that the output is the same as with text logging.
+ * The time and node prefixes are always printed in the format of
+ * DefaultTimePrinter() and DefaultNodePrinter(), and the file-local
+ * NS_LOG_APPEND_CONTEXT is not recorded.
+ */
+class BinaryLogSink
+{
+  public:
+    /**
+     * Open a binary log file, closing the current one if any.
+     *
+     * @param [in] filename The file to write to.
+     */
+    static void Open(const std::string& filename);
+    /**
+     * Flush the buffer of the calling thread and close the sink.
+     */
+    static void Close();
+    /**
+     * Is a binary sink open?
+     * @returns \c true if log records should go to the binary sink.
+     */
+    static bool IsActive();
+    /**
+     * Register a log statement.
+     *
+     * @param [in] component The log component name.
+     * @param [in] function The name of the function containing the statement.
+     * @param [in] level The LogLevel of the statement.
+     * @param [in] isFunction Whether this is a NS_LOG_FUNCTION statement.
+     * @returns The site id.
+     */
+    static uint32_t RegisterSite(const std::string& component,
+                                 const char* function,
+                                 int32_t level,
+                                 bool isFunction);
+    /**
+     * Convert a binary log to text.
+     *
+     * @param [in] is The binary log.
+     * @param [in] os The stream to write the text log to.
+     * @returns \c false if the input is not a valid binary log.
+     */
+    static bool Format(std::istream& is, std::ostream& os);
+
+    /** Item type tags in a binary log record. */
+    enum ItemTag : uint8_t
+    {
+        END = 0,      //!< End of record.
+        BOOL = 1,     //!< A bool, stored as one byte.
+        CHAR = 2,     //!< A character, stored as one byte.
+        SIGNED = 3,   //!< A signed integer, stored as 8 bytes.
+        UNSIGNED = 4, //!< An unsigned integer, stored as 8 bytes.
+        DOUBLE = 5,   //!< A floating point number, stored as a double.
+        POINTER = 6,  //!< A pointer value, stored as 8 bytes.
+        STRING = 7,   //!< A string argument: 4 bytes length, then the bytes.
+        TEXT = 8,     //!< Preformatted text: 4 bytes length, then the bytes.
+    };
+};
+
+/**
+ * @ingroup logging
+ * Open a binary log sink; see BinaryLogSink.
+ *
+ * @param [in] filename The file to write to.
+ */
+void LogSetBinarySink(const std::string& filename);
+
+/**
+ * @ingroup logging
+ * Close the binary log sink, returning to text logging.
+ */
+void LogClearBinarySink();
+
+/**
+ * @ingroup logging
+ * A single record for the BinaryLogSink.
+ *
+ * Instances are created by the NS_LOG macros, fed with the log
+ * statement arguments, and committed to the sink when destroyed.
+ */
+class BinaryLogRecord
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] site The site id from BinaryLogSink::RegisterSite().
+     * @param [in] prefixes The LOG_PREFIX_* flags enabled for the component.
+     * @param [in] isFunction Whether this is a NS_LOG_FUNCTION record,
+     *             whose arguments are printed like ParameterLogger does.
+     */
+    BinaryLogRecord(uint32_t site, int32_t prefixes, bool isFunction);
+    /** Destructor, commits the record. */
+    ~BinaryLogRecord();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    BinaryLogRecord(const BinaryLogRecord&) = delete;
+    BinaryLogRecord& operator=(const BinaryLogRecord&) = delete;
+
+    /**
+     * Append an argument to the record.
+     *
+     * The argument is taken by forwarding reference, as some types only
+     * provide an \c operator<< for non-const references.
+     *
+     * @tparam T \deduced The argument type.
+     * @param [in] param The argument.
+     * @return This record, so it's chainable.
+     */
+    template <typename T>
+    BinaryLogRecord& operator<<(T&& param);
+    /**
+     * Append each element of a vector, like ParameterLogger does.
+     *
+     * @tparam T \deduced The element type.
+     * @param [in] vector The vector of arguments.
+     * @return This record, so it's chainable.
+     */
+    template <typename T>
+    BinaryLogRecord& operator<<(const std::vector<T>& vector);
+    /**
+     * Apply a stream manipulator, such as \c std::endl.
+     *
+     * @param [in] manip The manipulator.
+     * @return This record, so it's chainable.
+     */
+    BinaryLogRecord& operator<<(std::ostream& (*manip)(std::ostream&));
+
+  private:
+    /** Check whether a type is a \c std::vector. */
+    template <typename T>
+    struct IsVector : std::false_type
+    {
+    };
+
+    /** Check whether a type is a \c std::vector. */
+    template <typename T>
+    struct IsVector<std::vector<T>> : std::true_type
+    {
+    };
+
+    /**
+     * Append raw bytes to the record.
+     * @param [in] data The bytes.
+     * @param [in] size The number of bytes.
+     */
+    void Put(const void* data, std::size_t size);
+    /**
+     * Append an item tag and its fixed-size value.
+     * @tparam V \deduced The value type.
+     * @param [in] tag The item tag.
+     * @param [in] value The value.
+     */
+    template <typename V>
+    void PutItem(BinaryLogSink::ItemTag tag, V value);
+    /**
+     * Append a string item.
+     * @param [in] tag Either STRING or TEXT.
+     * @param [in] str The string.
+     */
+    void PutString(BinaryLogSink::ItemTag tag, const std::string& str);
+    /**
+     * Get the stream used once the record has switched to text.
+     * @returns The text stream, creating it on first use.
+     */
+    std::ostream& Text();
+
+    std::vector<uint8_t>& m_buffer;             //!< Record bytes, reused per thread.
+    bool m_function;                            //!< NS_LOG_FUNCTION record.
+    std::unique_ptr<std::ostringstream> m_text; //!< Formatted tail of the record.
+    bool m_textFirst{true};                     //!< No argument written to #m_text yet.
+};
+
+template <typename V>
+void
+BinaryLogRecord::PutItem(BinaryLogSink::ItemTag tag, V value)
+{
+    Put(&tag, 1);
+    Put(&value, sizeof(value));
+}
+
+template <typename T>
+BinaryLogRecord&
+BinaryLogRecord::operator<<(T&& param)
+{
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    constexpr bool isChar = std::is_same_v<U, char> || std::is_same_v<U, signed char> ||
+                            std::is_same_v<U, unsigned char>;
+
+    if constexpr (IsVector<U>::value)
+    {
+        return *this << static_cast<const U&>(param);
+    }
+    else
+    {
+        if (m_text)
+        {
+            // Already formatting: keep going, so that manipulators apply
+        }
+        else if constexpr (std::is_convertible_v<U, std::string> &&
+                           !std::is_same_v<U, std::nullptr_t>)
+        {
+            PutString(BinaryLogSink::STRING, std::string(param));
+            return *this;
+        }
+        else if constexpr (std::is_same_v<U, bool>)
+        {
+            // ParameterLogger prints bool with a unary +
+            if (m_function)
+            {
+                PutItem<int64_t>(BinaryLogSink::SIGNED, param);
+            }
+            else
+            {
+                PutItem<uint8_t>(BinaryLogSink::BOOL, param);
+            }
+            return *this;
+        }
+        else if constexpr (isChar)
+        {
+            // ParameterLogger prints characters as numbers
+            if (m_function)
+            {
+                PutItem<int64_t>(BinaryLogSink::SIGNED, +param);
+            }
+            else
+            {
+                PutItem<char>(BinaryLogSink::CHAR, static_cast<char>(param));
+            }
+            return *this;
+        }
+        else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+        {
+            PutItem<int64_t>(BinaryLogSink::SIGNED, param);
+            return *this;
+        }
+        else if constexpr (std::is_integral_v<U>)
+        {
+            PutItem<uint64_t>(BinaryLogSink::UNSIGNED, param);
+            return *this;
+        }
+        else if constexpr (std::is_same_v<U, float> || std::is_same_v<U, double>)
+        {
+            PutItem<double>(BinaryLogSink::DOUBLE, param);
+            return *this;
+        }
+        else if constexpr (std::is_pointer_v<U>)
+        {
+            PutItem<uint64_t>(BinaryLogSink::POINTER, reinterpret_cast<uintptr_t>(param));
+            return *this;
+        }
+
+        // Any other type: format it, and everything after it, as text
+        if (m_function)
+        {
+            if (!m_textFirst)
+            {
+                Text() << ", ";
+            }
+            if constexpr (std::is_convertible_v<U, std::string>)
+            {
+                Text() << "\"" << param << "\"";
+            }
+            else if constexpr (std::is_arithmetic_v<U>)
+            {
+                Text() << +param;
+            }
+            else
+            {
+                Text() << param;
+            }
+        }
+        else
+        {
+            Text() << param;
+        }
+        m_textFirst = false;
+        return *this;
+    }
+}
+
+template <typename T>
+BinaryLogRecord&
+BinaryLogRecord::operator<<(const std::vector<T>& vector)
+{
+    for (const auto& i : vector)
+    {
+        *this << i;
+    }
+    return *this;
+}
+
+} // namespace ns3
+
+#endif /* NS3_LOG_BINARY_SINK_H */
@@ -61,6 +61,53 @@
 
 #ifdef NS3_LOG_ENABLE
 
+#ifndef NS_LOG_STATIC_MASK
+/**
+ * @ingroup logging
+ * The LogLevels which can be enabled at run time.
+ *
+ * Log statements at a level outside of this mask are removed by the
+ * compiler, even when logging is enabled, so they cost nothing.  The mask
+ * can be restricted for the whole build, by adding for example
+ * `-DNS_LOG_STATIC_MASK=ns3::LOG_LEVEL_WARN` to the compiler flags, or for
+ * a single component, in the same way as \c NS_LOG_APPEND_CONTEXT:
+ * @code
+ *   #undef NS_LOG_STATIC_MASK
+ *   #define NS_LOG_STATIC_MASK (ns3::LOG_LEVEL_INFO)
+ * @endcode
+ */
+#define NS_LOG_STATIC_MASK (ns3::LOG_ALL)
+#endif /* NS_LOG_STATIC_MASK */
+
+/**
+ * @ingroup logging
+ * Check if a log statement is enabled, first at compile time
+ * against \c NS_LOG_STATIC_MASK, then at run time.
+ * @internal
+ * Logging implementation macro; should not be called directly.
+ *
+ * @param [in] level The log level
+ */
+#define NS_LOG_IS_ENABLED(level) (((level) & (NS_LOG_STATIC_MASK)) && g_log.IsEnabled(level))
+
+/**
+ * @ingroup logging
+ * Write a log statement to the ns3::BinaryLogSink.
+ * @internal
+ * Logging implementation macro; should not be called directly.
+ *
+ * @param [in] level The log level
+ * @param [in] isFunction Whether this is a NS_LOG_FUNCTION statement.
+ * @param [in] msg The message or parameters to log
+ */
+#define NS_LOG_BINARY(level, isFunction, msg)                                                      \
+    do                                                                                             \
+    {                                                                                              \
+        static const uint32_t ns3LogSite =                                                         \
+            ns3::BinaryLogSink::RegisterSite(g_log.Name(), __FUNCTION__, level, isFunction);       \
+        ns3::BinaryLogRecord(ns3LogSite, g_log.GetPrefixes(), isFunction) msg;                     \
+    } while (false)
+
 /**
  * @ingroup logging
  * Append the simulation time to a log message.
@@ -171,8 +218,13 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(level))                                                                \
+        if (NS_LOG_IS_ENABLED(level))                                                              \
         {                                                                                          \
+            if (ns3::BinaryLogSink::IsActive())                                                    \
+            {                                                                                      \
+                NS_LOG_BINARY(level, false, << msg);                                               \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -196,8 +248,13 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
+        if (NS_LOG_IS_ENABLED(ns3::LOG_FUNCTION))                                                  \
         {                                                                                          \
+            if (ns3::BinaryLogSink::IsActive())                                                    \
+            {                                                                                      \
+                NS_LOG_BINARY(ns3::LOG_FUNCTION, true, );                                          \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -230,8 +287,13 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
+        if (NS_LOG_IS_ENABLED(ns3::LOG_FUNCTION))                                                  \
         {                                                                                          \
+            if (ns3::BinaryLogSink::IsActive())                                                    \
+            {                                                                                      \
+                NS_LOG_BINARY(ns3::LOG_FUNCTION, true, << parameters);                             \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
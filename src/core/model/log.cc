@@ -232,19 +232,6 @@ LogComponent::EnvVarCheck()
     Enable((LogLevel)level);
 }
 
-bool
-LogComponent::IsEnabled(const LogLevel level) const
-{
-    //  LogComponentEnableEnvVar ();
-    return level & m_levels;
-}
-
-bool
-LogComponent::IsNoneEnabled() const
-{
-    return m_levels == 0;
-}
-
 void
 LogComponent::SetMask(const LogLevel level)
 {
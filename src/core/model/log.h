@@ -9,6 +9,7 @@
 #ifndef NS3_LOG_H
 #define NS3_LOG_H
 
+#include "log-binary-sink.h"
 #include "log-macros-disabled.h"
 #include "log-macros-enabled.h"
 #include "node-printer.h"
@@ -339,6 +340,12 @@ class LogComponent
      * @return \c true if all levels are disabled.
      */
     bool IsNoneEnabled() const;
+    /**
+     * Get the LOG_PREFIX_* flags enabled for this LogComponent.
+     *
+     * @return The enabled prefix flags.
+     */
+    int32_t GetPrefixes() const;
     /**
      * Enable this LogComponent at \c level
      *
@@ -413,6 +420,26 @@ class LogComponent
     // end of class LogComponent
 };
 
+// Inline so that the check of a disabled log statement costs a test and a branch.
+
+inline bool
+LogComponent::IsEnabled(const LogLevel level) const
+{
+    return level & m_levels;
+}
+
+inline bool
+LogComponent::IsNoneEnabled() const
+{
+    return m_levels == 0;
+}
+
+inline int32_t
+LogComponent::GetPrefixes() const
+{
+    return m_levels & LOG_PREFIX_ALL;
+}
+
 /**
  * Get the LogComponent registered with the given name.
  *
@@ -8,6 +8,8 @@
 
 #include "matrix-array.h"
 
+#include <algorithm>
+
 #ifdef HAVE_EIGEN3
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -32,6 +34,140 @@ template <class T>
 using ConstEigenMatrix = Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>>;
 #endif
 
+namespace
+{
+
+/**
+ * Number of columns of the left matrix, i.e., of the inner dimension, processed
+ * at a time by MultiplyMatrices, so that the block of the left matrix stays in
+ * the cache while all the columns of the result are updated.
+ */
+constexpr size_t PRODUCT_BLOCK_SIZE = 64;
+
+/**
+ * Number of rows and columns of the tiles copied at a time by TransposeMatrix.
+ */
+constexpr size_t TRANSPOSE_BLOCK_SIZE = 16;
+
+/**
+ * Adds the product of a column and a scalar to another column, res += col * value.
+ * The loop has no dependency between iterations and can be vectorized.
+ *
+ * @param res the column to update
+ * @param col the column to multiply
+ * @param value the scalar
+ * @param size the number of elements of the columns
+ */
+template <class T>
+inline void
+AddScaledColumn(T* res, const T* col, const T value, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        res[i] += col[i] * value;
+    }
+}
+
+/**
+ * Specialization for complex values, which spells out the complex product on
+ * the real and imaginary parts. The product operator of std::complex also
+ * checks for infinite and NaN results, which prevents the vectorization of the
+ * loop.
+ *
+ * @param res the column to update
+ * @param col the column to multiply
+ * @param value the scalar
+ * @param size the number of elements of the columns
+ */
+template <>
+inline void
+AddScaledColumn(std::complex<double>* res,
+                const std::complex<double>* col,
+                const std::complex<double> value,
+                size_t size)
+{
+    // std::complex<double> is guaranteed to be laid out as an array of two doubles
+    auto resParts = reinterpret_cast<double*>(res);
+    auto colParts = reinterpret_cast<const double*>(col);
+    const double valueRe = value.real();
+    const double valueIm = value.imag();
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double colRe = colParts[2 * i];
+        const double colIm = colParts[2 * i + 1];
+        resParts[2 * i] += colRe * valueRe - colIm * valueIm;
+        resParts[2 * i + 1] += colRe * valueIm + colIm * valueRe;
+    }
+}
+
+/**
+ * Adds the product of two column-major matrices to a third one,
+ * res += lhs * rhs, processing the inner dimension in blocks.
+ *
+ * @param res the numRows x numCols result
+ * @param lhs the numRows x numInner left matrix
+ * @param rhs the numInner x numCols right matrix
+ * @param numRows the number of rows of lhs and res
+ * @param numInner the number of columns of lhs and of rows of rhs
+ * @param numCols the number of columns of rhs and res
+ */
+template <class T>
+void
+MultiplyMatrices(T* res,
+                 const T* lhs,
+                 const T* rhs,
+                 size_t numRows,
+                 size_t numInner,
+                 size_t numCols)
+{
+    for (size_t blockStart = 0; blockStart < numInner; blockStart += PRODUCT_BLOCK_SIZE)
+    {
+        size_t blockEnd = std::min(blockStart + PRODUCT_BLOCK_SIZE, numInner);
+        for (size_t col = 0; col < numCols; ++col)
+        {
+            for (size_t inner = blockStart; inner < blockEnd; ++inner)
+            {
+                AddScaledColumn(res + col * numRows,
+                                lhs + inner * numRows,
+                                rhs[inner + col * numInner],
+                                numRows);
+            }
+        }
+    }
+}
+
+/**
+ * Transposes a column-major matrix, copying it by tiles so that both the
+ * source and the destination are accessed in cache-sized blocks.
+ *
+ * @param res the numCols x numRows result
+ * @param matrix the numRows x numCols matrix
+ * @param numRows the number of rows of the matrix
+ * @param numCols the number of columns of the matrix
+ */
+template <class T>
+void
+TransposeMatrix(T* res, const T* matrix, size_t numRows, size_t numCols)
+{
+    for (size_t rowStart = 0; rowStart < numRows; rowStart += TRANSPOSE_BLOCK_SIZE)
+    {
+        size_t rowEnd = std::min(rowStart + TRANSPOSE_BLOCK_SIZE, numRows);
+        for (size_t colStart = 0; colStart < numCols; colStart += TRANSPOSE_BLOCK_SIZE)
+        {
+            size_t colEnd = std::min(colStart + TRANSPOSE_BLOCK_SIZE, numCols);
+            for (size_t row = rowStart; row < rowEnd; ++row)
+            {
+                for (size_t col = colStart; col < colEnd; ++col)
+                {
+                    res[col + row * numCols] = matrix[row + col * numRows];
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
 template <class T>
 MatrixArray<T>::MatrixArray(size_t numRows, size_t numCols, size_t numPages)
     : ValArray<T>(numRows, numCols, numPages)
@@ -102,23 +238,16 @@ MatrixArray<T>::operator*(const MatrixArray<T>& rhs) const
         ConstEigenMatrix<T> lhsEigenMatrix(GetPagePtr(page), m_numRows, m_numCols);
         ConstEigenMatrix<T> rhsEigenMatrix(rhs.GetPagePtr(page), rhs.m_numRows, rhs.m_numCols);
         EigenMatrix<T> resEigenMatrix(res.GetPagePtr(page), res.m_numRows, res.m_numCols);
-        resEigenMatrix = lhsEigenMatrix * rhsEigenMatrix;
+        resEigenMatrix.noalias() = lhsEigenMatrix * rhsEigenMatrix;
 
 #else // Eigen not found or Eigen optimizations not enabled
 
-        size_t matrixOffset = page * m_numRows * m_numCols;
-        size_t rhsMatrixOffset = page * rhs.m_numRows * rhs.m_numCols;
-        for (size_t i = 0; i < res.m_numRows; ++i)
-        {
-            for (size_t j = 0; j < res.m_numCols; ++j)
-            {
-                res(i, j, page) = (m_values[std::slice(matrixOffset + i, m_numCols, m_numRows)] *
-                                   rhs.m_values[std::slice(rhsMatrixOffset + j * rhs.m_numRows,
-                                                           rhs.m_numRows,
-                                                           1)])
-                                      .sum();
-            }
-        }
+        MultiplyMatrices(res.GetPagePtr(page),
+                         GetPagePtr(page),
+                         rhs.GetPagePtr(page),
+                         m_numRows,
+                         m_numCols,
+                         rhs.m_numCols);
 
 #endif
     }
@@ -143,12 +272,7 @@ MatrixArray<T>::Transpose() const
 
 #else // Eigen not found or Eigen optimizations not enabled
 
-        size_t matrixIndex = page * m_numRows * m_numCols;
-        for (size_t i = 0; i < m_numRows; ++i)
-        {
-            res.m_values[std::slice(matrixIndex + i * res.m_numRows, res.m_numRows, 1)] =
-                m_values[std::slice(matrixIndex + i, m_numCols, m_numRows)];
-        }
+        TransposeMatrix(res.GetPagePtr(page), GetPagePtr(page), m_numRows, m_numCols);
 
 #endif
     }
@@ -231,50 +355,82 @@ MatrixArray<T>::MultiplyByLeftAndRightMatrix(const MatrixArray<T>& lMatrix,
     NS_ASSERT_MSG(m_numCols == rMatrix.m_numRows,
                   "Right vector numRows and this MatrixArray numCols mismatch.");
 
-    MatrixArray<T> res{lMatrix.m_numRows, rMatrix.m_numCols, m_numPages};
-
-#ifdef HAVE_EIGEN3
+    size_t numLRows = lMatrix.m_numRows;
+    size_t numRCols = rMatrix.m_numCols;
+    MatrixArray<T> res{numLRows, numRCols, m_numPages};
 
-    ConstEigenMatrix<T> lMatrixEigen(lMatrix.GetPagePtr(0), lMatrix.m_numRows, lMatrix.m_numCols);
-    ConstEigenMatrix<T> rMatrixEigen(rMatrix.GetPagePtr(0), rMatrix.m_numRows, rMatrix.m_numCols);
-#endif
+    // The pages, side by side, form a single M x (N * P) matrix, hence the
+    // products by the left matrix of all the pages can be computed at once, as
+    // the J x (N * P) matrix lMatrix * [page_0, ..., page_P-1].
 
-    for (size_t page = 0; page < m_numPages; ++page)
-    {
 #ifdef HAVE_EIGEN3 // Eigen found and Eigen optimizations enabled
 
-        ConstEigenMatrix<T> matrixEigen(GetPagePtr(page), m_numRows, m_numCols);
-        EigenMatrix<T> resEigenMap(res.GetPagePtr(page), res.m_numRows, res.m_numCols);
+    ConstEigenMatrix<T> lMatrixEigen(lMatrix.GetPagePtr(0), numLRows, lMatrix.m_numCols);
+    ConstEigenMatrix<T> rMatrixEigen(rMatrix.GetPagePtr(0), rMatrix.m_numRows, numRCols);
 
-        resEigenMap = lMatrixEigen * matrixEigen * rMatrixEigen;
+    if (numLRows == 1)
+    {
+        // The pages of the product by the left vector are the columns of a
+        // N x P matrix, and the results are the columns of a K x P matrix,
+        // which is a single product by the transposed right matrix.
+        MatrixArray<T> lProduct{m_numCols, m_numPages};
+        ConstEigenMatrix<T> pagesEigen(GetPagePtr(0), m_numRows, m_numCols * m_numPages);
+        EigenMatrix<T> lProductEigen(lProduct.GetPagePtr(0), 1, m_numCols * m_numPages);
+        lProductEigen.noalias() = lMatrixEigen * pagesEigen;
+
+        ConstEigenMatrix<T> lPagesEigen(lProduct.GetPagePtr(0), m_numCols, m_numPages);
+        EigenMatrix<T> resEigen(res.GetPagePtr(0), numRCols, m_numPages);
+        resEigen.noalias() = rMatrixEigen.transpose() * lPagesEigen;
+    }
+    else
+    {
+        // Eigen is faster on the small per-page products than on the single
+        // product with a left matrix of few rows
+        for (size_t page = 0; page < m_numPages; ++page)
+        {
+            ConstEigenMatrix<T> matrixEigen(GetPagePtr(page), m_numRows, m_numCols);
+            EigenMatrix<T> resEigen(res.GetPagePtr(page), numLRows, numRCols);
+            resEigen.noalias() = lMatrixEigen * matrixEigen * rMatrixEigen;
+        }
+    }
 
 #else // Eigen not found or Eigen optimizations not enabled
 
-        size_t matrixOffset = page * m_numRows * m_numCols;
-        for (size_t resRow = 0; resRow < res.m_numRows; ++resRow)
+    MatrixArray<T> lProduct{numLRows, m_numCols * m_numPages};
+    MultiplyMatrices(lProduct.GetPagePtr(0),
+                     lMatrix.GetPagePtr(0),
+                     GetPagePtr(0),
+                     numLRows,
+                     m_numRows,
+                     m_numCols * m_numPages);
+
+    if (numLRows == 1)
+    {
+        // The pages of the product by the left matrix are the columns of a
+        // N x P matrix, and the results are the columns of a K x P matrix,
+        // which is a single product by the transposed right matrix.
+        MatrixArray<T> rMatrixTransposed = rMatrix.Transpose();
+        MultiplyMatrices(res.GetPagePtr(0),
+                         rMatrixTransposed.GetPagePtr(0),
+                         lProduct.GetPagePtr(0),
+                         numRCols,
+                         m_numCols,
+                         m_numPages);
+    }
+    else
+    {
+        for (size_t page = 0; page < m_numPages; ++page)
         {
-            for (size_t resCol = 0; resCol < res.m_numCols; ++resCol)
-            {
-                // create intermediate row result, a multiply of resRow row of lMatrix and each
-                // column of this matrix
-                std::valarray<T> interRes(m_numCols);
-                for (size_t thisCol = 0; thisCol < m_numCols; ++thisCol)
-                {
-                    interRes[thisCol] =
-                        (lMatrix
-                             .m_values[std::slice(resRow, lMatrix.m_numCols, lMatrix.m_numRows)] *
-                         m_values[std::slice(matrixOffset + thisCol * m_numRows, m_numRows, 1)])
-                            .sum();
-                }
-                // multiply intermediate results and resCol column of the rMatrix
-                res(resRow, resCol, page) =
-                    (interRes *
-                     rMatrix.m_values[std::slice(resCol * rMatrix.m_numRows, rMatrix.m_numRows, 1)])
-                        .sum();
-            }
+            MultiplyMatrices(res.GetPagePtr(page),
+                             lProduct.GetPagePtr(0) + page * numLRows * m_numCols,
+                             rMatrix.GetPagePtr(0),
+                             numLRows,
+                             m_numCols,
+                             numRCols);
         }
-#endif
     }
+
+#endif
     return res;
 }
 
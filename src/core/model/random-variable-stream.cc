@@ -25,6 +25,8 @@
 #include "uinteger.h"
 
 #include <algorithm> // upper_bound
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <iostream>
 #include <numbers>
@@ -40,6 +42,250 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
+namespace
+{
+
+/**
+ * @ingroup randomvariable
+ * The layers of a Ziggurat covering a decreasing density \f$f\f$ over
+ * \f$[0, \infty)\f$.  All the layers have the same area; the base layer
+ * includes the tail of the density beyond \c x[1].
+ * @tparam N The number of layers.
+ */
+template <std::size_t N>
+struct Ziggurat
+{
+    std::array<double, N + 1> x; //!< Right edge of each layer, from the base; \c x[N] is 0.
+    std::array<double, N> ratio; //!< \c x[i + 1] / \c x[i]: below, a point is under \f$f\f$.
+};
+
+/**
+ * @ingroup randomvariable
+ * Build a Ziggurat.
+ * @tparam N The number of layers.
+ * @param [in] r The start of the tail.
+ * @param [in] v The area of each layer.
+ * @param [in] f The density.
+ * @param [in] inverse The inverse of the density.
+ * @return The Ziggurat.
+ */
+template <std::size_t N, typename F, typename I>
+Ziggurat<N>
+MakeZiggurat(double r, double v, F f, I inverse)
+{
+    Ziggurat<N> zig;
+    zig.x[0] = v / f(r);
+    zig.x[1] = r;
+    for (std::size_t i = 2; i < N; ++i)
+    {
+        zig.x[i] = inverse(v / zig.x[i - 1] + f(zig.x[i - 1]));
+    }
+    zig.x[N] = 0;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        zig.ratio[i] = zig.x[i + 1] / zig.x[i];
+    }
+    return zig;
+}
+
+/**
+ * @ingroup randomvariable
+ * Draw a standard normal value with the Ziggurat method, with the
+ * parameters of Doornik, "An Improved Ziggurat Method to Generate Normal
+ * Random Samples", 2005.
+ * @tparam U01 The type of the uniform random value generator.
+ * @param [in] u01 A function returning uniform random values on (0,1).
+ * @return The value.
+ */
+template <typename U01>
+double
+ZigguratNormal(U01 u01)
+{
+    static const auto zig = MakeZiggurat<128>(
+        3.442619855899,
+        9.91256303526217e-3,
+        [](double x) { return std::exp(-0.5 * x * x); },
+        [](double y) { return std::sqrt(-2 * std::log(y)); });
+    const double r = zig.x[1];
+    while (true)
+    {
+        double u = 2 * u01() - 1;
+        auto i = std::min(static_cast<std::size_t>(u01() * 128), std::size_t{127});
+        if (std::fabs(u) < zig.ratio[i])
+        {
+            return u * zig.x[i];
+        }
+        if (i == 0)
+        {
+            // In the tail, use Marsaglia's method
+            double x;
+            double y;
+            do
+            {
+                x = std::log(u01()) / r;
+                y = std::log(u01());
+            } while (-2 * y < x * x);
+            return u < 0 ? x - r : r - x;
+        }
+        // In the wedge between the layer and the density
+        double x = u * zig.x[i];
+        double f0 = std::exp(-0.5 * (zig.x[i] * zig.x[i] - x * x));
+        double f1 = std::exp(-0.5 * (zig.x[i + 1] * zig.x[i + 1] - x * x));
+        if (f1 + u01() * (f0 - f1) < 1.0)
+        {
+            return x;
+        }
+    }
+}
+
+/**
+ * @ingroup randomvariable
+ * Draw an exponential value of mean 1 with the Ziggurat method of Marsaglia
+ * and Tsang, "The Ziggurat Method for Generating Random Variables", 2000.
+ * @tparam U01 The type of the uniform random value generator.
+ * @param [in] u01 A function returning uniform random values on (0,1).
+ * @return The value.
+ */
+template <typename U01>
+double
+ZigguratExponential(U01 u01)
+{
+    static const auto zig = MakeZiggurat<256>(
+        7.69711747013104972,
+        3.949659822581572e-3,
+        [](double x) { return std::exp(-x); },
+        [](double y) { return -std::log(y); });
+    while (true)
+    {
+        double u = u01();
+        auto i = std::min(static_cast<std::size_t>(u01() * 256), std::size_t{255});
+        if (u < zig.ratio[i])
+        {
+            return u * zig.x[i];
+        }
+        if (i == 0)
+        {
+            // The tail is itself exponential
+            return zig.x[1] - std::log(u01());
+        }
+        // In the wedge between the layer and the density
+        double x = u * zig.x[i];
+        double f0 = std::exp(x - zig.x[i]);
+        double f1 = std::exp(x - zig.x[i + 1]);
+        if (f1 + u01() * (f0 - f1) < 1.0)
+        {
+            return x;
+        }
+    }
+}
+
+/**
+ * @ingroup randomvariable
+ * Build an alias table, with Vose's method.
+ * @param [in] weights The weight of each column; their sum must be positive.
+ * @param [out] prob The probability of the value of each column.
+ * @param [out] alias The alias of each column.
+ */
+void
+BuildAliasTable(const std::vector<double>& weights,
+                std::vector<double>& prob,
+                std::vector<uint32_t>& alias)
+{
+    auto n = static_cast<uint32_t>(weights.size());
+    double total = 0;
+    for (auto w : weights)
+    {
+        total += w;
+    }
+    NS_ASSERT_MSG(total > 0, "The weights of an alias table must not all be zero");
+    prob.resize(n);
+    alias.resize(n);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        prob[i] = weights[i] * n / total;
+        alias[i] = i;
+        (prob[i] < 1 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty())
+    {
+        uint32_t s = small.back();
+        small.pop_back();
+        uint32_t l = large.back();
+        large.pop_back();
+        alias[s] = l;
+        prob[l] = (prob[l] + prob[s]) - 1;
+        (prob[l] < 1 ? small : large).push_back(l);
+    }
+    // Whatever is left is only off by rounding errors
+    for (auto i : small)
+    {
+        prob[i] = 1;
+    }
+    for (auto i : large)
+    {
+        prob[i] = 1;
+    }
+}
+
+/**
+ * @ingroup randomvariable
+ * Draw a column from an alias table.
+ * @param [in] prob The probability of the value of each column.
+ * @param [in] alias The alias of each column.
+ * @param [in] u1 A uniform random value selecting the column.
+ * @param [in,out] u2 A uniform random value selecting the value in the column;
+ *                 on return, a uniform random value on [0,1) independent of
+ *                 the value drawn.
+ * @return The value, i.e., the index of the column drawn.
+ */
+uint32_t
+DrawAliasTable(const std::vector<double>& prob,
+               const std::vector<uint32_t>& alias,
+               double u1,
+               double& u2)
+{
+    auto n = prob.size();
+    auto i = std::min(static_cast<std::size_t>(u1 * n), n - 1);
+    if (u2 < prob[i])
+    {
+        u2 = u2 / prob[i];
+        return i;
+    }
+    u2 = (u2 - prob[i]) / (1 - prob[i]);
+    return alias[i];
+}
+
+/**
+ * @ingroup randomvariable
+ * Compute values from pairs of uniform random values, drawn in batches.
+ * @tparam F The type of the function computing a value.
+ * @param [in] rng The uniform random number generator.
+ * @param [in] antithetic Whether to use \f$1 - u\f$ instead of each uniform value \f$u\f$.
+ * @param [out] values The values.
+ * @param [in] draw The function computing a value from two uniform values.
+ */
+template <typename F>
+void
+DrawFromPairs(RngStream* rng, bool antithetic, std::span<double> values, F draw)
+{
+    std::array<double, 256> u;
+    for (std::size_t i = 0; i < values.size(); i += u.size() / 2)
+    {
+        auto n = std::min(values.size() - i, u.size() / 2);
+        rng->RandU01(std::span<double>(u.data(), 2 * n));
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            double u1 = antithetic ? 1 - u[2 * j] : u[2 * j];
+            double u2 = antithetic ? 1 - u[2 * j + 1] : u[2 * j + 1];
+            values[i + j] = draw(u1, u2);
+        }
+    }
+}
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
 TypeId
@@ -67,8 +313,21 @@ RandomVariableStream::GetTypeId()
     return tid;
 }
 
+/**
+ * @ingroup randomvariable
+ * The number of calls to RandomVariableStream::ReseedAllStreams().
+ *
+ * Each stream records the value it was seeded with, and restarts its
+ * RngStream the next time it is used if the value has changed since.
+ * This needs no registry of the existing streams, which the worker
+ * threads of a parallel simulation would otherwise have to lock.
+ */
+static std::atomic<uint32_t> g_reseeds{0};
+
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rng(nullptr),
+      m_reseeds(0),
+      m_streamIndex(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -78,6 +337,13 @@ RandomVariableStream::~RandomVariableStream()
     delete m_rng;
 }
 
+void
+RandomVariableStream::ReseedAllStreams()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_reseeds.fetch_add(1, std::memory_order_relaxed);
+}
+
 void
 RandomVariableStream::SetAntithetic(bool isAntithetic)
 {
@@ -100,6 +366,15 @@ RandomVariableStream::GetInteger()
     return value;
 }
 
+void
+RandomVariableStream::GetValues(std::span<double> values)
+{
+    for (auto& value : values)
+    {
+        value = GetValue();
+    }
+}
+
 void
 RandomVariableStream::SetStream(int64_t stream)
 {
@@ -114,7 +389,11 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " automatic stream: " << nextStream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_rng = new RngStream(RngSeedManager::GetSeed(),
+                              nextStream,
+                              RngSeedManager::GetRun(),
+                              RngSeedManager::GetGenerator());
+        m_streamIndex = nextStream;
     }
     else
     {
@@ -123,9 +402,14 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t base = ((1ULL) << 63);
         uint64_t target = base + stream;
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " configured stream: " << stream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_rng = new RngStream(RngSeedManager::GetSeed(),
+                              target,
+                              RngSeedManager::GetRun(),
+                              RngSeedManager::GetGenerator());
+        m_streamIndex = target;
     }
     m_stream = stream;
+    m_reseeds = g_reseeds.load(std::memory_order_relaxed);
 }
 
 int64_t
@@ -137,6 +421,17 @@ RandomVariableStream::GetStream() const
 RngStream*
 RandomVariableStream::Peek() const
 {
+    uint32_t reseeds = g_reseeds.load(std::memory_order_relaxed);
+    if (reseeds != m_reseeds && m_rng != nullptr)
+    {
+        NS_LOG_INFO(GetInstanceTypeId().GetName() << " reseeded stream: " << m_streamIndex);
+        delete m_rng;
+        m_rng = new RngStream(RngSeedManager::GetSeed(),
+                              m_streamIndex,
+                              RngSeedManager::GetRun(),
+                              RngSeedManager::GetGenerator());
+        m_reseeds = reseeds;
+    }
     return m_rng;
 }
 
@@ -218,6 +513,20 @@ UniformRandomVariable::GetInteger()
     return v;
 }
 
+void
+UniformRandomVariable::GetValues(std::span<double> values)
+{
+    Peek()->RandU01(values);
+    for (auto& v : values)
+    {
+        v = m_min + v * (m_max - m_min);
+        if (IsAntithetic())
+        {
+            v = m_min + (m_max - v);
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
 TypeId
@@ -380,13 +689,19 @@ ExponentialRandomVariable::GetTypeId()
                           "The upper bound on the values returned by this RNG stream.",
                           DoubleValue(0.0),
                           MakeDoubleAccessor(&ExponentialRandomVariable::m_bound),
-                          MakeDoubleChecker<double>());
+                          MakeDoubleChecker<double>())
+            .AddAttribute("Ziggurat",
+                          "Draw the values with the Ziggurat method, which is faster, "
+                          "instead of inverting the distribution.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ExponentialRandomVariable::m_ziggurat),
+                          MakeBooleanChecker());
     return tid;
 }
 
 ExponentialRandomVariable::ExponentialRandomVariable()
 {
-    // m_mean and m_bound are initialized after constructor by attributes
+    // m_mean, m_bound, and m_ziggurat are initialized after constructor by attributes
     NS_LOG_FUNCTION(this);
 }
 
@@ -405,17 +720,25 @@ ExponentialRandomVariable::GetBound() const
 double
 ExponentialRandomVariable::GetValue(double mean, double bound)
 {
+    auto u01 = [this] {
+        double u = Peek()->RandU01();
+        return IsAntithetic() ? 1 - u : u;
+    };
     while (true)
     {
-        // Get a uniform random variable in [0,1].
-        double v = Peek()->RandU01();
-        if (IsAntithetic())
+        double r;
+        if (m_ziggurat)
         {
-            v = (1 - v);
+            r = mean * ZigguratExponential(u01);
         }
+        else
+        {
+            // Get a uniform random variable in [0,1].
+            double v = u01();
 
-        // Calculate the exponential random variable.
-        double r = -mean * std::log(v);
+            // Calculate the exponential random variable.
+            r = -mean * std::log(v);
+        }
 
         // Use this value if it's acceptable.
         if (bound == 0 || r <= bound)
@@ -443,6 +766,15 @@ ExponentialRandomVariable::GetValue()
     return GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(std::span<double> values)
+{
+    for (auto& value : values)
+    {
+        value = GetValue(m_mean, m_bound);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -677,15 +1009,21 @@ NormalRandomVariable::GetTypeId()
                           "The bound on the values returned by this RNG stream.",
                           DoubleValue(INFINITE_VALUE),
                           MakeDoubleAccessor(&NormalRandomVariable::m_bound),
-                          MakeDoubleChecker<double>());
+                          MakeDoubleChecker<double>())
+            .AddAttribute("Ziggurat",
+                          "Draw the values with the Ziggurat method, which is faster, "
+                          "instead of the polar method.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&NormalRandomVariable::m_ziggurat),
+                          MakeBooleanChecker());
     return tid;
 }
 
 NormalRandomVariable::NormalRandomVariable()
     : m_nextValid(false)
 {
-    // m_mean, m_variance, and m_bound are initialized after constructor
-    // by attributes
+    // m_mean, m_variance, m_bound, and m_ziggurat are initialized after
+    // constructor by attributes
     NS_LOG_FUNCTION(this);
 }
 
@@ -710,6 +1048,23 @@ NormalRandomVariable::GetBound() const
 double
 NormalRandomVariable::GetValue(double mean, double variance, double bound)
 {
+    if (m_ziggurat)
+    {
+        auto u01 = [this] {
+            double u = Peek()->RandU01();
+            return IsAntithetic() ? 1 - u : u;
+        };
+        while (true)
+        {
+            double x = mean + ZigguratNormal(u01) * std::sqrt(variance);
+            if (std::fabs(x - mean) <= bound)
+            {
+                NS_LOG_DEBUG("value: " << x << " stream: " << GetStream() << " mean: " << mean
+                                       << " variance: " << variance << " bound: " << bound);
+                return x;
+            }
+        }
+    }
     if (m_nextValid)
     { // use previously generated
         m_nextValid = false;
@@ -778,6 +1133,15 @@ NormalRandomVariable::GetValue()
     return GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues(std::span<double> values)
+{
+    for (auto& value : values)
+    {
+        value = GetValue(m_mean, m_variance, m_bound);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
@@ -1308,13 +1672,22 @@ ZipfRandomVariable::GetTypeId()
                           "The alpha value for the Zipf distribution returned by this RNG stream.",
                           DoubleValue(0.0),
                           MakeDoubleAccessor(&ZipfRandomVariable::m_alpha),
-                          MakeDoubleChecker<double>());
+                          MakeDoubleChecker<double>())
+            .AddAttribute("Alias",
+                          "Draw the values from an alias table, in constant time, "
+                          "instead of searching the cumulative distribution.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ZipfRandomVariable::m_alias),
+                          MakeBooleanChecker());
     return tid;
 }
 
 ZipfRandomVariable::ZipfRandomVariable()
+    : m_c(0),
+      m_tableN(0),
+      m_tableAlpha(0)
 {
-    // m_n and m_alpha are initialized after constructor by attributes
+    // m_n, m_alpha, and m_alias are initialized after constructor by attributes
     NS_LOG_FUNCTION(this);
 }
 
@@ -1330,33 +1703,84 @@ ZipfRandomVariable::GetAlpha() const
     return m_alpha;
 }
 
-double
-ZipfRandomVariable::GetValue(uint32_t n, double alpha)
+void
+ZipfRandomVariable::UpdateTables(uint32_t n, double alpha)
 {
-    // Calculate the normalization constant c.
-    m_c = 0.0;
-    for (uint32_t i = 1; i <= n; i++)
+    if (n != m_tableN || alpha != m_tableAlpha)
     {
-        m_c += (1.0 / std::pow((double)i, alpha));
-    }
-    m_c = 1.0 / m_c;
+        NS_LOG_FUNCTION(this << n << alpha);
 
-    // Get a uniform random variable in [0,1].
-    double u = Peek()->RandU01();
-    if (IsAntithetic())
+        // Calculate the normalization constant c.
+        m_c = 0.0;
+        for (uint32_t i = 1; i <= n; i++)
+        {
+            m_c += (1.0 / std::pow((double)i, alpha));
+        }
+        m_c = 1.0 / m_c;
+
+        m_cdf.resize(n);
+        double sum_prob = 0;
+        for (uint32_t i = 1; i <= n; i++)
+        {
+            sum_prob += m_c / std::pow((double)i, alpha);
+            m_cdf[i - 1] = sum_prob;
+        }
+
+        m_aliasProb.clear();
+        m_aliasIndex.clear();
+        m_tableN = n;
+        m_tableAlpha = alpha;
+    }
+    if (m_alias && m_aliasProb.size() != n)
     {
-        u = (1 - u);
+        NS_LOG_LOGIC("building alias table, n: " << n << " alpha: " << alpha);
+        std::vector<double> weights(n);
+        for (uint32_t i = 1; i <= n; i++)
+        {
+            weights[i - 1] = m_c / std::pow((double)i, alpha);
+        }
+        BuildAliasTable(weights, m_aliasProb, m_aliasIndex);
     }
+}
+
+double
+ZipfRandomVariable::DrawAlias(double u1, double u2) const
+{
+    return DrawAliasTable(m_aliasProb, m_aliasIndex, u1, u2) + 1;
+}
+
+double
+ZipfRandomVariable::GetValue(uint32_t n, double alpha)
+{
+    UpdateTables(n, alpha);
 
-    double sum_prob = 0;
     double zipf_value = 0;
-    for (uint32_t i = 1; i <= n; i++)
+    if (m_alias && n > 0)
     {
-        sum_prob += m_c / std::pow((double)i, alpha);
-        if (sum_prob > u)
+        // Get two uniform random variables in [0,1].
+        double u1 = Peek()->RandU01();
+        double u2 = Peek()->RandU01();
+        if (IsAntithetic())
         {
-            zipf_value = i;
-            break;
+            u1 = (1 - u1);
+            u2 = (1 - u2);
+        }
+        zipf_value = DrawAlias(u1, u2);
+    }
+    else
+    {
+        // Get a uniform random variable in [0,1].
+        double u = Peek()->RandU01();
+        if (IsAntithetic())
+        {
+            u = (1 - u);
+        }
+
+        // Find the first cumulative probability greater than u
+        auto bound = std::upper_bound(m_cdf.begin(), m_cdf.end(), u);
+        if (bound != m_cdf.end())
+        {
+            zipf_value = (bound - m_cdf.begin()) + 1;
         }
     }
     NS_LOG_DEBUG("value: " << zipf_value << " stream: " << GetStream() << " n: " << n
@@ -1380,6 +1804,26 @@ ZipfRandomVariable::GetValue()
     return GetValue(m_n, m_alpha);
 }
 
+void
+ZipfRandomVariable::GetValues(std::span<double> values)
+{
+    UpdateTables(m_n, m_alpha);
+    if (m_alias && m_n > 0)
+    {
+        DrawFromPairs(Peek(), IsAntithetic(), values, [this](double u1, double u2) {
+            return DrawAlias(u1, u2);
+        });
+        return;
+    }
+    Peek()->RandU01(values);
+    for (auto& v : values)
+    {
+        double u = IsAntithetic() ? 1 - v : v;
+        auto bound = std::upper_bound(m_cdf.begin(), m_cdf.end(), u);
+        v = bound != m_cdf.end() ? (bound - m_cdf.begin()) + 1 : 0;
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ZetaRandomVariable);
 
 TypeId
@@ -1547,6 +1991,12 @@ EmpiricalRandomVariable::GetTypeId()
                           "default is to treat the CDF as a histogram and sample.",
                           BooleanValue(false),
                           MakeBooleanAccessor(&EmpiricalRandomVariable::m_interpolate),
+                          MakeBooleanChecker())
+            .AddAttribute("Alias",
+                          "Draw the bins from an alias table, in constant time, "
+                          "instead of searching the CDF.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&EmpiricalRandomVariable::m_alias),
                           MakeBooleanChecker());
     return tid;
 }
@@ -1585,14 +2035,14 @@ EmpiricalRandomVariable::PreSample(double& value)
     value = r;
     bool valid = false;
     // check extrema
-    if (r <= m_empCdf.begin()->first)
+    if (r <= m_cdfProb.front())
     {
-        value = m_empCdf.begin()->second; // Less than first
+        value = m_cdfValue.front(); // Less than first
         valid = true;
     }
-    else if (r >= m_empCdf.rbegin()->first)
+    else if (r >= m_cdfProb.back())
     {
-        value = m_empCdf.rbegin()->second; // Greater than last
+        value = m_cdfValue.back(); // Greater than last
         valid = true;
     }
     return valid;
@@ -1602,6 +2052,26 @@ double
 EmpiricalRandomVariable::GetValue()
 {
     double value;
+    if (m_alias)
+    {
+        if (!m_validated || m_aliasProb.empty())
+        {
+            Validate();
+        }
+
+        // Get two uniform random variables in [0, 1].
+        double u1 = Peek()->RandU01();
+        double u2 = Peek()->RandU01();
+        if (IsAntithetic())
+        {
+            u1 = (1 - u1);
+            u2 = (1 - u2);
+        }
+        value = DrawAlias(u1, u2);
+        NS_LOG_DEBUG("value: " << value << " stream: " << GetStream());
+        return value;
+    }
+
     if (PreSample(value))
     {
         return value;
@@ -1620,15 +2090,32 @@ EmpiricalRandomVariable::GetValue()
     return value;
 }
 
+void
+EmpiricalRandomVariable::GetValues(std::span<double> values)
+{
+    if (!m_alias)
+    {
+        RandomVariableStream::GetValues(values);
+        return;
+    }
+    if (!m_validated || m_aliasProb.empty())
+    {
+        Validate();
+    }
+    DrawFromPairs(Peek(), IsAntithetic(), values, [this](double u1, double u2) {
+        return DrawAlias(u1, u2);
+    });
+}
+
 double
 EmpiricalRandomVariable::DoSampleCDF(double r)
 {
     NS_LOG_FUNCTION(this << r);
 
     // Find first CDF that is greater than r
-    auto bound = m_empCdf.upper_bound(r);
+    auto bound = std::upper_bound(m_cdfProb.begin(), m_cdfProb.end(), r);
 
-    return bound->second;
+    return m_cdfValue[bound - m_cdfProb.begin()];
 }
 
 double
@@ -1656,24 +2143,47 @@ EmpiricalRandomVariable::DoInterpolate(double r)
     // This code based (loosely) on code by Bruce Mah (Thanks Bruce!)
 
     // search
-    auto upper = m_empCdf.upper_bound(r);
-    auto lower = std::prev(upper, 1);
+    std::size_t upper = std::upper_bound(m_cdfProb.begin(), m_cdfProb.end(), r) - m_cdfProb.begin();
+    std::size_t lower = upper - 1;
 
-    if (upper == m_empCdf.begin())
+    if (upper == 0)
     {
         lower = upper;
     }
 
     // Interpolate random value in range [v1..v2) based on [c1 .. r .. c2)
-    double c1 = lower->first;
-    double c2 = upper->first;
-    double v1 = lower->second;
-    double v2 = upper->second;
+    double c1 = m_cdfProb[lower];
+    double c2 = m_cdfProb[upper];
+    double v1 = m_cdfValue[lower];
+    double v2 = m_cdfValue[upper];
 
     double value = (v1 + ((v2 - v1) / (c2 - c1)) * (r - c1));
     return value;
 }
 
+double
+EmpiricalRandomVariable::DrawAlias(double u1, double u2) const
+{
+    // Bin 0 is below the first point, and bin n above the last one
+    std::size_t bin = DrawAliasTable(m_aliasProb, m_aliasIndex, u1, u2);
+    if (bin == 0)
+    {
+        return m_cdfValue.front();
+    }
+    if (bin == m_cdfValue.size())
+    {
+        return m_cdfValue.back();
+    }
+    if (!m_interpolate)
+    {
+        return m_cdfValue[bin];
+    }
+    // u2 is now uniform within the bin
+    double v1 = m_cdfValue[bin - 1];
+    double v2 = m_cdfValue[bin];
+    return v1 + (v2 - v1) * u2;
+}
+
 void
 EmpiricalRandomVariable::CDF(double v, double c)
 {
@@ -1689,6 +2199,7 @@ EmpiricalRandomVariable::CDF(double v, double c)
     }
 
     m_empCdf[c] = v;
+    m_validated = false;
 }
 
 void
@@ -1733,6 +2244,31 @@ EmpiricalRandomVariable::Validate()
                        << lastCdfPair->first << ", Value: " << lastCdfPair->second);
     }
 
+    // Copy the CDF to arrays, which are faster to search
+    m_cdfProb.clear();
+    m_cdfValue.clear();
+    for (const auto& [c, v] : m_empCdf)
+    {
+        m_cdfProb.push_back(c);
+        m_cdfValue.push_back(v);
+    }
+
+    m_aliasProb.clear();
+    m_aliasIndex.clear();
+    if (m_alias)
+    {
+        // The bins are below the first point, between two points, and above the last point
+        std::vector<double> weights(m_cdfProb.size() + 1);
+        double cPrev = 0;
+        for (std::size_t i = 0; i < m_cdfProb.size(); ++i)
+        {
+            weights[i] = m_cdfProb[i] - cPrev;
+            cPrev = m_cdfProb[i];
+        }
+        weights.back() = 1 - cPrev;
+        BuildAliasTable(weights, m_aliasProb, m_aliasIndex);
+    }
+
     m_validated = true;
 }
 
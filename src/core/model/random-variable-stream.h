@@ -20,7 +20,9 @@
 #include "type-id.h"
 
 #include <map>
+#include <span>
 #include <stdint.h>
+#include <vector>
 
 /**
  * @file
@@ -143,6 +145,31 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * @brief Get the next random values drawn from the distribution.
+     *
+     * This gives the same values as calling GetValue() once for each
+     * of them, but the distributions overriding it draw the underlying
+     * uniform numbers all at once, which is faster.
+     *
+     * @param [out] values The random values.
+     */
+    // The base implementation calls GetValue() for each value
+    virtual void GetValues(std::span<double> values);
+
+    /**
+     * @brief Restart all the existing streams with the current seed and run.
+     *
+     * RngSeedManager::SetSeed() and RngSeedManager::SetRun() only apply
+     * to the streams created afterwards.  This restarts every existing
+     * RandomVariableStream, keeping its stream number, as if it had been
+     * created with the current seed and run.  The streams are restarted
+     * lazily, the next time they draw a value.  This is meant for the
+     * processes restored from a ForkSnapshot, to run the rest of
+     * the simulation as another independent replication.
+     */
+    static void ReseedAllStreams();
+
   protected:
     /**
      * @brief Get the pointer to the underlying RngStream.
@@ -152,14 +179,20 @@ class RandomVariableStream : public Object
 
   private:
     /** Pointer to the underlying RngStream. */
-    RngStream* m_rng;
+    mutable RngStream* m_rng;
 
     /** Indicates if antithetic values should be generated by this RNG stream. */
     bool m_isAntithetic;
 
+    /** The number of calls to ReseedAllStreams() when m_rng was seeded. */
+    mutable uint32_t m_reseeds;
+
     /** The stream number for the RngStream. */
     int64_t m_stream;
 
+    /** The stream index of the RngStream, automatic or not. */
+    uint64_t m_streamIndex;
+
     // end of class RandomVariableStream
 };
 
@@ -274,6 +307,12 @@ class UniformRandomVariable : public RandomVariableStream
      */
     uint32_t GetInteger() override;
 
+    /**
+     * @copydoc RandomVariableStream::GetValues()
+     * @note The upper limit is excluded from the output range.
+     */
+    void GetValues(std::span<double> values) override;
+
   private:
     /** The lower bound on values that can be returned by this RNG stream. */
     double m_min;
@@ -532,6 +571,14 @@ class SequentialRandomVariable : public RandomVariableStream
  *   double value = x->GetValue ();
  * @endcode
  *
+ * @par Ziggurat Method
+ *
+ * If the \c Ziggurat attribute is \c true, the values are instead drawn
+ * with the Ziggurat method of Marsaglia and Tsang, with 256 layers.  Most
+ * values then take two uniform random values and a multiplication, without
+ * any logarithm.  The values have the same distribution, but they differ
+ * from the ones drawn with the inversion method above.
+ *
  * @par Antithetic Values.
  *
  * If an instance of this RNG is configured to return antithetic values,
@@ -541,7 +588,8 @@ class SequentialRandomVariable : public RandomVariableStream
  *      x' = - \frac{\log(1 - u)}{\alpha} = - Mean \log(1 - u),
  *   \f]
  *
- * where \f$u\f$ is a uniform random variable on [0,1).
+ * where \f$u\f$ is a uniform random variable on [0,1).  With the Ziggurat
+ * method, \f$1 - u\f$ is used instead of each uniform value \f$u\f$.
  */
 class ExponentialRandomVariable : public RandomVariableStream
 {
@@ -587,6 +635,11 @@ class ExponentialRandomVariable : public RandomVariableStream
     double GetValue() override;
     using RandomVariableStream::GetInteger;
 
+    /**
+     * @copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(std::span<double> values) override;
+
   private:
     /** The mean value of the unbounded exponential distribution. */
     double m_mean;
@@ -594,6 +647,9 @@ class ExponentialRandomVariable : public RandomVariableStream
     /** The upper bound on values that can be returned by this RNG stream. */
     double m_bound;
 
+    /** Whether the values are drawn with the Ziggurat method. */
+    bool m_ziggurat;
+
     // end of class ExponentialRandomVariable
 };
 
@@ -958,6 +1014,15 @@ class WeibullRandomVariable : public RandomVariableStream
  *   double value = x->GetValue ();
  * @endcode
  *
+ * @par Ziggurat Method
+ *
+ * If the \c Ziggurat attribute is \c true, the values are instead drawn
+ * with the Ziggurat method of Marsaglia and Tsang, with the 128 layers
+ * of Doornik's variant.  Most values then take two uniform random values
+ * and a multiplication, without any logarithm or square root, and no
+ * value is cached between calls.  The values have the same distribution,
+ * but they differ from the ones drawn with the polar method above.
+ *
  * @par Antithetic Values.
  *
  * If an instance of this RNG is configured to return antithetic values,
@@ -974,6 +1039,8 @@ class WeibullRandomVariable : public RandomVariableStream
  *   \f}
  *
  * which now involves the distances \f$u_1\f$ and \f$u_2\f$ are from 1.
+ * With the Ziggurat method, \f$1 - u\f$ is likewise used instead of each
+ * uniform value \f$u\f$.
  */
 class NormalRandomVariable : public RandomVariableStream
 {
@@ -1028,6 +1095,11 @@ class NormalRandomVariable : public RandomVariableStream
     double GetValue() override;
     using RandomVariableStream::GetInteger;
 
+    /**
+     * @copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(std::span<double> values) override;
+
   private:
     /** The mean value for the normal distribution returned by this RNG stream. */
     double m_mean;
@@ -1038,6 +1110,9 @@ class NormalRandomVariable : public RandomVariableStream
     /** The bound on values that can be returned by this RNG stream. */
     double m_bound;
 
+    /** Whether the values are drawn with the Ziggurat method. */
+    bool m_ziggurat;
+
     /** True if the next value is valid. */
     bool m_nextValid;
 
@@ -1627,7 +1702,18 @@ class TriangularRandomVariable : public RandomVariableStream
  *      u < \frac{H_k,\alpha}{H_N,\alpha}
  *   \f]
  *
- * where \f$u\f$ is a uniform random variable on [0,1).
+ * where \f$u\f$ is a uniform random variable on [0,1).  The cumulative
+ * probabilities are computed once, and kept until \c N or \c Alpha
+ * change, so that \f$k\f$ is found with a binary search.
+ *
+ * @par Alias Method
+ *
+ * If the \c Alias attribute is \c true, the values are instead drawn
+ * from an alias table (Walker's method, with Vose's construction), built
+ * once for \c N and \c Alpha.  Each value then takes two uniform random
+ * values and a constant time, whatever \c N, at the cost of 12 bytes of
+ * memory per value of \f$k\f$.  The values have the same distribution,
+ * but they differ from the ones drawn by inversion above.
  *
  * @par Example
  *
@@ -1652,6 +1738,8 @@ class TriangularRandomVariable : public RandomVariableStream
  *      1 - u < \frac{H_{k'},\alpha}{H_N,\alpha}
  *   \f]
  *
+ * With the alias method, \f$1 - u\f$ is likewise used instead of each
+ * uniform value \f$u\f$.
  */
 class ZipfRandomVariable : public RandomVariableStream
 {
@@ -1695,16 +1783,55 @@ class ZipfRandomVariable : public RandomVariableStream
     double GetValue() override;
     using RandomVariableStream::GetInteger;
 
+    /**
+     * @copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(std::span<double> values) override;
+
   private:
+    /**
+     * @brief Compute the tables of a distribution, unless they are
+     * already computed.
+     * @param [in] n N value for the Zipf distribution.
+     * @param [in] alpha Alpha value for the Zipf distribution.
+     */
+    void UpdateTables(uint32_t n, double alpha);
+
+    /**
+     * @brief Draw a value from the alias table.
+     * @param [in] u1 A uniform random value selecting the column of the table.
+     * @param [in] u2 A uniform random value selecting the value in the column.
+     * @return The value.
+     */
+    double DrawAlias(double u1, double u2) const;
+
     /** The n value for the Zipf distribution returned by this RNG stream. */
     uint32_t m_n;
 
     /** The alpha value for the Zipf distribution returned by this RNG stream. */
     double m_alpha;
 
+    /** Whether the values are drawn from an alias table. */
+    bool m_alias;
+
     /** The normalization constant. */
     double m_c;
 
+    /** The n value of the tables. */
+    uint32_t m_tableN;
+
+    /** The alpha value of the tables. */
+    double m_tableAlpha;
+
+    /** Cumulative probability of each value, from 1 to n. */
+    std::vector<double> m_cdf;
+
+    /** Probability of the value of each column of the alias table, from 1 to n. */
+    std::vector<double> m_aliasProb;
+
+    /** Alias of each column of the alias table. */
+    std::vector<uint32_t> m_aliasIndex;
+
     // end of class ZipfRandomVariable
 };
 
@@ -1944,6 +2071,18 @@ class DeterministicRandomVariable : public RandomVariableStream
  * beyond the first/last to work with), but simply return the extremal CDF
  * value, as in sampling.
  *
+ * The CDF points are copied in sorted arrays when the first value is
+ * drawn after a change, and the bin of \f$u\f$ is found with a binary search.
+ *
+ * @par Alias Method
+ *
+ * If the \c Alias attribute is \c true, GetValue() instead selects the bin
+ * from an alias table (Walker's method, with Vose's construction), in
+ * constant time whatever the number of CDF points, and then the value in
+ * the bin, in either mode.  Each value takes two uniform random values.
+ * The values have the same distribution, but they differ from the ones
+ * drawn by inversion.  Interpolate() always uses inversion.
+ *
  * @par Example
  *
  * Here is an example of how to use this class:
@@ -1983,7 +2122,8 @@ class DeterministicRandomVariable : public RandomVariableStream
  *
  * If an instance of this RNG is configured to return antithetic values,
  * the actual value returned, \f$x'\f$, is generated by using
- * \f$ 1 - u \f$ instead. of \f$u\f$ on [0, 1].
+ * \f$ 1 - u \f$ instead. of \f$u\f$ on [0, 1].  With the alias method,
+ * \f$1 - u\f$ is likewise used instead of each uniform value \f$u\f$.
  */
 class EmpiricalRandomVariable : public RandomVariableStream
 {
@@ -2019,6 +2159,11 @@ class EmpiricalRandomVariable : public RandomVariableStream
     double GetValue() override;
     using RandomVariableStream::GetInteger;
 
+    /**
+     * @copydoc RandomVariableStream::GetValues()
+     */
+    void GetValues(std::span<double> values) override;
+
     /**
      * @brief Returns the next value in the empirical distribution using
      * linear interpolation.
@@ -2075,8 +2220,15 @@ class EmpiricalRandomVariable : public RandomVariableStream
      * @returns The interpolated CDF at \pname{r}
      */
     double DoInterpolate(double r);
+    /**
+     * @brief Draw a value from the alias table.
+     * @param [in] u1 A uniform random value selecting the column of the table.
+     * @param [in] u2 A uniform random value selecting the bin in the column.
+     * @return The value.
+     */
+    double DrawAlias(double u1, double u2) const;
 
-    /** \c true once the CDF has been validated. */
+    /** \c true once the CDF has been validated, and the tables computed. */
     bool m_validated;
     /**
      * The map of CDF points (x, F(x)).
@@ -2089,6 +2241,20 @@ class EmpiricalRandomVariable : public RandomVariableStream
      * otherwise treat CDF as normal histogram.
      */
     bool m_interpolate;
+    /** If \c true GetValue will draw the bins from the alias table. */
+    bool m_alias;
+    /** The CDF values of the points, in increasing order. */
+    std::vector<double> m_cdfProb;
+    /** The domain values of the points, in the order of #m_cdfProb. */
+    std::vector<double> m_cdfValue;
+    /**
+     * Probability of the bin of each column of the alias table.  The bins
+     * are the ranges of \f$u\f$ below the first point, between two points
+     * and above the last point, in this order.
+     */
+    std::vector<double> m_aliasProb;
+    /** Alias of each column of the alias table. */
+    std::vector<uint32_t> m_aliasIndex;
 
     // end of class EmpiricalRandomVariable
 };
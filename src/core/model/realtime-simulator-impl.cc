@@ -11,6 +11,7 @@
 #include "enum.h"
 #include "event-impl.h"
 #include "fatal-error.h"
+#include "integer.h"
 #include "log.h"
 #include "pointer.h"
 #include "ptr.h"
@@ -23,6 +24,11 @@
 #include <mutex>
 #include <thread>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 /**
  * @file
  * @ingroup realtime
@@ -59,7 +65,24 @@ RealtimeSimulatorImpl::GetTypeId()
                           "SynchronizationMode=HardLimit)",
                           TimeValue(Seconds(0.1)),
                           MakeTimeAccessor(&RealtimeSimulatorImpl::m_hardLimit),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("BatchWindow",
+                          "Events whose timestamp is within this window of the current "
+                          "real time are run immediately, without waiting for the "
+                          "synchronizer.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&RealtimeSimulatorImpl::m_batchWindow),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("CpuAffinity",
+                          "Processor to pin the simulator thread to while running "
+                          "(-1 to leave the thread unpinned).  Only supported on Linux.",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&RealtimeSimulatorImpl::m_cpuAffinity),
+                          MakeIntegerChecker<int32_t>(-1))
+            .AddTraceSource("SchedulingLag",
+                            "How late, with respect to real time, an event is dispatched.",
+                            MakeTraceSourceAccessor(&RealtimeSimulatorImpl::m_lagTrace),
+                            "ns3::RealtimeSimulatorImpl::LagTracedCallback");
     return tid;
 }
 
@@ -75,6 +98,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_lagHistogram.resize(LAG_HISTOGRAM_BINS, 0);
 
     m_main = std::this_thread::get_id();
 
@@ -190,6 +214,7 @@ RealtimeSimulatorImpl::ProcessOneEvent()
         // We use tsNow as the indication of the current real time.
         //
         uint64_t tsNow;
+        bool due = false;
 
         {
             std::unique_lock lock{m_mutex};
@@ -235,6 +260,17 @@ RealtimeSimulatorImpl::ProcessOneEvent()
                 tsDelay = tsNext - tsNow;
             }
 
+            //
+            // If the next event is already due, or is close enough to be run in the
+            // same batch as the events before it, there is nothing to wait for.  This
+            // lets us work off a backlog of late events without paying for a trip
+            // through the synchronizer on each of them.
+            //
+            if (tsDelay <= static_cast<uint64_t>(m_batchWindow.GetTimeStep()))
+            {
+                due = true;
+            }
+
             //
             // We've figured out how long we need to delay in order to pace the
             // simulation time with the real time.  We're going to sleep, but need
@@ -245,6 +281,11 @@ RealtimeSimulatorImpl::ProcessOneEvent()
             m_synchronizer->SetCondition(false);
         }
 
+        if (due)
+        {
+            break;
+        }
+
         //
         // We have a time to delay.  This time may actually not be valid anymore
         // since we released the critical section immediately above, and a real-time
@@ -302,6 +343,7 @@ RealtimeSimulatorImpl::ProcessOneEvent()
     // whatever event is at the head of this list if the list is in time order.
     //
     Scheduler::Event next;
+    int64_t tsLag;
 
     {
         std::unique_lock lock{m_mutex};
@@ -347,31 +389,38 @@ RealtimeSimulatorImpl::ProcessOneEvent()
         // been asked to commit ritual suicide.
         //
         // We check the simulation time against the current real time to make this
-        // judgement.
+        // judgement, and record the difference as the lag of this event.
         //
-        if (m_synchronizationMode == SYNC_HARD_LIMIT)
-        {
-            uint64_t tsFinal = m_synchronizer->GetCurrentRealtime();
-            uint64_t tsJitter;
+        uint64_t tsFinal = m_synchronizer->GetCurrentRealtime();
+        uint64_t tsJitter;
 
-            if (tsFinal >= m_currentTs)
-            {
-                tsJitter = tsFinal - m_currentTs;
-            }
-            else
-            {
-                tsJitter = m_currentTs - tsFinal;
-            }
+        if (tsFinal >= m_currentTs)
+        {
+            tsJitter = tsFinal - m_currentTs;
+            tsLag = static_cast<int64_t>(tsJitter);
+        }
+        else
+        {
+            tsJitter = m_currentTs - tsFinal;
+            tsLag = -static_cast<int64_t>(tsJitter);
+        }
+        RecordLag(tsLag);
 
-            if (tsJitter > static_cast<uint64_t>(m_hardLimit.GetTimeStep()))
-            {
-                NS_FATAL_ERROR("RealtimeSimulatorImpl::ProcessOneEvent (): "
-                               "Hard real-time limit exceeded (jitter = "
-                               << tsJitter << ")");
-            }
+        if (m_synchronizationMode == SYNC_HARD_LIMIT &&
+            tsJitter > static_cast<uint64_t>(m_hardLimit.GetTimeStep()))
+        {
+            NS_FATAL_ERROR("RealtimeSimulatorImpl::ProcessOneEvent (): "
+                           "Hard real-time limit exceeded (jitter = "
+                           << tsJitter << ")");
         }
     }
 
+    //
+    // Trace sinks may schedule events, so they must be called outside of the
+    // critical section.
+    //
+    m_lagTrace(TimeStep(tsLag));
+
     //
     // We have got the event we're about to execute completely disentangled from the
     // event list so we can execute it outside a critical section without fear of someone
@@ -384,6 +433,50 @@ RealtimeSimulatorImpl::ProcessOneEvent()
     event->Unref();
 }
 
+void
+RealtimeSimulatorImpl::RecordLag(int64_t tsLag)
+{
+    std::size_t bin = 0;
+    if (tsLag > 0)
+    {
+        auto us = static_cast<uint64_t>(TimeStep(tsLag).GetMicroSeconds());
+        while (us > 0 && bin < LAG_HISTOGRAM_BINS - 1)
+        {
+            us >>= 1;
+            bin++;
+        }
+    }
+    m_lagHistogram[bin]++;
+}
+
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetLagHistogram() const
+{
+    std::unique_lock lock{m_mutex};
+    return m_lagHistogram;
+}
+
+void
+RealtimeSimulatorImpl::SetThreadAffinity() const
+{
+    NS_LOG_FUNCTION(this);
+    if (m_cpuAffinity < 0)
+    {
+        return;
+    }
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(m_cpuAffinity, &cpuset);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0)
+    {
+        NS_LOG_WARN("Unable to pin the simulator thread to CPU " << m_cpuAffinity);
+    }
+#else
+    NS_LOG_WARN("CpuAffinity is not supported on this platform; ignoring it");
+#endif
+}
+
 bool
 RealtimeSimulatorImpl::IsFinished() const
 {
@@ -418,6 +511,8 @@ RealtimeSimulatorImpl::Run()
     // Set the current threadId as the main threadId
     m_main = std::this_thread::get_id();
 
+    SetThreadAffinity();
+
     m_stop = false;
     m_running = true;
     m_synchronizer->SetOrigin(m_currentTs);
@@ -14,10 +14,12 @@
 #include "scheduler.h"
 #include "simulator-impl.h"
 #include "synchronizer.h"
+#include "traced-callback.h"
 
 #include <list>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 /**
  * @file
@@ -39,6 +41,14 @@ namespace ns3
  * @ingroup realtime
  *
  * Realtime version of SimulatorImpl.
+ *
+ * Events which are already due, or which fall within the "BatchWindow"
+ * of the current real time, are dispatched back to back without going
+ * through the Synchronizer, so that a simulation which has fallen behind
+ * catches up as fast as it can.  The simulator thread can be pinned to a
+ * single processor with the "CpuAffinity" attribute.  The lateness of each
+ * event with respect to real time is reported through the "SchedulingLag"
+ * trace source and accumulated in a histogram (see GetLagHistogram()).
  */
 class RealtimeSimulatorImpl : public SimulatorImpl
 {
@@ -152,6 +162,26 @@ class RealtimeSimulatorImpl : public SimulatorImpl
      */
     Time GetHardLimit() const;
 
+    /**
+     * Get the histogram of event scheduling lag.
+     *
+     * Bin 0 counts events dispatched less than 1 &mu;s after their
+     * scheduled real time (or early).  Bin @c i, for @c i > 0, counts
+     * events dispatched between @f$2^{i-1}@f$ and @f$2^i@f$ &mu;s late;
+     * the last bin also collects everything later than that.
+     *
+     * @returns The lag histogram, one count per bin.
+     */
+    std::vector<uint64_t> GetLagHistogram() const;
+
+    /**
+     * TracedCallback signature for the scheduling lag.
+     *
+     * @param [in] lag How late the event was dispatched with respect to
+     *     real time.  Negative if it was dispatched early.
+     */
+    typedef void (*LagTracedCallback)(Time lag);
+
   private:
     /**
      * Is the simulator running?
@@ -170,6 +200,19 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint64_t NextTs() const;
     /** Process the next event. */
     void ProcessOneEvent();
+    /**
+     * Record the lag of an event about to be dispatched.
+     *
+     * Should be called with critical section locked.
+     *
+     * @param [in] tsLag The lag, in timestep units; negative if early.
+     */
+    void RecordLag(int64_t tsLag);
+    /**
+     * Pin the calling thread to the processor configured by the
+     * "CpuAffinity" attribute, if any.
+     */
+    void SetThreadAffinity() const;
     /** Destructor implementation. */
     void DoDispose() override;
 
@@ -216,6 +259,20 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     /** The maximum allowable drift from real-time in SYNC_HARD_LIMIT mode. */
     Time m_hardLimit;
 
+    /** Events due within this much of the current real time are run without waiting. */
+    Time m_batchWindow;
+
+    /** Processor to pin the simulator thread to, or -1 to leave it unpinned. */
+    int32_t m_cpuAffinity;
+
+    /** Number of bins in #m_lagHistogram. */
+    static constexpr std::size_t LAG_HISTOGRAM_BINS = 32;
+    /** Histogram of event scheduling lag, in power-of-two &mu;s bins. */
+    std::vector<uint64_t> m_lagHistogram;
+
+    /** The scheduling lag trace source. */
+    TracedCallback<Time> m_lagTrace;
+
     /** Main thread. */
     std::thread::id m_main;
 };
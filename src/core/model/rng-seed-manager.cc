@@ -9,6 +9,7 @@
 
 #include "attribute-helper.h"
 #include "config.h"
+#include "enum.h"
 #include "global-value.h"
 #include "log.h"
 #include "uinteger.h"
@@ -58,6 +59,20 @@ static ns3::GlobalValue g_rngRun("RngRun",
                                  "The substream index used for all streams",
                                  ns3::UintegerValue(1),
                                  ns3::MakeUintegerChecker<uint64_t>());
+/**
+ * @relates RngSeedManager
+ * @anchor GlobalValueRngGenerator
+ * The algorithm of the random number generator of all streams.
+ *
+ * This is accessible as "--RngGenerator" from CommandLine.
+ */
+static ns3::GlobalValue g_rngGenerator("RngGenerator",
+                                       "The generator of all rng streams",
+                                       ns3::EnumValue(ns3::RngStream::MRG32K3A),
+                                       ns3::MakeEnumChecker(ns3::RngStream::MRG32K3A,
+                                                            "MRG32k3a",
+                                                            ns3::RngStream::PHILOX,
+                                                            "Philox"));
 
 uint32_t
 RngSeedManager::GetSeed()
@@ -92,6 +107,22 @@ RngSeedManager::GetRun()
     return run;
 }
 
+void
+RngSeedManager::SetGenerator(RngStream::Generator generator)
+{
+    NS_LOG_FUNCTION(generator);
+    Config::SetGlobal("RngGenerator", EnumValue(generator));
+}
+
+RngStream::Generator
+RngSeedManager::GetGenerator()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    EnumValue<RngStream::Generator> value;
+    g_rngGenerator.GetValue(value);
+    return value.Get();
+}
+
 uint64_t
 RngSeedManager::GetNextStreamIndex()
 {
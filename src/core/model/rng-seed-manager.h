@@ -8,6 +8,8 @@
 #ifndef RNG_SEED_MANAGER_H
 #define RNG_SEED_MANAGER_H
 
+#include "rng-stream.h"
+
 #include <stdint.h>
 
 /**
@@ -88,6 +90,27 @@ class RngSeedManager
      */
     static uint64_t GetRun();
 
+    /**
+     * @brief Set the algorithm of the underlying random number generator.
+     *
+     * Like the seed, this applies to the RandomVariableStream objects
+     * instantiated afterwards, and should be set once, at the start of
+     * the run.  The default, MRG32k3a, keeps the results of the previous
+     * releases; Philox is faster, in particular to draw many values at
+     * once with RandomVariableStream::GetValues().
+     *
+     * This is accessible as "--RngGenerator" from CommandLine.
+     *
+     * @param [in] generator The generator.
+     */
+    static void SetGenerator(RngStream::Generator generator);
+    /**
+     * @brief Get the algorithm of the underlying random number generator.
+     * @returns The generator.
+     * @see SetGenerator
+     */
+    static RngStream::Generator GetGenerator();
+
     /**
      * Get the next automatically assigned stream index.
      * @returns The next stream index.
@@ -13,13 +13,14 @@
 #include "fatal-error.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
 /**
  * @file
  * @ingroup rngimpl
- * ns3::RngStream and MRG32k3a implementations.
+ * ns3::RngStream, MRG32k3a and Philox4x32-10 implementations.
  */
 
 namespace ns3
@@ -321,6 +322,104 @@ void PowerOfTwoMatrix (int n, Matrix a1p, Matrix a2p)
 
 // clang-format on
 
+/** Namespace for Philox4x32-10 implementation details. */
+namespace Philox4x32
+{
+
+/** First round multiplier. */
+const uint32_t M0 = 0xD2511F53;
+
+/** Second round multiplier. */
+const uint32_t M1 = 0xCD9E8D57;
+
+/** First key increment, from the golden ratio. */
+const uint32_t W0 = 0x9E3779B9;
+
+/** Second key increment, from the square root of 3. */
+const uint32_t W1 = 0xBB67AE85;
+
+/** Number of blocks computed together, so that the rounds can be vectorized. */
+const std::size_t LANES = 8;
+
+/**
+ * Compute the Philox4x32-10 blocks of several counters.
+ *
+ * The lanes are independent, and each round is written as a loop over
+ * the lanes, which the compiler can turn into SIMD instructions.
+ *
+ * @param [in,out] c The counters, word by word, replaced by the blocks.
+ * @param [in] key The key.
+ */
+inline void
+Rounds(uint32_t c[4][LANES], const uint32_t key[2])
+{
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    for (int round = 0; round < 10; ++round)
+    {
+        for (std::size_t l = 0; l < LANES; ++l)
+        {
+            uint64_t p0 = static_cast<uint64_t>(M0) * c[0][l];
+            uint64_t p1 = static_cast<uint64_t>(M1) * c[2][l];
+            uint32_t c1 = c[1][l];
+            uint32_t c3 = c[3][l];
+            c[0][l] = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            c[1][l] = static_cast<uint32_t>(p1);
+            c[2][l] = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c[3][l] = static_cast<uint32_t>(p0);
+        }
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+/**
+ * Set the counters of consecutive blocks.
+ *
+ * @param [out] c The counters, word by word.
+ * @param [in] block The index of the block of the first lane.
+ * @param [in] substream The sub-stream number.
+ */
+inline void
+Counters(uint32_t c[4][LANES], uint64_t block, uint64_t substream)
+{
+    for (std::size_t l = 0; l < LANES; ++l)
+    {
+        c[0][l] = static_cast<uint32_t>(block + l);
+        c[1][l] = static_cast<uint32_t>((block + l) >> 32);
+        c[2][l] = static_cast<uint32_t>(substream);
+        c[3][l] = static_cast<uint32_t>(substream >> 32);
+    }
+}
+
+/**
+ * Convert a 32-bit output to a double strictly between 0 and 1.
+ *
+ * @param [in] x The output.
+ * @returns The double.
+ */
+inline double
+ToU01(uint32_t x)
+{
+    return (x + 0.5) * (1.0 / 4294967296.0);
+}
+
+/**
+ * Bijective 64-bit mixing function, the finalizer of SplitMix64.
+ *
+ * @param [in] x The value to mix.
+ * @returns The mixed value.
+ */
+inline uint64_t
+Mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace Philox4x32
+
 namespace ns3
 {
 
@@ -328,6 +427,78 @@ using namespace MRG32k3a;
 
 double
 RngStream::RandU01()
+{
+    if (m_generator == PHILOX)
+    {
+        if (m_used == 4)
+        {
+            uint32_t c[4][Philox4x32::LANES];
+            Philox4x32::Counters(c, m_block++, m_substream);
+            Philox4x32::Rounds(c, m_key);
+            for (int i = 0; i < 4; ++i)
+            {
+                m_buffer[i] = c[i][0];
+            }
+            m_used = 0;
+        }
+        return Philox4x32::ToU01(m_buffer[m_used++]);
+    }
+    return MrgU01();
+}
+
+void
+RngStream::RandU01(std::span<double> values)
+{
+    if (m_generator != PHILOX)
+    {
+        for (auto& value : values)
+        {
+            value = MrgU01();
+        }
+        return;
+    }
+    std::size_t i = 0;
+    while (i < values.size() && m_used < 4)
+    {
+        values[i++] = Philox4x32::ToU01(m_buffer[m_used++]);
+    }
+    std::size_t blocks = (values.size() - i) / 4;
+    PhiloxBlocks(values.subspan(i, blocks * 4));
+    for (i += blocks * 4; i < values.size(); ++i)
+    {
+        values[i] = RandU01();
+    }
+}
+
+void
+RngStream::PhiloxBlocks(std::span<double> values)
+{
+    using namespace Philox4x32;
+    uint32_t c[4][LANES];
+    for (std::size_t i = 0; i < values.size(); i += 4 * LANES)
+    {
+        Counters(c, m_block, m_substream);
+        Rounds(c, m_key);
+        std::size_t lanes = std::min(LANES, (values.size() - i) / 4);
+        for (std::size_t l = 0; l < lanes; ++l)
+        {
+            for (std::size_t j = 0; j < 4; ++j)
+            {
+                values[i + 4 * l + j] = ToU01(c[j][l]);
+            }
+        }
+        m_block += lanes;
+    }
+}
+
+RngStream::Generator
+RngStream::GetGenerator() const
+{
+    return m_generator;
+}
+
+double
+RngStream::MrgU01()
 {
     int32_t k;
     double p1;
@@ -364,12 +535,31 @@ RngStream::RandU01()
     return u;
 }
 
-RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
+RngStream::RngStream(uint32_t seedNumber,
+                     uint64_t stream,
+                     uint64_t substream,
+                     Generator generator)
+    : m_generator(generator),
+      m_currentState{},
+      m_substream(substream),
+      m_block(0),
+      m_buffer{},
+      m_used(4)
 {
     if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
         NS_FATAL_ERROR("invalid Seed " << seedNumber);
     }
+    if (m_generator == PHILOX)
+    {
+        // For a given seed, distinct streams get distinct keys
+        uint64_t key = Philox4x32::Mix(stream ^ Philox4x32::Mix(seedNumber));
+        m_key[0] = static_cast<uint32_t>(key);
+        m_key[1] = static_cast<uint32_t>(key >> 32);
+        return;
+    }
+    m_key[0] = 0;
+    m_key[1] = 0;
     for (int i = 0; i < 6; ++i)
     {
         m_currentState[i] = seedNumber;
@@ -379,11 +569,23 @@ RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
 }
 
 RngStream::RngStream(const RngStream& r)
+    : m_generator(r.m_generator),
+      m_substream(r.m_substream),
+      m_block(r.m_block),
+      m_used(r.m_used)
 {
     for (int i = 0; i < 6; ++i)
     {
         m_currentState[i] = r.m_currentState[i];
     }
+    for (int i = 0; i < 2; ++i)
+    {
+        m_key[i] = r.m_key[i];
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+        m_buffer[i] = r.m_buffer[i];
+    }
 }
 
 void
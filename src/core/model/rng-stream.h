@@ -7,6 +7,7 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <span>
 #include <stdint.h>
 #include <string>
 
@@ -34,18 +35,39 @@ namespace ns3
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * It can also generate its numbers with the counter-based generator
+ * Philox4x32-10, described in "Parallel random numbers: as easy as
+ * 1, 2, 3" (Salmon et al., SC'11).  Each output block is then a
+ * function of a key and a counter only: the key is a bijective
+ * mix of the seed and the stream number, and the counter is made
+ * of the sub-stream number and of the index of the block, so that
+ * the streams and sub-streams are independent as with MRG32k3a,
+ * without any jump-ahead computation, and several blocks can be
+ * computed at once.
  */
 class RngStream
 {
   public:
+    /** The algorithm generating the numbers. */
+    enum Generator
+    {
+        MRG32K3A, //!< Combined multiple-recursive generator MRG32k3a
+        PHILOX    //!< Counter-based generator Philox4x32-10
+    };
+
     /**
      * Construct from explicit seed, stream and substream values.
      *
      * @param [in] seed The starting seed.
      * @param [in] stream The stream number.
      * @param [in] substream The sub-stream number.
+     * @param [in] generator The algorithm generating the numbers.
      */
-    RngStream(uint32_t seed, uint64_t stream, uint64_t substream);
+    RngStream(uint32_t seed,
+              uint64_t stream,
+              uint64_t substream,
+              Generator generator = MRG32K3A);
     /**
      * Copy constructor.
      *
@@ -59,8 +81,36 @@ class RngStream
      * @returns The next random.
      */
     double RandU01();
+    /**
+     * Generate the next random numbers for this stream, as if RandU01()
+     * was called once for each of them.
+     *
+     * @param [out] values The random numbers, uniformly distributed
+     *              between 0 and 1.
+     */
+    void RandU01(std::span<double> values);
+    /**
+     * Get the algorithm generating the numbers.
+     *
+     * @returns The generator.
+     */
+    Generator GetGenerator() const;
 
   private:
+    /**
+     * Generate the next number of the MRG32k3a generator.
+     *
+     * @returns The next random.
+     */
+    double MrgU01();
+    /**
+     * Compute the next blocks of the Philox generator into \pname{values},
+     * which must hold a whole number of blocks.
+     *
+     * @param [out] values The random numbers.
+     */
+    void PhiloxBlocks(std::span<double> values);
+
     /**
      * Advance \pname{state} of the RNG by leaps and bounds.
      *
@@ -70,8 +120,20 @@ class RngStream
      */
     void AdvanceNthBy(uint64_t nth, int by, double state[6]);
 
-    /** The RNG state vector. */
+    /** The algorithm generating the numbers. */
+    Generator m_generator;
+    /** The RNG state vector, for MRG32k3a. */
     double m_currentState[6];
+    /** The Philox key, from the seed and the stream number. */
+    uint32_t m_key[2];
+    /** The Philox sub-stream number, high half of the counter. */
+    uint64_t m_substream;
+    /** The index of the next Philox block, low half of the counter. */
+    uint64_t m_block;
+    /** The last Philox block. */
+    uint32_t m_buffer[4];
+    /** The number of values of m_buffer already used. */
+    uint32_t m_used;
 };
 
 } // namespace ns3
@@ -15,12 +15,25 @@
 #include "singleton.h"
 #include "system-path.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <limits>
 #include <list>
 #include <map>
+#include <new>
+#include <thread>
 #include <vector>
 
+#ifndef __WIN32__
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 /**
  * @file
  * @ingroup testing
@@ -119,6 +132,12 @@ struct TestCase::Result
     std::vector<TestCaseFailure> failure;
     /** \c true if any child TestCases failed. */
     bool childrenFailed;
+    /** Real running time in ms, as measured by #clock. */
+    int64_t elapsedReal;
+    /** User running time in ms, as measured by #clock. */
+    int64_t elapsedUser;
+    /** System running time in ms, as measured by #clock. */
+    int64_t elapsedSystem;
 };
 
 /**
@@ -230,6 +249,59 @@ class TestRunnerImpl : public Singleton<TestRunnerImpl>
     std::list<TestCase*> FilterTests(std::string testName,
                                      TestSuite::Type testType,
                                      TestCase::Duration maximumTestDuration);
+    /**
+     * Run a test suite, distributing its test cases to worker processes.
+     *
+     * This is equivalent to TestCase::Run(), except that the children
+     * of the suite are run by #m_jobs worker processes, forked after the
+     * suite DoSetup().  The children are kept in a queue shared by all
+     * workers, ordered by ScheduleChildren(), from which each worker
+     * takes the next test case as soon as it is done with the previous
+     * one.  The workers send the results back to this process, which
+     * then runs the suite DoRun() and DoTeardown().
+     *
+     * @param [in] suite The TestSuite to run.
+     */
+    void RunParallel(TestCase* suite);
+    /**
+     * Order the children of a test suite for RunParallel().
+     *
+     * The test cases are sorted by decreasing running time, as recorded
+     * in the duration cache, so that the longest ones do not end up
+     * running alone at the end.  Test cases missing from the cache come
+     * first, ordered by decreasing TestCase::Duration.
+     *
+     * @param [in] suite The TestSuite.
+     * @returns The indices of the children, in scheduling order.
+     */
+    std::vector<std::size_t> ScheduleChildren(const TestCase* suite) const;
+    /** Load #m_durations from the duration cache file, if it exists. */
+    void ReadDurationCache();
+    /**
+     * Update the duration cache file with the running times of the
+     * children of a test suite.
+     * @param [in] suite The TestSuite which was run.
+     */
+    void WriteDurationCache(const TestCase* suite);
+    /**
+     * Get the key of a test case in #m_durations.
+     * @param [in] test The TestCase, which must be a child of a TestSuite.
+     * @returns The key.
+     */
+    std::string GetDurationKey(const TestCase* test) const;
+    /**
+     * Serialize the results of a test case and of its children.
+     * @param [in] test The TestCase.
+     * @param [in,out] os The stream to write to.
+     */
+    void WriteResult(const TestCase* test, std::ostream& os) const;
+    /**
+     * Deserialize the results written by WriteResult().
+     * @param [in,out] test The TestCase.
+     * @param [in,out] is The stream to read from.
+     * @returns \c false if the input is truncated.
+     */
+    bool ReadResult(TestCase* test, std::istream& is);
 
     /** Container type for the test. */
     typedef std::vector<TestSuite*> TestSuiteVector;
@@ -240,6 +312,9 @@ class TestRunnerImpl : public Singleton<TestRunnerImpl>
     bool m_assertOnFailure;   //!< \c true if we should assert on failure.
     bool m_continueOnFailure; //!< \c true if we should continue on failure.
     bool m_updateData;        //!< \c true if we should update reference data.
+    uint32_t m_jobs;          //!< The number of worker processes.
+    std::string m_durationCacheFile;          //!< The duration cache file.
+    std::map<std::string, int64_t> m_durations; //!< Cached test case running times in ms.
 };
 
 TestCaseFailure::TestCaseFailure(std::string _cond,
@@ -259,7 +334,10 @@ TestCaseFailure::TestCaseFailure(std::string _cond,
 }
 
 TestCase::Result::Result()
-    : childrenFailed(false)
+    : childrenFailed(false),
+      elapsedReal(0),
+      elapsedUser(0),
+      elapsedSystem(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -358,6 +436,9 @@ TestCase::Run(TestRunnerImpl* runner)
     DoRun();
 out:
     m_result->clock.End();
+    m_result->elapsedReal = m_result->clock.GetElapsedReal();
+    m_result->elapsedUser = m_result->clock.GetElapsedUser();
+    m_result->elapsedSystem = m_result->clock.GetElapsedSystem();
     DoTeardown();
     Config::Reset();
     m_runner = nullptr;
@@ -512,7 +593,9 @@ TestRunnerImpl::TestRunnerImpl()
     : m_tempDir(""),
       m_assertOnFailure(false),
       m_continueOnFailure(true),
-      m_updateData(false)
+      m_updateData(false),
+      m_jobs(1),
+      m_durationCacheFile("")
 {
     NS_LOG_FUNCTION(this);
 }
@@ -682,9 +765,9 @@ TestRunnerImpl::PrintReport(TestCase* test, std::ostream* os, bool xml, int leve
     }
     // Report times in seconds, from ms timer
     const double MS_PER_SEC = 1000.;
-    double real = test->m_result->clock.GetElapsedReal() / MS_PER_SEC;
-    double user = test->m_result->clock.GetElapsedUser() / MS_PER_SEC;
-    double system = test->m_result->clock.GetElapsedSystem() / MS_PER_SEC;
+    double real = test->m_result->elapsedReal / MS_PER_SEC;
+    double user = test->m_result->elapsedUser / MS_PER_SEC;
+    double system = test->m_result->elapsedSystem / MS_PER_SEC;
 
     std::streamsize oldPrecision = (*os).precision(3);
     *os << std::fixed;
@@ -779,6 +862,11 @@ TestRunnerImpl::PrintHelp(const char* program_name) const
         << "  --out=FILE             : send test result to FILE instead of standard output"
         << std::endl
         << "  --append=FILE          : append test result to FILE instead of standard output"
+        << std::endl
+        << "  --jobs=N               : run the test cases of the suite in N worker " << std::endl
+        << "                           processes (0 for one per CPU)" << std::endl
+        << "  --duration-cache=FILE  : record test case running times in FILE, and " << std::endl
+        << "                           with --jobs, start the longest test cases first"
         << std::endl;
 }
 
@@ -874,6 +962,376 @@ TestRunnerImpl::FilterTests(std::string testName,
     return tests;
 }
 
+std::string
+TestRunnerImpl::GetDurationKey(const TestCase* test) const
+{
+    NS_LOG_FUNCTION(this << test);
+    return test->m_parent->m_name + '\t' + test->m_name;
+}
+
+void
+TestRunnerImpl::ReadDurationCache()
+{
+    NS_LOG_FUNCTION(this);
+    // One line per test case: suite name, test case name and running
+    // time in ms, separated by tabs.
+    std::ifstream is(m_durationCacheFile);
+    std::string line;
+    while (std::getline(is, line))
+    {
+        std::string::size_type tab = line.find_last_of('\t');
+        if (tab == std::string::npos || line.find('\t') == tab)
+        {
+            continue;
+        }
+        std::istringstream iss(line.substr(tab + 1));
+        int64_t ms;
+        if (iss >> ms)
+        {
+            m_durations[line.substr(0, tab)] = ms;
+        }
+    }
+}
+
+void
+TestRunnerImpl::WriteDurationCache(const TestCase* suite)
+{
+    NS_LOG_FUNCTION(this << suite);
+    for (const TestCase* child : suite->m_children)
+    {
+        if (child->m_result != nullptr)
+        {
+            m_durations[GetDurationKey(child)] = child->m_result->elapsedReal;
+        }
+    }
+
+    // Other runners may update the cache concurrently for other suites:
+    // reload it just before writing, and replace it atomically.
+    std::map<std::string, int64_t> ours;
+    ours.swap(m_durations);
+    ReadDurationCache();
+    for (const auto& [key, ms] : ours)
+    {
+        m_durations[key] = ms;
+    }
+
+    std::string tmp = m_durationCacheFile + "." + suite->m_name + ".tmp";
+    {
+        std::ofstream os(tmp, std::ios_base::out | std::ios_base::trunc);
+        for (const auto& [key, ms] : m_durations)
+        {
+            os << key << '\t' << ms << '\n';
+        }
+        if (!os)
+        {
+            std::cerr << "Warning: cannot write the duration cache " << tmp << std::endl;
+            return;
+        }
+    }
+    if (std::rename(tmp.c_str(), m_durationCacheFile.c_str()) != 0)
+    {
+        std::cerr << "Warning: cannot update the duration cache " << m_durationCacheFile
+                  << std::endl;
+        std::remove(tmp.c_str());
+    }
+}
+
+std::vector<std::size_t>
+TestRunnerImpl::ScheduleChildren(const TestCase* suite) const
+{
+    NS_LOG_FUNCTION(this << suite);
+    const auto& children = suite->m_children;
+    std::vector<int64_t> cost(children.size(), std::numeric_limits<int64_t>::max());
+    for (std::size_t i = 0; i < children.size(); ++i)
+    {
+        auto it = m_durations.find(GetDurationKey(children[i]));
+        if (it != m_durations.end())
+        {
+            cost[i] = it->second;
+        }
+    }
+
+    std::vector<std::size_t> order(children.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (cost[a] != cost[b])
+        {
+            return cost[a] > cost[b];
+        }
+        return children[a]->m_duration > children[b]->m_duration;
+    });
+    return order;
+}
+
+/**
+ * Write a length-prefixed string.
+ * @param [in,out] os The output stream.
+ * @param [in] str The string.
+ */
+static void
+WriteString(std::ostream& os, const std::string& str)
+{
+    os << str.size() << ':' << str;
+}
+
+/**
+ * Read a string written by WriteString().
+ * @param [in,out] is The input stream.
+ * @param [out] str The string.
+ * @returns \c false if the input is truncated.
+ */
+static bool
+ReadString(std::istream& is, std::string& str)
+{
+    std::size_t size;
+    if (!(is >> size) || is.get() != ':')
+    {
+        return false;
+    }
+    str.resize(size);
+    return static_cast<bool>(is.read(str.data(), size));
+}
+
+void
+TestRunnerImpl::WriteResult(const TestCase* test, std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this << test << &os);
+    const TestCase::Result* result = test->m_result;
+    if (result == nullptr)
+    {
+        os << "0\n";
+        return;
+    }
+    os << "1 " << result->childrenFailed << ' ' << result->elapsedReal << ' '
+       << result->elapsedUser << ' ' << result->elapsedSystem << ' ' << result->failure.size();
+    for (const auto& failure : result->failure)
+    {
+        os << ' ';
+        WriteString(os, failure.cond);
+        WriteString(os, failure.actual);
+        WriteString(os, failure.limit);
+        WriteString(os, failure.message);
+        WriteString(os, failure.file);
+        os << ' ' << failure.line;
+    }
+    os << '\n';
+    for (const TestCase* child : test->m_children)
+    {
+        WriteResult(child, os);
+    }
+}
+
+bool
+TestRunnerImpl::ReadResult(TestCase* test, std::istream& is)
+{
+    NS_LOG_FUNCTION(this << test << &is);
+    bool run;
+    if (!(is >> run))
+    {
+        return false;
+    }
+    if (!run)
+    {
+        return true;
+    }
+    auto result = new TestCase::Result();
+    delete test->m_result;
+    test->m_result = result;
+    std::size_t failures;
+    if (!(is >> result->childrenFailed >> result->elapsedReal >> result->elapsedUser >>
+          result->elapsedSystem >> failures))
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < failures; ++i)
+    {
+        std::string cond;
+        std::string actual;
+        std::string limit;
+        std::string message;
+        std::string file;
+        int32_t line;
+        is >> std::ws;
+        if (!ReadString(is, cond) || !ReadString(is, actual) || !ReadString(is, limit) ||
+            !ReadString(is, message) || !ReadString(is, file) || !(is >> line))
+        {
+            return false;
+        }
+        result->failure.emplace_back(cond, actual, limit, message, file, line);
+    }
+    for (TestCase* child : test->m_children)
+    {
+        if (!ReadResult(child, is))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+TestRunnerImpl::RunParallel(TestCase* suite)
+{
+    NS_LOG_FUNCTION(this << suite);
+#ifndef __WIN32__
+    suite->m_result = new TestCase::Result();
+    suite->m_runner = this;
+    Config::Reset();
+    suite->DoSetup();
+    suite->m_result->clock.Start();
+
+    std::vector<std::size_t> order = ScheduleChildren(suite);
+    uint32_t jobs = std::min<std::size_t>(m_jobs, order.size());
+
+    // Shared between the workers: the index in order of the next test
+    // case to run, a flag to stop handing out test cases once one has
+    // failed, and for each worker, one plus the index of the test case
+    // it is running (zero when idle).
+    using Counter = std::atomic<uint32_t>;
+    std::size_t sharedSize = (2 + jobs) * sizeof(Counter);
+    void* shared = mmap(nullptr,
+                        sharedSize,
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS,
+                        -1,
+                        0);
+    NS_ABORT_MSG_IF(shared == MAP_FAILED, "Cannot map the test case queue");
+    Counter* counters = static_cast<Counter*>(shared);
+    for (std::size_t i = 0; i < 2 + jobs; ++i)
+    {
+        new (&counters[i]) Counter(0);
+    }
+    Counter& next = counters[0];
+    Counter& stop = counters[1];
+    Counter* running = &counters[2];
+
+    // Don't let the workers inherit, and flush again, pending output
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    std::vector<std::FILE*> files(jobs, nullptr);
+    std::vector<pid_t> pids(jobs, -1);
+    for (uint32_t w = 0; w < jobs; ++w)
+    {
+        files[w] = std::tmpfile();
+        NS_ABORT_MSG_IF(files[w] == nullptr, "Cannot create a test result file");
+        pids[w] = fork();
+        NS_ABORT_MSG_IF(pids[w] < 0, "Cannot fork a test worker");
+        if (pids[w] == 0)
+        {
+            // Worker: run test cases until the queue is empty, sending
+            // back the results of each one as soon as it is done.
+            for (;;)
+            {
+                uint32_t i = next.fetch_add(1);
+                if (i >= order.size() || stop.load() != 0)
+                {
+                    break;
+                }
+                running[w].store(order[i] + 1);
+                TestCase* child = suite->m_children[order[i]];
+                RngSeedManager::ResetNextStreamIndex();
+                child->Run(this);
+                std::ostringstream oss;
+                oss << order[i] << '\n';
+                WriteResult(child, oss);
+                std::string record = oss.str();
+                std::fwrite(record.data(), 1, record.size(), files[w]);
+                std::fflush(files[w]);
+                running[w].store(0);
+                if (child->IsFailed())
+                {
+                    stop.store(1);
+                }
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            _exit(0);
+        }
+    }
+
+    for (uint32_t w = 0; w < jobs; ++w)
+    {
+        int status = 0;
+        while (waitpid(pids[w], &status, 0) < 0 && errno == EINTR)
+        {
+        }
+
+        std::string records;
+        std::rewind(files[w]);
+        char buffer[4096];
+        std::size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), files[w])) > 0)
+        {
+            records.append(buffer, n);
+        }
+        std::fclose(files[w]);
+        std::istringstream is(records);
+        std::size_t index;
+        while (is >> index)
+        {
+            if (index >= suite->m_children.size() ||
+                !ReadResult(suite->m_children[index], is))
+            {
+                break;
+            }
+        }
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            std::ostringstream reason;
+            if (WIFSIGNALED(status))
+            {
+                reason << "signal " << WTERMSIG(status);
+            }
+            else
+            {
+                reason << "exit status " << WEXITSTATUS(status);
+            }
+            uint32_t current = running[w].load();
+            TestCase* culprit = current != 0 ? suite->m_children[current - 1] : suite;
+            if (culprit->m_result == nullptr)
+            {
+                culprit->m_result = new TestCase::Result();
+            }
+            culprit->ReportTestFailure("worker process completed",
+                                       reason.str(),
+                                       "exit status 0",
+                                       "Test worker process terminated abnormally",
+                                       __FILE__,
+                                       __LINE__);
+        }
+    }
+    munmap(shared, sharedSize);
+
+    for (TestCase* child : suite->m_children)
+    {
+        if (child->m_result != nullptr && child->IsFailed())
+        {
+            suite->m_result->childrenFailed = true;
+        }
+    }
+    if (!suite->IsFailed())
+    {
+        suite->DoRun();
+    }
+    suite->m_result->clock.End();
+    suite->m_result->elapsedReal = suite->m_result->clock.GetElapsedReal();
+    suite->m_result->elapsedUser = suite->m_result->clock.GetElapsedUser();
+    suite->m_result->elapsedSystem = suite->m_result->clock.GetElapsedSystem();
+    suite->DoTeardown();
+    Config::Reset();
+    suite->m_runner = nullptr;
+#else
+    suite->Run(this);
+#endif
+}
+
 int
 TestRunnerImpl::Run(int argc, char* argv[])
 {
@@ -955,6 +1413,23 @@ TestRunnerImpl::Run(int argc, char* argv[])
         {
             out = arg.substr(arg.find_first_of('=') + 1);
         }
+        else if (arg.find("--jobs=") != std::string::npos)
+        {
+            std::istringstream iss(arg.substr(arg.find_first_of('=') + 1));
+            if (!(iss >> m_jobs))
+            {
+                PrintHelp(progname);
+                return 3;
+            }
+            if (m_jobs == 0)
+            {
+                m_jobs = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+        }
+        else if (arg.find("--duration-cache=") != std::string::npos)
+        {
+            m_durationCacheFile = arg.substr(arg.find_first_of('=') + 1);
+        }
         else if (arg.find("--fullness=") != std::string::npos)
         {
             fullness = arg.substr(arg.find_first_of('=') + 1);
@@ -1017,6 +1492,19 @@ TestRunnerImpl::Run(int argc, char* argv[])
 
     std::list<TestCase*> tests = FilterTests(testName, testType, maximumTestDuration);
 
+#ifdef __WIN32__
+    if (m_jobs > 1)
+    {
+        std::cerr << "Warning: --jobs is not supported on this platform, "
+                  << "running the tests sequentially" << std::endl;
+        m_jobs = 1;
+    }
+#endif
+    if (!m_durationCacheFile.empty())
+    {
+        ReadDurationCache();
+    }
+
     if (m_tempDir.empty())
     {
         m_tempDir = SystemPath::MakeTemporaryDirectoryName();
@@ -1099,7 +1587,18 @@ TestRunnerImpl::Run(int argc, char* argv[])
         }
 #endif
 
-        test->Run(this);
+        if (m_jobs > 1 && test->m_children.size() > 1)
+        {
+            RunParallel(test);
+        }
+        else
+        {
+            test->Run(this);
+        }
+        if (!m_durationCacheFile.empty())
+        {
+            WriteDurationCache(test);
+        }
         PrintReport(test, os, xml, 0);
         if (test->IsFailed())
         {
@@ -7,11 +7,14 @@
 #include "wall-clock-synchronizer.h"
 
 #include "log.h"
+#include "nstime.h"
 
+#include <algorithm>
 #include <chrono>
 #include <condition_variable>
 #include <ctime> // clock_t
 #include <mutex>
+#include <thread>
 
 /**
  * @file
@@ -30,7 +33,22 @@ TypeId
 WallClockSynchronizer::GetTypeId()
 {
     static TypeId tid =
-        TypeId("ns3::WallClockSynchronizer").SetParent<Synchronizer>().SetGroupName("Core");
+        TypeId("ns3::WallClockSynchronizer")
+            .SetParent<Synchronizer>()
+            .SetGroupName("Core")
+            .AddAttribute("SleepThreshold",
+                          "The part of a delay which is not spent sleeping, but yielding "
+                          "or spinning, to compensate for sleep overshoot.  "
+                          "It is never less than three jiffies.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&WallClockSynchronizer::m_sleepThreshold),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("YieldThreshold",
+                          "While the remaining delay is longer than this, yield the "
+                          "processor instead of busy-waiting.  Zero disables yielding.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&WallClockSynchronizer::m_yieldThreshold),
+                          MakeTimeChecker(Time(0)));
     return tid;
 }
 
@@ -183,9 +201,6 @@ WallClockSynchronizer::DoSynchronize(uint64_t nsCurrent, uint64_t nsDelay)
     // If we want to be more accurate than a jiffy (we do) then we need to sleep
     // for some number of jiffies and then busy wait for any leftover time.
     //
-    uint64_t numberJiffies = ns / m_jiffy;
-    NS_LOG_INFO("Synchronize numberJiffies = " << numberJiffies);
-    //
     // This is where the real world interjects its very ugly head.  The code
     // immediately below reflects the fact that a sleep is actually quite probably
     // going to end up sleeping for some number of jiffies longer than you wanted.
@@ -202,21 +217,22 @@ WallClockSynchronizer::DoSynchronize(uint64_t nsCurrent, uint64_t nsDelay)
     // waiting (doing nothing).
     //
     // I'm not really sure about this number -- a boss of mine once said, "pick
-    // a number and it'll be wrong."  But this works for now.
-    //
-    // \todo Hardcoded tunable parameter below.
+    // a number and it'll be wrong."  So the amount we hold back from sleeping
+    // is the "SleepThreshold" attribute, but never less than three jiffies.
     //
-    if (numberJiffies > 3)
+    uint64_t nsGuard = std::max<uint64_t>(3 * m_jiffy, m_sleepThreshold.GetNanoSeconds());
+    if (ns > nsGuard)
     {
-        NS_LOG_INFO("SleepWait for " << numberJiffies * m_jiffy << " ns");
-        NS_LOG_INFO("SleepWait until " << nsCurrent + numberJiffies * m_jiffy << " ns");
+        uint64_t nsSleep = ((ns - nsGuard) / m_jiffy) * m_jiffy;
+        NS_LOG_INFO("SleepWait for " << nsSleep << " ns");
+        NS_LOG_INFO("SleepWait until " << nsCurrent + nsSleep << " ns");
         //
         // SleepWait is interruptible.  If it returns true it meant that the sleep
         // went until the end.  If it returns false, it means that the sleep was
         // interrupted by a Signal.  In this case, we need to return and let the
         // simulator re-evaluate what to do.
         //
-        if (!SleepWait((numberJiffies - 3) * m_jiffy))
+        if (nsSleep > 0 && !SleepWait(nsSleep))
         {
             NS_LOG_INFO("SleepWait interrupted");
             return false;
@@ -257,6 +273,20 @@ WallClockSynchronizer::DoSynchronize(uint64_t nsCurrent, uint64_t nsDelay)
     // using the SleepWait above.  If SpinWait completes to the end, it will
     // return true; if it is interrupted by a signal it will return false.
     //
+    // If a yield threshold is configured and the remaining wait is longer than
+    // it, give the processor away until only the threshold is left, so that
+    // other threads of this process can make progress in the meantime.
+    //
+    uint64_t nsYield = m_yieldThreshold.GetNanoSeconds();
+    if (nsYield > 0 && static_cast<uint64_t>(-nsDrift) > nsYield)
+    {
+        NS_LOG_INFO("YieldWait until " << nsCurrent + nsDelay - nsYield);
+        if (!YieldWait(nsCurrent + nsDelay - nsYield))
+        {
+            NS_LOG_INFO("YieldWait interrupted");
+            return false;
+        }
+    }
     NS_LOG_INFO("SpinWait until " << nsCurrent + nsDelay);
     return SpinWait(nsCurrent + nsDelay);
 }
@@ -318,6 +348,26 @@ WallClockSynchronizer::SpinWait(uint64_t ns)
     return true;
 }
 
+bool
+WallClockSynchronizer::YieldWait(uint64_t ns)
+{
+    NS_LOG_FUNCTION(this << ns);
+    for (;;)
+    {
+        if (GetNormalizedRealtime() >= ns)
+        {
+            return true;
+        }
+        if (m_condition)
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    // Quiet compiler
+    return true;
+}
+
 bool
 WallClockSynchronizer::SleepWait(uint64_t ns)
 {
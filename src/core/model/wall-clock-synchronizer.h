@@ -51,6 +51,16 @@ namespace ns3
  * to use the function @c clock_nanosleep() to sleep until a simulation Time
  * specified by the caller.
  *
+ * The wait for the next event is therefore split into up to three phases.
+ * The bulk of the delay is spent in an interruptible sleep on a condition
+ * variable.  The sleep stops short of the target by the "SleepThreshold"
+ * attribute (never less than three jiffies), since sleeps tend to overshoot.
+ * If the remaining delay is longer than the "YieldThreshold" attribute, the
+ * thread repeatedly yields the processor, which keeps latency low without
+ * monopolizing a core shared with other threads (e.g., a TapBridge reader).
+ * The last stretch is covered by a busy-wait.  Setting "YieldThreshold" to
+ * zero (the default) disables the yield phase.
+ *
  * @todo Add more on jiffies, sleep, processes, etc.
  *
  */
@@ -89,6 +99,19 @@ class WallClockSynchronizer : public Synchronizer
      *          @c false if we returned because the condition was set.
      */
     bool SpinWait(uint64_t ns);
+    /**
+     * @brief Yield the processor repeatedly until the normalized realtime
+     * equals the argument or the condition variable becomes @c true.
+     *
+     * This is a gentler form of SpinWait, used for the part of the delay
+     * which is too short to sleep reliably but long enough that burning
+     * a core on a busy-wait would starve other threads.
+     *
+     * @param [in] ns The target normalized real time we should wait for.
+     * @returns @c true if we reached the target time,
+     *          @c false if we returned because the condition was set.
+     */
+    bool YieldWait(uint64_t ns);
     /**
      * Put our process to sleep for some number of nanoseconds.
      *
@@ -152,6 +175,10 @@ class WallClockSynchronizer : public Synchronizer
 
     /** Size of the system clock tick, as reported by @c clock_getres, in ns. */
     uint64_t m_jiffy;
+    /** Remaining delay which is not slept, but yielded or spun away. */
+    Time m_sleepThreshold;
+    /** Remaining delay above which we yield rather than spin. */
+    Time m_yieldThreshold;
     /** Time recorded by DoEventStart. */
     uint64_t m_nsEventStart;
 
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/expiry-wheel.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup timer
+ * @ingroup timer-tests
+ * ExpiryWheel test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup timer-tests
+ * ExpiryWheel test
+ */
+class ExpiryWheelTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ExpiryWheelTestCase();
+    void DoRun() override;
+};
+
+ExpiryWheelTestCase::ExpiryWheelTestCase()
+    : TestCase("Check that the keys expire at their expiry time")
+{
+}
+
+void
+ExpiryWheelTestCase::DoRun()
+{
+    ExpiryWheel<uint32_t> wheel;
+    // Keys on every level of the wheel, and beyond it
+    std::vector<Time> expiries = {MicroSeconds(500),
+                                  MilliSeconds(5),
+                                  MilliSeconds(5),
+                                  MilliSeconds(100),
+                                  Seconds(10),
+                                  Seconds(100),
+                                  Hours(5),
+                                  Seconds(-1)};
+    for (uint32_t i = 0; i < expiries.size(); ++i)
+    {
+        wheel.Schedule(i, expiries[i]);
+    }
+    NS_TEST_EXPECT_MSG_EQ(wheel.GetSize(), expiries.size(), "trivial");
+
+    std::vector<bool> expired(expiries.size(), false);
+    std::vector<Time> checks = {Seconds(0),
+                                MicroSeconds(500),
+                                MicroSeconds(501),
+                                MilliSeconds(5),
+                                MicroSeconds(5001),
+                                Seconds(10) + NanoSeconds(1),
+                                Seconds(99),
+                                Seconds(101),
+                                Hours(5),
+                                Hours(6)};
+    for (const auto& now : checks)
+    {
+        wheel.Expire(now, [&](uint32_t key, Time expiry) {
+            NS_TEST_EXPECT_MSG_EQ(expiry, expiries[key], "Wrong expiry time");
+            NS_TEST_EXPECT_MSG_EQ(expired[key], false, "Key " << key << " expired twice");
+            expired[key] = true;
+        });
+        for (uint32_t i = 0; i < expiries.size(); ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(expired[i],
+                                  (expiries[i] < now),
+                                  "Key " << i << " at " << now.As(Time::S));
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(wheel.GetSize(), 0, "All keys should have expired");
+
+    // Keys scheduled again from the callback
+    wheel.Schedule(0, Hours(6) + Seconds(1));
+    uint32_t count = 0;
+    wheel.Expire(Hours(7), [&](uint32_t key, Time expiry) {
+        if (++count < 3)
+        {
+            wheel.Schedule(key, expiry + Seconds(1));
+        }
+    });
+    NS_TEST_EXPECT_MSG_EQ(count, 3, "The key should have been expired three times");
+}
+
+/**
+ * @ingroup timer-tests
+ * ExpiryWheel test suite
+ */
+class ExpiryWheelTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ExpiryWheelTestSuite()
+        : TestSuite("expiry-wheel")
+    {
+        AddTestCase(new ExpiryWheelTestCase());
+    }
+};
+
+/**
+ * @ingroup timer-tests
+ * ExpiryWheelTestSuite instance variable.
+ */
+static ExpiryWheelTestSuite g_expiryWheelTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/fork-snapshot.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup fork-snapshot-tests
+ * ForkSnapshot test suite.
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup fork-snapshot-tests ForkSnapshot tests
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup fork-snapshot-tests
+ * Check that restored processes resume the simulation from the snapshot.
+ */
+class ForkSnapshotTestCase : public TestCase
+{
+  public:
+    ForkSnapshotTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Draw a random number, and schedule the next draw one second later. */
+    void Draw();
+
+    Ptr<UniformRandomVariable> m_rng; //!< The random variable.
+    uint32_t m_count{0};              //!< Number of draws.
+    uint32_t m_increment{1};          //!< Draw count increment, changed by the variants.
+    double m_sum{0};                  //!< Sum of the draws.
+};
+
+ForkSnapshotTestCase::ForkSnapshotTestCase()
+    : TestCase("Check that restored processes resume the simulation from the snapshot")
+{
+}
+
+void
+ForkSnapshotTestCase::Draw()
+{
+    m_count += m_increment;
+    m_sum += m_rng->GetValue();
+    Simulator::Schedule(Seconds(1), &ForkSnapshotTestCase::Draw, this);
+}
+
+void
+ForkSnapshotTestCase::DoRun()
+{
+#ifndef __WIN32__
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(1);
+    Simulator::Schedule(Seconds(1), &ForkSnapshotTestCase::Draw, this);
+    Simulator::Stop(Seconds(5.5));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_count, 5, "Wrong number of draws before the snapshot");
+    double sumBefore = m_sum;
+
+    ForkSnapshot snapshot;
+    uint32_t variant = snapshot.Take();
+    if (variant != 0)
+    {
+        // Restored process: variant 2 counts the draws twice
+        m_increment = variant;
+        Simulator::Stop(Seconds(5));
+        Simulator::Run();
+        std::ofstream os(CreateTempDirFilename("variant-" + std::to_string(variant)));
+        os << std::setprecision(std::numeric_limits<double>::max_digits10) << m_sum - sumBefore;
+        os.close();
+        ForkSnapshot::Exit(m_count);
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(snapshot.IsTaken(), true, "Snapshot not taken");
+    int64_t pid1 = snapshot.Restore(1);
+    int64_t pid2 = snapshot.Restore(2);
+    NS_TEST_EXPECT_MSG_EQ(snapshot.Wait(pid1), 10, "Wrong number of draws in variant 1");
+    NS_TEST_EXPECT_MSG_EQ(snapshot.Wait(pid2), 15, "Wrong number of draws in variant 2");
+    snapshot.Discard();
+    NS_TEST_EXPECT_MSG_EQ(snapshot.IsTaken(), false, "Snapshot not discarded");
+
+    // The original process carries on too, with the same draws
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_count, 10, "Wrong number of draws after the snapshot");
+    for (uint32_t i = 1; i <= 2; ++i)
+    {
+        std::ifstream is(CreateTempDirFilename("variant-" + std::to_string(i)));
+        double sum = -1;
+        is >> sum;
+        NS_TEST_EXPECT_MSG_EQ(sum, m_sum - sumBefore, "Variant " << i << " drew different values");
+    }
+
+    Simulator::Destroy();
+#endif
+}
+
+/**
+ * @ingroup fork-snapshot-tests
+ * ForkSnapshot test suite.
+ */
+class ForkSnapshotTestSuite : public TestSuite
+{
+  public:
+    ForkSnapshotTestSuite();
+};
+
+ForkSnapshotTestSuite::ForkSnapshotTestSuite()
+    : TestSuite("fork-snapshot", Type::UNIT)
+{
+    AddTestCase(new ForkSnapshotTestCase, TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup fork-snapshot-tests
+ * Static variable for test initialization.
+ */
+static ForkSnapshotTestSuite g_forkSnapshotTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,163 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup log-binary-sink-tests
+ * Binary log sink test suite.
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup log-binary-sink-tests Binary log sink tests
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryLogSinkTest");
+
+/** A variable whose address is logged. */
+static int g_value = 42;
+
+/**
+ * @ingroup log-binary-sink-tests
+ * Log a few statements covering the argument types stored by the sink.
+ */
+void
+LogStatements()
+{
+    std::vector<int> vec{1, 2, 3};
+    NS_LOG_FUNCTION(g_value << "abc" << 1.5 << 'x' << true << vec << &g_value);
+    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_DEBUG("unsigned " << 7U << " double " << 0.25 << " bool " << false << " char " << 'c');
+    NS_LOG_INFO("time " << Seconds(1.5) << " then " << 3);
+    NS_LOG_LOGIC("hex " << std::hex << 255 << " width " << std::setw(5) << 1 << std::endl
+                        << "next line");
+    NS_LOG_WARN(std::string("a string") << " and a pointer " << static_cast<void*>(nullptr));
+}
+
+// Only allow INFO and more severe levels from here on
+#ifdef NS3_LOG_ENABLE
+#undef NS_LOG_STATIC_MASK
+#define NS_LOG_STATIC_MASK (ns3::LOG_LEVEL_INFO)
+#endif
+
+/**
+ * @ingroup log-binary-sink-tests
+ * Log statements restricted by NS_LOG_STATIC_MASK.
+ */
+void
+LogMaskedStatements()
+{
+    NS_LOG_INFO("kept");
+    NS_LOG_LOGIC("elided");
+    NS_LOG_FUNCTION_NOARGS();
+}
+
+/**
+ * @ingroup log-binary-sink-tests
+ * Check that a binary log, once formatted, matches the text log.
+ */
+class BinaryLogSinkTestCase : public TestCase
+{
+  public:
+    BinaryLogSinkTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a function capturing the text log.
+     * @param [in] f The function to run.
+     * @returns The text log.
+     */
+    std::string CaptureText(void (*f)());
+};
+
+BinaryLogSinkTestCase::BinaryLogSinkTestCase()
+    : TestCase("Check that the formatted binary log matches the text log")
+{
+}
+
+std::string
+BinaryLogSinkTestCase::CaptureText(void (*f)())
+{
+    std::ostringstream text;
+    std::streambuf* old = std::clog.rdbuf(text.rdbuf());
+    f();
+    std::clog.rdbuf(old);
+    return text.str();
+}
+
+void
+BinaryLogSinkTestCase::DoRun()
+{
+#ifdef NS3_LOG_ENABLE
+    // Create the simulator, which sets the time and node printers
+    Simulator::Now();
+    LogComponentEnable("BinaryLogSinkTest", LogLevel(LOG_LEVEL_ALL | LOG_PREFIX_ALL));
+
+    std::string expected = CaptureText(&LogStatements);
+
+    std::string filename = CreateTempDirFilename("binary.nslog");
+    LogSetBinarySink(filename);
+    NS_TEST_ASSERT_MSG_EQ(CaptureText(&LogStatements), "", "Binary log leaked to the text log");
+    LogClearBinarySink();
+
+    std::ifstream is(filename, std::ios::binary);
+    std::ostringstream formatted;
+    NS_TEST_ASSERT_MSG_EQ(BinaryLogSink::Format(is, formatted), true, "Invalid binary log");
+    NS_TEST_EXPECT_MSG_EQ(formatted.str(), expected, "Formatted binary log differs");
+
+    LogComponentDisable("BinaryLogSinkTest", LogLevel(LOG_LEVEL_ALL | LOG_PREFIX_ALL));
+    LogComponentEnable("BinaryLogSinkTest", LOG_LEVEL_ALL);
+    NS_TEST_EXPECT_MSG_EQ(CaptureText(&LogMaskedStatements),
+                          "kept\n",
+                          "NS_LOG_STATIC_MASK not honored");
+    LogComponentDisable("BinaryLogSinkTest", LOG_LEVEL_ALL);
+
+    Simulator::Destroy();
+#endif
+}
+
+/**
+ * @ingroup log-binary-sink-tests
+ * Binary log sink test suite.
+ */
+class BinaryLogSinkTestSuite : public TestSuite
+{
+  public:
+    BinaryLogSinkTestSuite();
+};
+
+BinaryLogSinkTestSuite::BinaryLogSinkTestSuite()
+    : TestSuite("log-binary-sink", Type::UNIT)
+{
+    AddTestCase(new BinaryLogSinkTestCase, TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup log-binary-sink-tests
+ * Static variable for test initialization.
+ */
+static BinaryLogSinkTestSuite g_binaryLogSinkTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
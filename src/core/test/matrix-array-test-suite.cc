@@ -11,6 +11,7 @@
 #include "ns3/test.h"
 
 #include <algorithm>
+#include <cmath>
 
 /**
  * @defgroup matrixArray-tests MatrixArray tests
@@ -682,6 +683,123 @@ ComplexMatrixArrayTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m2, m3, "m2 and m3 matrices should be equal");
 }
 
+/**
+ * @ingroup matrixArray-tests
+ *  Test for checking the products of large MatrixArrays, which are computed by
+ *  blocks, against a straightforward computation of each element
+ */
+class LargeMatrixArrayProductTestCase : public TestCase
+{
+  public:
+    /** Constructor*/
+    LargeMatrixArrayProductTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a MatrixArray with deterministic complex values
+     *
+     * @param [in] numRows the number of rows
+     * @param [in] numCols the number of columns
+     * @param [in] numPages the number of pages
+     * @return the MatrixArray
+     */
+    static ComplexMatrixArray CreateMatrix(size_t numRows, size_t numCols, size_t numPages);
+};
+
+LargeMatrixArrayProductTestCase::LargeMatrixArrayProductTestCase()
+    : TestCase("LargeMatrixArrayProductTestCase")
+{
+}
+
+ComplexMatrixArray
+LargeMatrixArrayProductTestCase::CreateMatrix(size_t numRows, size_t numCols, size_t numPages)
+{
+    ComplexMatrixArray matrix(numRows, numCols, numPages);
+    for (size_t i = 0; i < matrix.GetSize(); ++i)
+    {
+        matrix.GetPagePtr(0)[i] = std::complex<double>(std::sin(0.7 * i), std::cos(1.3 * i));
+    }
+    return matrix;
+}
+
+void
+LargeMatrixArrayProductTestCase::DoRun()
+{
+    // the inner dimension is larger than the blocks of the product
+    const size_t numRows = 5;
+    const size_t numInner = 150;
+    const size_t numCols = 3;
+    const size_t numPages = 4;
+
+    ComplexMatrixArray lhs = CreateMatrix(numRows, numInner, numPages);
+    ComplexMatrixArray rhs = CreateMatrix(numInner, numCols, numPages);
+    ComplexMatrixArray product = lhs * rhs;
+    ComplexMatrixArray reference(numRows, numCols, numPages);
+    for (size_t page = 0; page < numPages; ++page)
+    {
+        for (size_t row = 0; row < numRows; ++row)
+        {
+            for (size_t col = 0; col < numCols; ++col)
+            {
+                for (size_t k = 0; k < numInner; ++k)
+                {
+                    reference(row, col, page) += lhs(row, k, page) * rhs(k, col, page);
+                }
+            }
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(product.IsAlmostEqual(reference, 1e-10),
+                          true,
+                          "Mismatch in the product of large matrices");
+
+    ComplexMatrixArray transposed = lhs.Transpose();
+    for (size_t page = 0; page < numPages; ++page)
+    {
+        for (size_t row = 0; row < numRows; ++row)
+        {
+            for (size_t col = 0; col < numInner; ++col)
+            {
+                NS_TEST_ASSERT_MSG_EQ(transposed(col, row, page),
+                                      lhs(row, col, page),
+                                      "Mismatch in the transpose of a large matrix");
+            }
+        }
+    }
+
+    // products by a left vector, which are computed for all pages at once, and
+    // by a left matrix
+    ComplexMatrixArray pages = CreateMatrix(numRows, numInner, numPages);
+    for (size_t numLRows : {1, 2})
+    {
+        ComplexMatrixArray lMatrix = CreateMatrix(numLRows, numRows, 1);
+        ComplexMatrixArray rMatrix = CreateMatrix(numInner, numCols, 1);
+        ComplexMatrixArray result = pages.MultiplyByLeftAndRightMatrix(lMatrix, rMatrix);
+        ComplexMatrixArray expected(numLRows, numCols, numPages);
+        for (size_t page = 0; page < numPages; ++page)
+        {
+            for (size_t row = 0; row < numLRows; ++row)
+            {
+                for (size_t col = 0; col < numCols; ++col)
+                {
+                    for (size_t m = 0; m < numRows; ++m)
+                    {
+                        for (size_t n = 0; n < numInner; ++n)
+                        {
+                            expected(row, col, page) +=
+                                lMatrix(row, m) * pages(m, n, page) * rMatrix(n, col);
+                        }
+                    }
+                }
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(result.IsAlmostEqual(expected, 1e-10),
+                              true,
+                              "Mismatch in the product by a left and a right matrix");
+    }
+}
+
 /**
  * @ingroup matrixArray-tests
  * MatrixArray test suite
@@ -701,6 +819,7 @@ MatrixArrayTestSuite::MatrixArrayTestSuite()
         new MatrixArrayTestCase<std::complex<double>>("Test MatrixArray<std::complex<double>>"));
     AddTestCase(new MatrixArrayTestCase<int>("Test MatrixArray<int>"));
     AddTestCase(new ComplexMatrixArrayTestCase("Test ComplexMatrixArray"));
+    AddTestCase(new LargeMatrixArrayProductTestCase());
 }
 
 /**
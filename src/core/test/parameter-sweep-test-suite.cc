@@ -0,0 +1,153 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/parameter-sweep.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cmath>
+
+/**
+ * @file
+ * @ingroup parameter-sweep-tests
+ * ParameterSweep test suite.
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup parameter-sweep-tests ParameterSweep tests
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup parameter-sweep-tests
+ * Check that the variants of a sweep start from the same state, apply
+ * their own attributes and run numbers, and report their results.
+ */
+class ParameterSweepTestCase : public TestCase
+{
+  public:
+    ParameterSweepTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Draw a random number, and schedule the next draw one second later. */
+    void Draw();
+    /**
+     * Report the results of a variant.
+     * @param [in] variant The index of the variant.
+     */
+    void Report(uint32_t variant);
+
+    Ptr<UniformRandomVariable> m_rng; //!< The random variable, configured by the variants.
+    ParameterSweep m_sweep;           //!< The sweep.
+    uint32_t m_count{0};              //!< Number of draws.
+    double m_sum{0};                  //!< Sum of the draws.
+};
+
+ParameterSweepTestCase::ParameterSweepTestCase()
+    : TestCase("Check that the variants of a sweep run from a common state")
+{
+}
+
+void
+ParameterSweepTestCase::Draw()
+{
+    ++m_count;
+    m_sum += m_rng->GetValue();
+    Simulator::Schedule(Seconds(1), &ParameterSweepTestCase::Draw, this);
+}
+
+void
+ParameterSweepTestCase::Report(uint32_t variant)
+{
+    m_sweep.Report("count", m_count);
+    m_sweep.Report("sum", m_sum);
+    m_sweep.Report("variant", variant);
+}
+
+void
+ParameterSweepTestCase::DoRun()
+{
+#ifndef __WIN32__
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(1);
+    Config::RegisterRootNamespaceObject(m_rng);
+    Simulator::Schedule(Seconds(1), &ParameterSweepTestCase::Draw, this);
+
+    uint32_t same = m_sweep.AddVariant();
+    uint32_t scaled = m_sweep.AddVariant();
+    m_sweep.Set(scaled, "/Max", DoubleValue(10));
+    uint32_t reseeded = m_sweep.AddVariant();
+    m_sweep.SetRun(reseeded, 99);
+    m_sweep.SetJobs(2);
+    m_sweep.SetReportCallback(MakeCallback(&ParameterSweepTestCase::Report, this));
+    m_sweep.Run(Seconds(5.5), Seconds(5));
+
+    NS_TEST_ASSERT_MSG_EQ(m_count, 5, "The sweep did not stop at the fork time");
+    double sumBefore = m_sum;
+    Simulator::Stop(Seconds(5));
+    Simulator::Run();
+    double sumAfter = m_sum - sumBefore;
+
+    for (uint32_t v = 0; v < m_sweep.GetNVariants(); ++v)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_sweep.GetStatus(v), 0, "Variant " << v << " failed");
+        NS_TEST_EXPECT_MSG_EQ(m_sweep.GetResult(v, "count"), 10, "Wrong count in " << v);
+        NS_TEST_EXPECT_MSG_EQ(m_sweep.GetResult(v, "variant"), v, "Wrong variant reported");
+        NS_TEST_EXPECT_MSG_EQ(m_sweep.GetResults(v).size(), 3, "Wrong number of results");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_sweep.GetResult(same, "sum"), m_sum, "Unchanged variant differs");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_sweep.GetResult(scaled, "sum"),
+                              sumBefore + 10 * sumAfter,
+                              1e-9,
+                              "Attribute not applied in the variant");
+    NS_TEST_EXPECT_MSG_NE(m_sweep.GetResult(reseeded, "sum"),
+                          m_sum,
+                          "Run number not applied in the variant");
+    NS_TEST_EXPECT_MSG_EQ(std::isnan(m_sweep.GetResult(same, "missing")),
+                          true,
+                          "Missing result not NaN");
+
+    Config::UnregisterRootNamespaceObject(m_rng);
+    m_rng = nullptr;
+    Simulator::Destroy();
+#endif
+}
+
+/**
+ * @ingroup parameter-sweep-tests
+ * ParameterSweep test suite.
+ */
+class ParameterSweepTestSuite : public TestSuite
+{
+  public:
+    ParameterSweepTestSuite();
+};
+
+ParameterSweepTestSuite::ParameterSweepTestSuite()
+    : TestSuite("parameter-sweep", Type::UNIT)
+{
+    AddTestCase(new ParameterSweepTestCase, TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup parameter-sweep-tests
+ * Static variable for test initialization.
+ */
+static ParameterSweepTestSuite g_parameterSweepTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,474 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup randomvariable
+ * @ingroup rng-tests
+ * Ziggurat and alias samplers test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+namespace
+{
+
+/**
+ * @ingroup rng-tests
+ * Get the value of the chi-squared distribution exceeded with a
+ * probability of 1e-4, with the Wilson-Hilferty approximation.
+ * @param [in] dof The number of degrees of freedom.
+ * @return The critical value.
+ */
+double
+ChiSquaredCritical(uint32_t dof)
+{
+    const double z = 3.719; // Standard normal quantile of 1 - 1e-4
+    const double k = dof;
+    return k * std::pow(1 - 2 / (9 * k) + z * std::sqrt(2 / (9 * k)), 3);
+}
+
+/**
+ * @ingroup rng-tests
+ * Compute the chi-squared statistic of a histogram.
+ * @param [in] observed The number of values in each bin.
+ * @param [in] expected The expected number of values in each bin.
+ * @return The statistic.
+ */
+double
+ChiSquared(const std::vector<uint32_t>& observed, const std::vector<double>& expected)
+{
+    double chi2 = 0;
+    for (std::size_t i = 0; i < observed.size(); ++i)
+    {
+        double d = observed[i] - expected[i];
+        chi2 += d * d / expected[i];
+    }
+    return chi2;
+}
+
+/**
+ * @ingroup rng-tests
+ * Compute the chi-squared statistic of values of a continuous distribution,
+ * in bins of equal probability.
+ * @param [in] values The values.
+ * @param [in] cdf The cumulative distribution function.
+ * @param [in] bins The number of bins.
+ * @return The statistic.
+ */
+double
+ChiSquared(const std::vector<double>& values,
+           const std::function<double(double)>& cdf,
+           uint32_t bins)
+{
+    std::vector<uint32_t> observed(bins, 0);
+    for (auto value : values)
+    {
+        auto bin = static_cast<uint32_t>(cdf(value) * bins);
+        observed[std::min(bin, bins - 1)]++;
+    }
+    std::vector<double> expected(bins, static_cast<double>(values.size()) / bins);
+    return ChiSquared(observed, expected);
+}
+
+/** Number of values drawn to check a distribution. */
+const uint32_t N_VALUES = 100000;
+
+} // namespace
+
+/**
+ * @ingroup rng-tests
+ * Check the distribution of the normal values drawn with the Ziggurat method.
+ */
+class ZigguratNormalTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ZigguratNormalTestCase();
+    void DoRun() override;
+};
+
+ZigguratNormalTestCase::ZigguratNormalTestCase()
+    : TestCase("Check the distribution of the Ziggurat normal values")
+{
+}
+
+void
+ZigguratNormalTestCase::DoRun()
+{
+    const double mean = 5;
+    const double variance = 4;
+    auto x = CreateObject<NormalRandomVariable>();
+    x->SetStream(1);
+    x->SetAttribute("Mean", DoubleValue(mean));
+    x->SetAttribute("Variance", DoubleValue(variance));
+    x->SetAttribute("Ziggurat", BooleanValue(true));
+
+    std::vector<double> values(N_VALUES);
+    x->GetValues(values);
+    auto cdf = [=](double v) { return 0.5 * std::erfc(-(v - mean) / std::sqrt(2 * variance)); };
+    NS_TEST_EXPECT_MSG_LT(ChiSquared(values, cdf, 50),
+                          ChiSquaredCritical(49),
+                          "Values not normally distributed");
+
+    double sum = 0;
+    double sumSquares = 0;
+    for (auto v : values)
+    {
+        sum += v;
+        sumSquares += (v - mean) * (v - mean);
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(sum / N_VALUES, mean, 0.03, "Wrong mean");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sumSquares / N_VALUES, variance, 0.1, "Wrong variance");
+
+    // The tail beyond the base layer is drawn separately
+    uint32_t tail = 0;
+    for (auto v : values)
+    {
+        tail += std::fabs(v - mean) / std::sqrt(variance) > 3.442619855899 ? 1 : 0;
+    }
+    // P(|z| > 3.4426) = 5.76e-4, i.e. 57.6 values on average
+    NS_TEST_EXPECT_MSG_GT(tail, 30U, "Too few values in the tail");
+    NS_TEST_EXPECT_MSG_LT(tail, 90U, "Too many values in the tail");
+
+    x->SetAttribute("Bound", DoubleValue(1));
+    x->GetValues(values);
+    for (auto v : values)
+    {
+        NS_TEST_ASSERT_MSG_EQ((std::fabs(v - mean) <= 1), true, "Value out of bound: " << v);
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ * Check the distribution of the exponential values drawn with the Ziggurat method.
+ */
+class ZigguratExponentialTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ZigguratExponentialTestCase();
+    void DoRun() override;
+};
+
+ZigguratExponentialTestCase::ZigguratExponentialTestCase()
+    : TestCase("Check the distribution of the Ziggurat exponential values")
+{
+}
+
+void
+ZigguratExponentialTestCase::DoRun()
+{
+    const double mean = 3;
+    auto x = CreateObject<ExponentialRandomVariable>();
+    x->SetStream(2);
+    x->SetAttribute("Mean", DoubleValue(mean));
+    x->SetAttribute("Ziggurat", BooleanValue(true));
+
+    std::vector<double> values(N_VALUES);
+    x->GetValues(values);
+    auto cdf = [=](double v) { return 1 - std::exp(-v / mean); };
+    NS_TEST_EXPECT_MSG_LT(ChiSquared(values, cdf, 50),
+                          ChiSquaredCritical(49),
+                          "Values not exponentially distributed");
+
+    double sum = 0;
+    uint32_t tail = 0;
+    for (auto v : values)
+    {
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(v, 0, "Negative value");
+        sum += v;
+        tail += v / mean > 7.69711747013104972 ? 1 : 0;
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(sum / N_VALUES, mean, 0.05, "Wrong mean");
+    // P(x > 7.697) = 4.54e-4, i.e. 45.4 values on average
+    NS_TEST_EXPECT_MSG_GT(tail, 20U, "Too few values in the tail");
+    NS_TEST_EXPECT_MSG_LT(tail, 75U, "Too many values in the tail");
+
+    x->SetAttribute("Bound", DoubleValue(2));
+    x->GetValues(values);
+    for (auto v : values)
+    {
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(v, 2, "Value out of bound");
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ * Check the Zipf values drawn from the cached CDF and from the alias table.
+ */
+class ZipfSamplerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ZipfSamplerTestCase();
+    void DoRun() override;
+};
+
+ZipfSamplerTestCase::ZipfSamplerTestCase()
+    : TestCase("Check the Zipf values drawn by inversion and from the alias table")
+{
+}
+
+void
+ZipfSamplerTestCase::DoRun()
+{
+    const uint32_t n = 100;
+    const double alpha = 1.2;
+    std::vector<double> pmf(n);
+    double sum = 0;
+    for (uint32_t k = 1; k <= n; ++k)
+    {
+        pmf[k - 1] = 1 / std::pow(k, alpha);
+        sum += pmf[k - 1];
+    }
+
+    // Inversion, with the same uniform values as the reference algorithm
+    auto x = CreateObject<ZipfRandomVariable>();
+    x->SetStream(3);
+    x->SetAttribute("N", IntegerValue(n));
+    x->SetAttribute("Alpha", DoubleValue(alpha));
+    auto u = CreateObject<UniformRandomVariable>();
+    u->SetStream(3);
+    const double c = 1 / sum;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        double r = u->GetValue();
+        double cdf = 0;
+        uint32_t expected = 0;
+        for (uint32_t k = 1; k <= n; ++k)
+        {
+            cdf += c / std::pow(k, alpha);
+            if (cdf > r)
+            {
+                expected = k;
+                break;
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(x->GetInteger(), expected, "Wrong value by inversion");
+    }
+
+    // Alias table
+    x->SetAttribute("Alias", BooleanValue(true));
+    std::vector<double> values(N_VALUES);
+    x->GetValues(values);
+    std::vector<uint32_t> observed(n, 0);
+    std::vector<double> expected(n);
+    for (auto v : values)
+    {
+        NS_TEST_ASSERT_MSG_EQ((v >= 1 && v <= n && v == std::floor(v)), true, "Bad value " << v);
+        observed[static_cast<uint32_t>(v) - 1]++;
+    }
+    for (uint32_t k = 0; k < n; ++k)
+    {
+        expected[k] = N_VALUES * pmf[k] / sum;
+    }
+    NS_TEST_EXPECT_MSG_LT(ChiSquared(observed, expected),
+                          ChiSquaredCritical(n - 1),
+                          "Values not Zipf distributed");
+
+    // The tables follow the parameters
+    x->SetAttribute("N", IntegerValue(3));
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(x->GetInteger(), 3U, "Value out of range");
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ * Check the empirical values drawn from the alias table.
+ */
+class EmpiricalAliasTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EmpiricalAliasTestCase();
+    void DoRun() override;
+};
+
+EmpiricalAliasTestCase::EmpiricalAliasTestCase()
+    : TestCase("Check the empirical values drawn from the alias table")
+{
+}
+
+void
+EmpiricalAliasTestCase::DoRun()
+{
+    // Sampling: the last value is also returned above the last point
+    auto x = CreateObject<EmpiricalRandomVariable>();
+    x->SetStream(4);
+    x->SetAttribute("Alias", BooleanValue(true));
+    x->CDF(5, 0.25);
+    x->CDF(10, 0.6);
+    x->CDF(12, 0.9);
+    std::vector<double> values(N_VALUES);
+    x->GetValues(values);
+    std::vector<uint32_t> observed(3, 0);
+    for (auto v : values)
+    {
+        NS_TEST_ASSERT_MSG_EQ((v == 5 || v == 10 || v == 12), true, "Bad value " << v);
+        observed[v == 5 ? 0 : (v == 10 ? 1 : 2)]++;
+    }
+    std::vector<double> expected{0.25 * N_VALUES, 0.35 * N_VALUES, 0.4 * N_VALUES};
+    NS_TEST_EXPECT_MSG_LT(ChiSquared(observed, expected),
+                          ChiSquaredCritical(2),
+                          "Wrong sampled distribution");
+
+    // Interpolation, over a CDF changed after the first draws
+    x->SetInterpolate(true);
+    x->CDF(0, 0);
+    x->CDF(20, 1);
+    x->GetValues(values);
+    auto cdf = [](double v) {
+        const double points[][2] = {{0, 0}, {5, 0.25}, {10, 0.6}, {12, 0.9}, {20, 1}};
+        for (uint32_t i = 1; i < 5; ++i)
+        {
+            if (v <= points[i][0])
+            {
+                return points[i - 1][1] + (points[i][1] - points[i - 1][1]) *
+                                              (v - points[i - 1][0]) /
+                                              (points[i][0] - points[i - 1][0]);
+            }
+        }
+        return 1.0;
+    };
+    NS_TEST_EXPECT_MSG_LT(ChiSquared(values, cdf, 40),
+                          ChiSquaredCritical(39),
+                          "Wrong interpolated distribution");
+}
+
+/**
+ * @ingroup rng-tests
+ * Check that GetValues() gives the same values as GetValue().
+ */
+class SamplerBatchTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] name The name of the configuration.
+     * @param [in] create A function creating a random variable, with the configuration.
+     */
+    SamplerBatchTestCase(const std::string& name,
+                         std::function<Ptr<RandomVariableStream>()> create);
+    void DoRun() override;
+
+  private:
+    /** The function creating a random variable. */
+    std::function<Ptr<RandomVariableStream>()> m_create;
+};
+
+SamplerBatchTestCase::SamplerBatchTestCase(const std::string& name,
+                                           std::function<Ptr<RandomVariableStream>()> create)
+    : TestCase("Check the batches of the " + name),
+      m_create(create)
+{
+}
+
+void
+SamplerBatchTestCase::DoRun()
+{
+    for (bool antithetic : {false, true})
+    {
+        auto batch = m_create();
+        auto single = m_create();
+        batch->SetStream(5);
+        single->SetStream(5);
+        batch->SetAttribute("Antithetic", BooleanValue(antithetic));
+        single->SetAttribute("Antithetic", BooleanValue(antithetic));
+        std::vector<double> values(1000);
+        for (uint32_t size : {1, 300, 0, 699})
+        {
+            std::span<double> span(values.data(), size);
+            batch->GetValues(span);
+            for (auto v : span)
+            {
+                NS_TEST_ASSERT_MSG_EQ(v, single->GetValue(), "Batch and single values differ");
+            }
+        }
+        NS_TEST_EXPECT_MSG_EQ(batch->GetValue(), single->GetValue(), "Streams out of step");
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ * Ziggurat and alias samplers TestSuite
+ */
+class RandomVariableStreamSamplerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    RandomVariableStreamSamplerTestSuite();
+};
+
+RandomVariableStreamSamplerTestSuite::RandomVariableStreamSamplerTestSuite()
+    : TestSuite("random-variable-stream-samplers", Type::UNIT)
+{
+    AddTestCase(new ZigguratNormalTestCase());
+    AddTestCase(new ZigguratExponentialTestCase());
+    AddTestCase(new ZipfSamplerTestCase());
+    AddTestCase(new EmpiricalAliasTestCase());
+
+    for (bool fast : {false, true})
+    {
+        std::string method = fast ? " (fast method)" : "";
+        AddTestCase(new SamplerBatchTestCase("normal values" + method, [=]() {
+            auto x = CreateObject<NormalRandomVariable>();
+            x->SetAttribute("Bound", DoubleValue(1.5));
+            x->SetAttribute("Ziggurat", BooleanValue(fast));
+            return x;
+        }));
+        AddTestCase(new SamplerBatchTestCase("exponential values" + method, [=]() {
+            auto x = CreateObject<ExponentialRandomVariable>();
+            x->SetAttribute("Ziggurat", BooleanValue(fast));
+            return x;
+        }));
+        AddTestCase(new SamplerBatchTestCase("Zipf values" + method, [=]() {
+            auto x = CreateObject<ZipfRandomVariable>();
+            x->SetAttribute("N", IntegerValue(1000));
+            x->SetAttribute("Alpha", DoubleValue(0.8));
+            x->SetAttribute("Alias", BooleanValue(fast));
+            return x;
+        }));
+        for (bool interpolate : {false, true})
+        {
+            std::string mode = interpolate ? "interpolated" : "sampled";
+            AddTestCase(new SamplerBatchTestCase(mode + " empirical values" + method, [=]() {
+                auto x = CreateObject<EmpiricalRandomVariable>();
+                x->SetAttribute("Interpolate", BooleanValue(interpolate));
+                x->SetAttribute("Alias", BooleanValue(fast));
+                x->CDF(1, 0.1);
+                x->CDF(2, 0.5);
+                x->CDF(4, 0.8);
+                return x;
+            }));
+        }
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ * RandomVariableStreamSamplerTestSuite instance variable.
+ */
+static RandomVariableStreamSamplerTestSuite g_randomVariableStreamSamplerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
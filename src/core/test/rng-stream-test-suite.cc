@@ -0,0 +1,247 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup randomvariable
+ * @ingroup rng-tests
+ * RngStream test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup rng-tests
+ * Check the Philox generator against the known answer of its reference
+ * implementation.
+ */
+class RngStreamPhiloxKnownAnswerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RngStreamPhiloxKnownAnswerTestCase();
+    void DoRun() override;
+};
+
+RngStreamPhiloxKnownAnswerTestCase::RngStreamPhiloxKnownAnswerTestCase()
+    : TestCase("Check the Philox4x32-10 output of a known key and counter")
+{
+}
+
+void
+RngStreamPhiloxKnownAnswerTestCase::DoRun()
+{
+    // The key is Mix(stream ^ Mix(seed)), and Mix(0) = 0: this stream
+    // gives the key {0, 0}, and its first block has the counter {0, 0, 0, 0}.
+    auto mix = [](uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    };
+    RngStream rng(1, mix(1), 0, RngStream::PHILOX);
+    const uint32_t expected[] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    for (auto x : expected)
+    {
+        auto output = static_cast<uint32_t>(std::floor(rng.RandU01() * 4294967296.0));
+        NS_TEST_EXPECT_MSG_EQ(output, x, "Wrong Philox output");
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ * Check that drawing numbers in batches gives the same numbers as
+ * drawing them one by one.
+ */
+class RngStreamBatchTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] generator The generator to test.
+     */
+    RngStreamBatchTestCase(RngStream::Generator generator);
+    void DoRun() override;
+
+  private:
+    RngStream::Generator m_generator; //!< The generator to test.
+};
+
+RngStreamBatchTestCase::RngStreamBatchTestCase(RngStream::Generator generator)
+    : TestCase(std::string("Check the batches of the ") +
+               (generator == RngStream::PHILOX ? "Philox" : "MRG32k3a") + " generator"),
+      m_generator(generator)
+{
+}
+
+void
+RngStreamBatchTestCase::DoRun()
+{
+    RngStream batch(3, 5, 7, m_generator);
+    RngStream single(batch);
+    std::vector<double> values(1000);
+    uint32_t checked = 0;
+    // Batches of all sizes, starting anywhere in a block
+    for (uint32_t size : {3, 1, 0, 64, 5, 200, 2, 131})
+    {
+        batch.RandU01(std::span<double>(values.data(), size));
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(values[i],
+                                  single.RandU01(),
+                                  "Value " << checked + i << " differs from the single draws");
+        }
+        checked += size;
+        NS_TEST_EXPECT_MSG_EQ(batch.RandU01(), single.RandU01(), "Streams out of step");
+        ++checked;
+    }
+}
+
+/**
+ * @ingroup rng-tests
+ * Check the streams and sub-streams of the Philox generator.
+ */
+class RngStreamPhiloxStreamsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RngStreamPhiloxStreamsTestCase();
+    void DoRun() override;
+};
+
+RngStreamPhiloxStreamsTestCase::RngStreamPhiloxStreamsTestCase()
+    : TestCase("Check the streams and sub-streams of the Philox generator")
+{
+}
+
+void
+RngStreamPhiloxStreamsTestCase::DoRun()
+{
+    const uint32_t n = 100000;
+    std::vector<std::vector<double>> sequences;
+    for (auto [stream, substream] : {std::pair<uint64_t, uint64_t>{0, 1},
+                                     {1, 1},
+                                     {0, 2},
+                                     {(1ULL << 63) + 1, 1}})
+    {
+        RngStream rng(1, stream, substream, RngStream::PHILOX);
+        std::vector<double> values(n);
+        rng.RandU01(values);
+        double sum = 0;
+        for (auto value : values)
+        {
+            NS_TEST_ASSERT_MSG_GT(value, 0, "Value out of range");
+            NS_TEST_ASSERT_MSG_LT(value, 1, "Value out of range");
+            sum += value;
+        }
+        // Standard deviation of the mean: 1 / sqrt(12 n), about 0.0009
+        NS_TEST_EXPECT_MSG_EQ_TOL(sum / n, 0.5, 0.005, "Wrong mean");
+        sequences.push_back(values);
+    }
+    for (std::size_t i = 0; i < sequences.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < sequences.size(); ++j)
+        {
+            uint32_t equal = 0;
+            for (uint32_t k = 0; k < n; ++k)
+            {
+                equal += sequences[i][k] == sequences[j][k] ? 1 : 0;
+            }
+            NS_TEST_EXPECT_MSG_LT(equal, 10, "Sequences " << i << " and " << j << " overlap");
+        }
+    }
+
+    RngStream again(1, 1, 1, RngStream::PHILOX);
+    NS_TEST_EXPECT_MSG_EQ(again.RandU01(), sequences[1][0], "Sequence not reproducible");
+}
+
+/**
+ * @ingroup rng-tests
+ * Check that the generator selected in the RngSeedManager is used by
+ * the random variables.
+ */
+class RngStreamGeneratorSelectionTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RngStreamGeneratorSelectionTestCase();
+    void DoRun() override;
+};
+
+RngStreamGeneratorSelectionTestCase::RngStreamGeneratorSelectionTestCase()
+    : TestCase("Check the selection of the generator of the random variables")
+{
+}
+
+void
+RngStreamGeneratorSelectionTestCase::DoRun()
+{
+    RngStream::Generator previous = RngSeedManager::GetGenerator();
+    RngSeedManager::SetGenerator(RngStream::PHILOX);
+
+    Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable>();
+    x->SetStream(42);
+    x->SetAttribute("Min", DoubleValue(10));
+    x->SetAttribute("Max", DoubleValue(20));
+    std::vector<double> values(37);
+    x->GetValues(values);
+
+    RngStream rng(RngSeedManager::GetSeed(),
+                  (1ULL << 63) + 42,
+                  RngSeedManager::GetRun(),
+                  RngStream::PHILOX);
+    for (auto value : values)
+    {
+        double expected = 10 + 10 * rng.RandU01();
+        NS_TEST_EXPECT_MSG_EQ_TOL(value, expected, 1e-12, "Wrong value");
+    }
+    double expected = 10 + 10 * rng.RandU01();
+    NS_TEST_EXPECT_MSG_EQ_TOL(x->GetValue(), expected, 1e-12, "Wrong value");
+
+    RngSeedManager::SetGenerator(previous);
+}
+
+/**
+ * @ingroup rng-tests
+ * RngStream TestSuite
+ */
+class RngStreamTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    RngStreamTestSuite();
+};
+
+RngStreamTestSuite::RngStreamTestSuite()
+    : TestSuite("rng-stream", Type::UNIT)
+{
+    AddTestCase(new RngStreamPhiloxKnownAnswerTestCase());
+    AddTestCase(new RngStreamBatchTestCase(RngStream::MRG32K3A));
+    AddTestCase(new RngStreamBatchTestCase(RngStream::PHILOX));
+    AddTestCase(new RngStreamPhiloxStreamsTestCase());
+    AddTestCase(new RngStreamGeneratorSelectionTestCase());
+}
+
+/**
+ * @ingroup rng-tests
+ * RngStreamTestSuite instance variable.
+ */
+static RngStreamTestSuite g_rngStreamTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
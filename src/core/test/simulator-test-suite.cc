@@ -6,13 +6,20 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/realtime-simulator-impl.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
 using namespace ns3;
 
 /**
@@ -651,6 +658,114 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the realtime simulator dispatches late events in a batch
+ * and accounts for the lag of every event it runs.
+ */
+class RealtimeLagTestCase : public TestCase
+{
+  public:
+    RealtimeLagTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Trace sink for the SchedulingLag trace source.
+     * @param lag The lag of the event.
+     */
+    void LagTrace(Time lag);
+    /** Event which takes longer than the spacing between events to run. */
+    void SlowEvent();
+
+    uint32_t m_traced; //!< Number of lag traces received.
+    uint32_t m_ran;    //!< Number of events run.
+    Time m_minLag;     //!< Smallest traced lag.
+    Time m_maxLag;     //!< Largest traced lag.
+};
+
+RealtimeLagTestCase::RealtimeLagTestCase()
+    : TestCase("Check the realtime simulator lag trace and histogram")
+{
+}
+
+void
+RealtimeLagTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::RealtimeSimulatorImpl"));
+    m_traced = 0;
+    m_ran = 0;
+    m_minLag = Time::Max();
+    m_maxLag = Time(0);
+}
+
+void
+RealtimeLagTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+void
+RealtimeLagTestCase::LagTrace(Time lag)
+{
+    m_traced++;
+    m_minLag = std::min(m_minLag, lag);
+    m_maxLag = std::max(m_maxLag, lag);
+}
+
+void
+RealtimeLagTestCase::SlowEvent()
+{
+    m_ran++;
+    // Burn more real time than the event spacing, so that the following
+    // events are already late and are dispatched without waiting.
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2))
+    {
+    }
+}
+
+void
+RealtimeLagTestCase::DoRun()
+{
+    Ptr<RealtimeSimulatorImpl> impl =
+        DynamicCast<RealtimeSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Not running the realtime simulator");
+    impl->TraceConnectWithoutContext("SchedulingLag",
+                                     MakeCallback(&RealtimeLagTestCase::LagTrace, this));
+
+    const uint32_t events = 10;
+    for (uint32_t i = 0; i < events; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i), &RealtimeLagTestCase::SlowEvent, this);
+    }
+    Simulator::Stop(MilliSeconds(events));
+    Simulator::Run();
+
+    std::vector<uint64_t> histogram = impl->GetLagHistogram();
+    uint64_t counted = std::accumulate(histogram.begin(), histogram.end(), uint64_t{0});
+    // The stop event is traced and counted too
+    NS_TEST_EXPECT_MSG_EQ(m_ran, events, "Not all events were run");
+    NS_TEST_EXPECT_MSG_EQ(m_traced, events + 1, "Not all events were traced");
+    NS_TEST_EXPECT_MSG_EQ(counted, events + 1, "Not all events were counted in the histogram");
+    NS_TEST_EXPECT_MSG_GT(std::accumulate(histogram.begin() + 1, histogram.end(), uint64_t{0}),
+                          0,
+                          "Late events not accounted for");
+    // Each event runs for 2 ms of real time while they are spaced by 1 ms, so
+    // that the last events are late by several milliseconds.  Only lower
+    // bounds are checked, since a loaded machine can only make them later.
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_minLag, Time(0), "Negative lag traced");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(m_maxLag,
+                                MilliSeconds(events / 2),
+                                "The lag of the late events is too small");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -674,6 +789,8 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        // Depends on the wall clock of the host
+        AddTestCase(new RealtimeLagTestCase(), TestCase::Duration::EXTENSIVE);
     }
 };
 
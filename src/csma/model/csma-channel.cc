@@ -10,6 +10,8 @@
 
 #include "csma-net-device.h"
 
+#include "ns3/boolean.h"
+#include "ns3/ethernet-header.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -39,7 +41,13 @@ CsmaChannel::GetTypeId()
                           "Transmission delay through the channel",
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&CsmaChannel::m_delay),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("FanOut",
+                          "Deliver each packet to all the receivers from a single event, "
+                          "in the context of the sender, instead of one event per receiver",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CsmaChannel::m_fanOut),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -211,18 +219,45 @@ CsmaChannel::TransmitEnd()
 
     NS_LOG_LOGIC("Receive");
 
+    // Devices which would drop a frame unicast to another device without any
+    // observable effect are not scheduled for its reception.
+    EthernetHeader header(false);
+    bool filter = m_currentPkt->GetSize() >= header.GetSerializedSize();
+    if (filter)
+    {
+        m_currentPkt->PeekHeader(header);
+    }
+
+    Ptr<CsmaNetDevice> sender = m_deviceList[m_currentSrc].devicePtr;
+    std::vector<Ptr<CsmaNetDevice>> receivers;
     for (auto it = m_deviceList.begin(); it < m_deviceList.end(); it++)
     {
-        if (it->IsActive() && it->devicePtr != m_deviceList[m_currentSrc].devicePtr)
+        if (!it->IsActive() || it->devicePtr == sender ||
+            (filter && it->devicePtr->WouldDiscard(header.GetDestination())))
         {
-            // schedule reception events
-            Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
-                                           m_delay,
-                                           &CsmaNetDevice::Receive,
-                                           it->devicePtr,
-                                           m_currentPkt,
-                                           m_deviceList[m_currentSrc].devicePtr);
+            continue;
         }
+        if (m_fanOut)
+        {
+            receivers.push_back(it->devicePtr);
+            continue;
+        }
+        // schedule reception events
+        Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
+                                       m_delay,
+                                       &CsmaNetDevice::Receive,
+                                       it->devicePtr,
+                                       m_currentPkt,
+                                       sender);
+    }
+    if (!receivers.empty())
+    {
+        Simulator::Schedule(m_delay,
+                            &CsmaChannel::FanOutReceive,
+                            this,
+                            m_currentPkt,
+                            sender,
+                            std::move(receivers));
     }
 
     // also schedule for the tx side to go back to IDLE
@@ -230,6 +265,18 @@ CsmaChannel::TransmitEnd()
     return retVal;
 }
 
+void
+CsmaChannel::FanOutReceive(Ptr<const Packet> p,
+                           Ptr<CsmaNetDevice> sender,
+                           std::vector<Ptr<CsmaNetDevice>> receivers)
+{
+    NS_LOG_FUNCTION(this << p << sender << receivers.size());
+    for (const auto& receiver : receivers)
+    {
+        receiver->Receive(p, sender);
+    }
+}
+
 void
 CsmaChannel::PropagationCompleteEvent()
 {
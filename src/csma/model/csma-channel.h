@@ -190,6 +190,16 @@ class CsmaChannel : public Channel
      * packet p as the m_currentPkt, the packet being currently
      * transmitting.
      *
+     * The reception of the packet is scheduled on every other active net
+     * device, except the ones which would discard it without any
+     * observable effect (see CsmaNetDevice::WouldDiscard).  By default one
+     * event is scheduled per receiver, in the context of its node.  If the
+     * FanOut attribute is set, a single event delivers the packet to all
+     * the receivers instead; they all share the same read-only packet,
+     * which each receiver copies (copy-on-write) before modifying it.
+     * Since the simulator does not support switching the context within an
+     * event, the receivers then run in the context of the sender.
+     *
      * @return Returns true unless the source was detached before it
      * completed its transmission.
      */
@@ -286,6 +296,18 @@ class CsmaChannel : public Channel
     Time GetDelay();
 
   private:
+    /**
+     * Deliver the current packet to several net devices from a single
+     * event, in fan-out mode.
+     *
+     * @param p the packet to deliver
+     * @param sender the net device which transmitted the packet
+     * @param receivers the net devices to deliver the packet to
+     */
+    void FanOutReceive(Ptr<const Packet> p,
+                       Ptr<CsmaNetDevice> sender,
+                       std::vector<Ptr<CsmaNetDevice>> receivers);
+
     /**
      * The assigned data rate of the channel
      */
@@ -296,6 +318,11 @@ class CsmaChannel : public Channel
      */
     Time m_delay;
 
+    /**
+     * Whether the receptions of a packet are delivered from a single event
+     */
+    bool m_fanOut;
+
     /**
      * List of the net devices that have been or are currently connected
      * to the channel.
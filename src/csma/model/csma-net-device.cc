@@ -826,6 +826,18 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
     }
 }
 
+bool
+CsmaNetDevice::WouldDiscard(Mac48Address destination) const
+{
+    NS_LOG_FUNCTION(this << destination);
+    if (destination.IsGroup() || destination == m_address)
+    {
+        return false;
+    }
+    return m_promiscRxCallback.IsNull() && !m_receiveErrorModel && m_phyRxEndTrace.IsEmpty() &&
+           m_phyRxDropTrace.IsEmpty() && m_promiscSnifferTrace.IsEmpty();
+}
+
 Ptr<Queue<Packet>>
 CsmaNetDevice::GetQueue() const
 {
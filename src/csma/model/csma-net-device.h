@@ -163,6 +163,19 @@ class CsmaNetDevice : public NetDevice
      */
     void Receive(Ptr<const Packet> p, Ptr<CsmaNetDevice> sender);
 
+    /**
+     * Would Receive() drop a frame without any observable effect?
+     *
+     * This is the case of a frame unicast to another device, when neither a
+     * promiscuous receive callback, a receive error model nor any of the
+     * traces fired for such a frame are in use.  The channel can then skip
+     * the reception event of this device altogether.
+     *
+     * @param destination the destination address of the frame
+     * @returns true if the frame can be discarded before it is received
+     */
+    bool WouldDiscard(Mac48Address destination) const;
+
     /**
      * Is the send side of the network device enabled?
      *
@@ -72,6 +72,7 @@ DsrMaintainBuffer::Enqueue(DsrMaintainBuffEntry& entry)
         m_maintainBuffer.erase(m_maintainBuffer.begin()); // Drop the most aged packet
     }
     m_maintainBuffer.push_back(entry);
+    m_nextExpiry = std::min(m_nextExpiry, Simulator::Now() + entry.GetExpireTime());
     return true;
 }
 
@@ -236,9 +237,18 @@ void
 DsrMaintainBuffer::Purge()
 {
     NS_LOG_DEBUG("Purging Maintenance Buffer");
+    if (Simulator::Now() <= m_nextExpiry)
+    {
+        return;
+    }
     IsExpired pred;
     m_maintainBuffer.erase(std::remove_if(m_maintainBuffer.begin(), m_maintainBuffer.end(), pred),
                            m_maintainBuffer.end());
+    m_nextExpiry = Time::Max();
+    for (const auto& entry : m_maintainBuffer)
+    {
+        m_nextExpiry = std::min(m_nextExpiry, Simulator::Now() + entry.GetExpireTime());
+    }
 }
 
 } // namespace dsr
@@ -412,6 +412,7 @@ class DsrMaintainBuffer
      * Default constructor
      */
     DsrMaintainBuffer()
+        : m_nextExpiry(Time::Max())
     {
     }
 
@@ -504,6 +505,8 @@ class DsrMaintainBuffer
     /// The maximum period of time that a routing protocol is allowed to buffer a packet for,
     /// seconds.
     Time m_maintainBufferTimeout;
+    /// No entry expires before this time, so Purge() has nothing to do
+    Time m_nextExpiry;
 };
 
 /*******************************************************************************************************************************/
@@ -34,6 +34,7 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <map>
 #include <vector>
@@ -307,61 +308,42 @@ void
 DsrRouteCache::RebuildBestRouteTable(Ipv4Address source)
 {
     NS_LOG_FUNCTION(this << source);
-    /**
-     * @brief The following are initialize-single-source
-     */
-    // @d shortest-path estimate
-    std::map<Ipv4Address, uint32_t> d;
-    // @pre preceding node
-    std::map<Ipv4Address, Ipv4Address> pre;
-    for (auto i = m_netGraph.begin(); i != m_netGraph.end(); ++i)
+    // clean the best route table
+    m_bestRoutesTree.clear();
+    m_bestRoutesSource = source;
+    auto first = std::lower_bound(m_graphNodes.begin(), m_graphNodes.end(), source);
+    if (first == m_graphNodes.end() || *first != source)
     {
-        if (i->second.find(source) != i->second.end())
-        {
-            d[i->first] = i->second[source];
-            pre[i->first] = source;
-        }
-        else
-        {
-            d[i->first] = MAXWEIGHT;
-            pre[i->first] = Ipv4Address("255.255.255.255");
-        }
+        NS_LOG_LOGIC("The source is not in the network graph");
+        return;
     }
-    d[source] = 0;
-    /**
-     * @brief The following is the core of Dijkstra algorithm
+
+    /*
+     * All the links have a weight of 1, so the nodes are reached in increasing distance from
+     * the source by a breadth-first search.  The nodes at the same distance are visited in
+     * decreasing address order, and a node reached through several nodes at the same
+     * distance keeps the first of them, unless a later one has a link with a longer
+     * expected lifetime.
      */
-    // the node set which shortest distance has been calculated, if true calculated
-    std::map<Ipv4Address, bool> s;
-    double temp = MAXWEIGHT;
-    Ipv4Address tempip("255.255.255.255");
-    for (uint32_t i = 0; i < m_netGraph.size(); i++)
+    const uint32_t unreached = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> distance(m_graphNodes.size(), unreached);
+    std::vector<uint32_t> pre(m_graphNodes.size(), unreached);
+    std::vector<uint32_t> current{static_cast<uint32_t>(first - m_graphNodes.begin())};
+    std::vector<uint32_t> next;
+    distance[current.front()] = 0;
+    while (!current.empty())
     {
-        temp = MAXWEIGHT;
-        for (auto j = d.begin(); j != d.end(); ++j)
-        {
-            Ipv4Address ip = j->first;
-            if (s.find(ip) == s.end())
-            {
-                /*
-                 * @brief The following are for comparison
-                 */
-                if (j->second <= temp)
-                {
-                    temp = j->second;
-                    tempip = ip;
-                }
-            }
-        }
-        if (!tempip.IsBroadcast())
+        std::sort(current.begin(), current.end(), std::greater<>());
+        next.clear();
+        for (uint32_t node : current)
         {
-            s[tempip] = true;
-            for (auto k = m_netGraph[tempip].begin(); k != m_netGraph[tempip].end(); ++k)
+            for (uint32_t neighbor : m_graphLinks[node])
             {
-                if (s.find(k->first) == s.end() && d[k->first] > d[tempip] + k->second)
+                if (distance[neighbor] == unreached)
                 {
-                    d[k->first] = d[tempip] + k->second;
-                    pre[k->first] = tempip;
+                    distance[neighbor] = distance[node] + 1;
+                    pre[neighbor] = node;
+                    next.push_back(neighbor);
                 }
                 /*
                  *  Selects the shortest-length route that has the longest expected lifetime
@@ -370,17 +352,18 @@ DsrRouteCache::RebuildBestRouteTable(Ipv4Address source)
                  *  Here I just implement kind of greedy strategy to select link with the longest
                  * expected lifetime when there is two options
                  */
-                else if (d[k->first] == d[tempip] + k->second)
+                else if (distance[neighbor] == distance[node] + 1)
                 {
-                    auto oldlink = m_linkCache.find(Link(k->first, pre[k->first]));
-                    auto newlink = m_linkCache.find(Link(k->first, tempip));
+                    auto oldlink =
+                        m_linkCache.find(Link(m_graphNodes[neighbor], m_graphNodes[pre[neighbor]]));
+                    auto newlink =
+                        m_linkCache.find(Link(m_graphNodes[neighbor], m_graphNodes[node]));
                     if (oldlink != m_linkCache.end() && newlink != m_linkCache.end())
                     {
                         if (oldlink->second.GetLinkStability() < newlink->second.GetLinkStability())
                         {
                             NS_LOG_INFO("Select the link with longest expected lifetime");
-                            d[k->first] = d[tempip] + k->second;
-                            pre[k->first] = tempip;
+                            pre[neighbor] = node;
                         }
                     }
                     else
@@ -390,30 +373,17 @@ DsrRouteCache::RebuildBestRouteTable(Ipv4Address source)
                 }
             }
         }
+        current.swap(next);
     }
-    // clean the best route table
-    m_bestRoutesTable_link.clear();
-    for (auto i = pre.begin(); i != pre.end(); ++i)
-    {
-        // loop for all vertices
-        DsrRouteCacheEntry::IP_VECTOR route;
-        Ipv4Address iptemp = i->first;
 
-        if (!i->second.IsBroadcast() && iptemp != source)
+    for (uint32_t i = 0; i < m_graphNodes.size(); i++)
+    {
+        if (pre[i] != unreached)
         {
-            while (iptemp != source)
-            {
-                route.push_back(iptemp);
-                iptemp = pre[iptemp];
-            }
-            route.push_back(source);
-            // Reverse the route
-            DsrRouteCacheEntry::IP_VECTOR reverseroute(route.rbegin(), route.rend());
-            NS_LOG_LOGIC("Add newly calculated best routes");
-            PrintVector(reverseroute);
-            m_bestRoutesTable_link[i->first] = reverseroute;
+            m_bestRoutesTree[m_graphNodes[i]] = m_graphNodes[pre[i]];
         }
     }
+    NS_LOG_LOGIC("Newly calculated best routes to " << m_bestRoutesTree.size() << " nodes");
 }
 
 bool
@@ -422,27 +392,38 @@ DsrRouteCache::LookupRoute_Link(Ipv4Address id, DsrRouteCacheEntry& rt)
     NS_LOG_FUNCTION(this << id);
     /// We need to purge the link node cache
     PurgeLinkNode();
-    auto i = m_bestRoutesTable_link.find(id);
-    if (i == m_bestRoutesTable_link.end())
+    auto i = m_bestRoutesTree.find(id);
+    if (i == m_bestRoutesTree.end())
     {
         NS_LOG_INFO("No route find to " << id);
         return false;
     }
 
-    if (i->second.size() < 2)
+    // Walk the tree back to the source, then reverse the route
+    DsrRouteCacheEntry::IP_VECTOR route{id};
+    while (i != m_bestRoutesTree.end())
+    {
+        route.push_back(i->second);
+        if (i->second == m_bestRoutesSource)
+        {
+            break;
+        }
+        i = m_bestRoutesTree.find(i->second);
+    }
+    if (route.back() != m_bestRoutesSource)
     {
         NS_LOG_LOGIC("Route to " << id << " error");
         return false;
     }
+    std::reverse(route.begin(), route.end());
 
     DsrRouteCacheEntry newEntry; // Create the route entry
-    newEntry.SetVector(i->second);
+    newEntry.SetVector(route);
     newEntry.SetDestination(id);
     newEntry.SetExpireTime(RouteCacheTimeout);
-    NS_LOG_INFO("Route to " << id << " found with the length " << i->second.size());
+    NS_LOG_INFO("Route to " << id << " found with the length " << route.size());
     rt = newEntry;
-    std::vector<Ipv4Address> path = rt.GetVector();
-    PrintVector(path);
+    PrintVector(route);
     return true;
 }
 
@@ -485,14 +466,29 @@ void
 DsrRouteCache::UpdateNetGraph()
 {
     NS_LOG_FUNCTION(this);
-    m_netGraph.clear();
+    m_graphNodes.clear();
+    for (auto i = m_linkCache.begin(); i != m_linkCache.end(); ++i)
+    {
+        m_graphNodes.push_back(i->first.m_low);
+        m_graphNodes.push_back(i->first.m_high);
+    }
+    std::sort(m_graphNodes.begin(), m_graphNodes.end());
+    m_graphNodes.erase(std::unique(m_graphNodes.begin(), m_graphNodes.end()), m_graphNodes.end());
+
+    std::unordered_map<Ipv4Address, uint32_t, Ipv4AddressHash> index;
+    for (uint32_t i = 0; i < m_graphNodes.size(); i++)
+    {
+        index[m_graphNodes[i]] = i;
+    }
+    m_graphLinks.assign(m_graphNodes.size(), {});
     for (auto i = m_linkCache.begin(); i != m_linkCache.end(); ++i)
     {
         // Here the weight is set as 1
         /// @todo May need to set different weight for different link here later
-        uint32_t weight = 1;
-        m_netGraph[i->first.m_low][i->first.m_high] = weight;
-        m_netGraph[i->first.m_high][i->first.m_low] = weight;
+        uint32_t low = index[i->first.m_low];
+        uint32_t high = index[i->first.m_high];
+        m_graphLinks[low].push_back(high);
+        m_graphLinks[high].push_back(low);
     }
 }
 
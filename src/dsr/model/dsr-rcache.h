@@ -43,6 +43,7 @@
 #include <map>
 #include <stdint.h>
 #include <sys/types.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -781,20 +782,20 @@ class DsrRouteCache : public Object
     bool m_isLinkCache; ///< Check if the route is using path cache or link cache
 
     bool m_subRoute; ///< Check if save the sub route entries or not
-/**
- * The link cache to update all the link status, bi-link is two link for link is a struct
- * when the weight is calculated we normalized them: 100*weight/max of Weight
- */
-#define MAXWEIGHT 0xFFFF;
     /**
-     * Current network graph state for this node, double is weight, which is calculated by the node
-     * information and link information, any time some changes of link cache and node cache change
-     * the weight and then recompute the best choice for each node
+     * Current network graph state for this node, built from the link cache, as adjacency
+     * arrays: any time the link cache changes, the graph is updated and the best route to each
+     * node is computed again.
      */
-    std::map<Ipv4Address, std::map<Ipv4Address, uint32_t>> m_netGraph;
+    std::vector<Ipv4Address> m_graphNodes;           ///< Addresses of the nodes, in order
+    std::vector<std::vector<uint32_t>> m_graphLinks; ///< Neighbors of each node, by index
 
-    std::map<Ipv4Address, DsrRouteCacheEntry::IP_VECTOR>
-        m_bestRoutesTable_link;                     ///< for link route cache
+    /**
+     * Best routes from m_bestRoutesSource, as a shortest-path tree: the preceding node on
+     * the best route to each reachable node.  The routes are read from the tree on lookup.
+     */
+    std::unordered_map<Ipv4Address, Ipv4Address, Ipv4AddressHash> m_bestRoutesTree;
+    Ipv4Address m_bestRoutesSource;                 ///< Source of the best routes
     std::map<Link, DsrLinkStab> m_linkCache;        ///< The data structure to store link info
     std::map<Ipv4Address, DsrNodeStab> m_nodeCache; ///< The data structure to store node info
     /**
@@ -819,9 +820,8 @@ class DsrRouteCache : public Object
 
   public:
     /**
-     * @brief Dijsktra algorithm to get the best route from m_netGraph and update the
-     * m_bestRoutesTable_link when current graph information has changed
-     * @param type The type of the cache
+     * @brief set the type of the cache
+     * @param type The type of the cache, "LinkCache" or "PathCache"
      */
     void SetCacheType(std::string type);
     /**
@@ -838,8 +838,11 @@ class DsrRouteCache : public Object
     bool AddRoute_Link(DsrRouteCacheEntry::IP_VECTOR nodelist, Ipv4Address node);
     /**
      * @brief Rebuild the best route table
-     * @note Use MAXWEIGHT to represent maximum weight, use the IPv4 broadcast
-     *       address of 255.255.255.255 to represent a null preceding address
+     *
+     * All the links have the same weight, so the shortest routes are found with a
+     * breadth-first search over the network graph.  Among the shortest routes, the one
+     * whose last link has the longest expected lifetime is preferred.
+     *
      * @param source The source address used for computing the routes
      */
     void RebuildBestRouteTable(Ipv4Address source);
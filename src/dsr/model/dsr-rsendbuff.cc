@@ -70,6 +70,7 @@ DsrSendBuffer::Enqueue(DsrSendBuffEntry& entry)
     }
     // enqueue the entry
     m_sendBuffer.push_back(entry);
+    m_nextExpiry = std::min(m_nextExpiry, Simulator::Now() + entry.GetExpireTime());
     return true;
 }
 
@@ -153,7 +154,12 @@ DsrSendBuffer::Purge()
      * Purge the buffer to eliminate expired entries
      */
     NS_LOG_INFO("The send buffer size " << m_sendBuffer.size());
+    if (Simulator::Now() <= m_nextExpiry)
+    {
+        return;
+    }
     IsExpired pred;
+    m_nextExpiry = Time::Max();
     for (auto i = m_sendBuffer.begin(); i != m_sendBuffer.end(); ++i)
     {
         if (pred(*i))
@@ -161,6 +167,10 @@ DsrSendBuffer::Purge()
             NS_LOG_DEBUG("Dropping Queue Packets");
             Drop(*i, "Drop out-dated packet ");
         }
+        else
+        {
+            m_nextExpiry = std::min(m_nextExpiry, Simulator::Now() + i->GetExpireTime());
+        }
     }
     m_sendBuffer.erase(std::remove_if(m_sendBuffer.begin(), m_sendBuffer.end(), pred),
                        m_sendBuffer.end());
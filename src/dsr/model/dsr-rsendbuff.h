@@ -161,6 +161,7 @@ class DsrSendBuffer
      * Default constructor
      */
     DsrSendBuffer()
+        : m_nextExpiry(Time::Max())
     {
     }
 
@@ -246,7 +247,8 @@ class DsrSendBuffer
     // \}
 
     /**
-     * Return a pointer to the internal queue
+     * Return a pointer to the internal queue.  It may only be used to
+     * look at or remove entries.
      *
      * @return a pointer to the internal queue
      */
@@ -268,6 +270,7 @@ class DsrSendBuffer
         m_maxLen; ///< The maximum number of packets that we allow a routing protocol to buffer.
     Time m_sendBufferTimeout; ///< The maximum period of time that a routing protocol is allowed to
                               ///< buffer a packet for, seconds.
+    Time m_nextExpiry;        ///< No entry expires before this time, so Purge() has nothing to do
 };
 
 /*******************************************************************************************************************************/
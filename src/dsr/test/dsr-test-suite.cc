@@ -573,6 +573,73 @@ DsrSendBuffTest::CheckTimeout()
     NS_TEST_EXPECT_MSG_EQ(q.GetSize(), 0, "Must be empty now");
 }
 
+// -----------------------------------------------------------------------------
+/**
+ * @ingroup dsr-test
+ * @ingroup tests
+ *
+ * @class DsrLinkCacheTest
+ * @brief Unit test for the best routes of the DSR link cache
+ */
+class DsrLinkCacheTest : public TestCase
+{
+  public:
+    DsrLinkCacheTest();
+    ~DsrLinkCacheTest() override;
+    void DoRun() override;
+};
+
+DsrLinkCacheTest::DsrLinkCacheTest()
+    : TestCase("DSR LinkCache")
+{
+}
+
+DsrLinkCacheTest::~DsrLinkCacheTest()
+{
+}
+
+void
+DsrLinkCacheTest::DoRun()
+{
+    Ptr<dsr::DsrRouteCache> rcache = CreateObject<dsr::DsrRouteCache>();
+    rcache->SetCacheType("LinkCache");
+    rcache->SetInitStability(Seconds(25));
+    rcache->SetMinLifeTime(Seconds(1));
+    rcache->SetUseExtends(Seconds(120));
+    NS_TEST_EXPECT_MSG_EQ(rcache->IsLinkCache(), true, "trivial");
+
+    Ipv4Address a("10.0.0.1");
+    Ipv4Address b("10.0.0.2");
+    Ipv4Address c("10.0.0.3");
+    Ipv4Address d("10.0.0.4");
+    Ipv4Address e("10.0.0.5");
+    dsr::DsrRouteCacheEntry entry;
+
+    rcache->AddRoute_Link({a, b, c, d}, a);
+    NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(d, entry), true, "Route to d not found");
+    std::vector<Ipv4Address> longRoute{a, b, c, d};
+    NS_TEST_EXPECT_MSG_EQ((entry.GetVector() == longRoute), true, "Wrong route to d");
+    NS_TEST_EXPECT_MSG_EQ(entry.GetDestination(), d, "Wrong destination");
+    NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(b, entry), true, "Route to b not found");
+    NS_TEST_EXPECT_MSG_EQ(entry.GetVector().size(), 2, "Wrong route to b");
+    NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(a, entry), false, "Route to the source");
+
+    // A shorter route replaces the longer one
+    rcache->AddRoute_Link({a, e, d}, a);
+    NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(d, entry), true, "Route to d not found");
+    std::vector<Ipv4Address> shortRoute{a, e, d};
+    NS_TEST_EXPECT_MSG_EQ((entry.GetVector() == shortRoute), true, "Shorter route not used");
+
+    // The longer route is used again once the shorter one is broken
+    rcache->DeleteAllRoutesIncludeLink(a, e, a);
+    NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(d, entry), true, "Route to d not found");
+    NS_TEST_EXPECT_MSG_EQ((entry.GetVector() == longRoute), true, "Longer route not used");
+
+    NS_TEST_EXPECT_MSG_EQ(rcache->LookupRoute(Ipv4Address("10.0.0.9"), entry),
+                          false,
+                          "Route to an unknown node");
+}
+
 // -----------------------------------------------------------------------------
 /**
  * @ingroup dsr-test
@@ -630,5 +697,6 @@ class DsrTestSuite : public TestSuite
         AddTestCase(new DsrAckHeaderTest, TestCase::Duration::QUICK);
         AddTestCase(new DsrCacheEntryTest, TestCase::Duration::QUICK);
         AddTestCase(new DsrSendBuffTest, TestCase::Duration::QUICK);
+        AddTestCase(new DsrLinkCacheTest, TestCase::Duration::QUICK);
     }
 } g_dsrTestSuite;
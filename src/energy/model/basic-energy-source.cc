@@ -9,6 +9,7 @@
 #include "basic-energy-source.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -59,6 +60,13 @@ BasicEnergySource::GetTypeId()
                           MakeTimeAccessor(&BasicEnergySource::SetEnergyUpdateInterval,
                                            &BasicEnergySource::GetEnergyUpdateInterval),
                           MakeTimeChecker())
+            .AddAttribute("LazyEnergyUpdate",
+                          "Whether to update the remaining energy only when the current changes "
+                          "and when a battery threshold is expected to be crossed, instead of "
+                          "periodically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&BasicEnergySource::m_lazyUpdate),
+                          MakeBooleanChecker())
             .AddTraceSource("RemainingEnergy",
                             "Remaining energy at BasicEnergySource.",
                             MakeTraceSourceAccessor(&BasicEnergySource::m_remainingEnergyJ),
@@ -71,6 +79,7 @@ BasicEnergySource::BasicEnergySource()
     NS_LOG_FUNCTION(this);
     m_lastUpdateTime = Seconds(0);
     m_depleted = false;
+    m_lazyUpdate = false;
 }
 
 BasicEnergySource::~BasicEnergySource()
@@ -166,7 +175,15 @@ BasicEnergySource::UpdateEnergySource()
         NotifyEnergyChanged();
     }
 
-    if (m_energyUpdateEvent.IsExpired())
+    if (m_lazyUpdate)
+    {
+        // The device energy models update the energy source before changing their
+        // current, hence the next update is scheduled once the current event is over.
+        m_energyUpdateEvent.Cancel();
+        m_energyUpdateEvent =
+            Simulator::ScheduleNow(&BasicEnergySource::ScheduleThresholdUpdate, this);
+    }
+    else if (m_energyUpdateEvent.IsExpired())
     {
         m_energyUpdateEvent = Simulator::Schedule(m_energyUpdateInterval,
                                                   &BasicEnergySource::UpdateEnergySource,
@@ -208,6 +225,37 @@ BasicEnergySource::HandleEnergyRechargedEvent()
     NotifyEnergyRecharged(); // notify DeviceEnergyModel objects
 }
 
+void
+BasicEnergySource::ScheduleThresholdUpdate()
+{
+    NS_LOG_FUNCTION(this);
+    double powerW = CalculateTotalCurrent() * m_supplyVoltageV;
+    double energyToThresholdJ;
+    if (!m_depleted && powerW > 0)
+    {
+        energyToThresholdJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    }
+    else if (m_depleted && powerW < 0)
+    {
+        energyToThresholdJ = m_highBatteryTh * m_initialEnergyJ - m_remainingEnergyJ;
+        powerW = -powerW;
+    }
+    else
+    {
+        NS_LOG_DEBUG("BasicEnergySource:No threshold to cross.");
+        return;
+    }
+
+    // round up, so that the threshold is crossed at the update
+    Time delay = Seconds(energyToThresholdJ / powerW);
+    if (delay.IsZero() || delay.GetSeconds() * powerW < energyToThresholdJ)
+    {
+        delay += TimeStep(1);
+    }
+    NS_LOG_DEBUG("BasicEnergySource:Threshold crossed in " << delay.As(Time::S));
+    m_energyUpdateEvent = Simulator::Schedule(delay, &BasicEnergySource::UpdateEnergySource, this);
+}
+
 void
 BasicEnergySource::CalculateRemainingEnergy()
 {
@@ -25,6 +25,12 @@ namespace energy
  * BasicEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * By default, the remaining energy is updated periodically, besides when the
+ * device energy models change state. In lazy update mode (the LazyEnergyUpdate
+ * attribute), there is no periodic update: since the current is constant
+ * between two state changes, the time at which the remaining energy crosses
+ * the low (or high) battery threshold is computed after each update, and a
+ * single event is scheduled at that time.
  */
 class BasicEnergySource : public EnergySource
 {
@@ -120,6 +126,14 @@ class BasicEnergySource : public EnergySource
      */
     void HandleEnergyRechargedEvent();
 
+    /**
+     * Schedules the next energy update at the time the remaining energy is
+     * expected to cross the low battery threshold (or the high battery
+     * threshold, when recharging) with the current drawn from the source.
+     * Used in lazy update mode.
+     */
+    void ScheduleThresholdUpdate();
+
     /**
      * Calculates remaining energy. This function uses the total current from all
      * device models to calculate the amount of energy to decrease. The energy to
@@ -144,6 +158,7 @@ class BasicEnergySource : public EnergySource
     EventId m_energyUpdateEvent;            //!< energy update event
     Time m_lastUpdateTime;                  //!< last update time
     Time m_energyUpdateInterval;            //!< energy update interval
+    bool m_lazyUpdate;                      //!< whether the periodic updates are disabled
 };
 
 } // namespace energy
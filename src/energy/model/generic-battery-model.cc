@@ -12,6 +12,7 @@
 #include "generic-battery-model.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -92,6 +93,12 @@ GenericBatteryModel::GetTypeId()
                           MakeTimeAccessor(&GenericBatteryModel::SetEnergyUpdateInterval,
                                            &GenericBatteryModel::GetEnergyUpdateInterval),
                           MakeTimeChecker())
+            .AddAttribute("LazyEnergyUpdate",
+                          "Whether to update the battery only when its current changes and when "
+                          "the cutoff voltage may be reached, instead of periodically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&GenericBatteryModel::m_lazyUpdate),
+                          MakeBooleanChecker())
             .AddAttribute("BatteryType",
                           "Indicates the battery type used by the model",
                           EnumValue(LION_LIPO),
@@ -114,7 +121,8 @@ GenericBatteryModel::GenericBatteryModel()
       m_currentFiltered(0),
       m_entn(0),
       m_expZone(0),
-      m_lastUpdateTime()
+      m_lastUpdateTime(),
+      m_lazyUpdate(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -216,8 +224,66 @@ GenericBatteryModel::UpdateEnergySource()
         //       or should it be allowed to continue charging (overcharge)?
     }
 
+    if (m_lazyUpdate)
+    {
+        // The device energy models update the energy source before changing their
+        // current, hence the next update is scheduled once the current event is over.
+        m_energyUpdateEvent =
+            Simulator::ScheduleNow(&GenericBatteryModel::ScheduleThresholdUpdate, this);
+    }
+    else
+    {
+        m_energyUpdateEvent = Simulator::Schedule(m_energyUpdateInterval,
+                                                  &GenericBatteryModel::UpdateEnergySource,
+                                                  this);
+    }
+}
+
+void
+GenericBatteryModel::ScheduleThresholdUpdate()
+{
+    NS_LOG_FUNCTION(this);
+
+    double totalCurrentA = CalculateTotalCurrent();
+    if (totalCurrentA == 0 || m_supplyVoltageV <= m_cutoffVoltage)
+    {
+        NS_LOG_DEBUG("GenericBatteryModel:No threshold to reach.");
+        return;
+    }
+
+    Time delay = m_energyUpdateInterval;
+    if (totalCurrentA > 0 &&
+        GetVoltageLowerBound(totalCurrentA, m_drainedCapacity) > m_cutoffVoltage)
+    {
+        // the lower bound of the voltage decreases with the drained capacity
+        double low = m_drainedCapacity;
+        double high = m_qMax;
+        for (int i = 0; i < 64; i++)
+        {
+            double mid = (low + high) / 2;
+            if (GetVoltageLowerBound(totalCurrentA, mid) > m_cutoffVoltage)
+            {
+                low = mid;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        Time cutoffDelay = Hours((low - m_drainedCapacity) / totalCurrentA);
+        if (m_batteryType == LION_LIPO || cutoffDelay < delay)
+        {
+            delay = cutoffDelay;
+        }
+    }
+    if (delay.IsZero())
+    {
+        delay = TimeStep(1);
+    }
+
+    NS_LOG_DEBUG("GenericBatteryModel:Next update in " << delay.As(Time::S));
     m_energyUpdateEvent =
-        Simulator::Schedule(m_energyUpdateInterval, &GenericBatteryModel::UpdateEnergySource, this);
+        Simulator::Schedule(delay, &GenericBatteryModel::UpdateEnergySource, this);
 }
 
 void
@@ -363,6 +429,28 @@ GenericBatteryModel::GetChargeVoltage(double i)
     return V;
 }
 
+double
+GenericBatteryModel::GetVoltageLowerBound(double current, double drainedCapacity) const
+{
+    double A = m_vFull - m_vExp;
+    double B = 3 / m_qExp;
+    double E0 = m_vFull + m_internalResistance * m_typicalCurrent - A;
+    double expZoneFull = A * std::exp(-B * m_qNom);
+    double K = (E0 - m_vNom - (m_internalResistance * m_typicalCurrent) + expZoneFull) /
+               (m_qMax / (m_qMax - m_qNom) * (m_qNom + m_typicalCurrent));
+    double polResistance = K * (m_qMax / (m_qMax - drainedCapacity));
+
+    // the filtered current does not exceed the current, and the exponential zone of the
+    // chemistries other than Li-Ion is positive
+    double expZone = 0;
+    if (m_batteryType == LION_LIPO)
+    {
+        expZone = A * std::exp(-B * drainedCapacity);
+    }
+    return E0 - (m_internalResistance * current) - (polResistance * current) -
+           (polResistance * drainedCapacity) + expZone;
+}
+
 double
 GenericBatteryModel::GetVoltage(double i)
 {
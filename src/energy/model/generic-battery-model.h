@@ -139,6 +139,15 @@ static BatteryPresets g_batteryPreset[] = {{NIMH_NICD,
  *
  * The generic battery model can be used to describe the discharge behavior of
  * the battery chemestries supported by the model.
+ *
+ * In lazy update mode (the LazyEnergyUpdate attribute), the battery is not
+ * updated periodically while its current is constant. After each update of a
+ * discharging Li-Ion battery, the next one is scheduled when the drained
+ * capacity reaches the value at which a lower bound of the voltage (the one
+ * with the filtered current equal to the current) reaches the cutoff voltage.
+ * The exponential zone of the other chemistries is integrated at each update,
+ * hence their updates are not spaced more than PeriodicEnergyUpdateInterval
+ * apart, as are the updates of a charging battery.
  */
 class GenericBatteryModel : public EnergySource
 {
@@ -274,6 +283,23 @@ class GenericBatteryModel : public EnergySource
      */
     double GetChargeVoltage(double current);
 
+    /**
+     *  Get a lower bound of the battery voltage for a given discharge current
+     *  and drained capacity, whatever the filtered current.
+     *
+     *  @param current The discharge current value (+i).
+     *  @param drainedCapacity The drained capacity, in Ah.
+     *  @return The lower bound of the voltage of the battery.
+     */
+    double GetVoltageLowerBound(double current, double drainedCapacity) const;
+
+    /**
+     * Schedules the next energy update at the time the battery voltage may
+     * reach the cutoff voltage with the current drawn from the battery. Used in
+     * lazy update mode.
+     */
+    void ScheduleThresholdUpdate();
+
   private:
     TracedValue<double> m_remainingEnergyJ; //!< Remaining energy, in Joules
     double m_drainedCapacity;               //!< Capacity drained from the battery, in Ah
@@ -288,6 +314,7 @@ class GenericBatteryModel : public EnergySource
     EventId m_energyUpdateEvent;  //!< Energy update event
     Time m_lastUpdateTime;        //!< Last update time
     Time m_energyUpdateInterval;  //!< Energy update interval
+    bool m_lazyUpdate;            //!< Whether the periodic updates are disabled
     double m_vFull;               //!< Initial voltage of the battery, in Volts
     double m_vNom;                //!< Nominal voltage of the battery, in Volts
     double m_vExp;                //!< Battery voltage at the end of the exponential zone, in Volts
@@ -9,6 +9,7 @@
 #include "rv-battery-model.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -39,6 +40,12 @@ RvBatteryModel::GetTypeId()
                           MakeTimeAccessor(&RvBatteryModel::SetSamplingInterval,
                                            &RvBatteryModel::GetSamplingInterval),
                           MakeTimeChecker())
+            .AddAttribute("RvBatteryModelLazyEnergyUpdate",
+                          "Whether to sample the load only when it changes and when the low "
+                          "battery threshold may be reached, instead of periodically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RvBatteryModel::m_lazyUpdate),
+                          MakeBooleanChecker())
             .AddAttribute("RvBatteryModelLowBatteryThreshold",
                           "Low battery threshold.",
                           DoubleValue(0.10), // as a fraction of the initial energy
@@ -91,6 +98,7 @@ RvBatteryModel::RvBatteryModel()
     m_previousLoad = -1.0;
     m_batteryLevel = 1; // fully charged
     m_lifetime = Seconds(0);
+    m_lazyUpdate = false;
 }
 
 RvBatteryModel::~RvBatteryModel()
@@ -173,8 +181,18 @@ RvBatteryModel::UpdateEnergySource()
 
     m_previousLoad = currentLoad;
     m_lastSampleTime = Simulator::Now();
-    m_currentSampleEvent =
-        Simulator::Schedule(m_samplingInterval, &RvBatteryModel::UpdateEnergySource, this);
+    if (m_lazyUpdate)
+    {
+        // The device energy models update the energy source before changing their
+        // current, hence the next update is scheduled once the current event is over.
+        m_currentSampleEvent =
+            Simulator::ScheduleNow(&RvBatteryModel::ScheduleThresholdUpdate, this);
+    }
+    else
+    {
+        m_currentSampleEvent =
+            Simulator::Schedule(m_samplingInterval, &RvBatteryModel::UpdateEnergySource, this);
+    }
 }
 
 void
@@ -370,5 +388,42 @@ RvBatteryModel::RvModelAFunction(Time t, Time sk, Time sk_1, double beta)
     return delta + 2 * sum;
 }
 
+void
+RvBatteryModel::ScheduleThresholdUpdate()
+{
+    NS_LOG_FUNCTION(this);
+
+    double load = CalculateTotalCurrent() * 1000; // must be in mA
+    if (load <= 0 || m_batteryLevel <= m_lowBatteryTh)
+    {
+        NS_LOG_DEBUG("RvBatteryModel:No threshold to reach.");
+        return;
+    }
+
+    // start of the current load segment
+    Time segmentStart = m_lastSampleTime;
+    if (load == m_previousLoad && m_timeStamps.size() > 1)
+    {
+        segmentStart = m_timeStamps[m_timeStamps.size() - 2];
+    }
+
+    // maximum rate of the calculated alpha, per minute
+    double elapsed = (Simulator::Now() - segmentStart).GetMinutes();
+    double rate = 1;
+    for (int m = 1; m <= m_numOfTerms; m++)
+    {
+        rate += 2 * std::exp(-m_beta * m_beta * m * m * elapsed);
+    }
+    rate *= load;
+
+    Time delay = Minutes((m_batteryLevel - m_lowBatteryTh) * m_alpha / rate);
+    if (delay.IsZero())
+    {
+        delay = TimeStep(1);
+    }
+    NS_LOG_DEBUG("RvBatteryModel:Next update in " << delay.As(Time::S));
+    m_currentSampleEvent = Simulator::Schedule(delay, &RvBatteryModel::UpdateEnergySource, this);
+}
+
 } // namespace energy
 } // namespace ns3
@@ -38,6 +38,12 @@ namespace energy
  * battery effects". The real-time algorithm is modified by the authors of this
  * code for improved accuracy and reduced computation (sampling) overhead.
  *
+ * In lazy update mode (the RvBatteryModelLazyEnergyUpdate attribute), the load
+ * is not sampled periodically but only when it changes. After each update, the
+ * next one is scheduled at the earliest time the battery level can reach the
+ * low battery threshold with the current load: the calculated alpha grows at
+ * most at the rate of the current load segment at its start, since the rate
+ * of the segment decreases with time and the past segments can only recover.
  */
 class RvBatteryModel : public EnergySource
 {
@@ -211,6 +217,13 @@ class RvBatteryModel : public EnergySource
      */
     double RvModelAFunction(Time t, Time sk, Time sk_1, double beta);
 
+    /**
+     * Schedules the next update at the earliest time the battery level can
+     * reach the low battery threshold with the current load. Used in lazy
+     * update mode.
+     */
+    void ScheduleThresholdUpdate();
+
   private:
     double m_openCircuitVoltage; //!< Open circuit voltage (in Volts)
     double m_cutoffVoltage;      //!< Cutoff voltage (in Volts)
@@ -250,6 +263,7 @@ class RvBatteryModel : public EnergySource
      */
     Time m_samplingInterval;
     EventId m_currentSampleEvent; //!< Current sample event
+    bool m_lazyUpdate;            //!< whether the periodic sampling is disabled
 
     TracedValue<Time> m_lifetime; //!< time of death of the battery
 };
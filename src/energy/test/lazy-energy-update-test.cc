@@ -0,0 +1,261 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/basic-energy-source.h"
+#include "ns3/boolean.h"
+#include "ns3/device-energy-model.h"
+#include "ns3/double.h"
+#include "ns3/generic-battery-model.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/rv-battery-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+using namespace ns3::energy;
+
+NS_LOG_COMPONENT_DEFINE("LazyEnergyUpdateTestSuite");
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Device energy model drawing a given current, which updates its
+ * energy source before changing its current, as the radio energy models do,
+ * and is switched off when the energy source is depleted.
+ */
+class ConstantCurrentEnergyModel : public DeviceEnergyModel
+{
+  public:
+    void SetEnergySource(Ptr<EnergySource> source) override
+    {
+        m_source = source;
+    }
+
+    double GetTotalEnergyConsumption() const override
+    {
+        return 0;
+    }
+
+    void ChangeState(int newState) override
+    {
+    }
+
+    void HandleEnergyDepletion() override
+    {
+        if (m_depletionTime.IsNegative())
+        {
+            m_depletionTime = Simulator::Now();
+        }
+        // the energy source has just been updated
+        m_currentA = 0;
+    }
+
+    void HandleEnergyRecharged() override
+    {
+    }
+
+    void HandleEnergyChanged() override
+    {
+    }
+
+    /**
+     * Set the current drawn from the energy source.
+     * @param currentA the current, in Amperes
+     */
+    void SetCurrentA(double currentA)
+    {
+        m_source->UpdateEnergySource();
+        m_currentA = currentA;
+    }
+
+    /**
+     * @return the time the energy source notified its depletion, or a negative time
+     */
+    Time GetDepletionTime() const
+    {
+        return m_depletionTime;
+    }
+
+  protected:
+    void DoDispose() override
+    {
+        m_source = nullptr;
+    }
+
+  private:
+    double DoGetCurrentA() const override
+    {
+        return m_currentA;
+    }
+
+    Ptr<EnergySource> m_source; //!< the energy source
+    double m_currentA{0};       //!< the current drawn
+    Time m_depletionTime{-1};   //!< the time of the first depletion notification
+};
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Lazy energy update test.
+ *
+ * Draws a current from an energy source, and a larger current from a given
+ * time, and checks that the energy source notifies its depletion at the same
+ * time with periodic and with lazy updates, the latter with a few events.
+ * The periodic updates notify the depletion up to an update interval late.
+ */
+class LazyEnergyUpdateTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param typeId the type of the energy source
+     * @param lazyAttribute the name of the attribute enabling the lazy update mode
+     * @param firstCurrentA the first current, in Amperes
+     * @param secondCurrentA the second current, in Amperes
+     * @param changeTime the time the second current is drawn from
+     * @param stopTime the duration of the simulation
+     * @param expected the expected depletion time, if known, or a negative time
+     */
+    LazyEnergyUpdateTestCase(std::string typeId,
+                             std::string lazyAttribute,
+                             double firstCurrentA,
+                             double secondCurrentA,
+                             Time changeTime,
+                             Time stopTime,
+                             Time expected);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the simulation.
+     * @param lazy whether to enable the lazy update mode
+     * @param events the number of events executed
+     * @return the time the energy source notified its depletion
+     */
+    Time Run(bool lazy, uint64_t& events);
+
+    std::string m_typeId;        //!< the type of the energy source
+    std::string m_lazyAttribute; //!< the name of the attribute enabling the lazy update mode
+    double m_firstCurrentA;      //!< the first current
+    double m_secondCurrentA;     //!< the second current
+    Time m_changeTime;           //!< the time the second current is drawn from
+    Time m_stopTime;             //!< the duration of the simulation
+    Time m_expected;             //!< the expected depletion time
+};
+
+LazyEnergyUpdateTestCase::LazyEnergyUpdateTestCase(std::string typeId,
+                                                   std::string lazyAttribute,
+                                                   double firstCurrentA,
+                                                   double secondCurrentA,
+                                                   Time changeTime,
+                                                   Time stopTime,
+                                                   Time expected)
+    : TestCase("Lazy update of " + typeId),
+      m_typeId(typeId),
+      m_lazyAttribute(lazyAttribute),
+      m_firstCurrentA(firstCurrentA),
+      m_secondCurrentA(secondCurrentA),
+      m_changeTime(changeTime),
+      m_stopTime(stopTime),
+      m_expected(expected)
+{
+}
+
+Time
+LazyEnergyUpdateTestCase::Run(bool lazy, uint64_t& events)
+{
+    Ptr<Node> node = CreateObject<Node>();
+    ObjectFactory factory(m_typeId);
+    factory.Set(m_lazyAttribute, BooleanValue(lazy));
+    Ptr<EnergySource> source = factory.Create<EnergySource>();
+    source->SetNode(node);
+    node->AggregateObject(source);
+
+    Ptr<ConstantCurrentEnergyModel> model = CreateObject<ConstantCurrentEnergyModel>();
+    model->SetEnergySource(source);
+    source->AppendDeviceEnergyModel(model);
+
+    Simulator::Schedule(Seconds(0),
+                        &ConstantCurrentEnergyModel::SetCurrentA,
+                        model,
+                        m_firstCurrentA);
+    Simulator::Schedule(m_changeTime,
+                        &ConstantCurrentEnergyModel::SetCurrentA,
+                        model,
+                        m_secondCurrentA);
+    Simulator::Stop(m_stopTime);
+    Simulator::Run();
+    events = Simulator::GetEventCount();
+    Time depletionTime = model->GetDepletionTime();
+    Simulator::Destroy();
+    return depletionTime;
+}
+
+void
+LazyEnergyUpdateTestCase::DoRun()
+{
+    uint64_t periodicEvents;
+    Time periodic = Run(false, periodicEvents);
+    uint64_t lazyEvents;
+    Time lazy = Run(true, lazyEvents);
+    NS_LOG_DEBUG("Depleted at " << periodic.As(Time::S) << " with " << periodicEvents
+                                << " events, at " << lazy.As(Time::S) << " with " << lazyEvents
+                                << " lazy events");
+
+    NS_TEST_ASSERT_MSG_EQ(periodic.IsStrictlyPositive(), true, "The source is not depleted");
+    NS_TEST_ASSERT_MSG_EQ(lazy.IsStrictlyPositive(), true, "The lazy source is not depleted");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(periodic, lazy, "Late depletion with lazy updates");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(periodic, lazy + Seconds(1), "Early depletion with lazy updates");
+    if (m_expected.IsPositive())
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(lazy, m_expected, NanoSeconds(1), "Wrong depletion time");
+    }
+    NS_TEST_EXPECT_MSG_LT(lazyEvents, 50U, "Too many events with lazy updates");
+}
+
+/**
+ * @ingroup energy-tests
+ *
+ * @brief Lazy energy update TestSuite
+ */
+class LazyEnergyUpdateTestSuite : public TestSuite
+{
+  public:
+    LazyEnergyUpdateTestSuite();
+};
+
+LazyEnergyUpdateTestSuite::LazyEnergyUpdateTestSuite()
+    : TestSuite("lazy-energy-update", Type::UNIT)
+{
+    // 10 J at 3 V: 3 J drawn in 100 s, the remaining 6 J to the threshold in 100 s
+    AddTestCase(new LazyEnergyUpdateTestCase("ns3::energy::BasicEnergySource",
+                                             "LazyEnergyUpdate",
+                                             0.01,
+                                             0.02,
+                                             Seconds(100),
+                                             Seconds(300),
+                                             Seconds(200)),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LazyEnergyUpdateTestCase("ns3::energy::RvBatteryModel",
+                                             "RvBatteryModelLazyEnergyUpdate",
+                                             0.2,
+                                             0.5,
+                                             Seconds(1000.5),
+                                             Seconds(6000),
+                                             Seconds(-1)),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LazyEnergyUpdateTestCase("ns3::energy::GenericBatteryModel",
+                                             "LazyEnergyUpdate",
+                                             1,
+                                             2.33,
+                                             Seconds(600.5),
+                                             Seconds(4000),
+                                             Seconds(-1)),
+                TestCase::Duration::QUICK);
+}
+
+/// create an instance of the test suite
+static LazyEnergyUpdateTestSuite g_lazyEnergyUpdateTestSuite;
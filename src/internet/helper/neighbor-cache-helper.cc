@@ -65,6 +65,21 @@ NeighborCacheHelper::PopulateNeighborCache(Ptr<Channel> channel) const
             ipv6InterfaceIndex = node->GetObject<Ipv6>()->GetInterfaceForDevice(netDevice);
         }
 
+        if (m_sharedNeighborCache)
+        {
+            if (ipv4InterfaceIndex != -1)
+            {
+                AttachSharedTable(
+                    node->GetObject<Ipv4L3Protocol>()->GetInterface(ipv4InterfaceIndex));
+            }
+            if (ipv6InterfaceIndex != -1)
+            {
+                AttachSharedTable(
+                    node->GetObject<Ipv6L3Protocol>()->GetInterface(ipv6InterfaceIndex));
+            }
+            continue;
+        }
+
         for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
         {
             Ptr<NetDevice> neighborDevice = channel->GetDevice(j);
@@ -135,6 +150,21 @@ NeighborCacheHelper::PopulateNeighborCache(const NetDeviceContainer& c) const
             ipv6InterfaceIndex = node->GetObject<Ipv6>()->GetInterfaceForDevice(netDevice);
         }
 
+        if (m_sharedNeighborCache)
+        {
+            if (ipv4InterfaceIndex != -1)
+            {
+                AttachSharedTable(
+                    node->GetObject<Ipv4L3Protocol>()->GetInterface(ipv4InterfaceIndex));
+            }
+            if (ipv6InterfaceIndex != -1)
+            {
+                AttachSharedTable(
+                    node->GetObject<Ipv6L3Protocol>()->GetInterface(ipv6InterfaceIndex));
+            }
+            continue;
+        }
+
         for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
         {
             Ptr<NetDevice> neighborDevice = channel->GetDevice(j);
@@ -194,7 +224,11 @@ NeighborCacheHelper::PopulateNeighborCache(const Ipv4InterfaceContainer& c) cons
         Ptr<Ipv4> ipv4 = returnValue.first;
         uint32_t index = returnValue.second;
         Ptr<Ipv4Interface> ipv4Interface = DynamicCast<Ipv4L3Protocol>(ipv4)->GetInterface(index);
-        if (ipv4Interface)
+        if (ipv4Interface && m_sharedNeighborCache)
+        {
+            AttachSharedTable(ipv4Interface);
+        }
+        else if (ipv4Interface)
         {
             Ptr<NetDevice> netDevice = ipv4Interface->GetDevice();
             Ptr<Channel> channel = netDevice->GetChannel();
@@ -229,7 +263,11 @@ NeighborCacheHelper::PopulateNeighborCache(const Ipv6InterfaceContainer& c) cons
         Ptr<Ipv6> ipv6 = returnValue.first;
         uint32_t index = returnValue.second;
         Ptr<Ipv6Interface> ipv6Interface = DynamicCast<Ipv6L3Protocol>(ipv6)->GetInterface(index);
-        if (ipv6Interface)
+        if (ipv6Interface && m_sharedNeighborCache)
+        {
+            AttachSharedTable(ipv6Interface);
+        }
+        else if (ipv6Interface)
         {
             Ptr<NetDevice> netDevice = ipv6Interface->GetDevice();
             Ptr<Channel> channel = netDevice->GetChannel();
@@ -343,6 +381,131 @@ NeighborCacheHelper::PopulateNeighborEntriesIpv6(Ptr<Ipv6Interface> ipv6Interfac
     }
 }
 
+void
+NeighborCacheHelper::AttachSharedTable(Ptr<Ipv4Interface> ipv4Interface) const
+{
+    NS_LOG_FUNCTION(this << ipv4Interface);
+    Ptr<ArpCache> arpCache = ipv4Interface->GetArpCache();
+    if (!arpCache)
+    {
+        NS_LOG_LOGIC(
+            "ArpCache doesn't exist, might be a point-to-point NetDevice without ArpCache");
+        return;
+    }
+    if (m_dynamicNeighborCache)
+    {
+        ipv4Interface->RemoveAddressCallback(
+            MakeCallback(&NeighborCacheHelper::UpdateCacheByIpv4AddressRemoved, this));
+        if (m_globalNeighborCache)
+        {
+            ipv4Interface->AddAddressCallback(
+                MakeCallback(&NeighborCacheHelper::UpdateCacheByIpv4AddressAdded, this));
+        }
+    }
+    arpCache->SetSharedTable(GetArpTable(ipv4Interface->GetDevice()->GetChannel()));
+}
+
+void
+NeighborCacheHelper::AttachSharedTable(Ptr<Ipv6Interface> ipv6Interface) const
+{
+    NS_LOG_FUNCTION(this << ipv6Interface);
+    Ptr<NdiscCache> ndiscCache = ipv6Interface->GetNdiscCache();
+    if (!ndiscCache)
+    {
+        NS_LOG_LOGIC(
+            "NdiscCache doesn't exist, might be a point-to-point NetDevice without NdiscCache");
+        return;
+    }
+    if (m_dynamicNeighborCache)
+    {
+        ipv6Interface->RemoveAddressCallback(
+            MakeCallback(&NeighborCacheHelper::UpdateCacheByIpv6AddressRemoved, this));
+        if (m_globalNeighborCache)
+        {
+            ipv6Interface->AddAddressCallback(
+                MakeCallback(&NeighborCacheHelper::UpdateCacheByIpv6AddressAdded, this));
+        }
+    }
+    ndiscCache->SetSharedTable(GetNdiscTable(ipv6Interface->GetDevice()->GetChannel()));
+}
+
+Ptr<ArpCache::SharedTable>
+NeighborCacheHelper::GetArpTable(Ptr<Channel> channel) const
+{
+    NS_LOG_FUNCTION(this << channel);
+    Ptr<ArpCache::SharedTable>& table = m_arpTables[channel->GetId()];
+    if (table)
+    {
+        return table;
+    }
+    table = Create<ArpCache::SharedTable>();
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        Ptr<NetDevice> device = channel->GetDevice(i);
+        Ptr<Ipv4L3Protocol> ipv4 = device->GetNode()->GetObject<Ipv4L3Protocol>();
+        if (!ipv4)
+        {
+            continue;
+        }
+        int32_t interfaceIndex = ipv4->GetInterfaceForDevice(device);
+        if (interfaceIndex == -1)
+        {
+            continue;
+        }
+        Ptr<Ipv4Interface> ipv4Interface = ipv4->GetInterface(interfaceIndex);
+        for (uint32_t n = 0; n < ipv4Interface->GetNAddresses(); ++n)
+        {
+            table->Add(ipv4Interface->GetAddress(n).GetLocal(), device->GetAddress());
+        }
+    }
+    return table;
+}
+
+Ptr<NdiscCache::SharedTable>
+NeighborCacheHelper::GetNdiscTable(Ptr<Channel> channel) const
+{
+    NS_LOG_FUNCTION(this << channel);
+    Ptr<NdiscCache::SharedTable>& table = m_ndiscTables[channel->GetId()];
+    if (table)
+    {
+        return table;
+    }
+    table = Create<NdiscCache::SharedTable>();
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        Ptr<NetDevice> device = channel->GetDevice(i);
+        Ptr<Ipv6L3Protocol> ipv6 = device->GetNode()->GetObject<Ipv6L3Protocol>();
+        if (!ipv6)
+        {
+            continue;
+        }
+        int32_t interfaceIndex = ipv6->GetInterfaceForDevice(device);
+        if (interfaceIndex == -1)
+        {
+            continue;
+        }
+        Ptr<Ipv6Interface> ipv6Interface = ipv6->GetInterface(interfaceIndex);
+        bool global = false;
+        for (uint32_t n = 0; n < ipv6Interface->GetNAddresses(); ++n)
+        {
+            Ipv6InterfaceAddress ifAddr = ipv6Interface->GetAddress(n);
+            if (ifAddr.GetScope() == Ipv6InterfaceAddress::LINKLOCAL ||
+                ifAddr.GetScope() == Ipv6InterfaceAddress::HOST)
+            {
+                continue;
+            }
+            table->Add(ifAddr.GetAddress(), device->GetAddress());
+            global = true;
+        }
+        // The link-local address is only added along with a global address
+        if (global)
+        {
+            table->Add(ipv6Interface->GetLinkLocalAddress().GetAddress(), device->GetAddress());
+        }
+    }
+    return table;
+}
+
 void
 NeighborCacheHelper::AddEntry(Ptr<Ipv4Interface> netDeviceInterface,
                               Ipv4Address ipv4Address,
@@ -393,6 +556,8 @@ void
 NeighborCacheHelper::FlushAutoGenerated() const
 {
     NS_LOG_FUNCTION(this);
+    m_arpTables.clear();
+    m_ndiscTables.clear();
     for (uint32_t i = 0; i < NodeList::GetNNodes(); ++i)
     {
         Ptr<Node> node = NodeList::GetNode(i);
@@ -434,6 +599,12 @@ NeighborCacheHelper::UpdateCacheByIpv4AddressRemoved(const Ptr<Ipv4Interface> in
     NS_LOG_FUNCTION(this);
     Ptr<NetDevice> netDevice = interface->GetDevice();
     Ptr<Channel> channel = netDevice->GetChannel();
+    auto table = m_arpTables.find(channel->GetId());
+    if (table != m_arpTables.end())
+    {
+        table->second->Remove(ifAddr.GetLocal());
+    }
+    // Remove the entries of the caches, including the ones made out of the table
     for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
     {
         Ptr<NetDevice> neighborDevice = channel->GetDevice(i);
@@ -466,6 +637,13 @@ NeighborCacheHelper::UpdateCacheByIpv4AddressAdded(const Ptr<Ipv4Interface> inte
     NS_LOG_FUNCTION(this);
     Ptr<NetDevice> netDevice = interface->GetDevice();
     Ptr<Channel> channel = netDevice->GetChannel();
+    Ptr<ArpCache::SharedTable> table;
+    auto it = m_arpTables.find(channel->GetId());
+    if (it != m_arpTables.end())
+    {
+        table = it->second;
+        table->Add(ifAddr.GetLocal(), netDevice->GetAddress());
+    }
     for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
     {
         Ptr<NetDevice> neighborDevice = channel->GetDevice(i);
@@ -478,6 +656,12 @@ NeighborCacheHelper::UpdateCacheByIpv4AddressAdded(const Ptr<Ipv4Interface> inte
             {
                 Ptr<Ipv4Interface> neighborInterface =
                     neighborNode->GetObject<Ipv4L3Protocol>()->GetInterface(neighborInterfaceIndex);
+                Ptr<ArpCache> arpCache = neighborInterface->GetArpCache();
+                if (table && arpCache && arpCache->GetSharedTable() == table)
+                {
+                    // The neighbor sees the new binding through the table
+                    continue;
+                }
                 uint32_t neighborDeviceAddresses = neighborInterface->GetNAddresses();
                 for (uint32_t m = 0; m < neighborDeviceAddresses; ++m)
                 {
@@ -500,6 +684,12 @@ NeighborCacheHelper::UpdateCacheByIpv6AddressRemoved(const Ptr<Ipv6Interface> in
     NS_LOG_FUNCTION(this);
     Ptr<NetDevice> netDevice = interface->GetDevice();
     Ptr<Channel> channel = netDevice->GetChannel();
+    auto table = m_ndiscTables.find(channel->GetId());
+    if (table != m_ndiscTables.end())
+    {
+        table->second->Remove(ifAddr.GetAddress());
+    }
+    // Remove the entries of the caches, including the ones made out of the table
     for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
     {
         Ptr<NetDevice> neighborDevice = channel->GetDevice(i);
@@ -532,6 +722,14 @@ NeighborCacheHelper::UpdateCacheByIpv6AddressAdded(const Ptr<Ipv6Interface> inte
     NS_LOG_FUNCTION(this);
     Ptr<NetDevice> netDevice = interface->GetDevice();
     Ptr<Channel> channel = netDevice->GetChannel();
+    Ptr<NdiscCache::SharedTable> table;
+    auto it = m_ndiscTables.find(channel->GetId());
+    if (it != m_ndiscTables.end())
+    {
+        table = it->second;
+        table->Add(ifAddr.GetAddress(), netDevice->GetAddress());
+        table->Add(interface->GetLinkLocalAddress().GetAddress(), netDevice->GetAddress());
+    }
     for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
     {
         Ptr<NetDevice> neighborDevice = channel->GetDevice(i);
@@ -544,6 +742,12 @@ NeighborCacheHelper::UpdateCacheByIpv6AddressAdded(const Ptr<Ipv6Interface> inte
             {
                 Ptr<Ipv6Interface> neighborInterface =
                     neighborNode->GetObject<Ipv6L3Protocol>()->GetInterface(neighborInterfaceIndex);
+                Ptr<NdiscCache> ndiscCache = neighborInterface->GetNdiscCache();
+                if (table && ndiscCache && ndiscCache->GetSharedTable() == table)
+                {
+                    // The neighbor sees the new binding through the table
+                    continue;
+                }
                 uint32_t neighborDeviceAddresses = neighborInterface->GetNAddresses();
                 for (uint32_t m = 0; m < neighborDeviceAddresses; ++m)
                 {
@@ -566,4 +770,11 @@ NeighborCacheHelper::SetDynamicNeighborCache(bool enable)
     m_dynamicNeighborCache = enable;
 }
 
+void
+NeighborCacheHelper::SetSharedNeighborCache(bool enable)
+{
+    NS_LOG_FUNCTION(this << enable);
+    m_sharedNeighborCache = enable;
+}
+
 } // namespace ns3
@@ -22,9 +22,12 @@
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv6-interface.h"
 #include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ndisc-cache.h"
 #include "ns3/net-device-container.h"
 #include "ns3/node-list.h"
 
+#include <unordered_map>
+
 namespace ns3
 {
 
@@ -35,6 +38,11 @@ namespace ns3
  *
  * This class is used to populate neighbor cache. Permanent entries will be added
  * on the scope of a channel, a NetDeviceContainer, an InterfaceContainer or globally.
+ *
+ * By default, each populated interface gets one entry per neighbor, which
+ * takes O(N^2) memory on a channel with N hosts.  With a shared neighbor
+ * cache, the helper builds one table of the bindings of each channel instead,
+ * and the caches of the populated interfaces reference it.
  */
 class NeighborCacheHelper
 {
@@ -93,7 +101,42 @@ class NeighborCacheHelper
      */
     void SetDynamicNeighborCache(bool enable);
 
+    /**
+     * @brief Enable/disable shared neighbor cache. When enabled, the populated
+     * interfaces reference a table of the bindings of their channel, shared by all
+     * the interfaces of the channel, instead of getting a copy of their neighbors.
+     * See ArpCache::SetSharedTable and NdiscCache::SetSharedTable.
+     * @param enable enable state
+     */
+    void SetSharedNeighborCache(bool enable);
+
   private:
+    /**
+     * @brief Make the ARP cache of an IPv4 interface reference the table of its channel.
+     * @param ipv4Interface the Ipv4Interface to process
+     */
+    void AttachSharedTable(Ptr<Ipv4Interface> ipv4Interface) const;
+
+    /**
+     * @brief Make the NDISC cache of an IPv6 interface reference the table of its channel.
+     * @param ipv6Interface the Ipv6Interface to process
+     */
+    void AttachSharedTable(Ptr<Ipv6Interface> ipv6Interface) const;
+
+    /**
+     * @brief Get the table of the IPv4 bindings of a channel, building it if needed.
+     * @param channel the channel
+     * @return the table
+     */
+    Ptr<ArpCache::SharedTable> GetArpTable(Ptr<Channel> channel) const;
+
+    /**
+     * @brief Get the table of the IPv6 bindings of a channel, building it if needed.
+     * @param channel the channel
+     * @return the table
+     */
+    Ptr<NdiscCache::SharedTable> GetNdiscTable(Ptr<Channel> channel) const;
+
     /**
      * @brief Populate neighbor ARP entries for given IPv4 interface.
      * @param ipv4Interface the Ipv4Interface to process
@@ -171,6 +214,14 @@ class NeighborCacheHelper
 
     bool m_dynamicNeighborCache{
         false}; //!< flag will set true if dynamic neighbor cache is enabled.
+
+    bool m_sharedNeighborCache{
+        false}; //!< flag will set true if shared neighbor cache is enabled.
+
+    mutable std::unordered_map<uint32_t, Ptr<ArpCache::SharedTable>>
+        m_arpTables; //!< IPv4 bindings of each channel, by channel ID
+    mutable std::unordered_map<uint32_t, Ptr<NdiscCache::SharedTable>>
+        m_ndiscTables; //!< IPv6 bindings of each channel, by channel ID
 };
 
 } // namespace ns3
@@ -8,6 +8,7 @@
 #include "arp-cache.h"
 
 #include "ipv4-header.h"
+#include "ipv4-interface-address.h"
 #include "ipv4-interface.h"
 
 #include "ns3/assert.h"
@@ -19,6 +20,9 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <map>
+
 namespace ns3
 {
 
@@ -188,37 +192,45 @@ ArpCache::HandleWaitReplyTimeout()
     NS_LOG_FUNCTION(this);
     ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // Only the entries which were marked WAIT_REPLY are visited, in the
+    // order of their addresses
+    for (auto i = m_waitReply.begin(); i != m_waitReply.end();)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        auto it = m_arpCache.find(*i);
+        entry = it != m_arpCache.end() ? it->second : nullptr;
+        if (entry == nullptr || !entry->IsWaitReply())
         {
-            if (entry->GetRetries() < m_maxRetries)
-            {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- retransmitting arp request since retries = "
-                                     << entry->GetRetries());
-                m_arpRequestCallback(this, entry->GetIpv4Address());
-                restartWaitReplyTimer = true;
-                entry->IncrementRetries();
-            }
-            else
+            // the entry was resolved or removed since
+            i = m_waitReply.erase(i);
+            continue;
+        }
+        if (entry->GetRetries() < m_maxRetries)
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- retransmitting arp request since retries = "
+                                 << entry->GetRetries());
+            m_arpRequestCallback(this, entry->GetIpv4Address());
+            restartWaitReplyTimer = true;
+            entry->IncrementRetries();
+            i++;
+        }
+        else
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- drop since max retries exceeded: "
+                                 << entry->GetRetries());
+            i = m_waitReply.erase(i);
+            entry->MarkDead();
+            entry->ClearRetries();
+            Ipv4PayloadHeaderPair pending = entry->DequeuePending();
+            while (pending.first)
             {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- drop since max retries exceeded: "
-                                     << entry->GetRetries());
-                entry->MarkDead();
-                entry->ClearRetries();
-                Ipv4PayloadHeaderPair pending = entry->DequeuePending();
-                while (pending.first)
-                {
-                    // add the Ipv4 header for tracing purposes
-                    pending.first->AddHeader(pending.second);
-                    m_dropTrace(pending.first);
-                    pending = entry->DequeuePending();
-                }
+                // add the Ipv4 header for tracing purposes
+                pending.first->AddHeader(pending.second);
+                m_dropTrace(pending.first);
+                pending = entry->DequeuePending();
             }
         }
     }
@@ -239,6 +251,9 @@ ArpCache::Flush()
         delete (*i).second;
     }
     m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_macIndex.clear();
+    m_waitReply.clear();
+    m_sharedTable = nullptr;
     if (m_waitReplyTimer.IsPending())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -253,8 +268,40 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // The entries are printed in the order of their addresses, and the
+    // bindings of the shared table as auto-generated entries
+    std::map<Ipv4Address, ArpCache::Entry*> entries(m_arpCache.begin(), m_arpCache.end());
+    std::map<Ipv4Address, Address> shared;
+    if (m_sharedTable)
     {
+        for (const auto& [address, macAddress] : m_sharedTable->GetBindings())
+        {
+            if (entries.find(address) == entries.end() && IsSharedNeighbor(address, macAddress))
+            {
+                shared[address] = macAddress;
+            }
+        }
+    }
+    auto j = shared.begin();
+    for (auto i = entries.begin(); i != entries.end() || j != shared.end();)
+    {
+        if (j != shared.end() && (i == entries.end() || j->first < i->first))
+        {
+            *os << j->first << " dev ";
+            std::string found = Names::FindName(m_device);
+            if (!found.empty())
+            {
+                *os << found;
+            }
+            else
+            {
+                *os << static_cast<int>(m_device->GetIfIndex());
+            }
+            *os << " lladdr " << j->second << " STATIC_AUTOGENERATED\n";
+            j++;
+            continue;
+        }
+
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
         if (!Names::FindName(m_device).empty())
@@ -288,6 +335,7 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
         {
             *os << " STALE\n";
         }
+        i++;
     }
 }
 
@@ -300,12 +348,74 @@ ArpCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+            UnindexMacAddress(i->second);
             delete i->second;
-            m_arpCache.erase(i++);
+            i = m_arpCache.erase(i);
             continue;
         }
         i++;
     }
+    m_sharedTable = nullptr;
+}
+
+void
+ArpCache::SetSharedTable(Ptr<SharedTable> table)
+{
+    NS_LOG_FUNCTION(this << table);
+    m_sharedTable = table;
+    if (!m_sharedTable)
+    {
+        return;
+    }
+    // The bindings of the table take precedence over the existing entries
+    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    {
+        const Address* macAddress = m_sharedTable->Lookup(i->first);
+        if (macAddress && IsSharedNeighbor(i->first, *macAddress))
+        {
+            i->second->SetMacAddress(*macAddress);
+            i->second->MarkAutoGenerated();
+        }
+    }
+}
+
+Ptr<ArpCache::SharedTable>
+ArpCache::GetSharedTable() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_sharedTable;
+}
+
+bool
+ArpCache::IsSharedNeighbor(Ipv4Address to, const Address& macAddress) const
+{
+    NS_LOG_FUNCTION(this << to << macAddress);
+    if (m_device && macAddress == m_device->GetAddress())
+    {
+        return false;
+    }
+    if (!m_interface)
+    {
+        return true;
+    }
+    for (uint32_t i = 0; i < m_interface->GetNAddresses(); i++)
+    {
+        if (m_interface->GetAddress(i).IsInSameSubnet(to))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+ArpCache::Entry*
+ArpCache::AddShared(Ipv4Address to, const Address& macAddress)
+{
+    NS_LOG_FUNCTION(this << to << macAddress);
+    ArpCache::Entry* entry = Add(to);
+    entry->SetMacAddress(macAddress);
+    entry->MarkAutoGenerated();
+    return entry;
 }
 
 std::list<ArpCache::Entry*>
@@ -314,14 +424,21 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    if (m_sharedTable)
     {
-        ArpCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == to)
+        for (const auto& address : m_sharedTable->LookupInverse(to))
         {
-            entryList.push_back(entry);
+            if (m_arpCache.find(address) == m_arpCache.end() && IsSharedNeighbor(address, to))
+            {
+                AddShared(address, to);
+            }
         }
     }
+    auto it = m_macIndex.find(to);
+    if (it != m_macIndex.end())
+    {
+        entryList.assign(it->second.begin(), it->second.end());
+    }
     return entryList;
 }
 
@@ -334,6 +451,14 @@ ArpCache::Lookup(Ipv4Address to)
     {
         return it->second;
     }
+    if (m_sharedTable)
+    {
+        const Address* macAddress = m_sharedTable->Lookup(to);
+        if (macAddress && IsSharedNeighbor(to, *macAddress))
+        {
+            return AddShared(to, *macAddress);
+        }
+    }
     return nullptr;
 }
 
@@ -354,17 +479,49 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && i->second == entry)
+    {
+        m_arpCache.erase(i);
+        UnindexMacAddress(entry);
+        entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+        delete entry;
+        return;
+    }
+    NS_LOG_WARN("Entry not found in this ARP Cache");
+}
+
+void
+ArpCache::ReindexMacAddress(ArpCache::Entry* entry,
+                            const Address& oldAddress,
+                            const Address& newAddress)
+{
+    NS_LOG_FUNCTION(this << entry << oldAddress << newAddress);
+    if (oldAddress == newAddress)
+    {
+        return;
+    }
+    auto it = m_macIndex.find(oldAddress);
+    if (it != m_macIndex.end())
     {
-        if ((*i).second == entry)
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), entry),
+                         it->second.end());
+        if (it->second.empty())
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
-            return;
+            m_macIndex.erase(it);
         }
     }
-    NS_LOG_WARN("Entry not found in this ARP Cache");
+    if (!newAddress.IsInvalid())
+    {
+        m_macIndex[newAddress].push_back(entry);
+    }
+}
+
+void
+ArpCache::UnindexMacAddress(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    ReindexMacAddress(entry, entry->GetMacAddress(), Address());
 }
 
 ArpCache::Entry::Entry(ArpCache* arp)
@@ -425,6 +582,7 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
+    m_arp->ReindexMacAddress(this, m_macAddress, macAddress);
     m_macAddress = macAddress;
     m_state = ALIVE;
     ClearRetries();
@@ -481,6 +639,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     m_state = WAIT_REPLY;
     m_pending.push_back(waiting);
     UpdateSeen();
+    m_arp->m_waitReply.insert(m_ipv4Address);
     m_arp->StartWaitReplyTimer();
 }
 
@@ -495,6 +654,7 @@ void
 ArpCache::Entry::SetMacAddress(Address macAddress)
 {
     NS_LOG_FUNCTION(this);
+    m_arp->ReindexMacAddress(this, m_macAddress, macAddress);
     m_macAddress = macAddress;
 }
 
@@ -8,6 +8,8 @@
 #ifndef ARP_CACHE_H
 #define ARP_CACHE_H
 
+#include "shared-neighbor-table.h"
+
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/ipv4-address.h"
@@ -21,8 +23,10 @@
 #include "ns3/traced-callback.h"
 
 #include <list>
-#include <map>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -37,6 +41,12 @@ class Ipv4Header;
  *
  * A cached lookup table for translating layer 3 addresses to layer 2.
  * This implementation does lookups from IPv4 to a MAC address
+ *
+ * The entries are hashed by IPv4 address, and indexed by MAC address for
+ * LookupInverse.  The entries waiting for a reply are tracked apart, so that
+ * the retransmission timer, shared by the whole cache, does not scan the
+ * other ones.  The cache can also reference a SharedTable of the bindings
+ * of a channel, built by NeighborCacheHelper.
  */
 class ArpCache : public Object
 {
@@ -161,6 +171,30 @@ class ArpCache : public Object
      */
     void RemoveAutoGeneratedEntries();
 
+    /**
+     * @brief Bindings of the interfaces of a channel, shared by their ARP caches
+     */
+    typedef SharedNeighborTable<Ipv4Address, Ipv4AddressHash> SharedTable;
+
+    /**
+     * @brief Reference a table of auto-generated bindings
+     *
+     * The bindings of the table are seen as STATIC_AUTOGENERATED entries of
+     * this cache, except the ones of the device of this cache and the ones
+     * outside of the subnets of its interface.  The existing entries of the
+     * cache for these bindings are turned into auto-generated entries.  The
+     * table is dropped by Flush() and RemoveAutoGeneratedEntries().
+     *
+     * @param table the table, or nullptr to drop the current one
+     */
+    void SetSharedTable(Ptr<SharedTable> table);
+
+    /**
+     * @brief Get the table of auto-generated bindings referenced by this cache
+     * @return the table, or nullptr if none
+     */
+    Ptr<SharedTable> GetSharedTable() const;
+
     /**
      * @brief Pair of a packet and an Ipv4 header.
      */
@@ -310,14 +344,46 @@ class ArpCache : public Object
     /**
      * @brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash> Cache;
     /**
      * @brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     void DoDispose() override;
 
+    /**
+     * @brief Update the MAC address index when the MAC address of an entry changes
+     * @param entry the entry
+     * @param oldAddress the previous MAC address of the entry
+     * @param newAddress the new MAC address of the entry
+     */
+    void ReindexMacAddress(ArpCache::Entry* entry,
+                           const Address& oldAddress,
+                           const Address& newAddress);
+
+    /**
+     * @brief Remove an entry from the MAC address index
+     * @param entry the entry
+     */
+    void UnindexMacAddress(ArpCache::Entry* entry);
+
+    /**
+     * @brief Check whether a binding of the shared table is a neighbor of this cache
+     * @param to the IPv4 address of the binding
+     * @param macAddress the MAC address of the binding
+     * @return true if the binding is seen as an entry of this cache
+     */
+    bool IsSharedNeighbor(Ipv4Address to, const Address& macAddress) const;
+
+    /**
+     * @brief Turn a binding of the shared table into an auto-generated entry
+     * @param to the IPv4 address of the binding
+     * @param macAddress the MAC address of the binding
+     * @return the new entry
+     */
+    ArpCache::Entry* AddShared(Ipv4Address to, const Address& macAddress);
+
     Ptr<NetDevice> m_device;        //!< NetDevice associated with the cache
     Ptr<Ipv4Interface> m_interface; //!< Ipv4Interface associated with the cache
     Time m_aliveTimeout;            //!< cache alive state timeout
@@ -336,6 +402,10 @@ class ArpCache : public Object
     void HandleWaitReplyTimeout();
     uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
     Cache m_arpCache;            //!< the ARP cache
+    std::unordered_map<Address, std::vector<ArpCache::Entry*>, AddressHash>
+        m_macIndex;                    //!< entries by MAC address
+    std::set<Ipv4Address> m_waitReply; //!< addresses of the entries waiting for a reply
+    Ptr<SharedTable> m_sharedTable;    //!< auto-generated bindings of the channel
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
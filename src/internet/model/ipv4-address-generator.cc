@@ -116,6 +116,15 @@ class Ipv4AddressGeneratorImpl
      */
     bool AddAllocated(const Ipv4Address addr);
 
+    /**
+     * @brief Add a range of Ipv4Address to the list of IPv4 entries
+     *
+     * @param low The lowest Ipv4Address of the range
+     * @param high The highest Ipv4Address of the range
+     * @returns true on success
+     */
+    bool AddAllocatedRange(const Ipv4Address low, const Ipv4Address high);
+
     /**
      * @brief Check the Ipv4Address allocation in the list of IPv4 entries
      *
@@ -437,6 +446,56 @@ Ipv4AddressGeneratorImpl::AddAllocated(const Ipv4Address address)
     return true;
 }
 
+bool
+Ipv4AddressGeneratorImpl::AddAllocatedRange(const Ipv4Address low, const Ipv4Address high)
+{
+    NS_LOG_FUNCTION(this << low << high);
+
+    uint32_t addrLow = low.Get();
+    uint32_t addrHigh = high.Get();
+
+    NS_ABORT_MSG_UNLESS(addrLow,
+                        "Ipv4AddressGeneratorImpl::AddAllocatedRange(): "
+                        "Allocating the broadcast address is not a good idea");
+    NS_ABORT_MSG_UNLESS(addrLow <= addrHigh,
+                        "Ipv4AddressGeneratorImpl::AddAllocatedRange(): Invalid range "
+                            << low << "-" << high);
+
+    std::list<Entry>::iterator i;
+
+    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    {
+        NS_LOG_LOGIC("examine entry: " << Ipv4Address((*i).addrLow) << " to "
+                                       << Ipv4Address((*i).addrHigh));
+        //
+        // The entries are sorted, so the range can be inserted before the
+        // first entry above it, provided it does not overlap any entry.
+        //
+        if (addrLow <= (*i).addrHigh && addrHigh >= (*i).addrLow)
+        {
+            NS_LOG_LOGIC("Ipv4AddressGeneratorImpl::AddAllocatedRange(): Address Collision: "
+                         << low << "-" << high);
+            if (!m_test)
+            {
+                NS_FATAL_ERROR("Ipv4AddressGeneratorImpl::AddAllocatedRange(): "
+                               "Address Collision: "
+                               << low << "-" << high);
+            }
+            return false;
+        }
+        if (addrHigh < (*i).addrLow)
+        {
+            break;
+        }
+    }
+
+    Entry entry;
+    entry.addrLow = addrLow;
+    entry.addrHigh = addrHigh;
+    m_entries.insert(i, entry);
+    return true;
+}
+
 bool
 Ipv4AddressGeneratorImpl::IsAddressAllocated(const Ipv4Address address)
 {
@@ -594,6 +653,14 @@ Ipv4AddressGenerator::AddAllocated(const Ipv4Address addr)
     return SimulationSingleton<Ipv4AddressGeneratorImpl>::Get()->AddAllocated(addr);
 }
 
+bool
+Ipv4AddressGenerator::AddAllocatedRange(const Ipv4Address low, const Ipv4Address high)
+{
+    NS_LOG_FUNCTION(low << high);
+
+    return SimulationSingleton<Ipv4AddressGeneratorImpl>::Get()->AddAllocatedRange(low, high);
+}
+
 bool
 Ipv4AddressGenerator::IsAddressAllocated(const Ipv4Address addr)
 {
@@ -114,6 +114,20 @@ class Ipv4AddressGenerator
      */
     static bool AddAllocated(const Ipv4Address addr);
 
+    /**
+     * @brief Add a range of Ipv4Address to the list of IPv4 entries
+     *
+     * Typically, this is used by external address allocators that assign
+     * many networks at once and want to reserve them with a single entry,
+     * rather than with one entry per address.
+     *
+     * @param low The lowest Ipv4Address of the range
+     * @param high The highest Ipv4Address of the range
+     * @returns true on success, false if an address of the range is already
+     * allocated
+     */
+    static bool AddAllocatedRange(const Ipv4Address low, const Ipv4Address high);
+
     /**
      * @brief Check the Ipv4Address allocation in the list of IPv4 entries
      *
@@ -13,6 +13,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace ns3
 {
 
@@ -37,33 +40,137 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
     m_endPoints.clear();
 }
 
+std::size_t
+Ipv4EndPointDemux::FourTupleHash::operator()(const FourTuple& tuple) const
+{
+    uint64_t x = (static_cast<uint64_t>(tuple.localAddress.Get()) << 32) | tuple.peerAddress.Get();
+    x ^= ((static_cast<uint64_t>(tuple.localPort) << 16) | tuple.peerPort) * 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<std::size_t>(x ^ (x >> 31));
+}
+
+Ipv4EndPointDemux::FourTuple
+Ipv4EndPointDemux::GetFourTuple(const Ipv4EndPoint* endPoint)
+{
+    return {endPoint->GetLocalAddress(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerPort()};
+}
+
 bool
-Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv4EndPointDemux::IsConnected(const Ipv4EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return endPoint->GetPeerPort() != 0 && endPoint->GetPeerAddress() != Ipv4Address::GetAny();
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    m_endPoints.push_back(endPoint);
+    m_positions[endPoint] = std::prev(m_endPoints.end());
+    endPoint->m_demux = this;
+    Index(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint)
+{
+    if (IsConnected(endPoint))
+    {
+        m_connected.emplace(GetFourTuple(endPoint), endPoint);
+    }
+    else
     {
-        if ((*i)->GetLocalPort() == port)
+        m_wildcard[endPoint->GetLocalPort()].push_back(endPoint);
+    }
+
+    uint16_t port = endPoint->GetLocalPort();
+    if (m_portUsers[port]++ == 0 && !m_ephemeralPorts.empty() && port >= m_portFirst &&
+        port <= m_portLast)
+    {
+        uint32_t index = port - m_portFirst;
+        m_ephemeralPorts[index / 64] |= 1ULL << (index % 64);
+    }
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint)
+{
+    if (IsConnected(endPoint))
+    {
+        auto [begin, end] = m_connected.equal_range(GetFourTuple(endPoint));
+        for (auto it = begin; it != end; ++it)
         {
-            return true;
+            if (it->second == endPoint)
+            {
+                m_connected.erase(it);
+                break;
+            }
+        }
+    }
+    else
+    {
+        auto it = m_wildcard.find(endPoint->GetLocalPort());
+        NS_ASSERT(it != m_wildcard.end());
+        std::erase(it->second, endPoint);
+        if (it->second.empty())
+        {
+            m_wildcard.erase(it);
+        }
+    }
+
+    uint16_t port = endPoint->GetLocalPort();
+    auto users = m_portUsers.find(port);
+    NS_ASSERT(users != m_portUsers.end());
+    if (--users->second == 0)
+    {
+        m_portUsers.erase(users);
+        if (!m_ephemeralPorts.empty() && port >= m_portFirst && port <= m_portLast)
+        {
+            uint32_t index = port - m_portFirst;
+            m_ephemeralPorts[index / 64] &= ~(1ULL << (index % 64));
         }
     }
-    return false;
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_portUsers.contains(port);
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto users = m_portUsers.find(port);
+    if (users == m_portUsers.end())
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        return false;
+    }
+    auto match = [&](const Ipv4EndPoint* endPoint) {
+        return endPoint->GetLocalPort() == port && endPoint->GetLocalAddress() == addr &&
+               endPoint->GetBoundNetDevice() == boundNetDevice;
+    };
+    auto wildcard = m_wildcard.find(port);
+    if (wildcard != m_wildcard.end())
+    {
+        if (std::any_of(wildcard->second.begin(), wildcard->second.end(), match))
         {
             return true;
         }
+        if (wildcard->second.size() == users->second)
+        {
+            return false;
+        }
     }
-    return false;
+    // The port is used by connected end points too
+    return std::any_of(m_endPoints.begin(), m_endPoints.end(), match);
 }
 
 Ipv4EndPoint*
@@ -76,10 +183,7 @@ Ipv4EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(Ipv4Address::GetAny(), port));
 }
 
 Ipv4EndPoint*
@@ -92,10 +196,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -115,10 +216,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -129,37 +227,46 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
-        {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
-        }
-    }
+    auto duplicate = [&](const Ipv4EndPoint* endPoint) {
+        return endPoint->GetLocalPort() == localPort &&
+               endPoint->GetLocalAddress() == localAddress &&
+               endPoint->GetPeerPort() == peerPort && endPoint->GetPeerAddress() == peerAddress &&
+               (endPoint->GetBoundNetDevice() == boundNetDevice ||
+                !endPoint->GetBoundNetDevice());
+    };
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    // A duplicate has the same four-tuple, hence is in the same table
+    bool found = false;
+    if (IsConnected(endPoint))
+    {
+        auto [begin, end] = m_connected.equal_range(GetFourTuple(endPoint));
+        found = std::any_of(begin, end, [&](const auto& entry) { return duplicate(entry.second); });
+    }
+    else if (auto wildcard = m_wildcard.find(localPort); wildcard != m_wildcard.end())
+    {
+        found = std::any_of(wildcard->second.begin(), wildcard->second.end(), duplicate);
+    }
+    if (found)
+    {
+        NS_LOG_WARN("Duplicated endpoint.");
+        delete endPoint;
+        return nullptr;
+    }
+    return Insert(endPoint);
 }
 
 void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position != m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        Unindex(endPoint);
+        m_endPoints.erase(position->second);
+        m_positions.erase(position);
+        delete endPoint;
     }
 }
 
@@ -180,6 +287,138 @@ Ipv4EndPointDemux::GetAllEndPoints()
     return ret;
 }
 
+void
+Ipv4EndPointDemux::Match(Ipv4EndPoint* endP,
+                         Ipv4Address daddr,
+                         uint16_t dport,
+                         Ipv4Address saddr,
+                         uint16_t sport,
+                         Ptr<Ipv4Interface> incomingInterface,
+                         std::array<EndPoints, 4>& retvals)
+{
+    NS_LOG_DEBUG("Looking at endpoint dport=" << endP->GetLocalPort() << " daddr="
+                                              << endP->GetLocalAddress() << " sport="
+                                              << endP->GetPeerPort()
+                                              << " saddr=" << endP->GetPeerAddress());
+
+    if (!endP->IsRxEnabled())
+    {
+        NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint can not receive packets");
+        return;
+    }
+
+    if (endP->GetLocalPort() != dport)
+    {
+        NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                          << endP->GetLocalPort() << " does not match packet dport "
+                                          << dport);
+        return;
+    }
+    if (endP->GetBoundNetDevice())
+    {
+        if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+        {
+            NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                              << " because endpoint is bound to specific device and"
+                                              << endP->GetBoundNetDevice()
+                                              << " does not match packet device "
+                                              << incomingInterface->GetDevice());
+            return;
+        }
+    }
+
+    bool localAddressMatchesExact = false;
+    bool localAddressIsAny = false;
+    bool localAddressIsSubnetAny = false;
+
+    // We have 3 cases:
+    // 1) Exact local / destination address match
+    // 2) Local endpoint bound to Any -> matches anything
+    // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
+    // x.y.z.255 in a /24 net) and direct destination match.
+
+    if (endP->GetLocalAddress() == daddr)
+    {
+        // Case 1:
+        localAddressMatchesExact = true;
+    }
+    else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
+    {
+        // Case 2:
+        localAddressIsAny = true;
+    }
+    else
+    {
+        // Case 3:
+        for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
+        {
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+
+            Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+            if (endP->GetLocalAddress() == addrNetpart)
+            {
+                NS_LOG_LOGIC("Endpoint is SubnetDirectedAny " << endP->GetLocalAddress() << "/"
+                                                              << addr.GetMask().GetPrefixLength());
+
+                Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
+                if (addrNetpart == daddrNetPart)
+                {
+                    localAddressIsSubnetAny = true;
+                }
+            }
+        }
+
+        // if no match here, keep looking
+        if (!localAddressIsSubnetAny)
+        {
+            return;
+        }
+    }
+
+    bool remotePortMatchesExact = endP->GetPeerPort() == sport;
+    bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
+    bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+    bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
+
+    // If remote does not match either with exact or wildcard,
+    // skip this one
+    if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+    {
+        return;
+    }
+    if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+    {
+        return;
+    }
+
+    bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+
+    if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+    { // All 4 match - this is the case of an open TCP connection, for example.
+        NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        retvals[3].push_back(endP);
+    }
+    if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+    { // All but local address - no idea what this case could be.
+        NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        retvals[2].push_back(endP);
+    }
+    if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+    { // Only local port and local address matches exactly - Not yet opened connection
+        NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        retvals[1].push_back(endP);
+    }
+    if (localAddressMatchesWildCard && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
+    { // Only local port matches exactly - Endpoint open to "any" connection
+        NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
+                                                             << endP->GetLocalPort());
+        retvals[0].push_back(endP);
+    }
+}
+
 /*
  * If we have an exact match, we return it.
  * Otherwise, if we find a generic match, we return it.
@@ -194,157 +433,69 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
 
-    EndPoints retval1; // Matches exact on local port, wildcards on others
-    EndPoints retval2; // Matches exact on local port/adder, wildcards on others
-    EndPoints retval3; // Matches all but local address
-    EndPoints retval4; // Exact match on all 4
+    // retvals[0]: Matches exact on local port, wildcards on others
+    // retvals[1]: Matches exact on local port/adder, wildcards on others
+    // retvals[2]: Matches all but local address
+    // retvals[3]: Exact match on all 4
+    std::array<EndPoints, 4> retvals;
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv4EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
 
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-        if (endP->GetBoundNetDevice())
+    // The end points with a fully specified peer can only match the four-tuple
+    // of the packet, with the local address replaced by a wildcard for the
+    // matches on all but the local address.
+    std::vector<Ipv4Address> localAddresses{daddr, Ipv4Address::GetAny()};
+    if (incomingInterface)
+    {
+        for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
         {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+            if (daddr.CombineMask(addr.GetMask()) == addrNetpart &&
+                std::find(localAddresses.begin(), localAddresses.end(), addrNetpart) ==
+                    localAddresses.end())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
+                localAddresses.push_back(addrNetpart);
             }
         }
-
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
-
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
-
-        if (endP->GetLocalAddress() == daddr)
-        {
-            // Case 1:
-            localAddressMatchesExact = true;
-        }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
-        }
-        else
+    }
+    if (!m_connected.empty())
+    {
+        for (const auto& localAddress : localAddresses)
         {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
+            auto [begin, end] = m_connected.equal_range({localAddress, saddr, dport, sport});
+            for (auto it = begin; it != end; ++it)
             {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
-
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
-                {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
-
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
-                    {
-                        localAddressIsSubnetAny = true;
-                    }
-                }
-            }
-
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
-            {
-                continue;
+                Match(it->second, daddr, dport, saddr, sport, incomingInterface, retvals);
             }
         }
+    }
 
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+    if (auto wildcard = m_wildcard.find(dport); wildcard != m_wildcard.end())
+    {
+        for (auto endP : wildcard->second)
         {
-            continue;
-        }
-
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
-
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
+            Match(endP, daddr, dport, saddr, sport, incomingInterface, retvals);
         }
     }
 
     // Here we find the most exact match
     EndPoints retval;
-    if (!retval4.empty())
+    if (!retvals[3].empty())
     {
-        retval = retval4;
+        retval = retvals[3];
     }
-    else if (!retval3.empty())
+    else if (!retvals[2].empty())
     {
-        retval = retval3;
+        retval = retvals[2];
     }
-    else if (!retval2.empty())
+    else if (!retvals[1].empty())
     {
-        retval = retval2;
+        retval = retvals[1];
     }
     else
     {
-        retval = retval1;
+        retval = retvals[0];
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -400,22 +551,57 @@ Ipv4EndPointDemux::AllocateEphemeralPort()
 {
     // Similar to counting up logic in netinet/in_pcb.c
     NS_LOG_FUNCTION(this);
-    uint16_t port = m_ephemeral;
-    int count = m_portLast - m_portFirst;
-    do
+    uint32_t nPorts = m_portLast - m_portFirst + 1;
+    if (m_ephemeralPorts.empty())
+    {
+        // The bits after the last port are marked as used
+        m_ephemeralPorts.assign((nPorts + 63) / 64, 0);
+        for (uint32_t index = nPorts; index < m_ephemeralPorts.size() * 64; ++index)
+        {
+            m_ephemeralPorts[index / 64] |= 1ULL << (index % 64);
+        }
+        for (const auto& [port, users] : m_portUsers)
+        {
+            if (port >= m_portFirst && port <= m_portLast)
+            {
+                uint32_t index = port - m_portFirst;
+                m_ephemeralPorts[index / 64] |= 1ULL << (index % 64);
+            }
+        }
+    }
+
+    // Search from the port after the last one allocated, and wrap around
+    uint32_t start = 0;
+    if (m_ephemeral >= m_portFirst && m_ephemeral < m_portLast)
+    {
+        start = m_ephemeral - m_portFirst + 1;
+    }
+    uint32_t index = FindFreeEphemeralPort(start, nPorts);
+    if (index == nPorts)
     {
-        if (count-- < 0)
+        index = FindFreeEphemeralPort(0, start);
+        if (index == start)
         {
             return 0;
         }
-        ++port;
-        if (port < m_portFirst || port > m_portLast)
+    }
+    m_ephemeral = m_portFirst + index;
+    return m_ephemeral;
+}
+
+uint32_t
+Ipv4EndPointDemux::FindFreeEphemeralPort(uint32_t from, uint32_t to) const
+{
+    for (uint32_t index = from; index < to;)
+    {
+        uint64_t free = ~m_ephemeralPorts[index / 64] >> (index % 64);
+        if (free != 0)
         {
-            port = m_portFirst;
+            return std::min(index + std::countr_zero(free), to);
         }
-    } while (LookupPortLocal(port));
-    m_ephemeral = port;
-    return port;
+        index = (index / 64 + 1) * 64;
+    }
+    return to;
 }
 
 } // namespace ns3
@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv4EndPointDemux;
 class Packet;
 
 /**
@@ -180,6 +181,15 @@ class Ipv4EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv4EndPointDemux;
+
+    /**
+     * @brief The demux which indexes this endpoint, if any.
+     *
+     * The demux is notified when the four-tuple of the endpoint changes.
+     */
+    Ipv4EndPointDemux* m_demux;
+
     /**
      * @brief The local address.
      */
@@ -12,6 +12,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace ns3
 {
 
@@ -36,33 +39,139 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
     m_endPoints.clear();
 }
 
+std::size_t
+Ipv6EndPointDemux::FourTupleHash::operator()(const FourTuple& tuple) const
+{
+    Ipv6AddressHash addressHash;
+    uint64_t x = addressHash(tuple.localAddress) * 0x9E3779B97F4A7C15ULL;
+    x ^= addressHash(tuple.peerAddress) + 0x7F4A7C159E3779B9ULL + (x << 6) + (x >> 2);
+    x ^= ((static_cast<uint64_t>(tuple.localPort) << 16) | tuple.peerPort) * 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<std::size_t>(x ^ (x >> 31));
+}
+
+Ipv6EndPointDemux::FourTuple
+Ipv6EndPointDemux::GetFourTuple(const Ipv6EndPoint* endPoint)
+{
+    return {endPoint->GetLocalAddress(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerPort()};
+}
+
 bool
-Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv6EndPointDemux::IsConnected(const Ipv6EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return endPoint->GetPeerPort() != 0 && endPoint->GetPeerAddress() != Ipv6Address::GetAny();
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    m_endPoints.push_back(endPoint);
+    m_positions[endPoint] = std::prev(m_endPoints.end());
+    endPoint->m_demux = this;
+    Index(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint)
+{
+    if (IsConnected(endPoint))
     {
-        if ((*i)->GetLocalPort() == port)
+        m_connected.emplace(GetFourTuple(endPoint), endPoint);
+    }
+    else
+    {
+        m_wildcard[endPoint->GetLocalPort()].push_back(endPoint);
+    }
+
+    uint16_t port = endPoint->GetLocalPort();
+    if (m_portUsers[port]++ == 0 && !m_ephemeralPorts.empty() && port >= m_portFirst &&
+        port <= m_portLast)
+    {
+        uint32_t index = port - m_portFirst;
+        m_ephemeralPorts[index / 64] |= 1ULL << (index % 64);
+    }
+}
+
+void
+Ipv6EndPointDemux::Unindex(Ipv6EndPoint* endPoint)
+{
+    if (IsConnected(endPoint))
+    {
+        auto [begin, end] = m_connected.equal_range(GetFourTuple(endPoint));
+        for (auto it = begin; it != end; ++it)
         {
-            return true;
+            if (it->second == endPoint)
+            {
+                m_connected.erase(it);
+                break;
+            }
+        }
+    }
+    else
+    {
+        auto it = m_wildcard.find(endPoint->GetLocalPort());
+        NS_ASSERT(it != m_wildcard.end());
+        std::erase(it->second, endPoint);
+        if (it->second.empty())
+        {
+            m_wildcard.erase(it);
         }
     }
-    return false;
+
+    uint16_t port = endPoint->GetLocalPort();
+    auto users = m_portUsers.find(port);
+    NS_ASSERT(users != m_portUsers.end());
+    if (--users->second == 0)
+    {
+        m_portUsers.erase(users);
+        if (!m_ephemeralPorts.empty() && port >= m_portFirst && port <= m_portLast)
+        {
+            uint32_t index = port - m_portFirst;
+            m_ephemeralPorts[index / 64] &= ~(1ULL << (index % 64));
+        }
+    }
+}
+
+bool
+Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_portUsers.contains(port);
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto users = m_portUsers.find(port);
+    if (users == m_portUsers.end())
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        return false;
+    }
+    auto match = [&](const Ipv6EndPoint* endPoint) {
+        return endPoint->GetLocalPort() == port && endPoint->GetLocalAddress() == addr &&
+               endPoint->GetBoundNetDevice() == boundNetDevice;
+    };
+    auto wildcard = m_wildcard.find(port);
+    if (wildcard != m_wildcard.end())
+    {
+        if (std::any_of(wildcard->second.begin(), wildcard->second.end(), match))
         {
             return true;
         }
+        if (wildcard->second.size() == users->second)
+        {
+            return false;
+        }
     }
-    return false;
+    // The port is used by connected end points too
+    return std::any_of(m_endPoints.begin(), m_endPoints.end(), match);
 }
 
 Ipv6EndPoint*
@@ -75,10 +184,7 @@ Ipv6EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(Ipv6Address::GetAny(), port));
 }
 
 Ipv6EndPoint*
@@ -91,10 +197,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -114,10 +217,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -128,38 +228,141 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
-        {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
-        }
-    }
+    auto duplicate = [&](const Ipv6EndPoint* endPoint) {
+        return endPoint->GetLocalPort() == localPort &&
+               endPoint->GetLocalAddress() == localAddress &&
+               endPoint->GetPeerPort() == peerPort && endPoint->GetPeerAddress() == peerAddress &&
+               (endPoint->GetBoundNetDevice() == boundNetDevice ||
+                !endPoint->GetBoundNetDevice());
+    };
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    // A duplicate has the same four-tuple, hence is in the same table
+    bool found = false;
+    if (IsConnected(endPoint))
+    {
+        auto [begin, end] = m_connected.equal_range(GetFourTuple(endPoint));
+        found = std::any_of(begin, end, [&](const auto& entry) { return duplicate(entry.second); });
+    }
+    else if (auto wildcard = m_wildcard.find(localPort); wildcard != m_wildcard.end())
+    {
+        found = std::any_of(wildcard->second.begin(), wildcard->second.end(), duplicate);
+    }
+    if (found)
+    {
+        NS_LOG_WARN("Duplicated endpoint.");
+        delete endPoint;
+        return nullptr;
+    }
+    return Insert(endPoint);
 }
 
 void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position != m_positions.end())
+    {
+        Unindex(endPoint);
+        m_endPoints.erase(position->second);
+        m_positions.erase(position);
+        delete endPoint;
+    }
+}
+
+void
+Ipv6EndPointDemux::Match(Ipv6EndPoint* endP,
+                         Ipv6Address daddr,
+                         uint16_t dport,
+                         Ipv6Address saddr,
+                         uint16_t sport,
+                         Ptr<Ipv6Interface> incomingInterface,
+                         std::array<EndPoints, 4>& retvals)
+{
+    NS_LOG_DEBUG("Looking at endpoint dport="
+                 << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                 << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
+
+    if (!endP->IsRxEnabled())
+    {
+        NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                          << " because endpoint can not receive packets");
+        return;
+    }
+
+    if (endP->GetLocalPort() != dport)
     {
-        if (*i == endPoint)
+        NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                          << endP->GetLocalPort()
+                                          << " does not match packet dport " << dport);
+        return;
+    }
+
+    if (endP->GetBoundNetDevice())
+    {
+        if (!incomingInterface)
+        {
+            return;
+        }
+        if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
         {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
+            NS_LOG_LOGIC("Skipping endpoint "
+                         << &endP << " because endpoint is bound to specific device and"
+                         << endP->GetBoundNetDevice() << " does not match packet device "
+                         << incomingInterface->GetDevice());
+            return;
         }
     }
+
+    /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+    NS_LOG_DEBUG("dest addr " << daddr);
+
+    bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
+    bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
+    bool localAddressMatchesAllRouters =
+        endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
+
+    /* if no match here, keep looking */
+    if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+    {
+        return;
+    }
+    bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
+    bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
+    bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+    bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
+
+    /* If remote does not match either with exact or wildcard,i
+       skip this one */
+    if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+    {
+        return;
+    }
+    if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+    {
+        return;
+    }
+
+    /* Now figure out which return list to add this one to */
+    if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
+        remoteAddressMatchesWildCard)
+    { /* Only local port matches exactly */
+        retvals[0].push_back(endP);
+    }
+    if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
+        remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
+    { /* Only local port and local address matches exactly */
+        retvals[1].push_back(endP);
+    }
+    if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
+    { /* All but local address */
+        retvals[2].push_back(endP);
+    }
+    if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
+    { /* All 4 match */
+        retvals[3].push_back(endP);
+    }
 }
 
 /*
@@ -176,118 +379,58 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
 
-    EndPoints retval1; /* Matches exact on local port, wildcards on others */
-    EndPoints retval2; /* Matches exact on local port/adder, wildcards on others */
-    EndPoints retval3; /* Matches all but local address */
-    EndPoints retval4; /* Exact match on all 4 */
+    /* retvals[0]: Matches exact on local port, wildcards on others */
+    /* retvals[1]: Matches exact on local port/adder, wildcards on others */
+    /* retvals[2]: Matches all but local address */
+    /* retvals[3]: Exact match on all 4 */
+    std::array<EndPoints, 4> retvals;
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv6EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
 
-        if (endP->GetBoundNetDevice())
+    /* The end points with a fully specified peer can only match the
+       four-tuple of the packet, or the four-tuple with a wildcard local
+       address */
+    if (!m_connected.empty())
+    {
+        for (const auto& localAddress : {daddr, Ipv6Address::GetAny()})
         {
-            if (!incomingInterface)
+            auto [begin, end] = m_connected.equal_range({localAddress, saddr, dport, sport});
+            for (auto it = begin; it != end; ++it)
             {
-                continue;
+                Match(it->second, daddr, dport, saddr, sport, incomingInterface, retvals);
             }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            if (daddr == Ipv6Address::GetAny())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
+                break;
             }
         }
+    }
 
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
-
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
-
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+    if (auto wildcard = m_wildcard.find(dport); wildcard != m_wildcard.end())
+    {
+        for (auto endP : wildcard->second)
         {
-            continue;
-        }
-
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
+            Match(endP, daddr, dport, saddr, sport, incomingInterface, retvals);
         }
     }
 
     // Here we find the most exact match
     EndPoints retval;
-    if (!retval4.empty())
+    if (!retvals[3].empty())
     {
-        retval = retval4;
+        retval = retvals[3];
     }
-    else if (!retval3.empty())
+    else if (!retvals[2].empty())
     {
-        retval = retval3;
+        retval = retvals[2];
     }
-    else if (!retval2.empty())
+    else if (!retvals[1].empty())
     {
-        retval = retval2;
+        retval = retvals[1];
     }
     else
     {
-        retval = retval1;
+        retval = retvals[0];
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -341,22 +484,57 @@ uint16_t
 Ipv6EndPointDemux::AllocateEphemeralPort()
 {
     NS_LOG_FUNCTION(this);
-    uint16_t port = m_ephemeral;
-    int count = m_portLast - m_portFirst;
-    do
+    uint32_t nPorts = m_portLast - m_portFirst + 1;
+    if (m_ephemeralPorts.empty())
+    {
+        // The bits after the last port are marked as used
+        m_ephemeralPorts.assign((nPorts + 63) / 64, 0);
+        for (uint32_t index = nPorts; index < m_ephemeralPorts.size() * 64; ++index)
+        {
+            m_ephemeralPorts[index / 64] |= 1ULL << (index % 64);
+        }
+        for (const auto& [port, users] : m_portUsers)
+        {
+            if (port >= m_portFirst && port <= m_portLast)
+            {
+                uint32_t index = port - m_portFirst;
+                m_ephemeralPorts[index / 64] |= 1ULL << (index % 64);
+            }
+        }
+    }
+
+    // Search from the port after the last one allocated, and wrap around
+    uint32_t start = 0;
+    if (m_ephemeral >= m_portFirst && m_ephemeral < m_portLast)
     {
-        if (count-- < 0)
+        start = m_ephemeral - m_portFirst + 1;
+    }
+    uint32_t index = FindFreeEphemeralPort(start, nPorts);
+    if (index == nPorts)
+    {
+        index = FindFreeEphemeralPort(0, start);
+        if (index == start)
         {
             return 0;
         }
-        ++port;
-        if (port < m_portFirst || port > m_portLast)
+    }
+    m_ephemeral = m_portFirst + index;
+    return m_ephemeral;
+}
+
+uint32_t
+Ipv6EndPointDemux::FindFreeEphemeralPort(uint32_t from, uint32_t to) const
+{
+    for (uint32_t index = from; index < to;)
+    {
+        uint64_t free = ~m_ephemeralPorts[index / 64] >> (index % 64);
+        if (free != 0)
         {
-            port = m_portFirst;
+            return std::min(index + std::countr_zero(free), to);
         }
-    } while (LookupPortLocal(port));
-    m_ephemeral = port;
-    return port;
+        index = (index / 64 + 1) * 64;
+    }
+    return to;
 }
 
 Ipv6EndPointDemux::EndPoints
@@ -13,8 +13,11 @@
 
 #include "ns3/ipv6-address.h"
 
+#include <array>
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +28,12 @@ class Ipv6EndPoint;
  * @ingroup ipv6
  *
  * @brief Demultiplexer for end points.
+ *
+ * The endpoints with a fully specified peer (e.g., the connected TCP
+ * sockets) are indexed in a hash table of their four-tuple, and the other
+ * ones (e.g., the listening sockets) in a table of their local port, so
+ * that a lookup does not depend on the number of connections.  The
+ * endpoints notify the demux when their four-tuple changes.
  */
 class Ipv6EndPointDemux
 {
@@ -150,12 +159,102 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /// The four-tuple of an endpoint with a fully specified peer.
+    struct FourTuple
+    {
+        Ipv6Address localAddress; //!< Local address
+        Ipv6Address peerAddress;  //!< Peer address
+        uint16_t localPort;       //!< Local port
+        uint16_t peerPort;        //!< Peer port
+
+        /**
+         * @brief Compare two four-tuples.
+         * @param other the other four-tuple
+         * @return true if the four-tuples are equal
+         */
+        bool operator==(const FourTuple& other) const = default;
+    };
+
+    /// Hash function of the four-tuples.
+    struct FourTupleHash
+    {
+        /**
+         * @brief Hash a four-tuple.
+         * @param tuple the four-tuple
+         * @return the hash
+         */
+        std::size_t operator()(const FourTuple& tuple) const;
+    };
+
+    /**
+     * @brief Get the four-tuple of an endpoint.
+     * @param endPoint the endpoint
+     * @return the four-tuple
+     */
+    static FourTuple GetFourTuple(const Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Check whether the peer of an endpoint is fully specified.
+     * @param endPoint the endpoint
+     * @return true if both the peer address and port are set
+     */
+    static bool IsConnected(const Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Add a new endpoint to the demux.
+     * @param endPoint the endpoint
+     * @return the endpoint
+     */
+    Ipv6EndPoint* Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Add an endpoint to the lookup tables.
+     * @param endPoint the endpoint
+     */
+    void Index(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Remove an endpoint from the lookup tables.
+     * @param endPoint the endpoint
+     */
+    void Unindex(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Check whether an endpoint matches a packet, and add it to the
+     *        list of its kind of match.
+     * @param endP the endpoint
+     * @param daddr destination address to test
+     * @param dport destination port to test
+     * @param saddr source address to test
+     * @param sport source port to test
+     * @param incomingInterface the incoming interface
+     * @param retvals the lists of matching endpoints, from the least to the
+     *        most exact kind of match
+     */
+    static void Match(Ipv6EndPoint* endP,
+                      Ipv6Address daddr,
+                      uint16_t dport,
+                      Ipv6Address saddr,
+                      uint16_t sport,
+                      Ptr<Ipv6Interface> incomingInterface,
+                      std::array<EndPoints, 4>& retvals);
+
     /**
      * @brief Allocate a ephemeral port.
      * @return a port
      */
     uint16_t AllocateEphemeralPort();
 
+    /**
+     * @brief Find a free ephemeral port in a range of the bitmap.
+     * @param from the first index to search
+     * @param to the index after the last one to search
+     * @returns the index of the port, or \p to if they are all in use
+     */
+    uint32_t FindFreeEphemeralPort(uint32_t from, uint32_t to) const;
+
     /**
      * @brief The ephemeral port.
      */
@@ -175,6 +274,31 @@ class Ipv6EndPointDemux
      * @brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The position of each end point in the list.
+     */
+    std::unordered_map<Ipv6EndPoint*, EndPointsI> m_positions;
+
+    /**
+     * @brief The end points with a fully specified peer, by four-tuple.
+     */
+    std::unordered_multimap<FourTuple, Ipv6EndPoint*, FourTupleHash> m_connected;
+
+    /**
+     * @brief The other end points, by local port.
+     */
+    std::unordered_map<uint16_t, std::vector<Ipv6EndPoint*>> m_wildcard;
+
+    /**
+     * @brief The number of end points using each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_portUsers;
+
+    /**
+     * @brief Bitmap of the ephemeral ports in use, allocated on first use.
+     */
+    std::vector<uint64_t> m_ephemeralPorts;
 };
 
 } /* namespace ns3 */
@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv6EndPointDemux;
 class Packet;
 
 /**
@@ -184,6 +185,15 @@ class Ipv6EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv6EndPointDemux;
+
+    /**
+     * @brief The demux which indexes this endpoint, if any.
+     *
+     * The demux is notified when the four-tuple of the endpoint changes.
+     */
+    Ipv6EndPointDemux* m_demux;
+
     /**
      * @brief The local address.
      */
@@ -17,6 +17,9 @@
 #include "ns3/node.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <map>
+
 namespace ns3
 {
 
@@ -90,13 +93,23 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    auto it = m_ndCache.find(dst);
+    if (it != m_ndCache.end())
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = it->second;
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
     }
+    if (m_sharedTable)
+    {
+        const Address* macAddress = m_sharedTable->Lookup(dst);
+        if (macAddress && IsSharedNeighbor(dst, *macAddress))
+        {
+            NS_LOG_LOGIC("Found a shared entry");
+            return AddShared(dst, *macAddress);
+        }
+    }
     NS_LOG_LOGIC("Nothing found");
     return nullptr;
 }
@@ -107,10 +120,20 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    if (m_sharedTable)
     {
-        NdiscCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == dst)
+        for (const auto& address : m_sharedTable->LookupInverse(dst))
+        {
+            if (m_ndCache.find(address) == m_ndCache.end() && IsSharedNeighbor(address, dst))
+            {
+                AddShared(address, dst);
+            }
+        }
+    }
+    auto it = m_macIndex.find(dst);
+    if (it != m_macIndex.end())
+    {
+        for (NdiscCache::Entry* entry : it->second)
         {
             NS_LOG_LOGIC("Found an entry:" << (*entry));
             entryList.push_back(entry);
@@ -136,15 +159,13 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && i->second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
-        }
+        m_ndCache.erase(i);
+        UnindexMacAddress(entry);
+        entry->ClearWaitingPacket();
+        delete entry;
     }
 }
 
@@ -159,6 +180,8 @@ NdiscCache::Flush()
     }
 
     m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_macIndex.clear();
+    m_sharedTable = nullptr;
 }
 
 void
@@ -181,8 +204,40 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // The entries are printed in the order of their addresses, and the
+    // bindings of the shared table as auto-generated entries
+    std::map<Ipv6Address, NdiscCache::Entry*> entries(m_ndCache.begin(), m_ndCache.end());
+    std::map<Ipv6Address, Address> shared;
+    if (m_sharedTable)
+    {
+        for (const auto& [address, macAddress] : m_sharedTable->GetBindings())
+        {
+            if (entries.find(address) == entries.end() && IsSharedNeighbor(address, macAddress))
+            {
+                shared[address] = macAddress;
+            }
+        }
+    }
+    auto j = shared.begin();
+    for (auto i = entries.begin(); i != entries.end() || j != shared.end();)
     {
+        if (j != shared.end() && (i == entries.end() || j->first < i->first))
+        {
+            *os << j->first << " dev ";
+            std::string found = Names::FindName(m_device);
+            if (!found.empty())
+            {
+                *os << found;
+            }
+            else
+            {
+                *os << static_cast<int>(m_device->GetIfIndex());
+            }
+            *os << " lladdr " << j->second << " STATIC_AUTOGENERATED\n";
+            j++;
+            continue;
+        }
+
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
         if (!Names::FindName(m_device).empty())
@@ -229,6 +284,7 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
             NS_FATAL_ERROR("Test for possibly unreachable code-- please file a bug report, with a "
                            "test case, if this is ever hit");
         }
+        i++;
     }
 }
 
@@ -238,7 +294,8 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
       m_router(false),
       m_nudTimer(Timer::CANCEL_ON_DESTROY),
       m_lastReachabilityConfirmation(),
-      m_nsRetransmit(0)
+      m_nsRetransmit(0),
+      m_reachableTimer(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -283,6 +340,14 @@ void
 NdiscCache::Entry::FunctionReachableTimeout()
 {
     NS_LOG_FUNCTION(this);
+    // The reachability may have been confirmed since the timer was armed
+    Time left = m_lastReachabilityConfirmation + m_nudTimer.GetDelay() - Simulator::Now();
+    if (left.IsStrictlyPositive())
+    {
+        m_nudTimer.Schedule(left);
+        return;
+    }
+    m_reachableTimer = false;
     this->MarkStale();
 }
 
@@ -464,6 +529,7 @@ NdiscCache::Entry::StartReachableTimer()
     }
 
     m_lastReachabilityConfirmation = Simulator::Now();
+    m_reachableTimer = true;
     m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
     m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
     m_nudTimer.Schedule();
@@ -477,6 +543,11 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
+        if (m_reachableTimer && m_nudTimer.IsRunning())
+        {
+            // FunctionReachableTimeout will arm the timer again
+            return;
+        }
         if (m_nudTimer.IsRunning())
         {
             m_nudTimer.Cancel();
@@ -494,6 +565,7 @@ NdiscCache::Entry::StartProbeTimer()
         m_nudTimer.Cancel();
     }
 
+    m_reachableTimer = false;
     m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
     m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
     m_nudTimer.Schedule();
@@ -508,6 +580,7 @@ NdiscCache::Entry::StartDelayTimer()
         m_nudTimer.Cancel();
     }
 
+    m_reachableTimer = false;
     m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
     m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
     m_nudTimer.Schedule();
@@ -522,6 +595,7 @@ NdiscCache::Entry::StartRetransmitTimer()
         m_nudTimer.Cancel();
     }
 
+    m_reachableTimer = false;
     m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
     m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
     m_nudTimer.Schedule();
@@ -532,6 +606,7 @@ NdiscCache::Entry::StopNudTimer()
 {
     NS_LOG_FUNCTION(this);
     m_nudTimer.Cancel();
+    m_reachableTimer = false;
     m_nsRetransmit = 0;
 }
 
@@ -552,6 +627,7 @@ NdiscCache::Entry::MarkReachable(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = REACHABLE;
+    m_ndCache->ReindexMacAddress(this, m_macAddress, mac);
     m_macAddress = mac;
     return m_waiting;
 }
@@ -582,6 +658,7 @@ NdiscCache::Entry::MarkStale(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = STALE;
+    m_ndCache->ReindexMacAddress(this, m_macAddress, mac);
     m_macAddress = mac;
     return m_waiting;
 }
@@ -669,6 +746,7 @@ void
 NdiscCache::Entry::SetMacAddress(Address mac)
 {
     NS_LOG_FUNCTION(this << mac << int(m_state));
+    m_ndCache->ReindexMacAddress(this, m_macAddress, mac);
     m_macAddress = mac;
 }
 
@@ -711,12 +789,128 @@ NdiscCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearWaitingPacket();
+            UnindexMacAddress(i->second);
             delete i->second;
-            m_ndCache.erase(i++);
+            i = m_ndCache.erase(i);
             continue;
         }
         i++;
     }
+    m_sharedTable = nullptr;
+}
+
+void
+NdiscCache::SetSharedTable(Ptr<SharedTable> table)
+{
+    NS_LOG_FUNCTION(this << table);
+    m_sharedTable = table;
+    if (!m_sharedTable)
+    {
+        return;
+    }
+    // The bindings of the table take precedence over the existing entries
+    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    {
+        const Address* macAddress = m_sharedTable->Lookup(i->first);
+        if (macAddress && IsSharedNeighbor(i->first, *macAddress))
+        {
+            i->second->SetMacAddress(*macAddress);
+            i->second->MarkAutoGenerated();
+        }
+    }
+}
+
+Ptr<NdiscCache::SharedTable>
+NdiscCache::GetSharedTable() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_sharedTable;
+}
+
+bool
+NdiscCache::IsOnLink(Ipv6Address to) const
+{
+    NS_LOG_FUNCTION(this << to);
+    for (uint32_t i = 0; i < m_interface->GetNAddresses(); i++)
+    {
+        Ipv6InterfaceAddress ifAddr = m_interface->GetAddress(i);
+        if (ifAddr.GetScope() != Ipv6InterfaceAddress::LINKLOCAL &&
+            ifAddr.GetScope() != Ipv6InterfaceAddress::HOST && ifAddr.IsInSameSubnet(to))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+NdiscCache::IsSharedNeighbor(Ipv6Address to, const Address& macAddress) const
+{
+    NS_LOG_FUNCTION(this << to << macAddress);
+    if (m_device && macAddress == m_device->GetAddress())
+    {
+        return false;
+    }
+    if (!m_interface)
+    {
+        return true;
+    }
+    if (!to.IsLinkLocal())
+    {
+        return IsOnLink(to);
+    }
+    // A link-local address is seen along with an on-link global address of the neighbor
+    for (const auto& address : m_sharedTable->LookupInverse(macAddress))
+    {
+        if (!address.IsLinkLocal() && IsOnLink(address))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+NdiscCache::Entry*
+NdiscCache::AddShared(Ipv6Address to, const Address& macAddress)
+{
+    NS_LOG_FUNCTION(this << to << macAddress);
+    NdiscCache::Entry* entry = Add(to);
+    entry->SetMacAddress(macAddress);
+    entry->MarkAutoGenerated();
+    return entry;
+}
+
+void
+NdiscCache::ReindexMacAddress(NdiscCache::Entry* entry,
+                              const Address& oldAddress,
+                              const Address& newAddress)
+{
+    NS_LOG_FUNCTION(this << entry << oldAddress << newAddress);
+    if (oldAddress == newAddress)
+    {
+        return;
+    }
+    auto it = m_macIndex.find(oldAddress);
+    if (it != m_macIndex.end())
+    {
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), entry),
+                         it->second.end());
+        if (it->second.empty())
+        {
+            m_macIndex.erase(it);
+        }
+    }
+    if (!newAddress.IsInvalid())
+    {
+        m_macIndex[newAddress].push_back(entry);
+    }
+}
+
+void
+NdiscCache::UnindexMacAddress(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    ReindexMacAddress(entry, entry->GetMacAddress(), Address());
 }
 
 std::ostream&
@@ -9,6 +9,8 @@
 #ifndef NDISC_CACHE_H
 #define NDISC_CACHE_H
 
+#include "shared-neighbor-table.h"
+
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
@@ -18,8 +20,9 @@
 #include "ns3/timer.h"
 
 #include <list>
-#include <map>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -33,6 +36,10 @@ class Icmpv6L4Protocol;
  * @ingroup ipv6
  *
  * @brief IPv6 Neighbor Discovery cache.
+ *
+ * The entries are hashed by IPv6 address, and indexed by MAC address for
+ * LookupInverse.  The cache can also reference a SharedTable of the
+ * bindings of a channel, built by NeighborCacheHelper.
  */
 class NdiscCache : public Object
 {
@@ -142,6 +149,32 @@ class NdiscCache : public Object
      */
     void RemoveAutoGeneratedEntries();
 
+    /**
+     * @brief Bindings of the interfaces of a channel, shared by their NDISC caches
+     */
+    typedef SharedNeighborTable<Ipv6Address, Ipv6AddressHash> SharedTable;
+
+    /**
+     * @brief Reference a table of auto-generated bindings
+     *
+     * The bindings of the table are seen as STATIC_AUTOGENERATED entries of
+     * this cache, except the ones of the device of this cache and the ones
+     * outside of the subnets of its interface.  The link-local bindings are
+     * seen for the neighbors which have a global address in one of these
+     * subnets.  The existing entries of the cache for these bindings are
+     * turned into auto-generated entries.  The table is dropped by Flush()
+     * and RemoveAutoGeneratedEntries().
+     *
+     * @param table the table, or nullptr to drop the current one
+     */
+    void SetSharedTable(Ptr<SharedTable> table);
+
+    /**
+     * @brief Get the table of auto-generated bindings referenced by this cache
+     * @return the table, or nullptr if none
+     */
+    Ptr<SharedTable> GetSharedTable() const;
+
     /**
      * @brief Pair of a packet and an Ipv4 header.
      */
@@ -435,6 +468,15 @@ class NdiscCache : public Object
          * @brief Number of NS retransmission.
          */
         uint8_t m_nsRetransmit;
+
+        /**
+         * @brief Whether m_nudTimer is the reachable timer.
+         *
+         * The reachable timer is not rescheduled on each reachability
+         * confirmation: when it expires, it is armed again for the time
+         * left since the last confirmation.
+         */
+        bool m_reachableTimer;
     };
 
   protected:
@@ -446,11 +488,11 @@ class NdiscCache : public Object
     /**
      * @brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * @brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     /**
      * @brief A list of Entry.
@@ -458,6 +500,56 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * @brief Update the MAC address index when the MAC address of an entry changes
+     * @param entry the entry
+     * @param oldAddress the previous MAC address of the entry
+     * @param newAddress the new MAC address of the entry
+     */
+    void ReindexMacAddress(NdiscCache::Entry* entry,
+                           const Address& oldAddress,
+                           const Address& newAddress);
+
+    /**
+     * @brief Remove an entry from the MAC address index
+     * @param entry the entry
+     */
+    void UnindexMacAddress(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Check whether a global address is in the subnet of one of the
+     * global addresses of the interface
+     * @param to the address
+     * @return true if the address is on-link
+     */
+    bool IsOnLink(Ipv6Address to) const;
+
+    /**
+     * @brief Check whether a binding of the shared table is a neighbor of this cache
+     * @param to the IPv6 address of the binding
+     * @param macAddress the MAC address of the binding
+     * @return true if the binding is seen as an entry of this cache
+     */
+    bool IsSharedNeighbor(Ipv6Address to, const Address& macAddress) const;
+
+    /**
+     * @brief Turn a binding of the shared table into an auto-generated entry
+     * @param to the IPv6 address of the binding
+     * @param macAddress the MAC address of the binding
+     * @return the new entry
+     */
+    NdiscCache::Entry* AddShared(Ipv6Address to, const Address& macAddress);
+
+    /**
+     * @brief Entries by MAC address.
+     */
+    std::unordered_map<Address, std::vector<NdiscCache::Entry*>, AddressHash> m_macIndex;
+
+    /**
+     * @brief Auto-generated bindings of the channel.
+     */
+    Ptr<SharedTable> m_sharedTable;
+
     /**
      * @brief The NetDevice.
      */
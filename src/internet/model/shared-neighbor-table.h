@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SHARED_NEIGHBOR_TABLE_H
+#define SHARED_NEIGHBOR_TABLE_H
+
+#include "ns3/address.h"
+#include "ns3/simple-ref-count.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup internet
+ * ns3::SharedNeighborTable declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup internet
+ * @brief The layer 3 to layer 2 address bindings of the interfaces attached
+ * to a channel.
+ *
+ * NeighborCacheHelper can build one table per channel, which the ARP and
+ * NDISC caches of the populated interfaces then reference instead of holding
+ * one entry per neighbor.  A cache turns a binding into one of its own
+ * entries only when it is looked up, so that the memory used by a subnet of
+ * N hosts is O(N) plus the entries actually in use, instead of O(N^2).
+ *
+ * The table holds the bindings of all the interfaces of the channel,
+ * including the one of the cache which references it: each cache filters
+ * out the bindings which are not its neighbors.
+ *
+ * @tparam L3Address \explicit The layer 3 address type.
+ * @tparam L3AddressHash \explicit The hash function of the layer 3 addresses.
+ */
+template <typename L3Address, typename L3AddressHash>
+class SharedNeighborTable : public SimpleRefCount<SharedNeighborTable<L3Address, L3AddressHash>>
+{
+  public:
+    /// The bindings, indexed by layer 3 address
+    using Bindings = std::unordered_map<L3Address, Address, L3AddressHash>;
+
+    /**
+     * Add a binding, or replace the layer 2 address of an existing one
+     * @param address the layer 3 address
+     * @param macAddress the layer 2 address
+     */
+    void Add(L3Address address, const Address& macAddress)
+    {
+        auto [it, inserted] = m_bindings.insert({address, macAddress});
+        if (!inserted)
+        {
+            if (it->second == macAddress)
+            {
+                return;
+            }
+            RemoveInverse(address, it->second);
+            it->second = macAddress;
+        }
+        m_inverse[macAddress].push_back(address);
+    }
+
+    /**
+     * Remove a binding, if present
+     * @param address the layer 3 address
+     */
+    void Remove(L3Address address)
+    {
+        auto it = m_bindings.find(address);
+        if (it != m_bindings.end())
+        {
+            RemoveInverse(address, it->second);
+            m_bindings.erase(it);
+        }
+    }
+
+    /**
+     * @param address the layer 3 address
+     * @returns the layer 2 address bound to the address, or nullptr if none
+     */
+    const Address* Lookup(L3Address address) const
+    {
+        auto it = m_bindings.find(address);
+        return it != m_bindings.end() ? &it->second : nullptr;
+    }
+
+    /**
+     * @param macAddress the layer 2 address
+     * @returns the layer 3 addresses bound to the layer 2 address
+     */
+    std::vector<L3Address> LookupInverse(const Address& macAddress) const
+    {
+        auto it = m_inverse.find(macAddress);
+        return it != m_inverse.end() ? it->second : std::vector<L3Address>();
+    }
+
+    /**
+     * @returns all the bindings
+     */
+    const Bindings& GetBindings() const
+    {
+        return m_bindings;
+    }
+
+  private:
+    /**
+     * Remove a binding from the inverse index
+     * @param address the layer 3 address
+     * @param macAddress the layer 2 address
+     */
+    void RemoveInverse(L3Address address, const Address& macAddress)
+    {
+        auto it = m_inverse.find(macAddress);
+        if (it == m_inverse.end())
+        {
+            return;
+        }
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), address),
+                         it->second.end());
+        if (it->second.empty())
+        {
+            m_inverse.erase(it);
+        }
+    }
+
+    Bindings m_bindings; //!< Layer 2 address of each layer 3 address
+    std::unordered_map<Address, std::vector<L3Address>, AddressHash>
+        m_inverse; //!< Layer 3 addresses of each layer 2 address
+};
+
+} // namespace ns3
+
+#endif /* SHARED_NEIGHBOR_TABLE_H */
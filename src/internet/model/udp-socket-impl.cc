@@ -838,6 +838,54 @@ UdpSocketImpl::SendTo(Ptr<Packet> p, uint32_t flags, const Address& address)
     return -1;
 }
 
+int
+UdpSocketImpl::SendBatch(std::span<const Ptr<Packet>> packets, uint32_t flags)
+{
+    NS_LOG_FUNCTION(this << packets.size() << flags);
+
+    if (!m_connected)
+    {
+        m_errno = ERROR_NOTCONN;
+        return -1;
+    }
+    if (packets.empty())
+    {
+        return 0;
+    }
+
+    // The first packet binds the socket if needed; the destination of the
+    // others is resolved once.
+    if (DoSend(packets[0]) < 0)
+    {
+        return -1;
+    }
+    int sent = 1;
+    if (Ipv4Address::IsMatchingType(m_defaultAddress))
+    {
+        Ipv4Address dest = Ipv4Address::ConvertFrom(m_defaultAddress);
+        uint8_t tos = GetIpTos();
+        for (; sent < static_cast<int>(packets.size()); ++sent)
+        {
+            if (DoSendTo(packets[sent], dest, m_defaultPort, tos) < 0)
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        Ipv6Address dest = Ipv6Address::ConvertFrom(m_defaultAddress);
+        for (; sent < static_cast<int>(packets.size()); ++sent)
+        {
+            if (DoSendTo(packets[sent], dest, m_defaultPort) < 0)
+            {
+                break;
+            }
+        }
+    }
+    return sent;
+}
+
 uint32_t
 UdpSocketImpl::GetRxAvailable() const
 {
@@ -882,6 +930,30 @@ UdpSocketImpl::RecvFrom(uint32_t maxSize, uint32_t flags, Address& fromAddress)
     return p;
 }
 
+uint32_t
+UdpSocketImpl::RecvBatch(std::span<Ptr<Packet>> packets,
+                         std::span<Address> fromAddresses,
+                         uint32_t flags)
+{
+    NS_LOG_FUNCTION(this << packets.size() << flags);
+    NS_ASSERT_MSG(fromAddresses.size() >= packets.size(), "Address array too small");
+
+    uint32_t received = 0;
+    while (received < packets.size() && !m_deliveryQueue.empty())
+    {
+        packets[received] = m_deliveryQueue.front().first;
+        fromAddresses[received] = m_deliveryQueue.front().second;
+        m_rxAvailable -= packets[received]->GetSize();
+        m_deliveryQueue.pop();
+        ++received;
+    }
+    if (received == 0)
+    {
+        m_errno = ERROR_AGAIN;
+    }
+    return received;
+}
+
 int
 UdpSocketImpl::GetSockName(Address& address) const
 {
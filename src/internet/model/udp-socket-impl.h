@@ -96,9 +96,13 @@ class UdpSocketImpl : public UdpSocket
     uint32_t GetTxAvailable() const override;
     int Send(Ptr<Packet> p, uint32_t flags) override;
     int SendTo(Ptr<Packet> p, uint32_t flags, const Address& address) override;
+    int SendBatch(std::span<const Ptr<Packet>> packets, uint32_t flags) override;
     uint32_t GetRxAvailable() const override;
     Ptr<Packet> Recv(uint32_t maxSize, uint32_t flags) override;
     Ptr<Packet> RecvFrom(uint32_t maxSize, uint32_t flags, Address& fromAddress) override;
+    uint32_t RecvBatch(std::span<Ptr<Packet>> packets,
+                       std::span<Address> fromAddresses,
+                       uint32_t flags) override;
     int GetSockName(Address& address) const override;
     int GetPeerName(Address& address) const override;
     int MulticastJoinGroup(uint32_t interfaceIndex, const Address& groupAddress) override;
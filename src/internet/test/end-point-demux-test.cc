@@ -0,0 +1,252 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv4EndPointDemux lookup test.
+ *
+ * Checks that a packet is delivered to the most specific end point, among
+ * many connected ones, and that the end points are found again after their
+ * peer changes.
+ */
+class Ipv4EndPointDemuxLookupTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxLookupTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxLookupTestCase::Ipv4EndPointDemuxLookupTestCase()
+    : TestCase("Ipv4EndPointDemux lookup")
+{
+}
+
+void
+Ipv4EndPointDemuxLookupTestCase::DoRun()
+{
+    Ipv4EndPointDemux demux;
+    Ipv4Address local("10.1.1.1");
+    Ipv4Address peerBase("10.2.0.0");
+
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Could not allocate the listening end point");
+
+    std::vector<Ipv4EndPoint*> connected;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        Ipv4Address peer(peerBase.Get() + i);
+        Ipv4EndPoint* endPoint = demux.Allocate(nullptr, local, 80, peer, 1024 + i);
+        NS_TEST_ASSERT_MSG_NE(endPoint, nullptr, "Could not allocate a connected end point");
+        connected.push_back(endPoint);
+    }
+
+    Ipv4EndPoint* duplicate = demux.Allocate(nullptr, local, 80, peerBase, 1024);
+    NS_TEST_EXPECT_MSG_EQ(duplicate, nullptr, "A duplicated end point has been allocated");
+
+    Ipv4EndPointDemux::EndPoints found =
+        demux.Lookup(local, 80, Ipv4Address(peerBase.Get() + 500), 1524, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), connected[500], "The connected end point is not found");
+
+    found = demux.Lookup(local, 80, Ipv4Address(peerBase.Get() + 500), 1525, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), listener, "The listening end point is not found");
+
+    found = demux.Lookup(local, 81, Ipv4Address(peerBase.Get() + 500), 1524, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(found.empty(), true, "An end point is found for an unused port");
+
+    // Move a connected end point to a new peer
+    connected[500]->SetPeer(Ipv4Address("10.3.0.1"), 2000);
+    found = demux.Lookup(local, 80, Ipv4Address(peerBase.Get() + 500), 1524, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), listener, "The old peer is still connected");
+    found = demux.Lookup(local, 80, Ipv4Address("10.3.0.1"), 2000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), connected[500], "The new peer is not connected");
+
+    // A connected end point with a wildcard local address
+    Ipv4EndPoint* anyLocal = demux.Allocate(nullptr, Ipv4Address::GetAny(), 80);
+    NS_TEST_ASSERT_MSG_EQ(anyLocal, nullptr, "A duplicated end point has been allocated");
+    anyLocal = demux.Allocate(nullptr, Ipv4Address::GetAny(), 80, Ipv4Address("10.3.0.2"), 2000);
+    NS_TEST_ASSERT_MSG_NE(anyLocal, nullptr, "Could not allocate a connected end point");
+    found = demux.Lookup(local, 80, Ipv4Address("10.3.0.2"), 2000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), anyLocal, "The connected end point is not found");
+
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), true, "The port is not in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupLocal(nullptr, local, 80),
+                          true,
+                          "The connected end points are not found");
+
+    demux.DeAllocate(listener);
+    found = demux.Lookup(local, 80, Ipv4Address(peerBase.Get() + 1), 1024, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(found.empty(), true, "The listening end point is still found");
+    for (auto endPoint : connected)
+    {
+        demux.DeAllocate(endPoint);
+    }
+    demux.DeAllocate(anyLocal);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), false, "The port is still in use");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv6EndPointDemux lookup test.
+ *
+ * Checks that a packet is delivered to the most specific end point, among
+ * many connected ones, and that the end points are found again after their
+ * local port changes.
+ */
+class Ipv6EndPointDemuxLookupTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxLookupTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxLookupTestCase::Ipv6EndPointDemuxLookupTestCase()
+    : TestCase("Ipv6EndPointDemux lookup")
+{
+}
+
+void
+Ipv6EndPointDemuxLookupTestCase::DoRun()
+{
+    Ipv6EndPointDemux demux;
+    Ipv6Address local("2001:1::1");
+    Ipv6Address peer("2001:2::1");
+
+    Ipv6EndPoint* listener = demux.Allocate(nullptr, local, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Could not allocate the listening end point");
+
+    std::vector<Ipv6EndPoint*> connected;
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        Ipv6EndPoint* endPoint = demux.Allocate(nullptr, local, 80, peer, 1024 + i);
+        NS_TEST_ASSERT_MSG_NE(endPoint, nullptr, "Could not allocate a connected end point");
+        connected.push_back(endPoint);
+    }
+
+    Ipv6EndPoint* duplicate = demux.Allocate(nullptr, local, 80, peer, 1024);
+    NS_TEST_EXPECT_MSG_EQ(duplicate, nullptr, "A duplicated end point has been allocated");
+
+    Ipv6EndPointDemux::EndPoints found = demux.Lookup(local, 80, peer, 1524, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), connected[500], "The connected end point is not found");
+
+    found = demux.Lookup(local, 80, peer, 3000, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), listener, "The listening end point is not found");
+
+    // Move a connected end point to a new local port
+    connected[500]->SetLocalPort(8080);
+    found = demux.Lookup(local, 80, peer, 1524, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), listener, "The old port is still connected");
+    found = demux.Lookup(local, 8080, peer, 1524, nullptr);
+    NS_TEST_ASSERT_MSG_EQ(found.size(), 1U, "Wrong number of end points found");
+    NS_TEST_EXPECT_MSG_EQ(found.front(), connected[500], "The new port is not connected");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(8080), true, "The new port is not in use");
+
+    demux.DeAllocate(connected[500]);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(8080), false, "The new port is still in use");
+    found = demux.Lookup(local, 8080, peer, 1524, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(found.empty(), true, "A deallocated end point is still found");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv4EndPointDemux ephemeral port allocation test.
+ *
+ * Checks that the ephemeral ports are allocated in sequence, skipping the
+ * ports in use, and that the allocation wraps around the port range.
+ */
+class Ipv4EndPointDemuxEphemeralTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxEphemeralTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxEphemeralTestCase::Ipv4EndPointDemuxEphemeralTestCase()
+    : TestCase("Ipv4EndPointDemux ephemeral ports")
+{
+}
+
+void
+Ipv4EndPointDemuxEphemeralTestCase::DoRun()
+{
+    Ipv4EndPointDemux demux;
+    std::vector<Ipv4EndPoint*> endPoints;
+
+    Ipv4EndPoint* bound = demux.Allocate(nullptr, 49155);
+    NS_TEST_ASSERT_MSG_NE(bound, nullptr, "Could not allocate the end point");
+
+    for (uint16_t expected : {49153, 49154, 49156})
+    {
+        Ipv4EndPoint* endPoint = demux.Allocate();
+        NS_TEST_ASSERT_MSG_NE(endPoint, nullptr, "Could not allocate an ephemeral port");
+        uint16_t port = endPoint->GetLocalPort();
+        NS_TEST_EXPECT_MSG_EQ(port, expected, "Unexpected ephemeral port");
+        endPoints.push_back(endPoint);
+    }
+
+    // Exhaust the range: 49152 to 65535, less the four ports in use
+    uint32_t allocated = 0;
+    while (Ipv4EndPoint* endPoint = demux.Allocate())
+    {
+        endPoints.push_back(endPoint);
+        allocated++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(allocated, 16384U - 4, "Wrong number of ephemeral ports");
+
+    // A released port is found again, after wrapping around the range
+    auto released = std::find_if(endPoints.begin(), endPoints.end(), [](Ipv4EndPoint* endPoint) {
+        return endPoint->GetLocalPort() == 50000;
+    });
+    NS_TEST_ASSERT_MSG_EQ((released != endPoints.end()), true, "Port 50000 not allocated");
+    demux.DeAllocate(*released);
+    Ipv4EndPoint* endPoint = demux.Allocate();
+    NS_TEST_ASSERT_MSG_NE(endPoint, nullptr, "Could not allocate an ephemeral port");
+    uint16_t port = endPoint->GetLocalPort();
+    NS_TEST_EXPECT_MSG_EQ(port, 50000, "Unexpected ephemeral port");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief End point demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxLookupTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxLookupTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv4EndPointDemuxEphemeralTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -338,6 +338,60 @@ AddressCollisionTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(added, false, "404");
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 address range collision Test
+ */
+class AddressRangeCollisionTestCase : public TestCase
+{
+  public:
+    AddressRangeCollisionTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+AddressRangeCollisionTestCase::AddressRangeCollisionTestCase()
+    : TestCase("Make sure that the address collision logic works with ranges.")
+{
+}
+
+void
+AddressRangeCollisionTestCase::DoTeardown()
+{
+    Ipv4AddressGenerator::Reset();
+    Simulator::Destroy();
+}
+
+void
+AddressRangeCollisionTestCase::DoRun()
+{
+    Ipv4AddressGenerator::AddAllocated("0.0.0.5");
+    Ipv4AddressGenerator::AddAllocatedRange("0.0.0.10", "0.0.0.19");
+    Ipv4AddressGenerator::AddAllocatedRange("0.0.0.6", "0.0.0.9");
+
+    Ipv4AddressGenerator::TestMode();
+    bool allocated = Ipv4AddressGenerator::IsAddressAllocated("0.0.0.15");
+    NS_TEST_EXPECT_MSG_EQ(allocated, true, "0.0.0.15 should be already allocated");
+    allocated = Ipv4AddressGenerator::IsAddressAllocated("0.0.0.20");
+    NS_TEST_EXPECT_MSG_EQ(allocated, false, "0.0.0.20 should not be already allocated");
+
+    bool added = Ipv4AddressGenerator::AddAllocated("0.0.0.19");
+    NS_TEST_EXPECT_MSG_EQ(added, false, "500");
+    added = Ipv4AddressGenerator::AddAllocated("0.0.0.20");
+    NS_TEST_EXPECT_MSG_EQ(added, true, "501");
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.1", "0.0.0.5");
+    NS_TEST_EXPECT_MSG_EQ(added, false, "502");
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.18", "0.0.0.30");
+    NS_TEST_EXPECT_MSG_EQ(added, false, "503");
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.1", "0.0.0.4");
+    NS_TEST_EXPECT_MSG_EQ(added, true, "504");
+    added = Ipv4AddressGenerator::AddAllocatedRange("0.0.0.21", "0.0.0.30");
+    NS_TEST_EXPECT_MSG_EQ(added, true, "505");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -359,6 +413,7 @@ Ipv4AddressGeneratorTestSuite::Ipv4AddressGeneratorTestSuite()
     AddTestCase(new NetworkAndAddressTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new ExampleAddressGeneratorTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new AddressCollisionTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new AddressRangeCollisionTestCase(), TestCase::Duration::QUICK);
 }
 
 static Ipv4AddressGeneratorTestSuite
@@ -1210,6 +1210,146 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Shared Neighbor Cache Test
+ */
+class SharedTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    SharedTest();
+
+  private:
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+SharedTest::SharedTest()
+    : TestCase("The SharedTest checks that the caches referencing the table of their channel "
+               "see the same entries as populated caches.")
+{
+}
+
+void
+SharedTest::DoRun()
+{
+    m_nodes.Create(3);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer net = simpleHelper.Install(m_nodes.Get(0), channel);
+    net.Add(simpleHelper.Install(m_nodes.Get(1), channel));
+
+    Ptr<SimpleChannel> channel2 = CreateObject<SimpleChannel>();
+    SimpleNetDeviceHelper simpleHelper2;
+    NetDeviceContainer net2 = simpleHelper.Install(m_nodes.Get(1), channel2);
+    net2.Add(simpleHelper2.Install(m_nodes.Get(2), channel2));
+
+    InternetStackHelper internet;
+    internet.Install(m_nodes);
+
+    // Setup IPv4 addresses
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.252");
+    Ipv4InterfaceContainer i = ipv4.Assign(net);
+    ipv4.SetBase("10.1.2.0", "255.255.255.252");
+    Ipv4InterfaceContainer i2 = ipv4.Assign(net2);
+
+    // Setup IPv6 addresses
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001:0::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer icv61 = ipv6.Assign(net);
+    ipv6.SetBase(Ipv6Address("2001:1::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer icv62 = ipv6.Assign(net2);
+
+    // Populate neighbor caches with shared tables.
+    NeighborCacheHelper neighborCache;
+    neighborCache.SetSharedNeighborCache(true);
+    neighborCache.PopulateNeighborCache();
+
+    Ptr<ArpCache> arpCache0 =
+        DynamicCast<Ipv4L3Protocol>(i.Get(0).first)->GetInterface(i.Get(0).second)->GetArpCache();
+    Ptr<ArpCache> arpCache1 =
+        DynamicCast<Ipv4L3Protocol>(i.Get(1).first)->GetInterface(i.Get(1).second)->GetArpCache();
+    NS_TEST_ASSERT_MSG_NE(arpCache0->GetSharedTable(), nullptr, "No shared table.");
+    NS_TEST_EXPECT_MSG_EQ(arpCache0->GetSharedTable(),
+                          arpCache1->GetSharedTable(),
+                          "The caches of a channel do not share their table.");
+
+    // Lookups see the neighbors only
+    NS_TEST_EXPECT_MSG_EQ(arpCache0->Lookup(Ipv4Address("10.1.1.1")),
+                          nullptr,
+                          "The cache sees its own address.");
+    NS_TEST_EXPECT_MSG_EQ(arpCache1->Lookup(Ipv4Address("10.1.2.2")),
+                          nullptr,
+                          "The cache sees an address of another channel.");
+    std::list<ArpCache::Entry*> entries = arpCache0->LookupInverse(net.Get(1)->GetAddress());
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 1, "Wrong number of entries for the MAC address.");
+    NS_TEST_EXPECT_MSG_EQ(entries.front()->GetIpv4Address(),
+                          Ipv4Address("10.1.1.2"),
+                          "Wrong entry for the MAC address.");
+    NS_TEST_EXPECT_MSG_EQ(entries.front()->IsAutoGenerated(), true, "Wrong entry state.");
+    NS_TEST_EXPECT_MSG_EQ(arpCache0->Lookup(Ipv4Address("10.1.1.2")),
+                          entries.front(),
+                          "The entry made out of the table is not kept.");
+
+    Ptr<NdiscCache> ndiscCache0 = DynamicCast<Ipv6L3Protocol>(icv61.Get(0).first)
+                                      ->GetInterface(icv61.Get(0).second)
+                                      ->GetNdiscCache();
+    NdiscCache::Entry* ndiscEntry = ndiscCache0->Lookup(Ipv6Address("fe80::200:ff:fe00:2"));
+    NS_TEST_ASSERT_MSG_NE(ndiscEntry, nullptr, "The cache does not see a link-local neighbor.");
+    NS_TEST_EXPECT_MSG_EQ(ndiscEntry->GetMacAddress(),
+                          net.Get(1)->GetAddress(),
+                          "Wrong MAC address for the link-local neighbor.");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache0->Lookup(Ipv6Address("2001:1::200:ff:fe00:4")),
+                          nullptr,
+                          "The cache sees an address of another channel.");
+
+    std::ostringstream stringStream1v4;
+    Ptr<OutputStreamWrapper> arpStream = Create<OutputStreamWrapper>(&stringStream1v4);
+    std::ostringstream stringStream1v6;
+    Ptr<OutputStreamWrapper> ndiscStream = Create<OutputStreamWrapper>(&stringStream1v6);
+
+    // Print cache.
+    Ipv4RoutingHelper::PrintNeighborCacheAllAt(Seconds(0), arpStream);
+    Ipv6RoutingHelper::PrintNeighborCacheAllAt(Seconds(0), ndiscStream);
+
+    Simulator::Run();
+    // Check if the caches see the same entries as populated caches
+    constexpr auto ArpCache =
+        "ARP Cache of node 0 at time 0\n"
+        "10.1.1.2 dev 0 lladdr 04-06-00:00:00:00:00:02 STATIC_AUTOGENERATED\n"
+        "ARP Cache of node 1 at time 0\n"
+        "10.1.1.1 dev 0 lladdr 04-06-00:00:00:00:00:01 STATIC_AUTOGENERATED\n"
+        "10.1.2.2 dev 1 lladdr 04-06-00:00:00:00:00:04 STATIC_AUTOGENERATED\n"
+        "ARP Cache of node 2 at time 0\n"
+        "10.1.2.1 dev 0 lladdr 04-06-00:00:00:00:00:03 STATIC_AUTOGENERATED\n";
+    NS_TEST_EXPECT_MSG_EQ(stringStream1v4.str(), ArpCache, "Arp cache is incorrect.");
+
+    constexpr auto NdiscCache =
+        "NDISC Cache of node 0 at time +0s\n"
+        "2001::200:ff:fe00:2 dev 0 lladdr 04-06-00:00:00:00:00:02 STATIC_AUTOGENERATED\n"
+        "fe80::200:ff:fe00:2 dev 0 lladdr 04-06-00:00:00:00:00:02 STATIC_AUTOGENERATED\n"
+        "NDISC Cache of node 1 at time +0s\n"
+        "2001::200:ff:fe00:1 dev 0 lladdr 04-06-00:00:00:00:00:01 STATIC_AUTOGENERATED\n"
+        "fe80::200:ff:fe00:1 dev 0 lladdr 04-06-00:00:00:00:00:01 STATIC_AUTOGENERATED\n"
+        "2001:1::200:ff:fe00:4 dev 1 lladdr 04-06-00:00:00:00:00:04 STATIC_AUTOGENERATED\n"
+        "fe80::200:ff:fe00:4 dev 1 lladdr 04-06-00:00:00:00:00:04 STATIC_AUTOGENERATED\n"
+        "NDISC Cache of node 2 at time +0s\n"
+        "2001:1::200:ff:fe00:3 dev 0 lladdr 04-06-00:00:00:00:00:03 STATIC_AUTOGENERATED\n"
+        "fe80::200:ff:fe00:3 dev 0 lladdr 04-06-00:00:00:00:00:03 STATIC_AUTOGENERATED\n";
+    NS_TEST_EXPECT_MSG_EQ(stringStream1v6.str(), NdiscCache, "Ndisc cache is incorrect.");
+
+    // Flushing drops the tables
+    neighborCache.FlushAutoGenerated();
+    NS_TEST_EXPECT_MSG_EQ(arpCache0->GetSharedTable(), nullptr, "The table is not dropped.");
+    NS_TEST_EXPECT_MSG_EQ(arpCache0->Lookup(Ipv4Address("10.1.1.2")),
+                          nullptr,
+                          "The entry is not flushed.");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1228,6 +1368,7 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::Duration::QUICK);
         AddTestCase(new DuplicateTest, TestCase::Duration::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::Duration::QUICK);
+        AddTestCase(new SharedTest, TestCase::Duration::QUICK);
     }
 };
 
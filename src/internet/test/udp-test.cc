@@ -41,6 +41,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -157,6 +158,72 @@ Udp6SocketLoopbackTest::DoRun()
                           "second interface's address");
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief UDP Socket batched send and receive Test
+ */
+class UdpSocketBatchTest : public TestCase
+{
+  public:
+    UdpSocketBatchTest();
+    void DoRun() override;
+};
+
+UdpSocketBatchTest::UdpSocketBatchTest()
+    : TestCase("UDP batched send and receive test")
+{
+}
+
+void
+UdpSocketBatchTest::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+
+    Ptr<SocketFactory> socketFactory = node->GetObject<UdpSocketFactory>();
+    Ptr<Socket> rxSocket = socketFactory->CreateSocket();
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 80));
+
+    Ptr<Socket> txSocket = socketFactory->CreateSocket();
+    std::vector<Ptr<Packet>> packets;
+    for (uint32_t i = 1; i <= 5; ++i)
+    {
+        packets.push_back(Create<Packet>(100 * i));
+    }
+    NS_TEST_EXPECT_MSG_EQ(txSocket->SendBatch(packets, 0),
+                          -1,
+                          "Unconnected socket should not send");
+    NS_TEST_EXPECT_MSG_EQ(txSocket->GetErrno(), Socket::ERROR_NOTCONN, "Wrong error");
+
+    txSocket->Connect(InetSocketAddress("127.0.0.1", 80));
+    NS_TEST_EXPECT_MSG_EQ(txSocket->SendBatch(packets, 0), 5, "All packets should be sent");
+    Simulator::Run();
+
+    Address txAddress;
+    txSocket->GetSockName(txAddress);
+    uint16_t txPort = InetSocketAddress::ConvertFrom(txAddress).GetPort();
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->GetRxAvailable(), 1500U, "Wrong Rx buffer size");
+
+    std::vector<Ptr<Packet>> received(3);
+    std::vector<Address> from(3);
+    uint32_t n = rxSocket->RecvBatch(received, from, 0);
+    NS_TEST_ASSERT_MSG_EQ(n, 3U, "Wrong number of packets in the first batch");
+    n = rxSocket->RecvBatch(received, from, 0);
+    NS_TEST_ASSERT_MSG_EQ(n, 2U, "Wrong number of packets in the second batch");
+    NS_TEST_EXPECT_MSG_EQ(received[0]->GetSize(), 400U, "Packets out of order");
+    NS_TEST_EXPECT_MSG_EQ(received[1]->GetSize(), 500U, "Packets out of order");
+    uint16_t rxPort = InetSocketAddress::ConvertFrom(from[1]).GetPort();
+    NS_TEST_EXPECT_MSG_EQ(rxPort, txPort, "Wrong sender address");
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->GetRxAvailable(), 0U, "Rx buffer should be empty");
+    n = rxSocket->RecvBatch(received, from, 0);
+    NS_TEST_EXPECT_MSG_EQ(n, 0U, "No packet should be left");
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->GetErrno(), Socket::ERROR_AGAIN, "Wrong error");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -764,6 +831,7 @@ class UdpTestSuite : public TestSuite
         AddTestCase(new UdpSocketLoopbackTest, TestCase::Duration::QUICK);
         AddTestCase(new Udp6SocketImplTest, TestCase::Duration::QUICK);
         AddTestCase(new Udp6SocketLoopbackTest, TestCase::Duration::QUICK);
+        AddTestCase(new UdpSocketBatchTest, TestCase::Duration::QUICK);
     }
 };
 
@@ -10,7 +10,9 @@
 
 // Interface between ns-3 and the network animator
 
+#include <cmath>
 #include <cstdio>
+#include <cstring> // memcmp
 #ifndef WIN32
 #include <unistd.h>
 #endif
@@ -60,9 +62,173 @@ NS_LOG_COMPONENT_DEFINE("AnimationInterface");
 
 static bool initialized = false; //!< Initialization flag
 
+/**
+ * @ingroup netanim
+ * Unnamed namespace for the binary trace file format
+ *
+ * A binary trace file starts with ANIM_BINARY_MAGIC, followed by records
+ * made of a record type, the time elapsed since the previous record, in
+ * nanoseconds, and the record fields.  The integers are written as LEB128
+ * varints, zigzag encoded when signed, the strings are prefixed by their
+ * length, the positions are in millimetres, and the times of the packet
+ * records are in nanoseconds relative to the time of the record.
+ */
+namespace
+{
+
+/** File magic. */
+const char ANIM_BINARY_MAGIC[8] = {'N', 'S', '3', 'A', 'N', 'I', 'M', '1'};
+/** Record type: XML text, written as is. */
+const uint8_t RECORD_XML = 'X';
+/** Record type: node position, relative to the previous one, and velocity. */
+const uint8_t RECORD_POSITION = 'N';
+/** Record type: packet transmission and reception. */
+const uint8_t RECORD_PACKET = 'P';
+/** Record type: wireless packet transmission. */
+const uint8_t RECORD_PACKET_TX = 'T';
+/** Record type: wireless packet reception. */
+const uint8_t RECORD_PACKET_RX = 'R';
+
+/** Hand the records over to the writer thread once they grow past this size. */
+const std::size_t BINARY_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * Append an unsigned varint to a record.
+ * @param [in,out] record The record.
+ * @param [in] value The value.
+ */
+void
+PutVarint(std::string& record, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        record.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    record.push_back(static_cast<char>(value));
+}
+
+/**
+ * Append a signed varint to a record.
+ * @param [in,out] record The record.
+ * @param [in] value The value.
+ */
+void
+PutSignedVarint(std::string& record, int64_t value)
+{
+    PutVarint(record, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+/**
+ * Append a length-prefixed string to a record.
+ * @param [in,out] record The record.
+ * @param [in] str The string.
+ */
+void
+PutString(std::string& record, const std::string& str)
+{
+    PutVarint(record, str.size());
+    record += str;
+}
+
+/**
+ * Append a time, in seconds, relative to the time of a record.
+ * @param [in,out] record The record.
+ * @param [in] seconds The time, in seconds.
+ * @param [in] recordTime The time of the record, in nanoseconds.
+ */
+void
+PutTime(std::string& record, double seconds, int64_t recordTime)
+{
+    PutSignedVarint(record, std::llround(seconds * 1e9) - recordTime);
+}
+
+/**
+ * Read an unsigned varint.
+ * @param [in] is The input stream.
+ * @param [out] value The value read.
+ * @returns \c true if the read succeeded.
+ */
+bool
+ReadVarint(std::istream& is, uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        char c;
+        if (!is.get(c))
+        {
+            return false;
+        }
+        value |= static_cast<uint64_t>(c & 0x7f) << shift;
+        if (!(c & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Read a signed varint.
+ * @param [in] is The input stream.
+ * @param [out] value The value read.
+ * @returns \c true if the read succeeded.
+ */
+bool
+ReadSignedVarint(std::istream& is, int64_t& value)
+{
+    uint64_t zigzag;
+    if (!ReadVarint(is, zigzag))
+    {
+        return false;
+    }
+    value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    return true;
+}
+
+/**
+ * Read a length-prefixed string.
+ * @param [in] is The input stream.
+ * @param [out] str The string read.
+ * @returns \c true if the read succeeded.
+ */
+bool
+ReadString(std::istream& is, std::string& str)
+{
+    uint64_t len;
+    if (!ReadVarint(is, len))
+    {
+        return false;
+    }
+    str.resize(len);
+    return len == 0 || static_cast<bool>(is.read(str.data(), len));
+}
+
+/**
+ * Read a time relative to the time of a record.
+ * @param [in] is The input stream.
+ * @param [in] recordTime The time of the record, in nanoseconds.
+ * @param [out] seconds The time read, in seconds.
+ * @returns \c true if the read succeeded.
+ */
+bool
+ReadTime(std::istream& is, int64_t recordTime, double& seconds)
+{
+    int64_t offset;
+    if (!ReadSignedVarint(is, offset))
+    {
+        return false;
+    }
+    seconds = NanoSeconds(recordTime + offset).GetSeconds();
+    return true;
+}
+
+} // Unnamed namespace
+
 // Public methods
 
-AnimationInterface::AnimationInterface(const std::string fn)
+AnimationInterface::AnimationInterface(const std::string fn, OutputFormat format)
     : m_f(nullptr),
       m_routingF(nullptr),
       m_mobilityPollInterval(Seconds(0.25)),
@@ -78,7 +244,11 @@ AnimationInterface::AnimationInterface(const std::string fn)
       m_routingStopTime(),
       m_routingFileName(""),
       m_routingPollInterval(Seconds(5)),
-      m_trackPackets(true)
+      m_trackPackets(true),
+      m_packetSamplingRate(1),
+      m_devTxPktCount(0),
+      m_format(format),
+      m_binaryTime(0)
 {
     initialized = true;
     StartAnimation();
@@ -310,6 +480,19 @@ AnimationInterface::SetMobilityPollInterval(Time t)
     m_mobilityPollInterval = t;
 }
 
+void
+AnimationInterface::SetPacketSamplingRate(uint32_t rate)
+{
+    NS_ABORT_MSG_IF(rate == 0, "The packet sampling rate must be positive");
+    m_packetSamplingRate = rate;
+}
+
+bool
+AnimationInterface::IsPacketSampled(uint64_t pktCount) const
+{
+    return m_packetSamplingRate == 1 || pktCount % m_packetSamplingRate == 0;
+}
+
 void
 AnimationInterface::SetConstantPosition(Ptr<Node> n, double x, double y, double z)
 {
@@ -466,13 +649,18 @@ void
 AnimationInterface::MobilityAutoCheck()
 {
     CHECK_STARTED_INTIMEWINDOW;
-    std::vector<Ptr<Node>> MovedNodes = GetMovedNodes();
-    for (uint32_t i = 0; i < MovedNodes.size(); i++)
+    // The binary trace records the course changes, and leaves the
+    // positions in between to ConvertBinaryToXml
+    if (m_format == XML)
     {
-        Ptr<Node> n = MovedNodes[i];
-        NS_ASSERT(n);
-        Vector v = GetPosition(n);
-        WriteXmlUpdateNodePosition(n->GetId(), v.x, v.y);
+        std::vector<Ptr<Node>> MovedNodes = GetMovedNodes();
+        for (uint32_t i = 0; i < MovedNodes.size(); i++)
+        {
+            Ptr<Node> n = MovedNodes[i];
+            NS_ASSERT(n);
+            Vector v = GetPosition(n);
+            WriteXmlUpdateNodePosition(n->GetId(), v.x, v.y);
+        }
     }
     if (!Simulator::IsFinished())
     {
@@ -527,6 +715,13 @@ AnimationInterface::WriteN(const std::string& st, FILE* f)
     {
         m_writeCallback(st.c_str());
     }
+    if (m_format == BINARY && f == m_f)
+    {
+        std::string record = StartBinaryRecord(RECORD_XML);
+        PutString(record, st);
+        WriteBinaryRecord(record);
+        return st.length();
+    }
     return WriteN(st.c_str(), st.length(), f);
 }
 
@@ -555,6 +750,26 @@ AnimationInterface::WriteN(const char* data, uint32_t count, FILE* f)
     return written;
 }
 
+std::string
+AnimationInterface::StartBinaryRecord(uint8_t type)
+{
+    // The trace file may be closed once the simulator is destroyed, back at time 0
+    int64_t now = std::max(m_binaryTime, Simulator::Now().GetNanoSeconds());
+    std::string record(1, static_cast<char>(type));
+    PutVarint(record, now - m_binaryTime);
+    m_binaryTime = now;
+    return record;
+}
+
+void
+AnimationInterface::WriteBinaryRecord(const std::string& record)
+{
+    if (m_binaryWriter)
+    {
+        m_binaryWriter->Write(record);
+    }
+}
+
 void
 AnimationInterface::WriteRoutePath(uint32_t nodeId,
                                    std::string destination,
@@ -818,6 +1033,10 @@ AnimationInterface::DevTxTrace(std::string context,
     CHECK_STARTED_INTIMEWINDOW_TRACKPACKETS;
     NS_ASSERT(tx);
     NS_ASSERT(rx);
+    if (!IsPacketSampled(++m_devTxPktCount))
+    {
+        return;
+    }
     Time now = Simulator::Now();
     double fbTx = now.GetSeconds();
     double lbTx = (now + txTime).GetSeconds();
@@ -849,6 +1068,10 @@ AnimationInterface::GenericWirelessTxTrace(std::string context,
     NS_LOG_INFO(ProtocolTypeToString(protocolType)
                 << " GenericWirelessTxTrace for packet:" << gAnimUid);
     AddByteTag(gAnimUid, p);
+    if (!IsPacketSampled(gAnimUid))
+    {
+        return;
+    }
     AnimPacketInfo pktInfo(ndev, Simulator::Now());
     AddPendingPacket(protocolType, gAnimUid, pktInfo);
 
@@ -879,6 +1102,10 @@ AnimationInterface::GenericWirelessRxTrace(std::string context,
     UpdatePosition(ndev);
     uint64_t animUid = GetAnimUidFromPacket(p);
     NS_LOG_INFO(ProtocolTypeToString(protocolType) << " for packet:" << animUid);
+    if (!IsPacketSampled(animUid))
+    {
+        return;
+    }
     if (!IsPacketPending(animUid, protocolType))
     {
         NS_LOG_WARN(ProtocolTypeToString(protocolType) << " GenericWirelessRxTrace: unknown Uid");
@@ -925,6 +1152,10 @@ AnimationInterface::WifiPhyTxBeginTrace(std::string context,
             NS_LOG_INFO("WifiPhyTxTrace for MPDU:" << gAnimUid);
             AddByteTag(gAnimUid,
                        mpdu->GetPacket()); // the underlying MSDU/A-MSDU should be handed off
+            if (!IsPacketSampled(gAnimUid))
+            {
+                continue;
+            }
             AddPendingPacket(WIFI, gAnimUid, pktInfo);
             OutputWirelessPacketTxInfo(
                 mpdu->GetProtocolDataUnit(),
@@ -962,6 +1193,10 @@ AnimationInterface::WifiPhyRxBeginTrace(std::string context,
     UpdatePosition(ndev);
     uint64_t animUid = GetAnimUidFromPacket(p);
     NS_LOG_INFO("Wifi RxBeginTrace for packet: " << animUid);
+    if (!IsPacketSampled(animUid))
+    {
+        return;
+    }
     if (!IsPacketPending(animUid, AnimationInterface::WIFI))
     {
         NS_ASSERT_MSG(false, "WifiPhyRxBeginTrace: unknown Uid");
@@ -1033,6 +1268,10 @@ AnimationInterface::LrWpanPhyTxBeginTrace(std::string context, Ptr<const Packet>
     ++gAnimUid;
     NS_LOG_INFO("LrWpan TxBeginTrace for packet:" << gAnimUid);
     AddByteTag(gAnimUid, p);
+    if (!IsPacketSampled(gAnimUid))
+    {
+        return;
+    }
 
     AnimPacketInfo pktInfo(ndev, Simulator::Now());
     AddPendingPacket(AnimationInterface::LRWPAN, gAnimUid, pktInfo);
@@ -1058,6 +1297,10 @@ AnimationInterface::LrWpanPhyRxBeginTrace(std::string context, Ptr<const Packet>
 
     uint64_t animUid = GetAnimUidFromPacket(p);
     NS_LOG_INFO("LrWpan RxBeginTrace for packet:" << animUid);
+    if (!IsPacketSampled(animUid))
+    {
+        return;
+    }
     if (!IsPacketPending(animUid, AnimationInterface::LRWPAN))
     {
         NS_LOG_WARN("LrWpanPhyRxBeginTrace: unknown Uid - most probably it's an ACK.");
@@ -1119,6 +1362,10 @@ AnimationInterface::LteSpectrumPhyTxStart(std::string context, Ptr<const PacketB
         NS_LOG_INFO("LteSpectrumPhyTxTrace for packet:" << gAnimUid);
         AnimPacketInfo pktInfo(ndev, Simulator::Now());
         AddByteTag(gAnimUid, p);
+        if (!IsPacketSampled(gAnimUid))
+        {
+            continue;
+        }
         AddPendingPacket(AnimationInterface::LTE, gAnimUid, pktInfo);
         OutputWirelessPacketTxInfo(p, pktInfo, gAnimUid);
     }
@@ -1145,6 +1392,10 @@ AnimationInterface::LteSpectrumPhyRxStart(std::string context, Ptr<const PacketB
         Ptr<Packet> p = *i;
         uint64_t animUid = GetAnimUidFromPacket(p);
         NS_LOG_INFO("LteSpectrumPhyRxTrace for packet:" << gAnimUid);
+        if (!IsPacketSampled(animUid))
+        {
+            continue;
+        }
         if (!IsPacketPending(animUid, AnimationInterface::LTE))
         {
             NS_LOG_WARN("LteSpectrumPhyRxTrace: unknown Uid");
@@ -1167,6 +1418,10 @@ AnimationInterface::CsmaPhyTxBeginTrace(std::string context, Ptr<const Packet> p
     ++gAnimUid;
     NS_LOG_INFO("CsmaPhyTxBeginTrace for packet:" << gAnimUid);
     AddByteTag(gAnimUid, p);
+    if (!IsPacketSampled(gAnimUid))
+    {
+        return;
+    }
     UpdatePosition(ndev);
     AnimPacketInfo pktInfo(ndev, Simulator::Now());
     AddPendingPacket(AnimationInterface::CSMA, gAnimUid, pktInfo);
@@ -1182,6 +1437,10 @@ AnimationInterface::CsmaPhyTxEndTrace(std::string context, Ptr<const Packet> p)
     UpdatePosition(ndev);
     uint64_t animUid = GetAnimUidFromPacket(p);
     NS_LOG_INFO("CsmaPhyTxEndTrace for packet:" << animUid);
+    if (!IsPacketSampled(animUid))
+    {
+        return;
+    }
     if (!IsPacketPending(animUid, AnimationInterface::CSMA))
     {
         NS_LOG_WARN("CsmaPhyTxEndTrace: unknown Uid");
@@ -1204,6 +1463,10 @@ AnimationInterface::CsmaPhyRxEndTrace(std::string context, Ptr<const Packet> p)
     NS_ASSERT(ndev);
     UpdatePosition(ndev);
     uint64_t animUid = GetAnimUidFromPacket(p);
+    if (!IsPacketSampled(animUid))
+    {
+        return;
+    }
     if (!IsPacketPending(animUid, AnimationInterface::CSMA))
     {
         NS_LOG_WARN("CsmaPhyRxEndTrace: unknown Uid");
@@ -1225,6 +1488,10 @@ AnimationInterface::CsmaMacRxTrace(std::string context, Ptr<const Packet> p)
     Ptr<NetDevice> ndev = GetNetDeviceFromContext(context);
     NS_ASSERT(ndev);
     uint64_t animUid = GetAnimUidFromPacket(p);
+    if (!IsPacketSampled(animUid))
+    {
+        return;
+    }
     if (!IsPacketPending(animUid, AnimationInterface::CSMA))
     {
         NS_LOG_WARN("CsmaMacRxTrace: unknown Uid");
@@ -1442,6 +1709,7 @@ AnimationInterface::StopAnimation(bool onlyAnimation)
     {
         // Terminate the anim element
         WriteXmlClose("anim");
+        m_binaryWriter.reset();
         std::fclose(m_f);
         m_f = nullptr;
     }
@@ -1471,6 +1739,20 @@ AnimationInterface::StartAnimation(bool restart)
     WriteIpv6Addresses();
     WriteNodeSizes();
     WriteNodeEnergies();
+    if (m_format == BINARY)
+    {
+        // Record the initial course of the moving nodes, as their positions
+        // are not polled
+        for (auto i = NodeList::Begin(); i != NodeList::End(); ++i)
+        {
+            Ptr<MobilityModel> mobility = (*i)->GetObject<MobilityModel>();
+            if (mobility && mobility->GetVelocity().GetLength() > 0)
+            {
+                Vector v = mobility->GetPosition();
+                WriteXmlUpdateNodePosition((*i)->GetId(), v.x, v.y);
+            }
+        }
+    }
     if (!restart)
     {
         Simulator::Schedule(m_mobilityPollInterval, &AnimationInterface::MobilityAutoCheck, this);
@@ -2080,7 +2362,7 @@ AnimationInterface::SetOutputFile(const std::string& fn, bool routing)
 
     NS_LOG_INFO("Creating new trace file:" << fn);
     FILE* f = nullptr;
-    f = std::fopen(fn.c_str(), "w");
+    f = std::fopen(fn.c_str(), (!routing && m_format == BINARY) ? "wb" : "w");
     if (!f)
     {
         NS_FATAL_ERROR("Unable to open output file:" << fn);
@@ -2095,6 +2377,11 @@ AnimationInterface::SetOutputFile(const std::string& fn, bool routing)
     {
         m_f = f;
         m_outputFileName = fn;
+        if (m_format == BINARY)
+        {
+            m_binaryWriter = std::make_unique<BinaryWriter>(m_f);
+            m_binaryWriter->Write(std::string(ANIM_BINARY_MAGIC, sizeof(ANIM_BINARY_MAGIC)));
+        }
     }
 }
 
@@ -2530,6 +2817,22 @@ AnimationInterface::WriteXmlRp(uint32_t nodeId,
 
 void
 AnimationInterface::WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
+{
+    if (m_format == BINARY)
+    {
+        std::string record = StartBinaryRecord(RECORD_PACKET_TX);
+        PutVarint(record, animUid);
+        PutVarint(record, fId);
+        PutTime(record, fbTx, m_binaryTime);
+        PutString(record, metaInfo);
+        WriteBinaryRecord(record);
+        return;
+    }
+    WriteN(XmlPRef(animUid, fId, fbTx, metaInfo).ToString(), m_f);
+}
+
+AnimationInterface::AnimXmlElement
+AnimationInterface::XmlPRef(uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
 {
     AnimXmlElement element("pr");
     element.AddAttribute("uId", animUid);
@@ -2539,7 +2842,7 @@ AnimationInterface::WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, st
     {
         element.AddAttribute("meta-info", metaInfo.c_str(), true);
     }
-    WriteN(element.ToString(), m_f);
+    return element;
 }
 
 void
@@ -2548,13 +2851,34 @@ AnimationInterface::WriteXmlP(uint64_t animUid,
                               uint32_t tId,
                               double fbRx,
                               double lbRx)
+{
+    if (m_format == BINARY)
+    {
+        std::string record = StartBinaryRecord(RECORD_PACKET_RX);
+        PutVarint(record, animUid);
+        PutString(record, pktType);
+        PutVarint(record, tId);
+        PutTime(record, fbRx, m_binaryTime);
+        PutTime(record, lbRx, m_binaryTime);
+        WriteBinaryRecord(record);
+        return;
+    }
+    WriteN(XmlP(animUid, pktType, tId, fbRx, lbRx).ToString(), m_f);
+}
+
+AnimationInterface::AnimXmlElement
+AnimationInterface::XmlP(uint64_t animUid,
+                         std::string pktType,
+                         uint32_t tId,
+                         double fbRx,
+                         double lbRx)
 {
     AnimXmlElement element(pktType);
     element.AddAttribute("uId", animUid);
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    return element;
 }
 
 void
@@ -2566,6 +2890,33 @@ AnimationInterface::WriteXmlP(std::string pktType,
                               double fbRx,
                               double lbRx,
                               std::string metaInfo)
+{
+    if (m_format == BINARY)
+    {
+        std::string record = StartBinaryRecord(RECORD_PACKET);
+        PutString(record, pktType);
+        PutVarint(record, fId);
+        PutTime(record, fbTx, m_binaryTime);
+        PutTime(record, lbTx, m_binaryTime);
+        PutVarint(record, tId);
+        PutTime(record, fbRx, m_binaryTime);
+        PutTime(record, lbRx, m_binaryTime);
+        PutString(record, metaInfo);
+        WriteBinaryRecord(record);
+        return;
+    }
+    WriteN(XmlP(pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo).ToString(), m_f);
+}
+
+AnimationInterface::AnimXmlElement
+AnimationInterface::XmlP(std::string pktType,
+                         uint32_t fId,
+                         double fbTx,
+                         double lbTx,
+                         uint32_t tId,
+                         double fbRx,
+                         double lbRx,
+                         std::string metaInfo)
 {
     AnimXmlElement element(pktType);
     element.AddAttribute("fId", fId);
@@ -2578,7 +2929,7 @@ AnimationInterface::WriteXmlP(std::string pktType,
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    return element;
 }
 
 void
@@ -2627,14 +2978,46 @@ AnimationInterface::WriteXmlUpdateNodeSize(uint32_t nodeId, double width, double
 
 void
 AnimationInterface::WriteXmlUpdateNodePosition(uint32_t nodeId, double x, double y)
+{
+    if (m_format == BINARY)
+    {
+        if (!m_binaryWriter)
+        {
+            return;
+        }
+        Vector velocity;
+        Ptr<MobilityModel> mobility = NodeList::GetNode(nodeId)->GetObject<MobilityModel>();
+        if (mobility)
+        {
+            velocity = mobility->GetVelocity();
+        }
+        auto& [lastX, lastY] = m_binaryPositions[nodeId];
+        int64_t newX = std::llround(x * 1000);
+        int64_t newY = std::llround(y * 1000);
+        std::string record = StartBinaryRecord(RECORD_POSITION);
+        PutVarint(record, nodeId);
+        PutSignedVarint(record, newX - lastX);
+        PutSignedVarint(record, newY - lastY);
+        PutSignedVarint(record, std::llround(velocity.x * 1000));
+        PutSignedVarint(record, std::llround(velocity.y * 1000));
+        WriteBinaryRecord(record);
+        lastX = newX;
+        lastY = newY;
+        return;
+    }
+    WriteN(XmlUpdateNodePosition(Simulator::Now().GetSeconds(), nodeId, x, y).ToString(), m_f);
+}
+
+AnimationInterface::AnimXmlElement
+AnimationInterface::XmlUpdateNodePosition(double t, uint32_t nodeId, double x, double y)
 {
     AnimXmlElement element("nu");
     element.AddAttribute("p", "p");
-    element.AddAttribute("t", Simulator::Now().GetSeconds());
+    element.AddAttribute("t", t);
     element.AddAttribute("id", nodeId);
     element.AddAttribute("x", x);
     element.AddAttribute("y", y);
-    WriteN(element.ToString(), m_f);
+    return element;
 }
 
 void
@@ -2707,6 +3090,204 @@ AnimationInterface::WriteXmlNonP2pLinkProperties(uint32_t id,
     WriteN(element.ToString(), m_f);
 }
 
+/***** Binary trace *****/
+
+bool
+AnimationInterface::ConvertBinaryToXml(std::istream& is, std::ostream& os, Time pollInterval)
+{
+    char magic[sizeof(ANIM_BINARY_MAGIC)];
+    if (!is.read(magic, sizeof(magic)) || std::memcmp(magic, ANIM_BINARY_MAGIC, sizeof(magic)) != 0)
+    {
+        return false;
+    }
+
+    /// Course of a moving node
+    struct Course
+    {
+        int64_t x;  //!< position at the course change, in millimetres
+        int64_t y;  //!< position at the course change, in millimetres
+        int64_t vx; //!< velocity, in millimetres per second
+        int64_t vy; //!< velocity, in millimetres per second
+        int64_t t;  //!< time of the course change, in nanoseconds
+    };
+
+    std::unordered_map<uint32_t, std::pair<int64_t, int64_t>> positions;
+    std::map<uint32_t, Course> moving;
+    const int64_t poll = pollInterval.GetNanoSeconds();
+    int64_t nextPoll = poll;
+    int64_t now = 0;
+    char type;
+    while (is.get(type))
+    {
+        uint64_t elapsed;
+        if (!ReadVarint(is, elapsed))
+        {
+            return false;
+        }
+        now += elapsed;
+
+        // Write the positions the XML trace would have polled until now
+        if (poll > 0 && moving.empty() && nextPoll < now)
+        {
+            nextPoll += (now - nextPoll + poll - 1) / poll * poll;
+        }
+        for (; poll > 0 && nextPoll < now; nextPoll += poll)
+        {
+            for (const auto& [nodeId, course] : moving)
+            {
+                double dt = (nextPoll - course.t) * 1e-9;
+                int64_t x = course.x + std::llround(course.vx * dt);
+                int64_t y = course.y + std::llround(course.vy * dt);
+                double t = NanoSeconds(nextPoll).GetSeconds();
+                os << XmlUpdateNodePosition(t, nodeId, x / 1000.0, y / 1000.0).ToString();
+            }
+        }
+
+        switch (type)
+        {
+        case RECORD_XML: {
+            std::string text;
+            if (!ReadString(is, text))
+            {
+                return false;
+            }
+            os << text;
+            break;
+        }
+        case RECORD_POSITION: {
+            uint64_t nodeId;
+            int64_t dx;
+            int64_t dy;
+            int64_t vx;
+            int64_t vy;
+            if (!ReadVarint(is, nodeId) || !ReadSignedVarint(is, dx) || !ReadSignedVarint(is, dy) ||
+                !ReadSignedVarint(is, vx) || !ReadSignedVarint(is, vy))
+            {
+                return false;
+            }
+            auto& [x, y] = positions[nodeId];
+            x += dx;
+            y += dy;
+            if (vx != 0 || vy != 0)
+            {
+                moving[nodeId] = {x, y, vx, vy, now};
+            }
+            else
+            {
+                moving.erase(nodeId);
+            }
+            double t = NanoSeconds(now).GetSeconds();
+            os << XmlUpdateNodePosition(t, nodeId, x / 1000.0, y / 1000.0).ToString();
+            break;
+        }
+        case RECORD_PACKET: {
+            std::string pktType;
+            uint64_t fId;
+            double fbTx;
+            double lbTx;
+            uint64_t tId;
+            double fbRx;
+            double lbRx;
+            std::string metaInfo;
+            if (!ReadString(is, pktType) || !ReadVarint(is, fId) || !ReadTime(is, now, fbTx) ||
+                !ReadTime(is, now, lbTx) || !ReadVarint(is, tId) || !ReadTime(is, now, fbRx) ||
+                !ReadTime(is, now, lbRx) || !ReadString(is, metaInfo))
+            {
+                return false;
+            }
+            os << XmlP(pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo).ToString();
+            break;
+        }
+        case RECORD_PACKET_TX: {
+            uint64_t animUid;
+            uint64_t fId;
+            double fbTx;
+            std::string metaInfo;
+            if (!ReadVarint(is, animUid) || !ReadVarint(is, fId) || !ReadTime(is, now, fbTx) ||
+                !ReadString(is, metaInfo))
+            {
+                return false;
+            }
+            os << XmlPRef(animUid, fId, fbTx, metaInfo).ToString();
+            break;
+        }
+        case RECORD_PACKET_RX: {
+            uint64_t animUid;
+            std::string pktType;
+            uint64_t tId;
+            double fbRx;
+            double lbRx;
+            if (!ReadVarint(is, animUid) || !ReadString(is, pktType) || !ReadVarint(is, tId) ||
+                !ReadTime(is, now, fbRx) || !ReadTime(is, now, lbRx))
+            {
+                return false;
+            }
+            os << XmlP(animUid, pktType, tId, fbRx, lbRx).ToString();
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return is.eof();
+}
+
+AnimationInterface::BinaryWriter::BinaryWriter(FILE* f)
+    : m_f(f),
+      m_stop(false),
+      m_thread(&BinaryWriter::Run, this)
+{
+}
+
+AnimationInterface::BinaryWriter::~BinaryWriter()
+{
+    {
+        std::unique_lock lock{m_mutex};
+        m_queue.push_back(std::move(m_buffer));
+        m_stop = true;
+    }
+    m_condVar.notify_one();
+    m_thread.join();
+}
+
+void
+AnimationInterface::BinaryWriter::Write(const std::string& data)
+{
+    m_buffer += data;
+    if (m_buffer.size() < BINARY_BUFFER_SIZE)
+    {
+        return;
+    }
+    {
+        std::unique_lock lock{m_mutex};
+        m_queue.push_back(std::move(m_buffer));
+    }
+    m_condVar.notify_one();
+    m_buffer.clear();
+    m_buffer.reserve(BINARY_BUFFER_SIZE + data.size());
+}
+
+void
+AnimationInterface::BinaryWriter::Run()
+{
+    std::vector<std::string> buffers;
+    bool stop = false;
+    while (!stop)
+    {
+        {
+            std::unique_lock lock{m_mutex};
+            m_condVar.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            buffers.swap(m_queue);
+            stop = m_stop;
+        }
+        for (const auto& buffer : buffers)
+        {
+            std::fwrite(buffer.data(), 1, buffer.size(), m_f);
+        }
+        buffers.clear();
+    }
+}
+
 /***** AnimXmlElement  *****/
 
 AnimationInterface::AnimXmlElement::AnimXmlElement(std::string tagName, bool emptyElement)
@@ -30,9 +30,15 @@
 #include "ns3/uan-phy-gen.h"
 #include "ns3/wifi-phy.h"
 
+#include <condition_variable>
 #include <cstdio>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -76,12 +82,22 @@ class WifiPsdu;
 class AnimationInterface
 {
   public:
+    /**
+     * Trace file formats
+     */
+    enum OutputFormat
+    {
+        XML,   ///< XML trace, read by NetAnim
+        BINARY ///< Compact binary trace, converted to XML by ConvertBinaryToXml
+    };
+
     /**
      * @brief Constructor
      * @param filename The Filename for the trace file used by the Animator
+     * @param format The format of the trace file
      *
      */
-    AnimationInterface(const std::string filename);
+    AnimationInterface(const std::string filename, OutputFormat format = XML);
 
     /**
      * Counter Types
@@ -225,6 +241,39 @@ class AnimationInterface
      */
     void SetMobilityPollInterval(Time t);
 
+    /**
+     * @brief Trace only one out of every given number of packets
+     *
+     * The packets are sampled on their transmission, and the receptions of
+     * the packets left out are not traced either.
+     *
+     * @param rate The number of packets per traced packet
+     * Default: 1, all the packets are traced
+     *
+     */
+    void SetPacketSamplingRate(uint32_t rate);
+
+    /**
+     * @brief Convert a binary trace file to the XML format read by NetAnim
+     *
+     * The positions of the binary trace are rounded to the millimetre, and
+     * its times to the nanosecond.  The binary trace only records the
+     * positions of the nodes when their course changes: the positions of the
+     * moving nodes in between are interpolated from their velocity, as
+     * NetAnim would otherwise show them jumping from one course change to
+     * the next.
+     *
+     * @param is The binary trace
+     * @param os The XML trace
+     * @param pollInterval The interval at which the positions of the moving
+     *        nodes are interpolated, or zero to only write the course changes
+     * @returns true if the binary trace is valid and complete
+     *
+     */
+    static bool ConvertBinaryToXml(std::istream& is,
+                                   std::ostream& os,
+                                   Time pollInterval = Seconds(0.25));
+
     /**
      * @brief Set a callback function to listen to AnimationInterface write events
      *
@@ -603,6 +652,37 @@ class AnimationInterface
         std::vector<std::string> m_children;   ///< list of children
     };
 
+    /// Writes the records of a binary trace file from a background thread
+    class BinaryWriter
+    {
+      public:
+        /**
+         * Constructor, starts the writer thread
+         *
+         * @param f the file to write to
+         */
+        BinaryWriter(FILE* f);
+        /// Destructor, writes the remaining records and stops the writer thread
+        ~BinaryWriter();
+        /**
+         * Write records to the file
+         * @param data the records
+         */
+        void Write(const std::string& data);
+
+      private:
+        /// Write the buffers handed over by Write, until the writer is destroyed
+        void Run();
+
+        FILE* m_f;                         ///< the file
+        std::string m_buffer;              ///< records not yet handed over to the thread
+        std::vector<std::string> m_queue;  ///< buffers handed over to the thread
+        std::mutex m_mutex;                ///< protects m_queue and m_stop
+        std::condition_variable m_condVar; ///< signals a new buffer, or the stop
+        bool m_stop;                       ///< stop the thread once the queue is empty
+        std::thread m_thread;              ///< the writer thread
+    };
+
     // ##### State #####
 
     FILE* m_f;                             ///< File handle for output (0 if none)
@@ -631,6 +711,14 @@ class AnimationInterface
     Time m_wifiPhyCountersPollInterval;        ///< wifi Phy counters poll interval
     static Rectangle* userBoundary;            ///< user boundary
     bool m_trackPackets;                       ///< track packets
+    uint32_t m_packetSamplingRate;             ///< number of packets per traced packet
+    uint64_t m_devTxPktCount;                  ///< number of packets seen by DevTxTrace
+
+    OutputFormat m_format;                        ///< trace file format
+    std::unique_ptr<BinaryWriter> m_binaryWriter; ///< binary trace file writer
+    int64_t m_binaryTime; ///< time of the last binary record, in nanoseconds
+    /// last position written to the binary trace for each node, in millimetres
+    std::unordered_map<uint32_t, std::pair<int64_t, int64_t>> m_binaryPositions;
 
     // Counter ID
     uint32_t m_remainingEnergyCounterId; ///< remaining energy counter ID
@@ -765,6 +853,23 @@ class AnimationInterface
      * @returns the number of bytes written
      */
     int WriteN(const std::string& st, FILE* f);
+    /**
+     * Start a record of the binary trace file
+     * @param type the record type
+     * @returns the record, holding its type and its time
+     */
+    std::string StartBinaryRecord(uint8_t type);
+    /**
+     * Write a record to the binary trace file
+     * @param record the record
+     */
+    void WriteBinaryRecord(const std::string& record);
+    /**
+     * Is packet sampled function
+     * @param pktCount the packet UID, or count
+     * @returns true if the packet is traced
+     */
+    bool IsPacketSampled(uint64_t pktCount) const;
     /**
      * Get MAC address function
      * @param nd the device
@@ -1306,6 +1411,15 @@ class AnimationInterface
      * @param y the Y position
      */
     void WriteXmlUpdateNodePosition(uint32_t nodeId, double x, double y);
+    /**
+     * Get XML update node position function
+     * @param t the time, in seconds
+     * @param nodeId the node ID
+     * @param x the X position
+     * @param y the Y position
+     * @returns the XML element
+     */
+    static AnimXmlElement XmlUpdateNodePosition(double t, uint32_t nodeId, double x, double y);
     /**
      * Write XML update node color function
      * @param nodeId the node ID
@@ -1412,6 +1526,52 @@ class AnimationInterface
      * @param metaInfo the meta info
      */
     void WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo = "");
+    /**
+     * Get XMLP function
+     * @param pktType the packet type
+     * @param fId the FID
+     * @param fbTx the FB transmit
+     * @param lbTx the LB transmit
+     * @param tId the TID
+     * @param fbRx the FB receive
+     * @param lbRx the LB receive
+     * @param metaInfo the meta info
+     * @returns the XML element
+     */
+    static AnimXmlElement XmlP(std::string pktType,
+                               uint32_t fId,
+                               double fbTx,
+                               double lbTx,
+                               uint32_t tId,
+                               double fbRx,
+                               double lbRx,
+                               std::string metaInfo);
+    /**
+     * Get XMLP function
+     * @param animUid the UID
+     * @param pktType the packet type
+     * @param tId the TID
+     * @param fbRx the FB receive
+     * @param lbRx the LB receive
+     * @returns the XML element
+     */
+    static AnimXmlElement XmlP(uint64_t animUid,
+                               std::string pktType,
+                               uint32_t tId,
+                               double fbRx,
+                               double lbRx);
+    /**
+     * Get XMLP Ref function
+     * @param animUid the UID
+     * @param fId the FID
+     * @param fbTx the FB transmit
+     * @param metaInfo the meta info
+     * @returns the XML element
+     */
+    static AnimXmlElement XmlPRef(uint64_t animUid,
+                                  uint32_t fId,
+                                  double fbTx,
+                                  std::string metaInfo);
     /**
      * Write XML close function
      * @param name the name
@@ -11,6 +11,7 @@
 #endif
 
 #include "ns3/basic-energy-source.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/core-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/netanim-module.h"
@@ -20,7 +21,9 @@
 #include "ns3/simple-device-energy-model.h"
 #include "ns3/udp-echo-helper.h"
 
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 using namespace ns3;
 using namespace ns3::energy;
@@ -231,6 +234,179 @@ AnimationRemainingEnergyTestCase::CheckLogic()
                               "Wrong remaining energy value was traced");
 }
 
+/**
+ * @ingroup netanim-test
+ *
+ * @brief Animation Interface binary output Test Case
+ *
+ * Checks that a binary trace file converts to the XML trace file of the same
+ * simulation, that the packet sampling rate leaves packets out, and that the
+ * positions of a moving node are interpolated between its course changes.
+ */
+class AnimationBinaryOutputTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Constructor.
+     */
+    AnimationBinaryOutputTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a point-to-point simulation, and read its trace file
+     * @param format the trace file format
+     * @param samplingRate the packet sampling rate
+     * @param fileSize the size of the trace file
+     * @returns the trace file, converted to XML
+     */
+    std::string RunPointToPoint(AnimationInterface::OutputFormat format,
+                                uint32_t samplingRate,
+                                std::size_t& fileSize);
+
+    /**
+     * Read the trace file, and remove it
+     * @param format the trace file format
+     * @param fileSize the size of the trace file
+     * @returns the trace file, converted to XML
+     */
+    std::string ReadTraceFile(AnimationInterface::OutputFormat format, std::size_t& fileSize);
+
+    /**
+     * Count the packets of an XML trace
+     * @param xml the XML trace
+     * @returns the number of packets
+     */
+    static uint32_t CountPackets(const std::string& xml);
+
+    const char* m_traceFileName; ///< trace file name
+};
+
+AnimationBinaryOutputTestCase::AnimationBinaryOutputTestCase()
+    : TestCase("Verify AnimationInterface binary output"),
+      m_traceFileName("netanim-binary-test.anim")
+{
+}
+
+std::string
+AnimationBinaryOutputTestCase::RunPointToPoint(AnimationInterface::OutputFormat format,
+                                               uint32_t samplingRate,
+                                               std::size_t& fileSize)
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    AnimationInterface::SetConstantPosition(nodes.Get(0), 0, 10);
+    AnimationInterface::SetConstantPosition(nodes.Get(1), 1, 10);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    NetDeviceContainer devices = pointToPoint.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    UdpEchoServerHelper echoServer(9);
+    ApplicationContainer serverApps = echoServer.Install(nodes.Get(1));
+    serverApps.Start(Seconds(1));
+    serverApps.Stop(Seconds(10));
+
+    UdpEchoClientHelper echoClient(interfaces.GetAddress(1), 9);
+    echoClient.SetAttribute("MaxPackets", UintegerValue(100));
+    echoClient.SetAttribute("Interval", TimeValue(Seconds(1)));
+    echoClient.SetAttribute("PacketSize", UintegerValue(1024));
+    ApplicationContainer clientApps = echoClient.Install(nodes.Get(0));
+    clientApps.Start(Seconds(2));
+    clientApps.Stop(Seconds(10));
+
+    {
+        AnimationInterface anim(m_traceFileName, format);
+        anim.SetPacketSamplingRate(samplingRate);
+        Simulator::Run();
+    }
+    Simulator::Destroy();
+    return ReadTraceFile(format, fileSize);
+}
+
+std::string
+AnimationBinaryOutputTestCase::ReadTraceFile(AnimationInterface::OutputFormat format,
+                                             std::size_t& fileSize)
+{
+    std::ostringstream contents;
+    {
+        std::ifstream file(m_traceFileName, std::ios::binary);
+        contents << file.rdbuf();
+    }
+    remove(m_traceFileName);
+    fileSize = contents.str().size();
+    if (format == AnimationInterface::XML)
+    {
+        return contents.str();
+    }
+    std::istringstream is(contents.str());
+    std::ostringstream os;
+    bool converted = AnimationInterface::ConvertBinaryToXml(is, os, Seconds(1));
+    NS_TEST_EXPECT_MSG_EQ(converted, true, "The binary trace could not be converted");
+    return os.str();
+}
+
+uint32_t
+AnimationBinaryOutputTestCase::CountPackets(const std::string& xml)
+{
+    uint32_t count = 0;
+    for (auto pos = xml.find("<p "); pos != std::string::npos; pos = xml.find("<p ", pos + 1))
+    {
+        count++;
+    }
+    return count;
+}
+
+void
+AnimationBinaryOutputTestCase::DoRun()
+{
+    std::size_t xmlSize;
+    std::string xml = RunPointToPoint(AnimationInterface::XML, 1, xmlSize);
+    std::size_t binarySize;
+    std::string converted = RunPointToPoint(AnimationInterface::BINARY, 1, binarySize);
+    NS_TEST_EXPECT_MSG_EQ(CountPackets(xml), 16U, "Expected 16 packets traced");
+    NS_TEST_EXPECT_MSG_EQ(converted, xml, "The converted trace differs from the XML trace");
+    NS_TEST_EXPECT_MSG_LT(binarySize, xmlSize, "The binary trace is not smaller");
+
+    std::string sampled = RunPointToPoint(AnimationInterface::BINARY, 2, binarySize);
+    NS_TEST_EXPECT_MSG_EQ(CountPackets(sampled), 8U, "Expected 8 packets traced");
+
+    // A node moving along x, then along y after two seconds
+    NodeContainer nodes;
+    nodes.Create(1);
+    Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel>();
+    nodes.Get(0)->AggregateObject(mobility);
+    mobility->SetVelocity(Vector(1, 0, 0));
+    Simulator::Schedule(Seconds(2),
+                        &ConstantVelocityMobilityModel::SetVelocity,
+                        mobility,
+                        Vector(0, 2, 0));
+    Simulator::Stop(Seconds(4));
+    {
+        AnimationInterface anim(m_traceFileName, AnimationInterface::BINARY);
+        Simulator::Run();
+    }
+    Simulator::Destroy();
+    std::string positions = ReadTraceFile(AnimationInterface::BINARY, binarySize);
+    NS_TEST_EXPECT_MSG_NE(positions.find("<nu p=\"p\" t=\"1\" id=\"0\" x=\"1\" y=\"0\" />"),
+                          std::string::npos,
+                          "Position not interpolated before the course change");
+    NS_TEST_EXPECT_MSG_NE(positions.find("<nu p=\"p\" t=\"2\" id=\"0\" x=\"2\" y=\"0\" />"),
+                          std::string::npos,
+                          "Course change not traced");
+    NS_TEST_EXPECT_MSG_NE(positions.find("<nu p=\"p\" t=\"3\" id=\"0\" x=\"2\" y=\"2\" />"),
+                          std::string::npos,
+                          "Position not interpolated after the course change");
+}
+
 /**
  * @ingroup netanim-test
  *
@@ -244,5 +420,6 @@ static class AnimationInterfaceTestSuite : public TestSuite
     {
         AddTestCase(new AnimationInterfaceTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new AnimationRemainingEnergyTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new AnimationBinaryOutputTestCase(), TestCase::Duration::QUICK);
     }
 } g_animationInterfaceTestSuite; ///< the test suite
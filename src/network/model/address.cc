@@ -14,6 +14,7 @@
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <string_view>
 
 namespace ns3
 {
@@ -231,6 +232,15 @@ operator<(const Address& a, const Address& b)
     return false;
 }
 
+size_t
+AddressHash::operator()(const Address& x) const
+{
+    uint8_t buffer[Address::MAX_SIZE];
+    uint32_t len = x.CopyTo(buffer);
+    return std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(buffer), len));
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Address& address)
 {
@@ -159,6 +159,41 @@ Socket::SendTo(const uint8_t* buf, uint32_t size, uint32_t flags, const Address&
     return SendTo(p, flags, toAddress);
 }
 
+int
+Socket::SendBatch(std::span<const Ptr<Packet>> packets, uint32_t flags)
+{
+    NS_LOG_FUNCTION(this << packets.size() << flags);
+    int sent = 0;
+    for (const auto& p : packets)
+    {
+        if (Send(p, flags) < 0)
+        {
+            break;
+        }
+        ++sent;
+    }
+    return (sent == 0 && !packets.empty()) ? -1 : sent;
+}
+
+uint32_t
+Socket::RecvBatch(std::span<Ptr<Packet>> packets, std::span<Address> fromAddresses, uint32_t flags)
+{
+    NS_LOG_FUNCTION(this << packets.size() << flags);
+    NS_ASSERT_MSG(fromAddresses.size() >= packets.size(), "Address array too small");
+    uint32_t received = 0;
+    while (received < packets.size())
+    {
+        packets[received] =
+            RecvFrom(std::numeric_limits<uint32_t>::max(), flags, fromAddresses[received]);
+        if (!packets[received])
+        {
+            break;
+        }
+        ++received;
+    }
+    return received;
+}
+
 Ptr<Packet>
 Socket::Recv()
 {
@@ -21,6 +21,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <span>
 #include <stdint.h>
 
 namespace ns3
@@ -464,6 +465,40 @@ class Socket : public Object
      */
     virtual Ptr<Packet> RecvFrom(uint32_t maxSize, uint32_t flags, Address& fromAddress) = 0;
 
+    /**
+     * @brief Send several packets to the remote host, in order.
+     *
+     * This method has the semantics of as many calls to Send (p, flags),
+     * and stops at the first packet which is not accepted.  The default
+     * implementation does just that; subclasses may override it to check
+     * the socket state and resolve the destination once for the whole batch.
+     *
+     * @param packets the packets to send
+     * @param flags Socket control flags
+     * @returns the number of packets accepted for transmission, or -1 if
+     *          the first packet is not accepted.
+     */
+    virtual int SendBatch(std::span<const Ptr<Packet>> packets, uint32_t flags);
+
+    /**
+     * @brief Read several packets from the socket, and retrieve their sender
+     * addresses.
+     *
+     * This method has the semantics of as many calls to
+     * RecvFrom (maxSize, flags, fromAddress), with maxSize implicitly set to
+     * the maximum sized integer, and stops when no packet is left.  The
+     * caller owns the arrays, which can be reused from a call to the next.
+     *
+     * @param packets output array, filled from its start with the packets read
+     * @param fromAddresses output array of the addresses of the senders of
+     *        the packets; it must be at least as large as \p packets
+     * @param flags Socket control flags
+     * @returns the number of packets read
+     */
+    virtual uint32_t RecvBatch(std::span<Ptr<Packet>> packets,
+                               std::span<Address> fromAddresses,
+                               uint32_t flags);
+
     /////////////////////////////////////////////////////////////////////
     //   The remainder of these public methods are overloaded methods  //
     //   or variants of Send() and Recv(), and they are non-virtual    //
@@ -0,0 +1,193 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief SimpleChannel delivery test.
+ *
+ * Checks that the receivers which would discard a packet are not scheduled,
+ * and that the fan-out mode delivers the same packets as the default mode
+ * from a single event.
+ */
+class SimpleChannelDeliveryTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * @param fanOut whether the channel delivers the packets from a single event
+     */
+    SimpleChannelDeliveryTest(bool fanOut);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Receive callback of the devices
+     * @param device the receiving device
+     * @param packet the packet received
+     * @param protocol the protocol number
+     * @param from the sender address
+     * @returns true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /**
+     * Promiscuous receive callback of the devices
+     * @param device the receiving device
+     * @param packet the packet received
+     * @param protocol the protocol number
+     * @param from the sender address
+     * @param to the destination address
+     * @param packetType the packet type
+     * @returns true
+     */
+    bool PromiscReceive(Ptr<NetDevice> device,
+                        Ptr<const Packet> packet,
+                        uint16_t protocol,
+                        const Address& from,
+                        const Address& to,
+                        NetDevice::PacketType packetType);
+
+    bool m_fanOut;                               //!< Whether the channel is in fan-out mode
+    std::vector<Ptr<SimpleNetDevice>> m_devices; //!< The devices attached to the channel
+    std::vector<uint32_t> m_rx;                  //!< Packets received by each device
+    std::vector<uint32_t> m_sizes;               //!< Size of the packets received
+    uint32_t m_promiscRx; //!< Packets received by the promiscuous callback
+};
+
+SimpleChannelDeliveryTest::SimpleChannelDeliveryTest(bool fanOut)
+    : TestCase(std::string("SimpleChannel delivery") + (fanOut ? " (fan-out)" : "")),
+      m_fanOut(fanOut),
+      m_promiscRx(0)
+{
+}
+
+bool
+SimpleChannelDeliveryTest::Receive(Ptr<NetDevice> device,
+                                   Ptr<const Packet> packet,
+                                   uint16_t protocol,
+                                   const Address& from)
+{
+    auto it = std::find(m_devices.begin(), m_devices.end(), device);
+    m_rx[it - m_devices.begin()]++;
+    m_sizes.push_back(packet->GetSize());
+    // Modifying the received packet must not affect the other receivers
+    Ptr<Packet> p = ConstCast<Packet>(packet);
+    p->RemoveAtEnd(p->GetSize() / 2);
+    return true;
+}
+
+bool
+SimpleChannelDeliveryTest::PromiscReceive(Ptr<NetDevice> device,
+                                          Ptr<const Packet> packet,
+                                          uint16_t protocol,
+                                          const Address& from,
+                                          const Address& to,
+                                          NetDevice::PacketType packetType)
+{
+    m_promiscRx++;
+    return true;
+}
+
+void
+SimpleChannelDeliveryTest::DoRun()
+{
+    const uint32_t nDevices = 5;
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    channel->SetAttribute("FanOut", BooleanValue(m_fanOut));
+    for (uint32_t i = 0; i < nDevices; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        device->SetChannel(channel);
+        device->SetNode(node);
+        device->SetReceiveCallback(MakeCallback(&SimpleChannelDeliveryTest::Receive, this));
+        m_devices.push_back(device);
+    }
+    m_devices[nDevices - 1]->SetPromiscReceiveCallback(
+        MakeCallback(&SimpleChannelDeliveryTest::PromiscReceive, this));
+    m_rx.assign(nDevices, 0);
+
+    Mac48Address src = Mac48Address::ConvertFrom(m_devices[0]->GetAddress());
+    Mac48Address dst = Mac48Address::ConvertFrom(m_devices[1]->GetAddress());
+
+    // Run the initialization events of the nodes first
+    Simulator::Run();
+
+    // Unicast: only the destination and the promiscuous device are scheduled
+    channel->Send(Create<Packet>(100), 0, dst, src, m_devices[0]);
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount() - events,
+                          (m_fanOut ? 1 : 2),
+                          "Unexpected number of reception events for a unicast packet");
+    NS_TEST_EXPECT_MSG_EQ(m_rx[1], 1, "The destination did not receive the packet");
+    NS_TEST_EXPECT_MSG_EQ(m_promiscRx, 1, "The promiscuous device did not see the packet");
+    for (uint32_t i = 2; i < nDevices; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rx[i], 0, "A packet was delivered to the wrong device");
+    }
+
+    // Broadcast: all the devices but the sender receive the packet
+    m_sizes.clear();
+    channel->Send(Create<Packet>(100), 0, Mac48Address::GetBroadcast(), src, m_devices[0]);
+    events = Simulator::GetEventCount();
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount() - events,
+                          (m_fanOut ? 1 : nDevices - 1),
+                          "Unexpected number of reception events for a broadcast packet");
+    NS_TEST_EXPECT_MSG_EQ(m_rx[0], 0, "The sender received its own packet");
+    for (uint32_t i = 1; i < nDevices; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rx[i], (i == 1 ? 2 : 1), "A device missed the broadcast");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_sizes.size(), nDevices - 1, "Unexpected number of receptions");
+    for (auto size : m_sizes)
+    {
+        NS_TEST_EXPECT_MSG_EQ(size, 100, "A receiver saw a packet modified by another one");
+    }
+
+    m_devices.clear();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief SimpleChannel TestSuite
+ */
+class SimpleChannelTestSuite : public TestSuite
+{
+  public:
+    SimpleChannelTestSuite();
+};
+
+SimpleChannelTestSuite::SimpleChannelTestSuite()
+    : TestSuite("simple-channel", Type::UNIT)
+{
+    AddTestCase(new SimpleChannelDeliveryTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new SimpleChannelDeliveryTest(true), TestCase::Duration::QUICK);
+}
+
+static SimpleChannelTestSuite g_simpleChannelTestSuite; //!< Static variable for test initialization
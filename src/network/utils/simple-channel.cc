@@ -9,6 +9,7 @@
 
 #include "simple-net-device.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -34,7 +35,14 @@ SimpleChannel::GetTypeId()
                                           "Transmission delay through the channel",
                                           TimeValue(Seconds(0)),
                                           MakeTimeAccessor(&SimpleChannel::m_delay),
-                                          MakeTimeChecker());
+                                          MakeTimeChecker())
+                            .AddAttribute("FanOut",
+                                          "Deliver each packet to all the receivers from a single "
+                                          "event, in the context of the sender, instead of one "
+                                          "event per receiver",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&SimpleChannel::m_fanOut),
+                                          MakeBooleanChecker());
     return tid;
 }
 
@@ -51,10 +59,11 @@ SimpleChannel::Send(Ptr<Packet> p,
                     Ptr<SimpleNetDevice> sender)
 {
     NS_LOG_FUNCTION(this << p << protocol << to << from << sender);
+    std::vector<Ptr<SimpleNetDevice>> receivers;
     for (auto i = m_devices.begin(); i != m_devices.end(); ++i)
     {
         Ptr<SimpleNetDevice> tmp = *i;
-        if (tmp == sender)
+        if (tmp == sender || tmp->WouldDiscard(to))
         {
             continue;
         }
@@ -66,6 +75,11 @@ SimpleChannel::Send(Ptr<Packet> p,
                 continue;
             }
         }
+        if (m_fanOut)
+        {
+            receivers.push_back(tmp);
+            continue;
+        }
         Simulator::ScheduleWithContext(tmp->GetNode()->GetId(),
                                        m_delay,
                                        &SimpleNetDevice::Receive,
@@ -75,6 +89,31 @@ SimpleChannel::Send(Ptr<Packet> p,
                                        to,
                                        from);
     }
+    if (!receivers.empty())
+    {
+        Simulator::Schedule(m_delay,
+                            &SimpleChannel::FanOutReceive,
+                            this,
+                            p->Copy(),
+                            protocol,
+                            to,
+                            from,
+                            std::move(receivers));
+    }
+}
+
+void
+SimpleChannel::FanOutReceive(Ptr<Packet> p,
+                             uint16_t protocol,
+                             Mac48Address to,
+                             Mac48Address from,
+                             std::vector<Ptr<SimpleNetDevice>> receivers)
+{
+    NS_LOG_FUNCTION(this << p << protocol << to << from << receivers.size());
+    for (const auto& receiver : receivers)
+    {
+        receiver->Receive(p->Copy(), protocol, to, from);
+    }
 }
 
 void
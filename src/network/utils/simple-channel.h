@@ -47,7 +47,15 @@ class SimpleChannel : public Channel
     /**
      * A packet is sent by a net device.  A receive event will be
      * scheduled for all net device connected to the channel other
-     * than the net device who sent the packet
+     * than the net device who sent the packet, except the ones which
+     * would discard it without any observable effect (see
+     * SimpleNetDevice::WouldDiscard).
+     *
+     * If the FanOut attribute is set, a single event delivers the packet to
+     * all the receivers, in the context of the sender, instead of one event
+     * per receiver in the context of its node.  Each receiver gets its own
+     * copy of the packet, which shares the buffer of the original one until
+     * it is modified.
      *
      * @param p packet to be sent
      * @param protocol protocol number
@@ -92,7 +100,24 @@ class SimpleChannel : public Channel
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
   private:
-    Time m_delay; //!< The assigned speed-of-light delay of the channel
+    /**
+     * Deliver a packet to several net devices from a single event, in
+     * fan-out mode.
+     *
+     * @param p packet to be delivered
+     * @param protocol protocol number
+     * @param to address to send packet to
+     * @param from address the packet is coming from
+     * @param receivers the net devices to deliver the packet to
+     */
+    void FanOutReceive(Ptr<Packet> p,
+                       uint16_t protocol,
+                       Mac48Address to,
+                       Mac48Address from,
+                       std::vector<Ptr<SimpleNetDevice>> receivers);
+
+    Time m_delay;  //!< The assigned speed-of-light delay of the channel
+    bool m_fanOut; //!< Whether a packet is delivered to all receivers from a single event
     std::vector<Ptr<SimpleNetDevice>> m_devices; //!< devices connected by the channel
     std::map<Ptr<SimpleNetDevice>, std::vector<Ptr<SimpleNetDevice>>>
         m_blackListedDevices; //!< devices blocked on a device
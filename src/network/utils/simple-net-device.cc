@@ -260,6 +260,13 @@ SimpleNetDevice::Receive(Ptr<Packet> packet, uint16_t protocol, Mac48Address to,
     }
 }
 
+bool
+SimpleNetDevice::WouldDiscard(Mac48Address to) const
+{
+    NS_LOG_FUNCTION(this << to);
+    return !to.IsGroup() && to != m_address && m_promiscCallback.IsNull() && !m_receiveErrorModel;
+}
+
 void
 SimpleNetDevice::SetChannel(Ptr<SimpleChannel> channel)
 {
@@ -62,6 +62,18 @@ class SimpleNetDevice : public NetDevice
      */
     void Receive(Ptr<Packet> packet, uint16_t protocol, Mac48Address to, Mac48Address from);
 
+    /**
+     * Would Receive() drop a packet without any observable effect?
+     *
+     * This is the case of a packet unicast to another device, when neither a
+     * promiscuous receive callback nor a receive error model is in use.  The
+     * channel can then skip the reception event of this device altogether.
+     *
+     * @param to address packet should be sent to
+     * @returns true if the packet can be discarded before it is received
+     */
+    bool WouldDiscard(Mac48Address to) const;
+
     /**
      * Attach a channel to this net device.  This will be the
      * channel the net device sends on
@@ -14,10 +14,12 @@
 #include "nix-vector-routing.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/log.h"
 #include "ns3/loopback-net-device.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
 
 #include <iomanip>
 #include <queue>
@@ -44,6 +46,9 @@ template <typename T>
 typename NixVectorRouting<T>::NetDeviceToIpInterfaceMap
     NixVectorRouting<T>::g_netdeviceToIpInterfaceMap;
 
+template <typename T>
+NixVectorStore NixVectorRouting<T>::g_sharedCache;
+
 template <typename T>
 TypeId
 NixVectorRouting<T>::GetTypeId()
@@ -57,16 +62,32 @@ NixVectorRouting<T>::GetTypeId()
     {
         name = "Ipv6";
     }
-    static TypeId tid = TypeId("ns3::" + name + "NixVectorRouting")
-                            .SetParent<T>()
-                            .SetGroupName("NixVectorRouting")
-                            .template AddConstructor<NixVectorRouting<T>>();
+    static TypeId tid =
+        TypeId("ns3::" + name + "NixVectorRouting")
+            .SetParent<T>()
+            .SetGroupName("NixVectorRouting")
+            .template AddConstructor<NixVectorRouting<T>>()
+            .AddAttribute(
+                "SharedCache",
+                "Look the paths up in shortest-path tables, computed once per destination "
+                "and shared by all the nodes, rather than searching them for each source.",
+                BooleanValue(false),
+                MakeBooleanAccessor(&NixVectorRouting<T>::m_useSharedCache),
+                MakeBooleanChecker())
+            .AddAttribute("SharedCacheSize",
+                          "The maximum number of destinations kept in the shared cache, the "
+                          "least recently used being evicted first (0 for no limit).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&NixVectorRouting<T>::SetSharedCacheSize,
+                                               &NixVectorRouting<T>::GetSharedCacheSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 template <typename T>
 NixVectorRouting<T>::NixVectorRouting()
-    : m_totalNeighbors(0)
+    : m_useSharedCache(false),
+      m_totalNeighbors(0)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -121,6 +142,7 @@ NixVectorRouting<T>::DoDispose()
 
     m_node = nullptr;
     m_ip = nullptr;
+    g_sharedCache.MarkStale();
 
     T::DoDispose();
 }
@@ -157,6 +179,91 @@ NixVectorRouting<T>::FlushGlobalNixRoutingCache() const
     // IP address to node mapping is potentially invalid so clear it.
     // Will be repopulated in lazy evaluation when mapping is needed.
     g_ipAddressToNodeMap.clear();
+
+    // The shared cache only drops the paths invalidated by the changes,
+    // once the graph is rebuilt.
+    g_sharedCache.MarkStale();
+}
+
+template <typename T>
+NixVectorStore&
+NixVectorRouting<T>::GetSharedCache()
+{
+    return g_sharedCache;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::SetSharedCacheSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    g_sharedCache.SetMaxDestinations(size);
+}
+
+template <typename T>
+uint32_t
+NixVectorRouting<T>::GetSharedCacheSize() const
+{
+    return g_sharedCache.GetMaxDestinations();
+}
+
+template <typename T>
+bool
+NixVectorRouting<T>::UpdateSharedCache() const
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!g_sharedCache.IsStale() && g_sharedCache.GetNNodes() == NodeList::GetNNodes())
+    {
+        return g_sharedCache.IsUsable();
+    }
+
+    // The edges of each node are listed as BuildNixVector numbers the
+    // neighbors, so that their positions are the nix-vector indices.
+    NixVectorStore::Adjacency adjacency(NodeList::GetNNodes());
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        auto& edges = adjacency[node->GetId()];
+        for (uint32_t j = 0; j < node->GetNDevices(); j++)
+        {
+            Ptr<NetDevice> localNetDevice = node->GetDevice(j);
+            if (localNetDevice->IsBridge())
+            {
+                continue;
+            }
+            Ptr<Channel> channel = localNetDevice->GetChannel();
+            if (!channel)
+            {
+                continue;
+            }
+
+            // The local and remote interfaces of the adjacent devices are up,
+            // but BFS also requires the link to be up to go this way.
+            NetDeviceContainer netDeviceContainer;
+            GetAdjacentNetDevices(localNetDevice, channel, netDeviceContainer);
+            bool usable = localNetDevice->IsLinkUp();
+            for (auto iter = netDeviceContainer.Begin(); iter != netDeviceContainer.End(); iter++)
+            {
+                edges.push_back({(*iter)->GetNode()->GetId(), usable});
+            }
+        }
+    }
+    g_sharedCache.SetGraph(std::move(adjacency));
+    return g_sharedCache.IsUsable();
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::PrecomputeSharedCache(uint32_t threads) const
+{
+    NS_LOG_FUNCTION(this << threads);
+
+    CheckCacheStateAndFlush();
+    if (m_useSharedCache && UpdateSharedCache())
+    {
+        g_sharedCache.ComputeAll(threads);
+    }
 }
 
 template <typename T>
@@ -206,6 +313,22 @@ NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevic
     {
         // otherwise proceed as normal
         // and build the nix vector
+        if (m_useSharedCache && !oif && UpdateSharedCache())
+        {
+            std::vector<NixVectorStore::Hop> hops;
+            if (!g_sharedCache.GetPath(source->GetId(), destNode->GetId(), hops))
+            {
+                NS_LOG_ERROR("No routing path exists");
+                return nullptr;
+            }
+            // As in BuildNixVector, the index of the last hop is added first
+            for (auto hop = hops.rbegin(); hop != hops.rend(); hop++)
+            {
+                nixVector->AddNeighborIndex(hop->first, nixVector->BitCount(hop->second));
+            }
+            return nixVector;
+        }
+
         std::vector<Ptr<Node>> parentVector;
 
         if (BFS(NodeList::GetNNodes(), source, destNode, parentVector, oif))
@@ -1422,6 +1545,12 @@ template void NixVectorRouting<Ipv4RoutingProtocol>::SetNode(Ptr<Node> node);
 template void NixVectorRouting<Ipv6RoutingProtocol>::SetNode(Ptr<Node> node);
 template void NixVectorRouting<Ipv4RoutingProtocol>::FlushGlobalNixRoutingCache() const;
 template void NixVectorRouting<Ipv6RoutingProtocol>::FlushGlobalNixRoutingCache() const;
+template void NixVectorRouting<Ipv4RoutingProtocol>::PrecomputeSharedCache(
+    uint32_t threads) const;
+template void NixVectorRouting<Ipv6RoutingProtocol>::PrecomputeSharedCache(
+    uint32_t threads) const;
+template NixVectorStore& NixVectorRouting<Ipv4RoutingProtocol>::GetSharedCache();
+template NixVectorStore& NixVectorRouting<Ipv6RoutingProtocol>::GetSharedCache();
 template void NixVectorRouting<Ipv4RoutingProtocol>::PrintRoutingPath(
     Ptr<Node> source,
     IpAddress dest,
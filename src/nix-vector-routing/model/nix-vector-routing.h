@@ -14,6 +14,8 @@
 #ifndef NIX_VECTOR_ROUTING_H
 #define NIX_VECTOR_ROUTING_H
 
+#include "nix-vector-store.h"
+
 #include "ns3/bridge-net-device.h"
 #include "ns3/channel.h"
 #include "ns3/ipv4-interface.h"
@@ -116,6 +118,24 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     void FlushGlobalNixRoutingCache() const;
 
+    /**
+     * @brief Compute the shared nix-vector cache for all the destinations
+     *
+     * This only applies when the SharedCache attribute is true.  The
+     * shortest-path tables of all the destinations, or of as many as the
+     * SharedCacheSize attribute allows, are computed in parallel, so that
+     * no path has to be searched for during the simulation.
+     *
+     * @param threads The number of threads; 0 for one per CPU
+     */
+    void PrecomputeSharedCache(uint32_t threads) const;
+
+    /**
+     * @brief Get the store of the shared nix-vector cache
+     * @return The store shared by all the nodes
+     */
+    static NixVectorStore& GetSharedCache();
+
     /**
      * @brief Print the Routing Path according to Nix Routing
      * @param source Source node
@@ -151,6 +171,25 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     void ResetTotalNeighbors();
 
+    /**
+     * Set the maximum number of destinations kept in the shared cache.
+     * @param size The number of destinations; 0 for no limit
+     */
+    void SetSharedCacheSize(uint32_t size);
+
+    /**
+     * Get the maximum number of destinations kept in the shared cache.
+     * @returns The number of destinations; 0 for no limit
+     */
+    uint32_t GetSharedCacheSize() const;
+
+    /**
+     * Build the graph of the shared cache from the current topology,
+     * if it is out of date.
+     * @returns \c false if the shared cache can not be used with this topology
+     */
+    bool UpdateSharedCache() const;
+
     /**
      * Takes in the source node and dest IP and calls GetNodeByIp,
      * BFS, accounting for any output interface specified, and finally
@@ -480,6 +519,12 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     static uint32_t g_epoch;
 
+    /** Shortest-path tables shared by all the nodes */
+    static NixVectorStore g_sharedCache;
+
+    /** Use the shared cache rather than a per-source search */
+    bool m_useSharedCache;
+
     /** Cache stores nix-vectors based on destination ip */
     mutable NixMap_t m_nixCache;
 
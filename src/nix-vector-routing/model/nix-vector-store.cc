@@ -0,0 +1,328 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "nix-vector-store.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("NixVectorStore");
+
+NixVectorStore::NixVectorStore()
+    : m_maxDestinations(0),
+      m_stale(true),
+      m_usable(true),
+      m_computations(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+NixVectorStore::SetMaxDestinations(uint32_t max)
+{
+    NS_LOG_FUNCTION(this << max);
+    m_maxDestinations = max;
+    while (m_maxDestinations != 0 && m_tables.size() > m_maxDestinations)
+    {
+        m_tables.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+uint32_t
+NixVectorStore::GetMaxDestinations() const
+{
+    return m_maxDestinations;
+}
+
+void
+NixVectorStore::MarkStale()
+{
+    NS_LOG_FUNCTION(this);
+    m_stale = true;
+}
+
+bool
+NixVectorStore::IsStale() const
+{
+    return m_stale;
+}
+
+uint32_t
+NixVectorStore::GetNNodes() const
+{
+    return m_adjacency.size();
+}
+
+bool
+NixVectorStore::IsUsable() const
+{
+    return m_usable;
+}
+
+void
+NixVectorStore::SetGraph(Adjacency adjacency)
+{
+    NS_LOG_FUNCTION(this);
+    m_stale = false;
+
+    // Find the nodes whose edges changed, and whether any edge was added
+    bool added = adjacency.size() != m_adjacency.size();
+    std::vector<uint32_t> restructured;
+    std::vector<uint32_t> flagged;
+    for (uint32_t node = 0; !added && node < adjacency.size(); ++node)
+    {
+        const auto& before = m_adjacency[node];
+        const auto& after = adjacency[node];
+        if (before == after)
+        {
+            continue;
+        }
+        bool sameNeighbors = before.size() == after.size();
+        for (uint32_t i = 0; sameNeighbors && i < after.size(); ++i)
+        {
+            sameNeighbors = before[i].neighbor == after[i].neighbor;
+        }
+        if (sameNeighbors)
+        {
+            // Only the usable flags changed
+            for (uint32_t i = 0; i < after.size(); ++i)
+            {
+                added = added || (after[i].usable && !before[i].usable);
+            }
+            flagged.push_back(node);
+        }
+        else
+        {
+            // The neighbor indices changed
+            std::unordered_set<uint32_t> reachable;
+            for (const auto& edge : before)
+            {
+                if (edge.usable)
+                {
+                    reachable.insert(edge.neighbor);
+                }
+            }
+            for (const auto& edge : after)
+            {
+                added = added || (edge.usable && reachable.count(edge.neighbor) == 0);
+            }
+            restructured.push_back(node);
+        }
+    }
+
+    if (added)
+    {
+        // Any path may be shortened
+        NS_LOG_LOGIC("Edges added, dropping all the tables");
+        Clear();
+    }
+    else
+    {
+        // Only the trees going through a removed edge are invalid
+        for (auto it = m_lru.begin(); it != m_lru.end();)
+        {
+            uint32_t dest = *it;
+            const Table& table = m_tables[dest].table;
+            bool valid = true;
+            for (auto node : restructured)
+            {
+                valid = valid && (node == dest || table[node] == UNREACHABLE);
+            }
+            for (auto node : flagged)
+            {
+                valid = valid && (node == dest || table[node] == UNREACHABLE ||
+                                  adjacency[node][table[node]].usable);
+            }
+            if (valid)
+            {
+                ++it;
+                continue;
+            }
+            NS_LOG_LOGIC("Dropping the table of node " << dest);
+            m_tables.erase(dest);
+            it = m_lru.erase(it);
+        }
+    }
+
+    m_adjacency = std::move(adjacency);
+    m_reverse.assign(m_adjacency.size(), {});
+    m_usable = true;
+    for (uint32_t node = 0; node < m_adjacency.size(); ++node)
+    {
+        const auto& edges = m_adjacency[node];
+        if (edges.size() >= UNREACHABLE)
+        {
+            m_usable = false;
+            continue;
+        }
+        for (uint32_t i = 0; i < edges.size(); ++i)
+        {
+            if (edges[i].usable)
+            {
+                m_reverse[edges[i].neighbor].emplace_back(node, i);
+            }
+        }
+    }
+    if (!m_usable)
+    {
+        Clear();
+    }
+}
+
+void
+NixVectorStore::Compute(uint32_t dest, Table& table) const
+{
+    table.assign(m_adjacency.size(), UNREACHABLE);
+    std::vector<uint32_t> queue;
+    queue.reserve(m_adjacency.size());
+    queue.push_back(dest);
+    table[dest] = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        uint32_t node = queue[head];
+        for (const auto& [previous, index] : m_reverse[node])
+        {
+            if (table[previous] == UNREACHABLE)
+            {
+                table[previous] = index;
+                queue.push_back(previous);
+            }
+        }
+    }
+}
+
+const NixVectorStore::Table&
+NixVectorStore::Insert(uint32_t dest, Table table)
+{
+    m_lru.push_front(dest);
+    Entry& entry = m_tables[dest];
+    entry.table = std::move(table);
+    entry.use = m_lru.begin();
+    if (m_maxDestinations != 0 && m_tables.size() > m_maxDestinations)
+    {
+        m_tables.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+    return entry.table;
+}
+
+bool
+NixVectorStore::GetPath(uint32_t source, uint32_t dest, std::vector<Hop>& hops)
+{
+    NS_LOG_FUNCTION(this << source << dest);
+    NS_ASSERT_MSG(!m_stale && m_usable, "Nix-vector store not ready");
+    hops.clear();
+    if (source >= m_adjacency.size() || dest >= m_adjacency.size())
+    {
+        return false;
+    }
+
+    const Table* table;
+    auto it = m_tables.find(dest);
+    if (it != m_tables.end())
+    {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.use);
+        table = &it->second.table;
+    }
+    else
+    {
+        Table computed;
+        Compute(dest, computed);
+        ++m_computations;
+        table = &Insert(dest, std::move(computed));
+    }
+
+    for (uint32_t node = source; node != dest;)
+    {
+        uint16_t index = (*table)[node];
+        if (index == UNREACHABLE)
+        {
+            hops.clear();
+            return false;
+        }
+        hops.emplace_back(index, m_adjacency[node].size());
+        node = m_adjacency[node][index].neighbor;
+    }
+    return true;
+}
+
+void
+NixVectorStore::ComputeAll(uint32_t threads)
+{
+    NS_LOG_FUNCTION(this << threads);
+    NS_ASSERT_MSG(!m_stale && m_usable, "Nix-vector store not ready");
+    uint32_t nNodes = m_adjacency.size();
+    uint32_t count = m_maxDestinations == 0 ? nNodes : std::min(nNodes, m_maxDestinations);
+    std::vector<uint32_t> missing;
+    for (uint32_t dest = 0; dest < nNodes && m_tables.size() + missing.size() < count; ++dest)
+    {
+        if (m_tables.count(dest) == 0)
+        {
+            missing.push_back(dest);
+        }
+    }
+
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    threads = std::min<uint32_t>(threads, missing.size());
+
+    // The workers only read the graph, and each writes its own tables
+    std::vector<Table> tables(missing.size());
+    std::atomic<std::size_t> next{0};
+    auto work = [&]() {
+        for (std::size_t i = next++; i < missing.size(); i = next++)
+        {
+            Compute(missing[i], tables[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < threads; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    m_computations += missing.size();
+    for (std::size_t i = 0; i < missing.size(); ++i)
+    {
+        Insert(missing[i], std::move(tables[i]));
+    }
+}
+
+void
+NixVectorStore::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_tables.clear();
+    m_lru.clear();
+}
+
+uint32_t
+NixVectorStore::GetNDestinations() const
+{
+    return m_tables.size();
+}
+
+uint64_t
+NixVectorStore::GetNComputations() const
+{
+    return m_computations;
+}
+
+} // namespace ns3
@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef NIX_VECTOR_STORE_H
+#define NIX_VECTOR_STORE_H
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup nix-vector-routing
+ * Shortest-path tables shared by the nix-vector routing protocols of
+ * all the nodes.
+ *
+ * The topology is kept as a graph whose nodes are the ns-3 nodes,
+ * indexed by node id, and whose edges are listed, for each node, in
+ * the order of the nix-vector neighbor indices of that node.  For each
+ * destination, a single breadth-first search from the destination,
+ * over the reversed edges, gives the neighbor index of the next hop
+ * towards that destination from every node.  These tables are stored
+ * in 16 bits per node, and the path from any source is then a walk
+ * through the table, without any further search.
+ *
+ * The tables are computed on demand, or all at once, in parallel, with
+ * ComputeAll().  Their number can be bounded, in which case the least
+ * recently used table is evicted first.  When the graph changes, only
+ * the tables whose shortest-path tree uses a removed or changed edge
+ * are dropped, unless an edge was added, which may shorten any path.
+ */
+class NixVectorStore
+{
+  public:
+    /** An edge of the graph, from a node to a neighbor. */
+    struct Edge
+    {
+        uint32_t neighbor; //!< Node id of the neighbor.
+        bool usable;       //!< Whether packets can be sent to the neighbor on this edge.
+
+        /**
+         * Compare two edges.
+         * @param [in] other The other edge.
+         * @returns \c true if the edges are equal.
+         */
+        bool operator==(const Edge& other) const
+        {
+            return neighbor == other.neighbor && usable == other.usable;
+        }
+    };
+
+    /** The edges of each node, in nix-vector neighbor index order. */
+    using Adjacency = std::vector<std::vector<Edge>>;
+
+    /** A hop of a path: the neighbor index, and the number of neighbors of the node. */
+    using Hop = std::pair<uint32_t, uint32_t>;
+
+    NixVectorStore();
+
+    /**
+     * Set the maximum number of destination tables kept.
+     * @param [in] max The number of tables; 0 for no limit.
+     */
+    void SetMaxDestinations(uint32_t max);
+    /**
+     * @returns The maximum number of destination tables kept, 0 for no limit.
+     */
+    uint32_t GetMaxDestinations() const;
+
+    /**
+     * Replace the graph, and drop the tables invalidated by the changes.
+     * @param [in] adjacency The new graph.
+     */
+    void SetGraph(Adjacency adjacency);
+    /**
+     * Mark the graph as out of date, to be set again before any lookup.
+     */
+    void MarkStale();
+    /**
+     * @returns \c true if the graph has not been set since the last MarkStale().
+     */
+    bool IsStale() const;
+    /**
+     * @returns The number of nodes in the graph.
+     */
+    uint32_t GetNNodes() const;
+    /**
+     * The tables can only store up to 65535 neighbor indices per node.
+     * @returns \c false if a node has too many neighbors to use the tables.
+     */
+    bool IsUsable() const;
+
+    /**
+     * Get the shortest path between two nodes.
+     *
+     * @param [in] source The node id of the source.
+     * @param [in] dest The node id of the destination.
+     * @param [out] hops The hops of the path, starting from the source.
+     * @returns \c false if the destination can not be reached.
+     */
+    bool GetPath(uint32_t source, uint32_t dest, std::vector<Hop>& hops);
+
+    /**
+     * Compute the tables of all the destinations, or of as many as can be
+     * kept, in parallel.
+     * @param [in] threads The number of threads; 0 for one per CPU.
+     */
+    void ComputeAll(uint32_t threads);
+
+    /**
+     * Drop all the tables.
+     */
+    void Clear();
+
+    /**
+     * @returns The number of destination tables currently kept.
+     */
+    uint32_t GetNDestinations() const;
+    /**
+     * @returns The number of tables computed since the creation of the store.
+     */
+    uint64_t GetNComputations() const;
+
+  private:
+    /** Neighbor index of the next hop of each node, or #UNREACHABLE. */
+    using Table = std::vector<uint16_t>;
+
+    /** Marks the nodes which can not reach the destination. */
+    static constexpr uint16_t UNREACHABLE = 0xffff;
+
+    /**
+     * Compute the table of a destination.  This only reads the graph, so
+     * that several tables can be computed at the same time.
+     * @param [in] dest The node id of the destination.
+     * @param [out] table The table.
+     */
+    void Compute(uint32_t dest, Table& table) const;
+
+    /**
+     * Keep a table, evicting the least recently used one if needed.
+     * @param [in] dest The node id of the destination.
+     * @param [in] table The table.
+     * @returns The table kept.
+     */
+    const Table& Insert(uint32_t dest, Table table);
+
+    /** A kept table. */
+    struct Entry
+    {
+        Table table;                       //!< The table.
+        std::list<uint32_t>::iterator use; //!< Position in #m_lru.
+    };
+
+    /** Incoming edges of each node, as (node, neighbor index in that node). */
+    std::vector<std::vector<std::pair<uint32_t, uint16_t>>> m_reverse;
+
+    Adjacency m_adjacency;                        //!< The graph.
+    std::unordered_map<uint32_t, Entry> m_tables; //!< Tables, by destination.
+    std::list<uint32_t> m_lru;                    //!< Destinations, most recently used first.
+    uint32_t m_maxDestinations;                   //!< Maximum number of tables, 0 for no limit.
+    bool m_stale;                                 //!< Whether the graph must be set again.
+    bool m_usable;                                //!< Whether all the indices fit in the tables.
+    uint64_t m_computations;                      //!< Number of tables computed.
+};
+
+} // namespace ns3
+
+#endif /* NIX_VECTOR_STORE_H */
@@ -6,6 +6,8 @@
  * Author: Ameya Deshpande <ameyanrd@outlook.com>
  */
 
+#include "ns3/boolean.h"
+#include "ns3/config.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -14,6 +16,7 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/nix-vector-helper.h"
+#include "ns3/nix-vector-store.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
@@ -49,11 +52,14 @@ using namespace ns3;
  * (Set down the interface of nC on nB-nC channel.)
  * - Test that routing is not possible from nSrc to nDst.
  *
+ * The test is run with and without the shared cache.
+ *
  * @brief IPv4 Nix-Vector Routing Test
  */
 class NixVectorRoutingTest : public TestCase
 {
     Ptr<Packet> m_receivedPacket; //!< Received packet
+    bool m_sharedCache;           //!< Use the shared cache
 
     /**
      * @brief Send data immediately after being called.
@@ -87,7 +93,11 @@ class NixVectorRoutingTest : public TestCase
 
   public:
     void DoRun() override;
-    NixVectorRoutingTest();
+    /**
+     * Constructor.
+     * @param sharedCache Use the shared cache.
+     */
+    NixVectorRoutingTest(bool sharedCache);
 
     /**
      * @brief Receive data.
@@ -98,8 +108,10 @@ class NixVectorRoutingTest : public TestCase
     std::vector<uint32_t> m_receivedPacketSizes; //!< Received packet sizes
 };
 
-NixVectorRoutingTest::NixVectorRoutingTest()
-    : TestCase("three router, two path test")
+NixVectorRoutingTest::NixVectorRoutingTest(bool sharedCache)
+    : TestCase(std::string("three router, two path test") +
+               (sharedCache ? " with shared cache" : "")),
+      m_sharedCache(sharedCache)
 {
 }
 
@@ -194,6 +206,9 @@ NixVectorRoutingTest::DoRun()
     std::ostringstream stringStream3v6;
     Ptr<OutputStreamWrapper> routingStream3v6 = Create<OutputStreamWrapper>(&stringStream3v6);
 
+    Config::SetDefault("ns3::Ipv4NixVectorRouting::SharedCache", BooleanValue(m_sharedCache));
+    Config::SetDefault("ns3::Ipv6NixVectorRouting::SharedCache", BooleanValue(m_sharedCache));
+
     // NixHelper to install nix-vector routing on all nodes
     Ipv4NixVectorHelper ipv4NixRouting;
     Ipv6NixVectorHelper ipv6NixRouting;
@@ -380,6 +395,125 @@ NixVectorRoutingTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(stringStream2v6.str(), emptyCaches, "The caches should have been empty.");
 
     Simulator::Destroy();
+
+    Config::SetDefault("ns3::Ipv4NixVectorRouting::SharedCache", BooleanValue(false));
+    Config::SetDefault("ns3::Ipv6NixVectorRouting::SharedCache", BooleanValue(false));
+}
+
+/**
+ * @ingroup nix-vector-routing-test
+ * @ingroup tests
+ *
+ * The graph is of the form:
+ * @verbatim
+    n0 -- n1
+    |     |
+    n3 -- n2 -- n4     n5
+   \endverbatim
+ *
+ * - Test the paths, and the unreachable node.
+ * - Test that disabling an edge only drops the tables using it.
+ * - Test that enabling an edge drops all the tables.
+ * - Test the eviction of the least recently used table.
+ * - Test the parallel computation of all the tables.
+ *
+ * @brief Nix-Vector Store Test
+ */
+class NixVectorStoreTest : public TestCase
+{
+  public:
+    NixVectorStoreTest();
+
+  private:
+    void DoRun() override;
+};
+
+NixVectorStoreTest::NixVectorStoreTest()
+    : TestCase("shared nix-vector store test")
+{
+}
+
+void
+NixVectorStoreTest::DoRun()
+{
+    using Hops = std::vector<NixVectorStore::Hop>;
+    NixVectorStore::Adjacency graph = {
+        {{1, true}, {3, true}},
+        {{0, true}, {2, true}},
+        {{1, true}, {3, true}, {4, true}},
+        {{2, true}, {0, true}},
+        {{2, true}},
+        {},
+    };
+
+    NixVectorStore store;
+    NS_TEST_EXPECT_MSG_EQ(store.IsStale(), true, "The store should wait for a graph.");
+    store.SetGraph(graph);
+    NS_TEST_EXPECT_MSG_EQ(store.IsStale(), false, "The graph should have been set.");
+    NS_TEST_EXPECT_MSG_EQ(store.IsUsable(), true, "The store should be usable.");
+
+    Hops hops;
+    NS_TEST_EXPECT_MSG_EQ(store.GetPath(0, 4, hops), true, "Node 4 should be reachable.");
+    NS_TEST_EXPECT_MSG_EQ((hops == Hops{{0, 2}, {1, 2}, {2, 3}}), true, "Wrong path.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetPath(3, 4, hops), true, "Node 4 should be reachable.");
+    NS_TEST_EXPECT_MSG_EQ((hops == Hops{{0, 2}, {2, 3}}), true, "Wrong path.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetNComputations(), 1, "One search should serve all sources.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetPath(0, 5, hops), false, "Node 5 should be unreachable.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetNDestinations(), 2, "Wrong number of tables.");
+
+    // n3 -> n0 is not in the tree towards n4, whose table is kept
+    graph[3][1].usable = false;
+    store.SetGraph(graph);
+    NS_TEST_EXPECT_MSG_EQ(store.GetNDestinations(), 2, "No table should have been dropped.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetPath(0, 4, hops), true, "Node 4 should be reachable.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetNComputations(), 2, "The table should have been kept.");
+
+    // n0 -> n1 is in the tree towards n4, whose table is dropped
+    graph[0][0].usable = false;
+    store.SetGraph(graph);
+    NS_TEST_EXPECT_MSG_EQ(store.GetNDestinations(), 1, "The table of n4 should have been dropped.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetPath(0, 4, hops), true, "Node 4 should be reachable.");
+    NS_TEST_EXPECT_MSG_EQ((hops == Hops{{1, 2}, {0, 2}, {2, 3}}), true, "Wrong path.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetNComputations(), 3, "The table should have been computed.");
+
+    // Enabling an edge may shorten any path
+    graph[0][0].usable = true;
+    store.SetGraph(graph);
+    NS_TEST_EXPECT_MSG_EQ(store.GetNDestinations(), 0, "All the tables should have been dropped.");
+
+    // Least recently used eviction
+    store.SetMaxDestinations(2);
+    store.GetPath(4, 0, hops);
+    store.GetPath(4, 1, hops);
+    store.GetPath(4, 0, hops);
+    store.GetPath(4, 2, hops);
+    NS_TEST_EXPECT_MSG_EQ(store.GetNDestinations(), 2, "Wrong number of tables.");
+    uint64_t computations = store.GetNComputations();
+    store.GetPath(4, 0, hops);
+    NS_TEST_EXPECT_MSG_EQ(store.GetNComputations(), computations, "n0 should have been kept.");
+    store.GetPath(4, 1, hops);
+    NS_TEST_EXPECT_MSG_EQ(store.GetNComputations(),
+                          computations + 1,
+                          "n1 should have been evicted.");
+
+    // Parallel computation of all the tables
+    store.SetMaxDestinations(0);
+    store.Clear();
+    store.ComputeAll(2);
+    NS_TEST_EXPECT_MSG_EQ(store.GetNDestinations(), 6, "All the tables should have been computed.");
+    computations = store.GetNComputations();
+    for (uint32_t source = 0; source < 5; source++)
+    {
+        for (uint32_t dest = 0; dest < 5; dest++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(store.GetPath(source, dest, hops),
+                                  true,
+                                  "Node " << dest << " should be reachable from " << source);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(store.GetPath(0, 4, hops), true, "Node 4 should be reachable.");
+    NS_TEST_EXPECT_MSG_EQ((hops == Hops{{0, 2}, {1, 2}, {2, 3}}), true, "Wrong path.");
+    NS_TEST_EXPECT_MSG_EQ(store.GetNComputations(), computations, "No table should be missing.");
 }
 
 /**
@@ -394,7 +528,9 @@ class NixVectorRoutingTestSuite : public TestSuite
     NixVectorRoutingTestSuite()
         : TestSuite("nix-vector-routing", Type::UNIT)
     {
-        AddTestCase(new NixVectorRoutingTest(), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorRoutingTest(false), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorRoutingTest(true), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorStoreTest(), TestCase::Duration::QUICK);
     }
 };
 
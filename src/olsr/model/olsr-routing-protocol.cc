@@ -41,8 +41,12 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 /********** Useful macros **********/
 
@@ -647,19 +651,17 @@ RoutingProtocol::RecvOlsr(Ptr<Socket> socket)
 int
 RoutingProtocol::Degree(const NeighborTuple& tuple)
 {
+    // The 2-hop neighbor tuples counted are those whose neighbor is not in the neighbor set
+    if (m_state.FindNeighborTuple(tuple.neighborMainAddr) != nullptr)
+    {
+        return 0;
+    }
     int degree = 0;
-    for (auto it = m_state.GetTwoHopNeighbors().begin(); it != m_state.GetTwoHopNeighbors().end();
-         it++)
+    for (const auto& nb2hop_tuple : m_state.GetTwoHopNeighbors())
     {
-        const TwoHopNeighborTuple& nb2hop_tuple = *it;
         if (nb2hop_tuple.neighborMainAddr == tuple.neighborMainAddr)
         {
-            const NeighborTuple* nb_tuple =
-                m_state.FindNeighborTuple(nb2hop_tuple.neighborMainAddr);
-            if (nb_tuple == nullptr)
-            {
-                degree++;
-            }
+            degree++;
         }
     }
     return degree;
@@ -706,6 +708,21 @@ RoutingProtocol::MprComputation()
 {
     NS_LOG_FUNCTION(this);
 
+    // The MPR set only depends on the neighbor and 2-hop neighbor sets: if they are the same
+    // as at the last computation, so is the MPR set.
+    const OlsrState& state = m_state;
+    if (m_mprInputsValid && m_mprMainAddress == m_mainAddress &&
+        m_mprNeighbors == state.GetNeighbors() &&
+        m_mprTwoHopNeighbors == state.GetTwoHopNeighbors())
+    {
+        NS_LOG_LOGIC("Neighborhood unchanged, keeping the MPR set");
+        return;
+    }
+    m_mprInputsValid = true;
+    m_mprMainAddress = m_mainAddress;
+    m_mprNeighbors = state.GetNeighbors();
+    m_mprTwoHopNeighbors = state.GetTwoHopNeighbors();
+
     // MPR computation should be done for each interface. See section 8.3.1
     // (RFC 3626) for details.
     MprSet mprSet;
@@ -713,12 +730,14 @@ RoutingProtocol::MprComputation()
     // N is the subset of neighbors of the node, which are
     // neighbor "of the interface I"
     NeighborSet N;
-    for (auto neighbor = m_state.GetNeighbors().begin(); neighbor != m_state.GetNeighbors().end();
-         neighbor++)
+    // Willingness of the members of N, by main address
+    std::unordered_map<Ipv4Address, Willingness, Ipv4AddressHash> willingnessOfN;
+    for (const auto& neighbor : state.GetNeighbors())
     {
-        if (neighbor->status == NeighborTuple::STATUS_SYM) // I think that we need this check
+        if (neighbor.status == NeighborTuple::STATUS_SYM) // I think that we need this check
         {
-            N.push_back(*neighbor);
+            N.push_back(neighbor);
+            willingnessOfN.emplace(neighbor.neighborMainAddr, neighbor.willingness);
         }
     }
 
@@ -729,29 +748,19 @@ RoutingProtocol::MprComputation()
     // (iii) all the symmetric neighbors: the nodes for which there exists a symmetric
     //       link to this node on some interface.
     TwoHopNeighborSet N2;
-    for (auto twoHopNeigh = m_state.GetTwoHopNeighbors().begin();
-         twoHopNeigh != m_state.GetTwoHopNeighbors().end();
-         twoHopNeigh++)
+    for (const auto& twoHopNeigh : state.GetTwoHopNeighbors())
     {
         // excluding:
         // (ii)  the node performing the computation
-        if (twoHopNeigh->twoHopNeighborAddr == m_mainAddress)
+        if (twoHopNeigh.twoHopNeighborAddr == m_mainAddress)
         {
             continue;
         }
 
         //  excluding:
         // (i)   the nodes only reachable by members of N with willingness Willingness::NEVER
-        bool ok = false;
-        for (auto neigh = N.begin(); neigh != N.end(); neigh++)
-        {
-            if (neigh->neighborMainAddr == twoHopNeigh->neighborMainAddr)
-            {
-                ok = (neigh->willingness != Willingness::NEVER);
-                break;
-            }
-        }
-        if (!ok)
+        auto neigh = willingnessOfN.find(twoHopNeigh.neighborMainAddr);
+        if (neigh == willingnessOfN.end() || neigh->second == Willingness::NEVER)
         {
             continue;
         }
@@ -759,19 +768,12 @@ RoutingProtocol::MprComputation()
         // excluding:
         // (iii) all the symmetric neighbors: the nodes for which there exists a symmetric
         //       link to this node on some interface.
-        for (auto neigh = N.begin(); neigh != N.end(); neigh++)
+        if (willingnessOfN.contains(twoHopNeigh.twoHopNeighborAddr))
         {
-            if (neigh->neighborMainAddr == twoHopNeigh->twoHopNeighborAddr)
-            {
-                ok = false;
-                break;
-            }
+            continue;
         }
 
-        if (ok)
-        {
-            N2.push_back(*twoHopNeigh);
-        }
+        N2.push_back(twoHopNeigh);
     }
 
 #ifdef NS3_LOG_ENABLE
@@ -811,20 +813,25 @@ RoutingProtocol::MprComputation()
 
     // 3. Add to the MPR set those nodes in N, which are the *only*
     // nodes to provide reachability to a node in N2.
+    // For each 2-hop neighbor, record whether it can be reached by more than one neighbor,
+    // and for each neighbor, the 2-hop neighbors it can reach.
+    std::unordered_map<Ipv4Address, std::pair<Ipv4Address, bool>, Ipv4AddressHash> reachedBy;
+    std::unordered_map<Ipv4Address, std::vector<Ipv4Address>, Ipv4AddressHash> reaches;
+    for (const auto& twoHopNeigh : N2)
+    {
+        auto [it, inserted] = reachedBy.emplace(twoHopNeigh.twoHopNeighborAddr,
+                                                std::pair{twoHopNeigh.neighborMainAddr, false});
+        if (!inserted && it->second.first != twoHopNeigh.neighborMainAddr)
+        {
+            it->second.second = true;
+        }
+        reaches[twoHopNeigh.neighborMainAddr].push_back(twoHopNeigh.twoHopNeighborAddr);
+    }
     std::set<Ipv4Address> coveredTwoHopNeighbors;
     for (auto twoHopNeigh = N2.begin(); twoHopNeigh != N2.end(); twoHopNeigh++)
     {
-        bool onlyOne = true;
         // try to find another neighbor that can reach twoHopNeigh->twoHopNeighborAddr
-        for (auto otherTwoHopNeigh = N2.begin(); otherTwoHopNeigh != N2.end(); otherTwoHopNeigh++)
-        {
-            if (otherTwoHopNeigh->twoHopNeighborAddr == twoHopNeigh->twoHopNeighborAddr &&
-                otherTwoHopNeigh->neighborMainAddr != twoHopNeigh->neighborMainAddr)
-            {
-                onlyOne = false;
-                break;
-            }
-        }
+        bool onlyOne = !reachedBy[twoHopNeigh->twoHopNeighborAddr].second;
         if (onlyOne)
         {
             NS_LOG_LOGIC("Neighbor " << twoHopNeigh->neighborMainAddr
@@ -834,14 +841,8 @@ RoutingProtocol::MprComputation()
             mprSet.insert(twoHopNeigh->neighborMainAddr);
 
             // take note of all the 2-hop neighbors reachable by the newly elected MPR
-            for (auto otherTwoHopNeigh = N2.begin(); otherTwoHopNeigh != N2.end();
-                 otherTwoHopNeigh++)
-            {
-                if (otherTwoHopNeigh->neighborMainAddr == twoHopNeigh->neighborMainAddr)
-                {
-                    coveredTwoHopNeighbors.insert(otherTwoHopNeigh->twoHopNeighborAddr);
-                }
-            }
+            const auto& reached = reaches[twoHopNeigh->neighborMainAddr];
+            coveredTwoHopNeighbors.insert(reached.begin(), reached.end());
         }
     }
     // Remove the nodes from N2 which are now covered by a node in the MPR set.
@@ -890,20 +891,18 @@ RoutingProtocol::MprComputation()
         // number of nodes in N2 which are not yet covered by at
         // least one node in the MPR set, and which are reachable
         // through this 1-hop neighbor
+        std::unordered_map<Ipv4Address, int, Ipv4AddressHash> reachable;
+        for (const auto& nb2hop_tuple : N2)
+        {
+            reachable[nb2hop_tuple.neighborMainAddr]++;
+        }
         std::map<int, std::vector<const NeighborTuple*>> reachability;
         std::set<int> rs;
         for (auto it = N.begin(); it != N.end(); it++)
         {
             const NeighborTuple& nb_tuple = *it;
-            int r = 0;
-            for (auto it2 = N2.begin(); it2 != N2.end(); it2++)
-            {
-                const TwoHopNeighborTuple& nb2hop_tuple = *it2;
-                if (nb_tuple.neighborMainAddr == nb2hop_tuple.neighborMainAddr)
-                {
-                    r++;
-                }
-            }
+            auto found = reachable.find(nb_tuple.neighborMainAddr);
+            int r = found == reachable.end() ? 0 : found->second;
             rs.insert(r);
             reachability[r].push_back(&nb_tuple);
         }
@@ -1006,9 +1005,25 @@ RoutingProtocol::RoutingTableComputation()
     // 1. All the entries from the routing table are removed.
     Clear();
 
+    const OlsrState& state = m_state;
+
     // 2. The new routing entries are added starting with the
     // symmetric neighbors (h=1) as the destination nodes.
-    const NeighborSet& neighborSet = m_state.GetNeighbors();
+    //
+    // The link tuples which are not expired are grouped by neighbor main address,
+    // keeping the order of the link set.
+    std::unordered_map<Ipv4Address, std::vector<const LinkTuple*>, Ipv4AddressHash> linksOf;
+    for (const auto& link_tuple : state.GetLinks())
+    {
+        NS_LOG_DEBUG("Looking at link tuple: "
+                     << link_tuple << (link_tuple.time >= Simulator::Now() ? "" : " (expired)"));
+        if (link_tuple.time >= Simulator::Now())
+        {
+            linksOf[GetMainAddress(link_tuple.neighborIfaceAddr)].push_back(&link_tuple);
+        }
+    }
+
+    const NeighborSet& neighborSet = state.GetNeighbors();
     for (auto it = neighborSet.begin(); it != neighborSet.end(); it++)
     {
         const NeighborTuple& nb_tuple = *it;
@@ -1017,37 +1032,24 @@ RoutingProtocol::RoutingTableComputation()
         {
             bool nb_main_addr = false;
             const LinkTuple* lt = nullptr;
-            const LinkSet& linkSet = m_state.GetLinks();
-            for (auto it2 = linkSet.begin(); it2 != linkSet.end(); it2++)
+            auto links = linksOf.find(nb_tuple.neighborMainAddr);
+            if (links != linksOf.end())
             {
-                const LinkTuple& link_tuple = *it2;
-                NS_LOG_DEBUG("Looking at link tuple: "
-                             << link_tuple
-                             << (link_tuple.time >= Simulator::Now() ? "" : " (expired)"));
-                if ((GetMainAddress(link_tuple.neighborIfaceAddr) == nb_tuple.neighborMainAddr) &&
-                    link_tuple.time >= Simulator::Now())
+                for (const LinkTuple* link_tuple : links->second)
                 {
                     NS_LOG_LOGIC("Link tuple matches neighbor "
                                  << nb_tuple.neighborMainAddr
                                  << " => adding routing table entry to neighbor");
-                    lt = &link_tuple;
-                    AddEntry(link_tuple.neighborIfaceAddr,
-                             link_tuple.neighborIfaceAddr,
-                             link_tuple.localIfaceAddr,
+                    lt = link_tuple;
+                    AddEntry(link_tuple->neighborIfaceAddr,
+                             link_tuple->neighborIfaceAddr,
+                             link_tuple->localIfaceAddr,
                              1);
-                    if (link_tuple.neighborIfaceAddr == nb_tuple.neighborMainAddr)
+                    if (link_tuple->neighborIfaceAddr == nb_tuple.neighborMainAddr)
                     {
                         nb_main_addr = true;
                     }
                 }
-                else
-                {
-                    NS_LOG_LOGIC("Link tuple: linkMainAddress= "
-                                 << GetMainAddress(link_tuple.neighborIfaceAddr)
-                                 << "; neighborMainAddr =  " << nb_tuple.neighborMainAddr
-                                 << "; expired=" << int(link_tuple.time < Simulator::Now())
-                                 << " => IGNORE");
-                }
             }
 
             // If, in the above, no R_dest_addr is equal to the main
@@ -1073,7 +1075,15 @@ RoutingProtocol::RoutingTableComputation()
     //  least one entry in the 2-hop neighbor set where
     //  N_neighbor_main_addr correspond to a neighbor node with
     //  willingness different of Willingness::NEVER,
-    const TwoHopNeighborSet& twoHopNeighbors = m_state.GetTwoHopNeighbors();
+    std::unordered_set<Ipv4Address, Ipv4AddressHash> willingNeighbors;
+    for (const auto& neighbor : neighborSet)
+    {
+        if (neighbor.willingness != Willingness::NEVER)
+        {
+            willingNeighbors.insert(neighbor.neighborMainAddr);
+        }
+    }
+    const TwoHopNeighborSet& twoHopNeighbors = state.GetTwoHopNeighbors();
     for (auto it = twoHopNeighbors.begin(); it != twoHopNeighbors.end(); it++)
     {
         const TwoHopNeighborTuple& nb2hop_tuple = *it;
@@ -1081,7 +1091,7 @@ RoutingProtocol::RoutingTableComputation()
         NS_LOG_LOGIC("Looking at two-hop neighbor tuple: " << nb2hop_tuple);
 
         // a 2-hop neighbor which is not a neighbor node or the node itself
-        if (m_state.FindSymNeighborTuple(nb2hop_tuple.twoHopNeighborAddr))
+        if (state.FindSymNeighborTuple(nb2hop_tuple.twoHopNeighborAddr))
         {
             NS_LOG_LOGIC("Two-hop neighbor tuple is also neighbor; skipped.");
             continue;
@@ -1096,17 +1106,7 @@ RoutingProtocol::RoutingTableComputation()
         // ...and such that there exist at least one entry in the 2-hop
         // neighbor set where N_neighbor_main_addr correspond to a
         // neighbor node with willingness different of Willingness::NEVER...
-        bool nb2hopOk = false;
-        for (auto neighbor = neighborSet.begin(); neighbor != neighborSet.end(); neighbor++)
-        {
-            if (neighbor->neighborMainAddr == nb2hop_tuple.neighborMainAddr &&
-                neighbor->willingness != Willingness::NEVER)
-            {
-                nb2hopOk = true;
-                break;
-            }
-        }
-        if (!nb2hopOk)
+        if (!willingNeighbors.contains(nb2hop_tuple.neighborMainAddr))
         {
             NS_LOG_LOGIC("Two-hop neighbor tuple skipped: 2-hop neighbor "
                          << nb2hop_tuple.twoHopNeighborAddr << " is attached to neighbor "
@@ -1140,58 +1140,77 @@ RoutingProtocol::RoutingTableComputation()
         }
     }
 
-    for (uint32_t h = 2;; h++)
+    // 3.1. For each topology entry in the topology table, if its
+    // T_dest_addr does not correspond to R_dest_addr of any
+    // route entry in the routing table AND its T_last_addr
+    // corresponds to R_dest_addr of a route entry whose R_dist
+    // is equal to h, then a new route entry MUST be recorded in
+    // the routing table (if it does not already exist)
+    //
+    // This is done for h = 2, 3, ... until no entry is added.  Rather than scanning the
+    // whole topology set for each h, the topology entries are indexed by T_last_addr, and
+    // only those whose T_last_addr is a destination found at distance h are considered,
+    // in the order of the topology set.
+    const TopologySet& topology = state.GetTopologySet();
+    std::unordered_map<Ipv4Address, std::vector<uint32_t>, Ipv4AddressHash> topologyByLast;
+    for (uint32_t i = 0; i < topology.size(); i++)
     {
-        bool added = false;
+        topologyByLast[topology[i].lastAddr].push_back(i);
+    }
+    std::vector<Ipv4Address> destinations;
+    for (const auto& [dest, entry] : m_table)
+    {
+        if (entry.distance == 2)
+        {
+            destinations.push_back(dest);
+        }
+    }
+    std::vector<uint32_t> candidates;
+    for (uint32_t h = 2; !destinations.empty(); h++)
+    {
+        candidates.clear();
+        for (const auto& lastAddr : destinations)
+        {
+            auto it = topologyByLast.find(lastAddr);
+            if (it != topologyByLast.end())
+            {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
 
-        // 3.1. For each topology entry in the topology table, if its
-        // T_dest_addr does not correspond to R_dest_addr of any
-        // route entry in the routing table AND its T_last_addr
-        // corresponds to R_dest_addr of a route entry whose R_dist
-        // is equal to h, then a new route entry MUST be recorded in
-        // the routing table (if it does not already exist)
-        const TopologySet& topology = m_state.GetTopologySet();
-        for (auto it = topology.begin(); it != topology.end(); it++)
+        destinations.clear();
+        for (uint32_t i : candidates)
         {
-            const TopologyTuple& topology_tuple = *it;
+            const TopologyTuple& topology_tuple = topology[i];
             NS_LOG_LOGIC("Looking at topology tuple: " << topology_tuple);
 
             RoutingTableEntry destAddrEntry;
             RoutingTableEntry lastAddrEntry;
-            bool have_destAddrEntry = Lookup(topology_tuple.destAddr, destAddrEntry);
-            bool have_lastAddrEntry = Lookup(topology_tuple.lastAddr, lastAddrEntry);
-            if (!have_destAddrEntry && have_lastAddrEntry && lastAddrEntry.distance == h)
-            {
-                NS_LOG_LOGIC("Adding routing table entry based on the topology tuple.");
-                // then a new route entry MUST be recorded in
-                //                the routing table (if it does not already exist) where:
-                //                     R_dest_addr  = T_dest_addr;
-                //                     R_next_addr  = R_next_addr of the recorded
-                //                                    route entry where:
-                //                                    R_dest_addr == T_last_addr
-                //                     R_dist       = h+1; and
-                //                     R_iface_addr = R_iface_addr of the recorded
-                //                                    route entry where:
-                //                                       R_dest_addr == T_last_addr.
-                AddEntry(topology_tuple.destAddr,
-                         lastAddrEntry.nextAddr,
-                         lastAddrEntry.interface,
-                         h + 1);
-                added = true;
-            }
-            else
+            if (Lookup(topology_tuple.destAddr, destAddrEntry))
             {
                 NS_LOG_LOGIC("NOT adding routing table entry based on the topology tuple: "
-                             "have_destAddrEntry="
-                             << have_destAddrEntry << " have_lastAddrEntry=" << have_lastAddrEntry
-                             << " lastAddrEntry.distance=" << (int)lastAddrEntry.distance
-                             << " (h=" << h << ")");
+                             "have_destAddrEntry=1 (h="
+                             << h << ")");
+                continue;
             }
-        }
-
-        if (!added)
-        {
-            break;
+            Lookup(topology_tuple.lastAddr, lastAddrEntry);
+            NS_LOG_LOGIC("Adding routing table entry based on the topology tuple.");
+            // then a new route entry MUST be recorded in
+            //                the routing table (if it does not already exist) where:
+            //                     R_dest_addr  = T_dest_addr;
+            //                     R_next_addr  = R_next_addr of the recorded
+            //                                    route entry where:
+            //                                    R_dest_addr == T_last_addr
+            //                     R_dist       = h+1; and
+            //                     R_iface_addr = R_iface_addr of the recorded
+            //                                    route entry where:
+            //                                       R_dest_addr == T_last_addr.
+            AddEntry(topology_tuple.destAddr,
+                     lastAddrEntry.nextAddr,
+                     lastAddrEntry.interface,
+                     h + 1);
+            destinations.push_back(topology_tuple.destAddr);
         }
     }
 
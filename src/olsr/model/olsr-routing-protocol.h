@@ -33,6 +33,8 @@
 
 /// Testcase for MPR computation mechanism
 class OlsrMprTestCase;
+/// Testcase for routing table computation
+class OlsrRoutingTableTestCase;
 
 namespace ns3
 {
@@ -77,6 +79,7 @@ class RoutingProtocol : public Ipv4RoutingProtocol
      * Declared friend to enable unit tests.
      */
     friend class ::OlsrMprTestCase;
+    friend class ::OlsrRoutingTableTestCase;
 
     static const uint16_t OLSR_PORT_NUMBER; //!< port number (698)
 
@@ -254,6 +257,15 @@ class RoutingProtocol : public Ipv4RoutingProtocol
     OlsrState m_state; //!< Internal state with all needed data structs.
     Ptr<Ipv4> m_ipv4;  //!< IPv4 object the routing is linked to.
 
+    /// Whether the inputs of the last MPR computation are recorded.
+    bool m_mprInputsValid{false};
+    /// Main address of the node at the last MPR computation.
+    Ipv4Address m_mprMainAddress;
+    /// Neighbor set at the last MPR computation.
+    NeighborSet m_mprNeighbors;
+    /// 2-hop neighbor set at the last MPR computation.
+    TwoHopNeighborSet m_mprTwoHopNeighbors;
+
     /**
      * @brief Clears the routing table and frees the memory assigned to each one of its entries.
      */
@@ -381,11 +393,17 @@ class RoutingProtocol : public Ipv4RoutingProtocol
 
     /**
      * @brief Computes MPR set of a node following \RFC{3626} hints.
+     *
+     * The computation is skipped if the neighbor and 2-hop neighbor sets have not changed
+     * since the last one.
      */
     void MprComputation();
 
     /**
      * @brief Creates the routing table of the node following \RFC{3626} hints.
+     *
+     * The routes beyond two hops are found with a breadth-first search over the topology set,
+     * indexed by last hop, in time linear in the size of the set.
      */
     void RoutingTableComputation();
 
@@ -16,11 +16,115 @@
 
 #include "olsr-state.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 namespace olsr
 {
 
+namespace
+{
+
+/**
+ * Finds the position of the first tuple of a set with a given key, which matches a predicate.
+ *
+ * The index of the set is rebuilt first if needed.  If the keys of the set are not distinct,
+ * the set is scanned instead.
+ *
+ * @tparam Set \deduced The set type.
+ * @tparam Index \deduced The index type.
+ * @tparam Key \deduced The key type.
+ * @tparam KeyOf \deduced The type of the function giving the key of a tuple.
+ * @tparam Pred \deduced The predicate type.
+ * @param set The set.
+ * @param index The index of the set.
+ * @param key The key.
+ * @param keyOf The function giving the key of a tuple.
+ * @param pred The predicate.
+ * @returns The position, or the size of the set if no match.
+ */
+template <typename Set, typename Index, typename Key, typename KeyOf, typename Pred>
+std::size_t
+FindPosition(const Set& set, Index& index, const Key& key, KeyOf keyOf, Pred pred)
+{
+    if (!index.valid)
+    {
+        index.positions.clear();
+        index.unique = true;
+        for (std::size_t i = 0; i < set.size(); i++)
+        {
+            if (!index.positions.emplace(keyOf(set[i]), i).second)
+            {
+                index.unique = false;
+            }
+        }
+        index.valid = true;
+    }
+    if (!index.unique)
+    {
+        for (std::size_t i = 0; i < set.size(); i++)
+        {
+            if (keyOf(set[i]) == key && pred(set[i]))
+            {
+                return i;
+            }
+        }
+        return set.size();
+    }
+    auto it = index.positions.find(key);
+    if (it == index.positions.end() || !pred(set[it->second]))
+    {
+        return set.size();
+    }
+    return it->second;
+}
+
+/**
+ * Adds the last tuple of a set to the index of the set.
+ *
+ * @tparam Set \deduced The set type.
+ * @tparam Index \deduced The index type.
+ * @tparam Key \deduced The key type.
+ * @param set The set.
+ * @param index The index of the set.
+ * @param key The key of the last tuple.
+ */
+template <typename Set, typename Index, typename Key>
+void
+IndexLastTuple(const Set& set, Index& index, const Key& key)
+{
+    if (index.valid && !index.positions.emplace(key, set.size() - 1).second)
+    {
+        index.unique = false;
+    }
+}
+
+/**
+ * @param tuple A neighbor tuple.
+ * @returns The key of the tuple.
+ */
+const Ipv4Address&
+GetNeighborKey(const NeighborTuple& tuple)
+{
+    return tuple.neighborMainAddr;
+}
+
+/**
+ * @param tuple An interface association tuple.
+ * @returns The key of the tuple.
+ */
+const Ipv4Address&
+GetIfaceAssocKey(const IfaceAssocTuple& tuple)
+{
+    return tuple.ifaceAddr;
+}
+
+/// Predicate matching any tuple.
+constexpr auto AnyTuple = [](const auto&) { return true; };
+
+} // unnamed namespace
+
 /********** MPR Selector Set Manipulation **********/
 
 MprSelectorTuple*
@@ -95,81 +199,76 @@ OlsrState::PrintMprSelectorSet() const
 NeighborTuple*
 OlsrState::FindNeighborTuple(const Ipv4Address& mainAddr)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
-    {
-        if (it->neighborMainAddr == mainAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    std::size_t i =
+        FindPosition(m_neighborSet, m_neighborIndex, mainAddr, GetNeighborKey, AnyTuple);
+    return i < m_neighborSet.size() ? &m_neighborSet[i] : nullptr;
 }
 
 const NeighborTuple*
 OlsrState::FindSymNeighborTuple(const Ipv4Address& mainAddr) const
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
-    {
-        if (it->neighborMainAddr == mainAddr && it->status == NeighborTuple::STATUS_SYM)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    std::size_t i = FindPosition(m_neighborSet,
+                                 m_neighborIndex,
+                                 mainAddr,
+                                 GetNeighborKey,
+                                 [](const NeighborTuple& tuple) {
+                                     return tuple.status == NeighborTuple::STATUS_SYM;
+                                 });
+    return i < m_neighborSet.size() ? &m_neighborSet[i] : nullptr;
 }
 
 NeighborTuple*
 OlsrState::FindNeighborTuple(const Ipv4Address& mainAddr, Willingness willingness)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
-    {
-        if (it->neighborMainAddr == mainAddr && it->willingness == willingness)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    std::size_t i = FindPosition(m_neighborSet,
+                                 m_neighborIndex,
+                                 mainAddr,
+                                 GetNeighborKey,
+                                 [willingness](const NeighborTuple& tuple) {
+                                     return tuple.willingness == willingness;
+                                 });
+    return i < m_neighborSet.size() ? &m_neighborSet[i] : nullptr;
 }
 
 void
 OlsrState::EraseNeighborTuple(const NeighborTuple& tuple)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    std::size_t i = FindPosition(m_neighborSet,
+                                 m_neighborIndex,
+                                 tuple.neighborMainAddr,
+                                 GetNeighborKey,
+                                 [&tuple](const NeighborTuple& other) { return other == tuple; });
+    if (i < m_neighborSet.size())
     {
-        if (*it == tuple)
-        {
-            m_neighborSet.erase(it);
-            break;
-        }
+        m_neighborSet.erase(m_neighborSet.begin() + i);
+        m_neighborIndex.valid = false;
     }
 }
 
 void
 OlsrState::EraseNeighborTuple(const Ipv4Address& mainAddr)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    std::size_t i =
+        FindPosition(m_neighborSet, m_neighborIndex, mainAddr, GetNeighborKey, AnyTuple);
+    if (i < m_neighborSet.size())
     {
-        if (it->neighborMainAddr == mainAddr)
-        {
-            it = m_neighborSet.erase(it);
-            break;
-        }
+        m_neighborSet.erase(m_neighborSet.begin() + i);
+        m_neighborIndex.valid = false;
     }
 }
 
 void
 OlsrState::InsertNeighborTuple(const NeighborTuple& tuple)
 {
-    for (auto it = m_neighborSet.begin(); it != m_neighborSet.end(); it++)
+    NeighborTuple* existing = FindNeighborTuple(tuple.neighborMainAddr);
+    if (existing != nullptr)
     {
-        if (it->neighborMainAddr == tuple.neighborMainAddr)
-        {
-            // Update it
-            *it = tuple;
-            return;
-        }
+        // Update it
+        *existing = tuple;
+        return;
     }
     m_neighborSet.push_back(tuple);
+    IndexLastTuple(m_neighborSet, m_neighborIndex, tuple.neighborMainAddr);
 }
 
 /********** Neighbor 2 Hop Set Manipulation **********/
@@ -357,14 +456,13 @@ OlsrState::InsertLinkTuple(const LinkTuple& tuple)
 TopologyTuple*
 OlsrState::FindTopologyTuple(const Ipv4Address& destAddr, const Ipv4Address& lastAddr)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end(); it++)
-    {
-        if (it->destAddr == destAddr && it->lastAddr == lastAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    std::size_t i = FindPosition(
+        m_topologySet,
+        m_topologyIndex,
+        GetTopologyKey(destAddr, lastAddr),
+        [](const TopologyTuple& tuple) { return GetTopologyKey(tuple.destAddr, tuple.lastAddr); },
+        AnyTuple);
+    return i < m_topologySet.size() ? &m_topologySet[i] : nullptr;
 }
 
 TopologyTuple*
@@ -383,29 +481,31 @@ OlsrState::FindNewerTopologyTuple(const Ipv4Address& lastAddr, uint16_t ansn)
 void
 OlsrState::EraseTopologyTuple(const TopologyTuple& tuple)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end(); it++)
+    std::size_t i = FindPosition(
+        m_topologySet,
+        m_topologyIndex,
+        GetTopologyKey(tuple.destAddr, tuple.lastAddr),
+        [](const TopologyTuple& other) { return GetTopologyKey(other.destAddr, other.lastAddr); },
+        [&tuple](const TopologyTuple& other) { return other == tuple; });
+    if (i < m_topologySet.size())
     {
-        if (*it == tuple)
-        {
-            m_topologySet.erase(it);
-            break;
-        }
+        m_topologySet.erase(m_topologySet.begin() + i);
+        m_topologyIndex.valid = false;
     }
 }
 
 void
 OlsrState::EraseOlderTopologyTuples(const Ipv4Address& lastAddr, uint16_t ansn)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end();)
+    auto end = std::remove_if(m_topologySet.begin(),
+                              m_topologySet.end(),
+                              [&lastAddr, ansn](const TopologyTuple& tuple) {
+                                  return tuple.lastAddr == lastAddr && tuple.sequenceNumber < ansn;
+                              });
+    if (end != m_topologySet.end())
     {
-        if (it->lastAddr == lastAddr && it->sequenceNumber < ansn)
-        {
-            it = m_topologySet.erase(it);
-        }
-        else
-        {
-            it++;
-        }
+        m_topologySet.erase(end, m_topologySet.end());
+        m_topologyIndex.valid = false;
     }
 }
 
@@ -413,6 +513,7 @@ void
 OlsrState::InsertTopologyTuple(const TopologyTuple& tuple)
 {
     m_topologySet.push_back(tuple);
+    IndexLastTuple(m_topologySet, m_topologyIndex, GetTopologyKey(tuple.destAddr, tuple.lastAddr));
 }
 
 /********** Interface Association Set Manipulation **********/
@@ -420,39 +521,31 @@ OlsrState::InsertTopologyTuple(const TopologyTuple& tuple)
 IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple(const Ipv4Address& ifaceAddr)
 {
-    for (auto it = m_ifaceAssocSet.begin(); it != m_ifaceAssocSet.end(); it++)
-    {
-        if (it->ifaceAddr == ifaceAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    std::size_t i =
+        FindPosition(m_ifaceAssocSet, m_ifaceAssocIndex, ifaceAddr, GetIfaceAssocKey, AnyTuple);
+    return i < m_ifaceAssocSet.size() ? &m_ifaceAssocSet[i] : nullptr;
 }
 
 const IfaceAssocTuple*
 OlsrState::FindIfaceAssocTuple(const Ipv4Address& ifaceAddr) const
 {
-    for (auto it = m_ifaceAssocSet.begin(); it != m_ifaceAssocSet.end(); it++)
-    {
-        if (it->ifaceAddr == ifaceAddr)
-        {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    std::size_t i =
+        FindPosition(m_ifaceAssocSet, m_ifaceAssocIndex, ifaceAddr, GetIfaceAssocKey, AnyTuple);
+    return i < m_ifaceAssocSet.size() ? &m_ifaceAssocSet[i] : nullptr;
 }
 
 void
 OlsrState::EraseIfaceAssocTuple(const IfaceAssocTuple& tuple)
 {
-    for (auto it = m_ifaceAssocSet.begin(); it != m_ifaceAssocSet.end(); it++)
+    std::size_t i = FindPosition(m_ifaceAssocSet,
+                                 m_ifaceAssocIndex,
+                                 tuple.ifaceAddr,
+                                 GetIfaceAssocKey,
+                                 [&tuple](const IfaceAssocTuple& other) { return other == tuple; });
+    if (i < m_ifaceAssocSet.size())
     {
-        if (*it == tuple)
-        {
-            m_ifaceAssocSet.erase(it);
-            break;
-        }
+        m_ifaceAssocSet.erase(m_ifaceAssocSet.begin() + i);
+        m_ifaceAssocIndex.valid = false;
     }
 }
 
@@ -460,6 +553,7 @@ void
 OlsrState::InsertIfaceAssocTuple(const IfaceAssocTuple& tuple)
 {
     m_ifaceAssocSet.push_back(tuple);
+    IndexLastTuple(m_ifaceAssocSet, m_ifaceAssocIndex, tuple.ifaceAddr);
 }
 
 std::vector<Ipv4Address>
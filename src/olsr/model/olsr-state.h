@@ -13,6 +13,8 @@
 
 #include "olsr-repositories.h"
 
+#include <unordered_map>
+
 namespace ns3
 {
 namespace olsr
@@ -21,6 +23,12 @@ namespace olsr
 /// @ingroup olsr
 /// This class encapsulates all data structures needed for maintaining internal state of an OLSR
 /// node.
+///
+/// The neighbor, topology and interface association sets are indexed by their keys, so that
+/// the corresponding Find functions do not scan the sets.  The indices are updated when a tuple
+/// is inserted, and rebuilt on the next lookup after a tuple is erased or after a set is
+/// accessed through a non-const reference.  The key fields of the tuples returned by the Find
+/// functions must not be changed.
 class OlsrState
 {
     //  friend class Olsr;
@@ -103,6 +111,7 @@ class OlsrState
      */
     NeighborSet& GetNeighbors()
     {
+        m_neighborIndex.valid = false;
         return m_neighborSet;
     }
 
@@ -333,6 +342,7 @@ class OlsrState
      */
     IfaceAssocSet& GetIfaceAssocSetMutable()
     {
+        m_ifaceAssocIndex.valid = false;
         return m_ifaceAssocSet;
     }
 
@@ -416,6 +426,38 @@ class OlsrState
      * @returns A container of the neighbor addresses (excluding the main one).
      */
     std::vector<Ipv4Address> FindNeighborInterfaces(const Ipv4Address& neighborMainAddr) const;
+
+  private:
+    /**
+     * Position of the tuples of a set, by key.
+     * @tparam Key The key type.
+     * @tparam Hash The key hash function.
+     */
+    template <typename Key, typename Hash = std::hash<Key>>
+    struct SetIndex
+    {
+        std::unordered_map<Key, uint32_t, Hash> positions; //!< Position of the tuple of each key.
+        bool valid{false};                                 //!< Whether the positions match the set.
+        bool unique{true};                                 //!< Whether the keys are distinct.
+    };
+
+    /**
+     * Gets the key of a topology tuple.
+     * @param destAddr The destination address.
+     * @param lastAddr The address of the node previous to the destination.
+     * @returns The key.
+     */
+    static uint64_t GetTopologyKey(const Ipv4Address& destAddr, const Ipv4Address& lastAddr)
+    {
+        return (static_cast<uint64_t>(destAddr.Get()) << 32) | lastAddr.Get();
+    }
+
+    /// Index of the neighbor set, by neighbor main address.
+    mutable SetIndex<Ipv4Address, Ipv4AddressHash> m_neighborIndex;
+    /// Index of the topology set, by destination and last addresses.
+    mutable SetIndex<uint64_t> m_topologyIndex;
+    /// Index of the interface association set, by interface address.
+    mutable SetIndex<Ipv4Address, Ipv4AddressHash> m_ifaceAssocIndex;
 };
 
 } // namespace olsr
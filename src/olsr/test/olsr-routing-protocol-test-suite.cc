@@ -8,9 +8,12 @@
  *          Gustavo J. A. M. Carneiro <gjc@inescporto.pt>
  */
 
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-header.h"
 #include "ns3/olsr-repositories.h"
 #include "ns3/olsr-routing-protocol.h"
+#include "ns3/simple-net-device-helper.h"
 #include "ns3/test.h"
 
 /**
@@ -163,6 +166,150 @@ OlsrMprTestCase::DoRun()
                           "Node 1 must NOT select node 8 as MPR");
 }
 
+/**
+ * @ingroup olsr-test
+ * @ingroup tests
+ *
+ * Testcase for the routing table computation, after changes of the link,
+ * neighbor and topology sets
+ */
+class OlsrRoutingTableTestCase : public TestCase
+{
+  public:
+    OlsrRoutingTableTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Check the route to a destination
+     * @param protocol the routing protocol
+     * @param dest the destination
+     * @param next the expected next hop, or the any address if there should be no route
+     * @param distance the expected distance
+     */
+    void CheckRoute(Ptr<RoutingProtocol> protocol,
+                    const char* dest,
+                    const char* next,
+                    uint32_t distance);
+};
+
+OlsrRoutingTableTestCase::OlsrRoutingTableTestCase()
+    : TestCase("Check OLSR routing table computation after link state changes")
+{
+}
+
+void
+OlsrRoutingTableTestCase::CheckRoute(Ptr<RoutingProtocol> protocol,
+                                     const char* dest,
+                                     const char* next,
+                                     uint32_t distance)
+{
+    RoutingTableEntry entry;
+    bool found = protocol->Lookup(Ipv4Address(dest), entry);
+    if (Ipv4Address(next) == Ipv4Address::GetAny())
+    {
+        NS_TEST_EXPECT_MSG_EQ(found, false, "There should be no route to " << dest);
+        return;
+    }
+    NS_TEST_ASSERT_MSG_EQ(found, true, "There should be a route to " << dest);
+    NS_TEST_EXPECT_MSG_EQ(entry.nextAddr, Ipv4Address(next), "Wrong next hop to " << dest);
+    NS_TEST_EXPECT_MSG_EQ(entry.distance, distance, "Wrong distance to " << dest);
+}
+
+void
+OlsrRoutingTableTestCase::DoRun()
+{
+    // a node with a single interface, to resolve the interface of the routes
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer devices = simple.Install(node);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.0");
+    address.Assign(devices);
+
+    Ptr<RoutingProtocol> protocol = CreateObject<RoutingProtocol>();
+    protocol->SetIpv4(node->GetObject<Ipv4>());
+    protocol->m_mainAddress = Ipv4Address("10.0.0.1");
+    OlsrState& state = protocol->m_state;
+
+    /*
+     *  1 -- 2
+     *  |    |
+     *  3 -- 4 -- 5 -- 6
+     */
+    LinkTuple link;
+    link.localIfaceAddr = Ipv4Address("10.0.0.1");
+    link.symTime = Seconds(3600);
+    link.time = Seconds(3600);
+    NeighborTuple neighbor;
+    neighbor.status = NeighborTuple::STATUS_SYM;
+    neighbor.willingness = Willingness::DEFAULT;
+    TwoHopNeighborTuple twoHop;
+    twoHop.twoHopNeighborAddr = Ipv4Address("10.0.0.4");
+    twoHop.expirationTime = Seconds(3600);
+    // of the two-hop tuples to node 4, the last one inserted sets the route
+    for (const char* addr : {"10.0.0.3", "10.0.0.2"})
+    {
+        link.neighborIfaceAddr = Ipv4Address(addr);
+        state.InsertLinkTuple(link);
+        neighbor.neighborMainAddr = Ipv4Address(addr);
+        state.InsertNeighborTuple(neighbor);
+        twoHop.neighborMainAddr = Ipv4Address(addr);
+        state.InsertTwoHopNeighborTuple(twoHop);
+    }
+    TopologyTuple topology;
+    topology.expirationTime = Seconds(3600);
+    topology.sequenceNumber = 1;
+    topology.lastAddr = Ipv4Address("10.0.0.4");
+    topology.destAddr = Ipv4Address("10.0.0.5");
+    state.InsertTopologyTuple(topology);
+    TopologyTuple farTopology = topology;
+    farTopology.lastAddr = Ipv4Address("10.0.0.5");
+    farTopology.destAddr = Ipv4Address("10.0.0.6");
+    state.InsertTopologyTuple(farTopology);
+
+    protocol->RoutingTableComputation();
+    CheckRoute(protocol, "10.0.0.2", "10.0.0.2", 1);
+    CheckRoute(protocol, "10.0.0.3", "10.0.0.3", 1);
+    CheckRoute(protocol, "10.0.0.4", "10.0.0.2", 2);
+    CheckRoute(protocol, "10.0.0.5", "10.0.0.2", 3);
+    CheckRoute(protocol, "10.0.0.6", "10.0.0.2", 4);
+
+    // the link to node 2 is lost: all the routes go through node 3
+    link.neighborIfaceAddr = Ipv4Address("10.0.0.2");
+    state.EraseLinkTuple(link);
+    state.EraseNeighborTuple(Ipv4Address("10.0.0.2"));
+    state.EraseTwoHopNeighborTuples(Ipv4Address("10.0.0.2"));
+
+    protocol->RoutingTableComputation();
+    CheckRoute(protocol, "10.0.0.2", "0.0.0.0", 0);
+    CheckRoute(protocol, "10.0.0.3", "10.0.0.3", 1);
+    CheckRoute(protocol, "10.0.0.4", "10.0.0.3", 2);
+    CheckRoute(protocol, "10.0.0.5", "10.0.0.3", 3);
+    CheckRoute(protocol, "10.0.0.6", "10.0.0.3", 4);
+
+    // node 6 moves from node 5 to node 4
+    state.EraseTopologyTuple(farTopology);
+    farTopology.lastAddr = Ipv4Address("10.0.0.4");
+    state.InsertTopologyTuple(farTopology);
+
+    protocol->RoutingTableComputation();
+    CheckRoute(protocol, "10.0.0.5", "10.0.0.3", 3);
+    CheckRoute(protocol, "10.0.0.6", "10.0.0.3", 3);
+
+    // node 5 leaves
+    state.EraseTopologyTuple(topology);
+
+    protocol->RoutingTableComputation();
+    CheckRoute(protocol, "10.0.0.5", "0.0.0.0", 0);
+    CheckRoute(protocol, "10.0.0.6", "10.0.0.3", 3);
+
+    protocol->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup olsr-test
  * @ingroup tests
@@ -179,6 +326,7 @@ OlsrProtocolTestSuite::OlsrProtocolTestSuite()
     : TestSuite("routing-olsr", Type::UNIT)
 {
     AddTestCase(new OlsrMprTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new OlsrRoutingTableTestCase(), TestCase::Duration::QUICK);
 }
 
 static OlsrProtocolTestSuite g_olsrProtocolTestSuite; //!< Static variable for test initialization
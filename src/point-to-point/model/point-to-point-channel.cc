@@ -96,6 +96,37 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
     return true;
 }
 
+bool
+PointToPointChannel::TransmitBatch(const PointToPointNetDevice::PacketBatch& batch,
+                                   Ptr<PointToPointNetDevice> src)
+{
+    NS_LOG_FUNCTION(this << batch.size() << src);
+    NS_ASSERT(!batch.empty());
+
+    NS_ASSERT(m_link[0].m_state != INITIALIZING);
+    NS_ASSERT(m_link[1].m_state != INITIALIZING);
+
+    uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+
+    PointToPointNetDevice::PacketBatch rxBatch;
+    rxBatch.reserve(batch.size());
+    for (const auto& [p, txEnd] : batch)
+    {
+        NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
+        rxBatch.emplace_back(p->Copy(), Simulator::Now() + txEnd + m_delay);
+
+        // Call the tx anim callback on the net device
+        m_txrxPointToPoint(p, src, m_link[wire].m_dst, txEnd, txEnd + m_delay);
+    }
+
+    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
+                                   batch.back().second + m_delay,
+                                   &PointToPointNetDevice::ReceiveBatch,
+                                   m_link[wire].m_dst,
+                                   std::move(rxBatch));
+    return true;
+}
+
 std::size_t
 PointToPointChannel::GetNDevices() const
 {
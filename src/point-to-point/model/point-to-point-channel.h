@@ -7,6 +7,8 @@
 #ifndef POINT_TO_POINT_CHANNEL_H
 #define POINT_TO_POINT_CHANNEL_H
 
+#include "point-to-point-net-device.h"
+
 #include "ns3/channel.h"
 #include "ns3/data-rate.h"
 #include "ns3/nstime.h"
@@ -18,7 +20,6 @@
 namespace ns3
 {
 
-class PointToPointNetDevice;
 class Packet;
 
 /**
@@ -70,6 +71,21 @@ class PointToPointChannel : public Channel
      */
     virtual bool TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
 
+    /**
+     * @brief Transmit a batch of packets sent back to back over this channel
+     *
+     * The batch is delivered to the peer device by a single event, when the
+     * last bit of its last packet arrives, with the arrival time of each
+     * packet.
+     *
+     * @param batch Packets to transmit, with the time at which their last bit
+     * is transmitted, relative to now
+     * @param src Source PointToPointNetDevice
+     * @returns true if successful (currently always true)
+     */
+    virtual bool TransmitBatch(const PointToPointNetDevice::PacketBatch& batch,
+                               Ptr<PointToPointNetDevice> src);
+
     /**
      * @brief Get number of devices on this channel
      * @returns number of devices on this channel
@@ -60,6 +60,20 @@ PointToPointNetDevice::GetTypeId()
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("BackgroundDataRate",
+                          "The share of the data rate used by the traffic which is not "
+                          "simulated by packets (see FluidBackgroundTraffic). The packets are "
+                          "transmitted at the remaining data rate.",
+                          DataRateValue(DataRate(0)),
+                          MakeDataRateAccessor(&PointToPointNetDevice::m_backgroundBps),
+                          MakeDataRateChecker())
+            .AddAttribute("CoalescingWindow",
+                          "The maximum time over which the packets waiting in the queue are "
+                          "sent back to back as a single batch, delivered by a single event. "
+                          "Zero to send the packets one by one.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&PointToPointNetDevice::m_coalescingWindow),
+                          MakeTimeChecker(Seconds(0)))
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -204,6 +218,7 @@ PointToPointNetDevice::DoDispose()
     m_channel = nullptr;
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
+    m_currentBatch.clear();
     m_queue = nullptr;
     NetDevice::DoDispose();
 }
@@ -215,6 +230,13 @@ PointToPointNetDevice::SetDataRate(DataRate bps)
     m_bps = bps;
 }
 
+DataRate
+PointToPointNetDevice::GetTxDataRate() const
+{
+    NS_ASSERT_MSG(m_backgroundBps < m_bps, "The background traffic takes the whole data rate");
+    return m_bps - m_backgroundBps;
+}
+
 void
 PointToPointNetDevice::SetInterframeGap(Time t)
 {
@@ -233,12 +255,17 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     // We need to tell the channel that we've started wiggling the wire and
     // schedule an event that will be executed when the transmission is complete.
     //
+    if (m_coalescingWindow.IsStrictlyPositive())
+    {
+        return TransmitBatchStart(p);
+    }
+
     NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
     m_txMachineState = BUSY;
     m_currentPkt = p;
     m_phyTxBeginTrace(m_currentPkt);
 
-    Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    Time txTime = GetTxDataRate().CalculateBytesTxTime(p->GetSize());
     Time txCompleteTime = txTime + m_tInterframeGap;
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
@@ -266,10 +293,22 @@ PointToPointNetDevice::TransmitComplete()
     NS_ASSERT_MSG(m_txMachineState == BUSY, "Must be BUSY if transmitting");
     m_txMachineState = READY;
 
-    NS_ASSERT_MSG(m_currentPkt, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
+    if (!m_currentBatch.empty())
+    {
+        for (const auto& packet : m_currentBatch)
+        {
+            m_phyTxEndTrace(packet);
+        }
+        m_currentBatch.clear();
+    }
+    else
+    {
+        NS_ASSERT_MSG(m_currentPkt,
+                      "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
-    m_phyTxEndTrace(m_currentPkt);
-    m_currentPkt = nullptr;
+        m_phyTxEndTrace(m_currentPkt);
+        m_currentPkt = nullptr;
+    }
 
     Ptr<Packet> p = m_queue->Dequeue();
     if (!p)
@@ -286,6 +325,63 @@ PointToPointNetDevice::TransmitComplete()
     TransmitStart(p);
 }
 
+bool
+PointToPointNetDevice::TransmitBatchStart(Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+    NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
+
+    NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
+    m_txMachineState = BUSY;
+
+    //
+    // The first packet is always sent.  The packets waiting in the queue follow
+    // it back to back, as long as their last bit is transmitted within the
+    // coalescing window.
+    //
+    DataRate bps = GetTxDataRate();
+    Time end = bps.CalculateBytesTxTime(p->GetSize());
+    PacketBatch batch;
+    batch.emplace_back(p, end);
+
+    Ptr<const Packet> next;
+    while ((next = m_queue->Peek()))
+    {
+        Time nextEnd = end + m_tInterframeGap + bps.CalculateBytesTxTime(next->GetSize());
+        if (nextEnd > m_coalescingWindow)
+        {
+            break;
+        }
+        Ptr<Packet> packet = m_queue->Dequeue();
+        m_snifferTrace(packet);
+        m_promiscSnifferTrace(packet);
+        batch.emplace_back(packet, nextEnd);
+        end = nextEnd;
+    }
+
+    for (const auto& [packet, txEnd] : batch)
+    {
+        m_phyTxBeginTrace(packet);
+        m_currentBatch.push_back(packet);
+    }
+
+    Time txCompleteTime = end + m_tInterframeGap;
+
+    NS_LOG_LOGIC("Schedule TransmitCompleteEvent of " << batch.size() << " packets in "
+                                                      << txCompleteTime.As(Time::S));
+    Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+
+    bool result = m_channel->TransmitBatch(batch, this);
+    if (!result)
+    {
+        for (const auto& [packet, txEnd] : batch)
+        {
+            m_phyTxDropTrace(packet);
+        }
+    }
+    return result;
+}
+
 bool
 PointToPointNetDevice::Attach(Ptr<PointToPointChannel> ch)
 {
@@ -373,6 +469,24 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
     }
 }
 
+void
+PointToPointNetDevice::ReceiveBatch(PacketBatch batch)
+{
+    NS_LOG_FUNCTION(this << batch.size());
+    for (const auto& [packet, rxTime] : batch)
+    {
+        m_rxTimestamp = rxTime;
+        Receive(packet);
+    }
+    m_rxTimestamp.reset();
+}
+
+Time
+PointToPointNetDevice::GetRxTimestamp() const
+{
+    return m_rxTimestamp.value_or(Simulator::Now());
+}
+
 Ptr<Queue<Packet>>
 PointToPointNetDevice::GetQueue() const
 {
@@ -20,6 +20,9 @@
 #include "ns3/traced-callback.h"
 
 #include <cstring>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -48,6 +51,16 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device
  * include a queue, data rate, and interframe transmission gap (the
  * propagation delay is set in the PointToPointChannel).
+ *
+ * If the CoalescingWindow attribute is set, the packets waiting in the
+ * queue when a transmission starts are sent back to back as a single batch,
+ * as long as the last bit of the last one is transmitted within the window.
+ * The batch is delivered to the peer device by a single event, at the time
+ * the last bit of its last packet arrives, instead of one event per packet
+ * at each end of the link.  The receivers which need the precise arrival
+ * time of a packet can get it from GetRxTimestamp().  The PhyTxBegin and
+ * PhyTxEnd traces are fired for all the packets of a batch at its start and
+ * its end, respectively.
  */
 class PointToPointNetDevice : public NetDevice
 {
@@ -143,6 +156,35 @@ class PointToPointNetDevice : public NetDevice
      */
     void Receive(Ptr<Packet> p);
 
+    /**
+     * Packets sent back to back, in order, each with a time.  When handed to
+     * the channel, it is the time at which the last bit of the packet is
+     * transmitted, relative to the start of the batch.  When delivered to the
+     * peer device, it is the time at which the last bit of the packet arrived.
+     */
+    typedef std::vector<std::pair<Ptr<Packet>, Time>> PacketBatch;
+
+    /**
+     * Receive a batch of packets from a connected PointToPointChannel.
+     *
+     * The packets are received in order, as if by Receive(), once the last
+     * bit of the last one has arrived.
+     *
+     * @param batch the packets received, with the time their last bit arrived
+     */
+    void ReceiveBatch(PacketBatch batch);
+
+    /**
+     * Get the time at which the last bit of the packet being received arrived.
+     *
+     * When called while a packet received as part of a batch is forwarded up
+     * the protocol stack, this is the time the packet would have been
+     * received at without coalescing.  Otherwise, this is the current time.
+     *
+     * @returns the arrival time of the packet being received
+     */
+    Time GetRxTimestamp() const;
+
     // The remaining methods are documented in ns3::NetDevice*
 
     void SetIfIndex(const uint32_t index) override;
@@ -250,6 +292,22 @@ class PointToPointNetDevice : public NetDevice
      */
     void TransmitComplete();
 
+    /**
+     * Start sending a batch of packets down the wire, beginning with the
+     * given packet and followed by the packets of the queue which can be
+     * sent within the coalescing window.
+     *
+     * @see PointToPointChannel::TransmitBatch ()
+     * @param p a reference to the first packet to send
+     * @returns true if success, false on failure
+     */
+    bool TransmitBatchStart(Ptr<Packet> p);
+
+    /**
+     * @returns the data rate left to the packets by the background traffic
+     */
+    DataRate GetTxDataRate() const;
+
     /**
      * @brief Make the link up and running
      *
@@ -277,12 +335,24 @@ class PointToPointNetDevice : public NetDevice
      */
     DataRate m_bps;
 
+    /**
+     * The share of the data rate used by the traffic which is not simulated
+     * by packets.
+     */
+    DataRate m_backgroundBps;
+
     /**
      * The interframe gap that the Net Device uses to throttle packet
      * transmission
      */
     Time m_tInterframeGap;
 
+    /**
+     * The maximum time over which the packets waiting in the queue are sent
+     * as a single batch, or zero to send the packets one by one
+     */
+    Time m_coalescingWindow;
+
     /**
      * The PointToPointChannel to which this PointToPointNetDevice has been
      * attached.
@@ -431,7 +501,9 @@ class PointToPointNetDevice : public NetDevice
      */
     uint32_t m_mtu;
 
-    Ptr<Packet> m_currentPkt; //!< Current packet processed
+    Ptr<Packet> m_currentPkt;               //!< Current packet processed
+    std::vector<Ptr<Packet>> m_currentBatch; //!< Current batch of packets processed
+    std::optional<Time> m_rxTimestamp;       //!< Arrival time of the batched packet received
 
     /**
      * @brief PPP to Ethernet protocol number mapping
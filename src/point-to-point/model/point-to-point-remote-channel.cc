@@ -62,4 +62,26 @@ PointToPointRemoteChannel::TransmitStart(Ptr<const Packet> p,
     return true;
 }
 
+bool
+PointToPointRemoteChannel::TransmitBatch(const PointToPointNetDevice::PacketBatch& batch,
+                                         Ptr<PointToPointNetDevice> src)
+{
+    NS_LOG_FUNCTION(this << batch.size() << src);
+
+    IsInitialized();
+
+    uint32_t wire = src == GetSource(0) ? 0 : 1;
+    Ptr<PointToPointNetDevice> dst = GetDestination(wire);
+
+    for (const auto& [p, txEnd] : batch)
+    {
+        NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
+
+        // Calculate the rxTime (absolute)
+        Time rxTime = Simulator::Now() + txEnd + GetDelay();
+        MpiInterface::SendPacket(p->Copy(), rxTime, dst->GetNode()->GetId(), dst->GetIfIndex());
+    }
+    return true;
+}
+
 } // namespace ns3
@@ -56,6 +56,20 @@ class PointToPointRemoteChannel : public PointToPointChannel
      * @returns true if successful (currently always true)
      */
     bool TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime) override;
+
+    /**
+     * @brief Transmit a batch of packets
+     *
+     * The packets are sent to the remote system one by one, each with its own
+     * arrival time.
+     *
+     * @param batch Packets to transmit, with the time at which their last bit
+     * is transmitted, relative to now
+     * @param src Source PointToPointNetDevice
+     * @returns true if successful (currently always true)
+     */
+    bool TransmitBatch(const PointToPointNetDevice::PacketBatch& batch,
+                       Ptr<PointToPointNetDevice> src) override;
 };
 
 } // namespace ns3
@@ -14,6 +14,7 @@
 #include "ns3/test.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +129,130 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test class for the coalesced link mode of the PointToPoint model
+ *
+ * It sends a burst of packets from one NetDevice to another, one by one and
+ * in batches, and checks that the packets arrive at the same times with
+ * fewer events.
+ */
+class PointToPointCoalescingTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointCoalescingTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Send a burst of packets over a link
+     *
+     * @param coalescingWindow The coalescing window of the devices.
+     * @param [out] events The number of events executed.
+     * @return The arrival time of each packet.
+     */
+    std::vector<Time> SendBurst(Time coalescingWindow, uint64_t& events);
+
+    /**
+     * @brief Callback function which records the arrival time of a packet
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    std::vector<Time> m_rxTimes; //!< Arrival times of the received packets
+};
+
+PointToPointCoalescingTest::PointToPointCoalescingTest()
+    : TestCase("PointToPoint coalesced link mode")
+{
+}
+
+bool
+PointToPointCoalescingTest::RxPacket(Ptr<NetDevice> dev,
+                                     Ptr<const Packet> pkt,
+                                     uint16_t mode,
+                                     const Address& sender)
+{
+    m_rxTimes.push_back(DynamicCast<PointToPointNetDevice>(dev)->GetRxTimestamp());
+    return true;
+}
+
+std::vector<Time>
+PointToPointCoalescingTest::SendBurst(Time coalescingWindow, uint64_t& events)
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(2)));
+
+    for (const auto& dev : {devA, devB})
+    {
+        dev->SetAttribute("DataRate", DataRateValue(DataRate("8Mb/s")));
+        dev->SetAttribute("InterframeGap", TimeValue(MicroSeconds(10)));
+        dev->SetAttribute("CoalescingWindow", TimeValue(coalescingWindow));
+        dev->Attach(channel);
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    }
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointCoalescingTest::RxPacket, this));
+
+    // The first packet is sent alone, the following ones wait in the queue
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(Seconds(1), [devA, i]() {
+            devA->Send(Create<Packet>(500 + 100 * i), devA->GetBroadcast(), 0x800);
+        });
+    }
+
+    m_rxTimes.clear();
+    Simulator::Run();
+    events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return m_rxTimes;
+}
+
+void
+PointToPointCoalescingTest::DoRun()
+{
+    uint64_t events;
+    std::vector<Time> expected = SendBurst(Seconds(0), events);
+    NS_TEST_ASSERT_MSG_EQ(expected.size(), 10, "Not all the packets were received");
+
+    uint64_t coalescedEvents;
+    std::vector<Time> rxTimes = SendBurst(MilliSeconds(5), coalescedEvents);
+    NS_TEST_ASSERT_MSG_EQ(rxTimes.size(), expected.size(), "Not all the packets were received");
+    for (std::size_t i = 0; i < rxTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rxTimes[i], expected[i], "Wrong arrival time of packet " << i);
+    }
+    NS_TEST_EXPECT_MSG_LT(coalescedEvents, events, "Coalescing did not save any event");
+
+    // A window shorter than a packet does not coalesce anything
+    rxTimes = SendBurst(MicroSeconds(1), coalescedEvents);
+    NS_TEST_ASSERT_MSG_EQ(rxTimes.size(), expected.size(), "Not all the packets were received");
+    for (std::size_t i = 0; i < rxTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rxTimes[i], expected[i], "Wrong arrival time of packet " << i);
+    }
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +269,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointCoalescingTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
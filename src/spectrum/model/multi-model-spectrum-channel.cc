@@ -164,12 +164,16 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
                 auto ret2 = txInfoIterator->second.m_spectrumConverterMap.insert(
                     std::make_pair(rxSpectrumModelUid, converter));
                 NS_ASSERT(ret2.second);
+
+                // the last converted PSD lacks the conversion to the new RX SpectrumModel
+                txInfoIterator->second.m_lastTxPsd = nullptr;
+                txInfoIterator->second.m_lastConvertedPsds.reset();
             }
         }
     }
 }
 
-TxSpectrumModelInfoMap_t::const_iterator
+TxSpectrumModelInfoMap_t::iterator
 MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel(
     Ptr<const SpectrumModel> txSpectrumModel)
 {
@@ -232,13 +236,33 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     const auto txInfoIterator =
         FindAndEventuallyAddTxSpectrumModel(txParams->psd->GetSpectrumModel());
     NS_ASSERT(txInfoIterator != m_txSpectrumModelInfoMap.cend());
+    auto& txInfo = txInfoIterator->second;
 
     NS_LOG_LOGIC("converter map for TX SpectrumModel with Uid " << txInfoIterator->first);
-    NS_LOG_LOGIC("converter map size: " << txInfoIterator->second.m_spectrumConverterMap.size());
-    NS_LOG_LOGIC("converter map first element: "
-                 << txInfoIterator->second.m_spectrumConverterMap.begin()->first);
+    NS_LOG_LOGIC("converter map size: " << txInfo.m_spectrumConverterMap.size());
+
+    // The PSDs converted for the previous transmission are reused if the TX PSD
+    // has the same values. The TX PSD itself may be modified after the
+    // transmission, hence it is compared with a copy of the previous one.
+    if (!txInfo.m_lastConvertedPsds || *txInfo.m_lastTxPsd != *txParams->psd)
+    {
+        auto convertedPsds = std::make_shared<ConvertedPsdMap_t>();
+        for (const auto& [rxSpectrumModelUid, converter] : txInfo.m_spectrumConverterMap)
+        {
+            NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
+                         << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
+            convertedPsds->emplace(rxSpectrumModelUid, converter.Convert(txParams->psd));
+        }
+        txInfo.m_lastTxPsd = txParams->psd->Copy();
+        txInfo.m_lastConvertedPsds = convertedPsds;
+    }
+    else
+    {
+        NS_LOG_LOGIC("reusing the PSDs converted for the previous transmission");
+    }
+    const auto& convertedPsds = txInfo.m_lastConvertedPsds;
+    auto txNetDevice = txParams->txPhy->GetDevice();
 
-    std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> convertedPsds{};
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -246,39 +270,21 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         const auto rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
-        Ptr<SpectrumValue> convertedTxPowerSpectrum;
+        Ptr<const SpectrumValue> rxPsd;
         if (txSpectrumModelUid == rxSpectrumModelUid)
         {
             NS_LOG_LOGIC("no spectrum conversion needed");
-            convertedTxPowerSpectrum = txParams->psd;
+            rxPsd = txParams->psd;
         }
         else
         {
-            NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
-                         << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-            auto rxConverterIterator =
-                txInfoIterator->second.m_spectrumConverterMap.find(rxSpectrumModelUid);
-            if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end())
+            auto convertedPsdIterator = convertedPsds->find(rxSpectrumModelUid);
+            if (convertedPsdIterator == convertedPsds->end())
             {
                 // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
                 continue;
             }
-            convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
-        }
-        convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
-    }
-
-    for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
-         rxInfoIterator != m_rxSpectrumModelInfoMap.end();
-         ++rxInfoIterator)
-    {
-        const auto rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
-
-        if ((txSpectrumModelUid != rxSpectrumModelUid) &&
-            !txInfoIterator->second.m_spectrumConverterMap.contains(rxSpectrumModelUid))
-        {
-            // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
-            continue;
+            rxPsd = convertedPsdIterator->second;
         }
 
         for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
@@ -293,7 +299,6 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             if ((*rxPhyIterator) != txParams->txPhy)
             {
                 auto rxNetDevice = (*rxPhyIterator)->GetDevice();
-                auto txNetDevice = txParams->txPhy->GetDevice();
 
                 if (rxNetDevice && txNetDevice)
                 {
@@ -314,7 +319,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
                 NS_LOG_LOGIC("copying signal parameters " << txParams);
                 auto rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedPsds.at(rxSpectrumModelUid));
+                rxParams->psd = rxPsd->Copy();
                 Time delay{0};
 
                 auto receiverMobility = (*rxPhyIterator)->GetMobility();
@@ -366,12 +371,11 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 }
 
 void
-MultiModelSpectrumChannel::StartRx(
-    Ptr<SpectrumValue> txPsd,
-    double txAntennaGain,
-    Ptr<SpectrumSignalParameters> params,
-    Ptr<SpectrumPhy> receiver,
-    const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds)
+MultiModelSpectrumChannel::StartRx(Ptr<SpectrumValue> txPsd,
+                                   double txAntennaGain,
+                                   Ptr<SpectrumSignalParameters> params,
+                                   Ptr<SpectrumPhy> receiver,
+                                   std::shared_ptr<const ConvertedPsdMap_t> availableConvertedPsds)
 {
     NS_LOG_FUNCTION(this);
 
@@ -384,11 +388,18 @@ MultiModelSpectrumChannel::StartRx(
     {
         NS_LOG_LOGIC("SpectrumModelUid changed since TX started");
 
-        const auto itConvertedPsd = availableConvertedPsds.find(phySpectrumModelUid);
-        if (itConvertedPsd != availableConvertedPsds.cend())
+        // the available converted PSDs and the TX PSD are shared, hence they are copied
+        // before the propagation loss is applied
+        const auto itConvertedPsd = availableConvertedPsds->find(phySpectrumModelUid);
+        if (phySpectrumModelUid == txPsd->GetSpectrumModelUid())
+        {
+            NS_LOG_LOGIC("no spectrum conversion needed");
+            params->psd = txPsd->Copy();
+        }
+        else if (itConvertedPsd != availableConvertedPsds->cend())
         {
             NS_LOG_LOGIC("converted PSD already exists for " << phySpectrumModelUid);
-            params->psd = itConvertedPsd->second;
+            params->psd = itConvertedPsd->second->Copy();
         }
         else
         {
@@ -404,7 +415,7 @@ MultiModelSpectrumChannel::StartRx(
             if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.cend())
             {
                 // No converter means TX SpectrumModel is orthogonal to current PHY SpectrumModel
-                params->psd = txPsd;
+                params->psd = txPsd->Copy();
             }
             else
             {
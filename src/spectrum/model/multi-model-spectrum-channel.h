@@ -17,6 +17,7 @@
 #include "ns3/propagation-delay-model.h"
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace ns3
@@ -28,6 +29,12 @@ namespace ns3
  */
 typedef std::map<SpectrumModelUid_t, SpectrumConverter> SpectrumConverterMap_t;
 
+/**
+ * @ingroup spectrum
+ * Container: SpectrumModelUid_t, PSD converted to the SpectrumModel
+ */
+typedef std::map<SpectrumModelUid_t, Ptr<SpectrumValue>> ConvertedPsdMap_t;
+
 /**
  * @ingroup spectrum
  * The Tx spectrum model information. This class is used to convert
@@ -44,6 +51,10 @@ class TxSpectrumModelInfo
 
     Ptr<const SpectrumModel> m_txSpectrumModel;    //!< Tx Spectrum model.
     SpectrumConverterMap_t m_spectrumConverterMap; //!< Spectrum converter.
+    Ptr<const SpectrumValue> m_lastTxPsd;          //!< Copy of the last converted Tx PSD.
+    /// Conversions of the last converted Tx PSD to the Rx Spectrum models, shared by the
+    /// receptions of all the transmissions of the same PSD.
+    std::shared_ptr<const ConvertedPsdMap_t> m_lastConvertedPsds;
 };
 
 /**
@@ -88,6 +99,11 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * The conversions of the last PSD transmitted with each TX SpectrumModel
+ * are kept, and reused as long as the following transmissions with this
+ * SpectrumModel have a PSD with the same values, as it is the case for
+ * the devices transmitting at a fixed power, e.g., beacons.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -123,7 +139,7 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      *
      * @return An iterator pointing to the corresponding entry in m_txSpectrumModelInfoMap
      */
-    TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel(
+    TxSpectrumModelInfoMap_t::iterator FindAndEventuallyAddTxSpectrumModel(
         Ptr<const SpectrumModel> txSpectrumModel);
 
     /**
@@ -133,14 +149,14 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * @param txAntennaGain The antenna gain at the transmitter.
      * @param params The signal parameters.
      * @param receiver A pointer to the receiver SpectrumPhy.
-     * @param availableConvertedPsds available converted PSDs from the TX PSD.
+     * @param availableConvertedPsds available converted PSDs from the TX PSD, which are
+     *        shared by all the receivers and must not be modified.
      */
-    virtual void StartRx(
-        Ptr<SpectrumValue> txPsd,
-        double txAntennaGain,
-        Ptr<SpectrumSignalParameters> params,
-        Ptr<SpectrumPhy> receiver,
-        const std::map<SpectrumModelUid_t, Ptr<SpectrumValue>>& availableConvertedPsds);
+    virtual void StartRx(Ptr<SpectrumValue> txPsd,
+                         double txAntennaGain,
+                         Ptr<SpectrumSignalParameters> params,
+                         Ptr<SpectrumPhy> receiver,
+                         std::shared_ptr<const ConvertedPsdMap_t> availableConvertedPsds);
 
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
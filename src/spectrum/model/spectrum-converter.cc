@@ -69,19 +69,23 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
 
     Ptr<SpectrumValue> tvvf = Create<SpectrumValue>(m_toSpectrumModel);
 
-    auto tvit = tvvf->ValuesBegin();
-    size_t i = 0; // Index of conversion coefficient
+    // the values and the coefficients are accessed through raw pointers, without
+    // bounds checks, so that the inner loop is a plain sparse dot product
+    const double* fromValues = fvvf->GetValues().data();
+    const double* coefficients = m_conversionMatrix.data();
+    const size_t* colInd = m_conversionColInd.data();
+    double* toValues = tvvf->GetValues().data();
 
-    for (auto convIt = m_conversionRowPtr.begin(); convIt != m_conversionRowPtr.end(); ++convIt)
+    size_t i = 0; // Index of conversion coefficient
+    for (size_t row = 0; row < m_conversionRowPtr.size(); ++row)
     {
+        const size_t rowEnd = m_conversionRowPtr[row];
         double sum = 0;
-        while (i < *convIt)
+        for (; i < rowEnd; ++i)
         {
-            sum += (*fvvf)[m_conversionColInd.at(i)] * m_conversionMatrix.at(i);
-            i++;
+            sum += fromValues[colInd[i]] * coefficients[i];
         }
-        *tvit = sum;
-        ++tvit;
+        toValues[row] = sum;
     }
 
     return tvvf;
@@ -3316,12 +3316,41 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     Angles sAngle(uMob->GetPosition(), sMob->GetPosition());
     Angles uAngle(sMob->GetPosition(), uMob->GetPosition());
 
-    Double2DVector sinCosA; // cached multiplications of sin and cos of the ZoA and AoA angles
-    Double2DVector sinSinA; // cached multiplications of sines of the ZoA and AoA angles
-    Double2DVector cosZoA;  // cached cos of the ZoA angle
-    Double2DVector sinCosD; // cached multiplications of sin and cos of the ZoD and AoD angles
-    Double2DVector sinSinD; // cached multiplications of the cosines of the ZoA and AoA angles
-    Double2DVector cosZoD;  // cached cos of the ZoD angle
+    // the directions of the rays, in the order of the clusters and then of the rays,
+    // used to compute the field patterns and the phase terms of all the rays at once
+    size_t numRays = channelParams->m_reducedClusterNumber * table3gpp->m_raysPerCluster;
+    std::vector<Angles> rxFieldPatternAngles;
+    std::vector<Angles> txFieldPatternAngles;
+    std::vector<Angles> rxPhaseAngles;
+    std::vector<Angles> txPhaseAngles;
+    rxFieldPatternAngles.reserve(numRays);
+    txFieldPatternAngles.reserve(numRays);
+    rxPhaseAngles.reserve(numRays);
+    txPhaseAngles.reserve(numRays);
+    for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+    {
+        for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+        {
+            rxFieldPatternAngles.emplace_back(channelParams->m_rayAoaRadian[nIndex][mIndex],
+                                              channelParams->m_rayZoaRadian[nIndex][mIndex]);
+            txFieldPatternAngles.emplace_back(channelParams->m_rayAodRadian[nIndex][mIndex],
+                                              channelParams->m_rayZodRadian[nIndex][mIndex]);
+            rxPhaseAngles.emplace_back(rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]);
+            txPhaseAngles.emplace_back(rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]);
+        }
+    }
+
+    // the field patterns of all the rays, for each polarization
+    std::vector<std::vector<std::pair<double, double>>> rxFieldPatterns;
+    std::vector<std::vector<std::pair<double, double>>> txFieldPatterns;
+    for (uint8_t polUa = 0; polUa < uAntenna->GetNumPols(); ++polUa)
+    {
+        rxFieldPatterns.push_back(uAntenna->GetElementFieldPatterns(rxFieldPatternAngles, polUa));
+    }
+    for (uint8_t polSa = 0; polSa < sAntenna->GetNumPols(); ++polSa)
+    {
+        txFieldPatterns.push_back(sAntenna->GetElementFieldPatterns(txFieldPatternAngles, polSa));
+    }
 
     // contains part of the ray expression, cached as independent from the u- and s-indexes,
     // but calculate it for different polarization angles of s and u
@@ -3335,22 +3364,6 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         }
     }
 
-    // resize to appropriate dimensions
-    sinCosA.resize(channelParams->m_reducedClusterNumber);
-    sinSinA.resize(channelParams->m_reducedClusterNumber);
-    cosZoA.resize(channelParams->m_reducedClusterNumber);
-    sinCosD.resize(channelParams->m_reducedClusterNumber);
-    sinSinD.resize(channelParams->m_reducedClusterNumber);
-    cosZoD.resize(channelParams->m_reducedClusterNumber);
-    for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
-    {
-        sinCosA[nIndex].resize(table3gpp->m_raysPerCluster);
-        sinSinA[nIndex].resize(table3gpp->m_raysPerCluster);
-        cosZoA[nIndex].resize(table3gpp->m_raysPerCluster);
-        sinCosD[nIndex].resize(table3gpp->m_raysPerCluster);
-        sinSinD[nIndex].resize(table3gpp->m_raysPerCluster);
-        cosZoD[nIndex].resize(table3gpp->m_raysPerCluster);
-    }
     // pre-compute the terms which are independent from uIndex and sIndex
     for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
     {
@@ -3359,22 +3372,17 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
             DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
             NS_ASSERT(4 <= initialPhase.size());
             double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
+            size_t rayIndex = nIndex * table3gpp->m_raysPerCluster + mIndex;
 
             // cache the component of the "rays" terms which depend on the random angle of arrivals
             // and departures and initial phases only
             for (uint8_t polUa = 0; polUa < uAntenna->GetNumPols(); ++polUa)
             {
-                auto [rxFieldPatternPhi, rxFieldPatternTheta] = uAntenna->GetElementFieldPattern(
-                    Angles(channelParams->m_rayAoaRadian[nIndex][mIndex],
-                           channelParams->m_rayZoaRadian[nIndex][mIndex]),
-                    polUa);
+                auto [rxFieldPatternPhi, rxFieldPatternTheta] = rxFieldPatterns[polUa][rayIndex];
                 for (uint8_t polSa = 0; polSa < sAntenna->GetNumPols(); ++polSa)
                 {
                     auto [txFieldPatternPhi, txFieldPatternTheta] =
-                        sAntenna->GetElementFieldPattern(
-                            Angles(channelParams->m_rayAodRadian[nIndex][mIndex],
-                                   channelParams->m_rayZodRadian[nIndex][mIndex]),
-                            polSa);
+                        txFieldPatterns[polSa][rayIndex];
                     raysPreComp[std::make_pair(polSa, polUa)](nIndex, mIndex) =
                         std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
                             rxFieldPatternTheta * txFieldPatternTheta +
@@ -3386,24 +3394,34 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                             rxFieldPatternPhi * txFieldPatternPhi;
                 }
             }
+        }
+    }
+
+    // The "rxPhaseDiff" and "txPhaseDiff" terms of each ray and each element are the
+    // complex conjugates of the steering vectors toward the rays, which are computed for
+    // all the rays at once. lambda_0 is accounted in the element locations.
+    ComplexMatrixArray rxSteering = uAntenna->GetSteeringMatrix(rxPhaseAngles);
+    ComplexMatrixArray txSteering = sAntenna->GetSteeringMatrix(txPhaseAngles);
 
-            // cache the component of the "rxPhaseDiff" terms which depend on the random angle of
-            // arrivals only
-            double sinRayZoa = sin(rayZoaRadian[nIndex][mIndex]);
-            double sinRayAoa = sin(rayAoaRadian[nIndex][mIndex]);
-            double cosRayAoa = cos(rayAoaRadian[nIndex][mIndex]);
-            sinCosA[nIndex][mIndex] = sinRayZoa * cosRayAoa;
-            sinSinA[nIndex][mIndex] = sinRayZoa * sinRayAoa;
-            cosZoA[nIndex][mIndex] = cos(rayZoaRadian[nIndex][mIndex]);
-
-            // cache the component of the "txPhaseDiff" terms which depend on the random angle of
-            // departure only
-            double sinRayZod = sin(rayZodRadian[nIndex][mIndex]);
-            double sinRayAod = sin(rayAodRadian[nIndex][mIndex]);
-            double cosRayAod = cos(rayAodRadian[nIndex][mIndex]);
-            sinCosD[nIndex][mIndex] = sinRayZod * cosRayAod;
-            sinSinD[nIndex][mIndex] = sinRayZod * sinRayAod;
-            cosZoD[nIndex][mIndex] = cos(rayZodRadian[nIndex][mIndex]);
+    // cache the product of the "rays" terms and the "rxPhaseDiff" terms, which is independent
+    // from sIndex except for the polarization, so that the inner loop over the rays only
+    // multiplies contiguous arrays
+    std::vector<ComplexMatrixArray> rxRaysPreComp(sAntenna->GetNumPols(),
+                                                  ComplexMatrixArray(numRays, uSize));
+    for (uint8_t polSa = 0; polSa < sAntenna->GetNumPols(); ++polSa)
+    {
+        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
+            const auto& preComp = raysPreComp[std::make_pair(polSa, uAntenna->GetElemPol(uIndex))];
+            for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+            {
+                for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                {
+                    size_t rayIndex = nIndex * table3gpp->m_raysPerCluster + mIndex;
+                    rxRaysPreComp[polSa](rayIndex, uIndex) =
+                        preComp(nIndex, mIndex) * std::conj(rxSteering(rayIndex, uIndex));
+                }
+            }
         }
     }
 
@@ -3412,13 +3430,14 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     uint8_t numSubClustersAdded = 0;
     for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
     {
+        size_t firstRay = nIndex * table3gpp->m_raysPerCluster;
         for (size_t uIndex = 0; uIndex < uSize; uIndex++)
         {
-            Vector uLoc = uAntenna->GetElementLocation(uIndex);
-
             for (size_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-                Vector sLoc = sAntenna->GetElementLocation(sIndex);
+                const std::complex<double>* rxRays =
+                    &rxRaysPreComp[sAntenna->GetElemPol(sIndex)](firstRay, uIndex);
+                const std::complex<double>* txSteeringRays = &txSteering(firstRay, sIndex);
                 // Compute the N-2 weakest cluster, assuming 0 slant angle and a
                 // polarization slant angle configured in the array (7.5-22)
                 if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
@@ -3426,23 +3445,9 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     std::complex<double> rays(0, 0);
                     for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
                     {
-                        // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
                         // NOTE Doppler is computed in the CalcBeamformingGain function and is
                         // simplified to only account for the center angle of each cluster.
-                        rays += raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                           uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                          mIndex) *
-                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        rays += rxRays[mIndex] * std::conj(txSteeringRays[mIndex]);
                     }
                     rays *=
                         sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
@@ -3458,22 +3463,8 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     {
                         // ZML:Just remind me that the angle offsets for the 3 subclusters were not
                         // generated correctly.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
-
                         std::complex<double> raySub =
-                            raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                       uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                      mIndex) *
-                            std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                            std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                            rxRays[mIndex] * std::conj(txSteeringRays[mIndex]);
 
                         switch (mIndex)
                         {
@@ -3525,45 +3516,40 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         std::complex<double> phaseDiffDueToDistance(cos(-2 * M_PI * distance3D / lambda),
                                                     sin(-2 * M_PI * distance3D / lambda));
 
-        const double sinUAngleIncl = sin(uAngle.GetInclination());
-        const double cosUAngleIncl = cos(uAngle.GetInclination());
-        const double sinUAngleAz = sin(uAngle.GetAzimuth());
-        const double cosUAngleAz = cos(uAngle.GetAzimuth());
-        const double sinSAngleIncl = sin(sAngle.GetInclination());
-        const double cosSAngleIncl = cos(sAngle.GetInclination());
-        const double sinSAngleAz = sin(sAngle.GetAzimuth());
-        const double cosSAngleAz = cos(sAngle.GetAzimuth());
+        // the "rxPhaseDiff" and "txPhaseDiff" terms are the complex conjugates of the
+        // steering vectors toward the LOS direction
+        PhasedArrayModel::ComplexVector rxSteeringLos = uAntenna->GetSteeringVector(uAngle);
+        PhasedArrayModel::ComplexVector txSteeringLos = sAntenna->GetSteeringVector(sAngle);
+
+        // the field patterns toward the LOS direction only depend on the polarization
+        std::vector<std::pair<double, double>> rxFieldPatternsLos;
+        std::vector<std::pair<double, double>> txFieldPatternsLos;
+        for (uint8_t polUa = 0; polUa < uAntenna->GetNumPols(); ++polUa)
+        {
+            rxFieldPatternsLos.push_back(uAntenna->GetElementFieldPattern(uAngle, polUa));
+        }
+        for (uint8_t polSa = 0; polSa < sAntenna->GetNumPols(); ++polSa)
+        {
+            txFieldPatternsLos.push_back(sAntenna->GetElementFieldPattern(sAngle, polSa));
+        }
 
+        double kLinear = pow(10, channelParams->m_K_factor / 10.0);
         for (size_t uIndex = 0; uIndex < uSize; uIndex++)
         {
-            Vector uLoc = uAntenna->GetElementLocation(uIndex);
-            double rxPhaseDiff = 2 * M_PI *
-                                 (sinUAngleIncl * cosUAngleAz * uLoc.x +
-                                  sinUAngleIncl * sinUAngleAz * uLoc.y + cosUAngleIncl * uLoc.z);
+            auto [rxFieldPatternPhi, rxFieldPatternTheta] =
+                rxFieldPatternsLos[uAntenna->GetElemPol(uIndex)];
 
             for (size_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-                Vector sLoc = sAntenna->GetElementLocation(sIndex);
-                std::complex<double> ray(0, 0);
-                double txPhaseDiff =
-                    2 * M_PI *
-                    (sinSAngleIncl * cosSAngleAz * sLoc.x + sinSAngleIncl * sinSAngleAz * sLoc.y +
-                     cosSAngleIncl * sLoc.z);
-
-                auto [rxFieldPatternPhi, rxFieldPatternTheta] = uAntenna->GetElementFieldPattern(
-                    Angles(uAngle.GetAzimuth(), uAngle.GetInclination()),
-                    uAntenna->GetElemPol(uIndex));
-                auto [txFieldPatternPhi, txFieldPatternTheta] = sAntenna->GetElementFieldPattern(
-                    Angles(sAngle.GetAzimuth(), sAngle.GetInclination()),
-                    sAntenna->GetElemPol(sIndex));
-
-                ray = (rxFieldPatternTheta * txFieldPatternTheta -
-                       rxFieldPatternPhi * txFieldPatternPhi) *
-                      phaseDiffDueToDistance *
-                      std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                      std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
-
-                double kLinear = pow(10, channelParams->m_K_factor / 10.0);
+                auto [txFieldPatternPhi, txFieldPatternTheta] =
+                    txFieldPatternsLos[sAntenna->GetElemPol(sIndex)];
+
+                std::complex<double> ray =
+                    (rxFieldPatternTheta * txFieldPatternTheta -
+                     rxFieldPatternPhi * txFieldPatternPhi) *
+                    phaseDiffDueToDistance * std::conj(rxSteeringLos[uIndex]) *
+                    std::conj(txSteeringLos[sIndex]);
+
                 // the LOS path should be attenuated if blockage is enabled.
                 hUsn(uIndex, sIndex, 0) =
                     sqrt(1.0 / (kLinear + 1)) * hUsn(uIndex, sIndex, 0) +
@@ -0,0 +1,272 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-converter.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("MultiModelSpectrumChannelTest");
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief SpectrumPhy which records the values of the PSDs it receives
+ *
+ * The received PSDs are modified after being recorded, to check that the
+ * channel does not share them between receivers or transmissions.
+ */
+class RecordingSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     * @param model the SpectrumModel of the phy
+     */
+    RecordingSpectrumPhy(Ptr<const SpectrumModel> model);
+
+    // inherited from SpectrumPhy
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    std::vector<SpectrumValue> m_rxPsds; //!< the values of the received PSDs
+
+  private:
+    Ptr<const SpectrumModel> m_model; //!< the SpectrumModel of the phy
+};
+
+RecordingSpectrumPhy::RecordingSpectrumPhy(Ptr<const SpectrumModel> model)
+    : m_model(model)
+{
+}
+
+void
+RecordingSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+RecordingSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+RecordingSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+}
+
+Ptr<MobilityModel>
+RecordingSpectrumPhy::GetMobility() const
+{
+    return nullptr;
+}
+
+void
+RecordingSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+RecordingSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_model;
+}
+
+Ptr<Object>
+RecordingSpectrumPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+RecordingSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_rxPsds.push_back(*params->psd);
+    *params->psd *= 10;
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief MultiModelSpectrumChannel conversion test
+ *
+ * Transmits several times the same PSD, modified in place or not, and a copy
+ * of it, and checks that each receiver gets the PSD converted to its
+ * SpectrumModel, also when the PSDs converted for a previous transmission are
+ * reused, and after a receiver with a new SpectrumModel is added.
+ */
+class MultiModelSpectrumChannelConversionTestCase : public TestCase
+{
+  public:
+    MultiModelSpectrumChannelConversionTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Start the transmission of a PSD
+     * @param txPhy the transmitting phy
+     * @param psd the PSD to transmit
+     */
+    void Transmit(Ptr<SpectrumPhy> txPhy, Ptr<SpectrumValue> psd);
+
+    /**
+     * Check the PSDs received by a phy
+     * @param phy the receiving phy
+     * @param expected the expected PSDs, converted to the SpectrumModel of the phy
+     * @param name the name of the phy, for the error messages
+     */
+    void CheckReceived(Ptr<RecordingSpectrumPhy> phy,
+                       const std::vector<SpectrumValue>& expected,
+                       const std::string& name);
+
+    Ptr<MultiModelSpectrumChannel> m_channel; //!< the channel
+};
+
+MultiModelSpectrumChannelConversionTestCase::MultiModelSpectrumChannelConversionTestCase()
+    : TestCase("Check the PSDs converted by MultiModelSpectrumChannel")
+{
+}
+
+void
+MultiModelSpectrumChannelConversionTestCase::Transmit(Ptr<SpectrumPhy> txPhy,
+                                                      Ptr<SpectrumValue> psd)
+{
+    auto params = Create<SpectrumSignalParameters>();
+    params->txPhy = txPhy;
+    params->psd = psd;
+    params->duration = MilliSeconds(1);
+    m_channel->StartTx(params);
+}
+
+void
+MultiModelSpectrumChannelConversionTestCase::CheckReceived(
+    Ptr<RecordingSpectrumPhy> phy,
+    const std::vector<SpectrumValue>& expected,
+    const std::string& name)
+{
+    NS_TEST_ASSERT_MSG_EQ(phy->m_rxPsds.size(),
+                          expected.size(),
+                          "Wrong number of PSDs received by " << name);
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(phy->m_rxPsds[i],
+                              expected[i],
+                              "Wrong PSD " << i << " received by " << name);
+    }
+}
+
+void
+MultiModelSpectrumChannelConversionTestCase::DoRun()
+{
+    auto txModel = Create<SpectrumModel>(std::vector<double>{1e6, 2e6, 3e6, 4e6});
+    auto overlappingModel = Create<SpectrumModel>(std::vector<double>{1.5e6, 2.5e6, 3.5e6});
+    auto orthogonalModel = Create<SpectrumModel>(std::vector<double>{100e6, 101e6});
+    auto lateModel = Create<SpectrumModel>(std::vector<double>{2e6, 4e6});
+
+    m_channel = CreateObject<MultiModelSpectrumChannel>();
+    auto txPhy = CreateObject<RecordingSpectrumPhy>(txModel);
+    auto sameModelPhy = CreateObject<RecordingSpectrumPhy>(txModel);
+    auto overlappingPhy = CreateObject<RecordingSpectrumPhy>(overlappingModel);
+    auto orthogonalPhy = CreateObject<RecordingSpectrumPhy>(orthogonalModel);
+    auto latePhy = CreateObject<RecordingSpectrumPhy>(lateModel);
+    m_channel->AddRx(txPhy);
+    m_channel->AddRx(sameModelPhy);
+    m_channel->AddRx(overlappingPhy);
+    m_channel->AddRx(orthogonalPhy);
+
+    auto psd = Create<SpectrumValue>(txModel);
+    (*psd)[0] = 1;
+    (*psd)[1] = 2;
+    (*psd)[2] = 3;
+    (*psd)[3] = 4;
+    auto doubledPsd = Create<SpectrumValue>(*psd * 2);
+
+    // the same PSD twice, then modified in place, then a copy of it
+    Simulator::Schedule(Seconds(1),
+                        &MultiModelSpectrumChannelConversionTestCase::Transmit,
+                        this,
+                        txPhy,
+                        psd);
+    Simulator::Schedule(Seconds(2),
+                        &MultiModelSpectrumChannelConversionTestCase::Transmit,
+                        this,
+                        txPhy,
+                        psd);
+    Simulator::Schedule(Seconds(2.5), [psd]() { *psd *= 2; });
+    Simulator::Schedule(Seconds(3),
+                        &MultiModelSpectrumChannelConversionTestCase::Transmit,
+                        this,
+                        txPhy,
+                        psd);
+    Simulator::Schedule(Seconds(4),
+                        &MultiModelSpectrumChannelConversionTestCase::Transmit,
+                        this,
+                        txPhy,
+                        doubledPsd->Copy());
+    // a receiver with a new SpectrumModel, which the PSDs converted before lack
+    Simulator::Schedule(Seconds(4.5), [this, latePhy]() { m_channel->AddRx(latePhy); });
+    Simulator::Schedule(Seconds(5),
+                        &MultiModelSpectrumChannelConversionTestCase::Transmit,
+                        this,
+                        txPhy,
+                        psd);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    const SpectrumValue original = *psd / 2;
+    const SpectrumValue doubled = *doubledPsd;
+    CheckReceived(txPhy, {}, "the transmitter");
+    CheckReceived(sameModelPhy,
+                  {original, original, doubled, doubled, doubled},
+                  "the phy with the same model");
+    SpectrumConverter toOverlapping(txModel, overlappingModel);
+    const SpectrumValue convOriginal = *toOverlapping.Convert(original.Copy());
+    const SpectrumValue convDoubled = *toOverlapping.Convert(doubledPsd);
+    CheckReceived(overlappingPhy,
+                  {convOriginal, convOriginal, convDoubled, convDoubled, convDoubled},
+                  "the phy with an overlapping model");
+    CheckReceived(orthogonalPhy, {}, "the phy with an orthogonal model");
+    SpectrumConverter toLate(txModel, lateModel);
+    CheckReceived(latePhy, {*toLate.Convert(doubledPsd)}, "the phy added last");
+
+    m_channel->Dispose();
+    m_channel = nullptr;
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * @brief MultiModelSpectrumChannel Test Suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    MultiModelSpectrumChannelTestSuite();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite()
+    : TestSuite("multi-model-spectrum-channel", Type::UNIT)
+{
+    AddTestCase(new MultiModelSpectrumChannelConversionTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;
@@ -290,6 +290,12 @@ FileHelper::GetProbe(std::string probeName) const
     }
 }
 
+std::string
+FileHelper::GetExtension() const
+{
+    return m_fileType == FileAggregator::COLUMNAR ? ".bin" : ".txt";
+}
+
 Ptr<FileAggregator>
 FileHelper::GetAggregatorSingle()
 {
@@ -300,7 +306,7 @@ FileHelper::GetAggregatorSingle()
     if (!m_aggregator)
     {
         // Create the aggregator.
-        std::string outputFileName = m_outputFileNameWithoutExtension + ".txt";
+        std::string outputFileName = m_outputFileNameWithoutExtension + GetExtension();
         m_aggregator = CreateObject<FileAggregator>(outputFileName, m_fileType);
 
         // Set all of the format strings for the aggregator.
@@ -513,7 +519,7 @@ FileHelper::ConnectProbeToAggregator(const std::string& typeId,
 
     // Add the aggregator to the map of aggregators, which will keep the
     // aggregator in memory after this function ends.
-    std::string outputFileName = outputFileNameWithoutExtension + ".txt";
+    std::string outputFileName = outputFileNameWithoutExtension + GetExtension();
     AddAggregator(probeContext, outputFileName, onlyOneAggregator);
 
     // Connect the adaptor to the aggregator.
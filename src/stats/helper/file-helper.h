@@ -41,8 +41,9 @@ class FileHelper
      *
      * Constructs a file helper that will create a file named
      * outputFileNameWithoutExtension plus possible extra information
-     * from wildcard matches plus ".txt" with values printed as
-     * specified by fileType.  The default file type is space-separated.
+     * from wildcard matches plus ".txt", or ".bin" for the COLUMNAR
+     * type, with values printed as specified by fileType.  The default
+     * file type is space-separated.
      */
     FileHelper(const std::string& outputFileNameWithoutExtension,
                FileAggregator::FileType fileType = FileAggregator::SPACE_SEPARATED);
@@ -56,9 +57,9 @@ class FileHelper
      *
      * Configures file related parameters for this file helper so that
      * it will create a file named outputFileNameWithoutExtension plus
-     * possible extra information from wildcard matches plus ".txt" with
-     * values printed as specified by fileType.  The default file type
-     * is space-separated.
+     * possible extra information from wildcard matches plus ".txt", or
+     * ".bin" for the COLUMNAR type, with values printed as specified by
+     * fileType.  The default file type is space-separated.
      */
     void ConfigureFile(const std::string& outputFileNameWithoutExtension,
                        FileAggregator::FileType fileType = FileAggregator::SPACE_SEPARATED);
@@ -267,6 +268,12 @@ class FileHelper
                                   const std::string& outputFileNameWithoutExtension,
                                   bool onlyOneAggregator);
 
+    /**
+     * @brief Gets the extension of the output files.
+     * @return ".bin" for the COLUMNAR file type, ".txt" otherwise.
+     */
+    std::string GetExtension() const;
+
     /// Used to create the probes and collectors as they are added.
     ObjectFactory m_factory;
 
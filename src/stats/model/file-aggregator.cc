@@ -44,7 +44,9 @@ FileAggregator::FileAggregator(const std::string& outputFileName, FileType fileT
       m_7dFormat("%e %e %e %e %e %e %e"),
       m_8dFormat("%e %e %e %e %e %e %e %e"),
       m_9dFormat("%e %e %e %e %e %e %e %e %e"),
-      m_10dFormat("%e %e %e %e %e %e %e %e %e %e")
+      m_10dFormat("%e %e %e %e %e %e %e %e %e %e"),
+      m_rows(0),
+      m_hasHeaderBeenWritten(false)
 {
     NS_LOG_FUNCTION(this << outputFileName << fileType);
 
@@ -63,12 +65,17 @@ FileAggregator::FileAggregator(const std::string& outputFileName, FileType fileT
         break;
     }
 
-    m_file.open(m_outputFileName);
+    m_file.open(m_outputFileName,
+                m_fileType == COLUMNAR ? std::ios::out | std::ios::binary : std::ios::out);
 }
 
 FileAggregator::~FileAggregator()
 {
     NS_LOG_FUNCTION(this);
+    if (m_fileType == COLUMNAR)
+    {
+        WriteBlock();
+    }
     m_file.close();
 }
 
@@ -88,8 +95,11 @@ FileAggregator::SetHeading(const std::string& heading)
         m_heading = heading;
         m_hasHeadingBeenSet = true;
 
-        // Print the heading to the file.
-        m_file << m_heading << std::endl;
+        // Print the heading to the file, or with the header of a binary file.
+        if (m_fileType != COLUMNAR)
+        {
+            m_file << m_heading << std::endl;
+        }
     }
 }
 
@@ -170,6 +180,12 @@ FileAggregator::Write1d(std::string context, double v1)
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1});
+            return;
+        }
+
         // Write the 1D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -204,6 +220,12 @@ FileAggregator::Write2d(std::string context, double v1, double v2)
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2});
+            return;
+        }
+
         // Write the 2D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -238,6 +260,12 @@ FileAggregator::Write3d(std::string context, double v1, double v2, double v3)
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3});
+            return;
+        }
+
         // Write the 3D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -272,6 +300,12 @@ FileAggregator::Write4d(std::string context, double v1, double v2, double v3, do
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3, v4});
+            return;
+        }
+
         // Write the 4D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -307,6 +341,12 @@ FileAggregator::Write5d(std::string context, double v1, double v2, double v3, do
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3, v4, v5});
+            return;
+        }
+
         // Write the 5D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -349,6 +389,12 @@ FileAggregator::Write6d(std::string context,
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3, v4, v5, v6});
+            return;
+        }
+
         // Write the 6D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -392,6 +438,12 @@ FileAggregator::Write7d(std::string context,
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3, v4, v5, v6, v7});
+            return;
+        }
+
         // Write the 7D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -436,6 +488,12 @@ FileAggregator::Write8d(std::string context,
 
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3, v4, v5, v6, v7, v8});
+            return;
+        }
+
         // Write the 8D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -481,6 +539,12 @@ FileAggregator::Write9d(std::string context,
     NS_LOG_FUNCTION(this << context << v1 << v2 << v3 << v4 << v5 << v6 << v7 << v8 << v9);
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3, v4, v5, v6, v7, v8, v9});
+            return;
+        }
+
         // Write the 9D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -537,6 +601,12 @@ FileAggregator::Write10d(std::string context,
     NS_LOG_FUNCTION(this << context << v1 << v2 << v3 << v4 << v5 << v6 << v7 << v8 << v9 << v10);
     if (m_enabled)
     {
+        if (m_fileType == COLUMNAR)
+        {
+            WriteRow({v1, v2, v3, v4, v5, v6, v7, v8, v9, v10});
+            return;
+        }
+
         // Write the 10D data point to the file.
         if (m_fileType == FORMATTED)
         {
@@ -578,4 +648,51 @@ FileAggregator::Write10d(std::string context,
     }
 }
 
+void
+FileAggregator::WriteRow(std::initializer_list<double> values)
+{
+    NS_LOG_FUNCTION(this);
+    if (values.size() != m_columns.size())
+    {
+        WriteBlock();
+        m_columns.assign(values.size(), {});
+    }
+    auto column = m_columns.begin();
+    for (double value : values)
+    {
+        (column++)->push_back(value);
+    }
+    if (++m_rows == 4096)
+    {
+        WriteBlock();
+    }
+}
+
+void
+FileAggregator::WriteBlock()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_hasHeaderBeenWritten)
+    {
+        m_hasHeaderBeenWritten = true;
+        uint32_t headingLength = m_heading.size();
+        m_file.write("NS3COLS", 8);
+        m_file.write(reinterpret_cast<const char*>(&headingLength), sizeof(headingLength));
+        m_file.write(m_heading.data(), headingLength);
+    }
+    if (m_rows == 0)
+    {
+        return;
+    }
+    uint32_t columns = m_columns.size();
+    m_file.write(reinterpret_cast<const char*>(&columns), sizeof(columns));
+    m_file.write(reinterpret_cast<const char*>(&m_rows), sizeof(m_rows));
+    for (auto& column : m_columns)
+    {
+        m_file.write(reinterpret_cast<const char*>(column.data()), m_rows * sizeof(double));
+        column.clear();
+    }
+    m_rows = 0;
+}
+
 } // namespace ns3
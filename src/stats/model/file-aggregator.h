@@ -15,8 +15,10 @@
 #include "data-collection-object.h"
 
 #include <fstream>
+#include <initializer_list>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +27,16 @@ namespace ns3
  * @ingroup aggregator
  *
  * This aggregator sends values it receives to a file.
+ *
+ * With the COLUMNAR file type, the values are written in binary, in
+ * blocks of up to 4096 rows stored column by column, so that long time
+ * series can be written and read back without formatting or parsing
+ * each value.  The file starts with the 8 bytes "NS3COLS" followed by a
+ * null character, a 32-bit heading length and the heading.  Each block
+ * then has a 32-bit number of columns, a 32-bit number of rows, and for
+ * each column in turn, the values of the rows as 64-bit doubles.  All
+ * the numbers are stored in the byte order of the host.  The heading
+ * must be set before the first values are written.
  **/
 class FileAggregator : public DataCollectionObject
 {
@@ -35,7 +47,8 @@ class FileAggregator : public DataCollectionObject
         FORMATTED,
         SPACE_SEPARATED,
         COMMA_SEPARATED,
-        TAB_SEPARATED
+        TAB_SEPARATED,
+        COLUMNAR
     };
 
     /**
@@ -326,6 +339,18 @@ class FileAggregator : public DataCollectionObject
                   double v10);
 
   private:
+    /**
+     * @param values the values of the row.
+     *
+     * @brief Add a row to the current block of a COLUMNAR file, and
+     * write the block when it is full, or when the number of values
+     * changes.
+     */
+    void WriteRow(std::initializer_list<double> values);
+
+    /// Writes the current block of a COLUMNAR file, after the file header if needed.
+    void WriteBlock();
+
     /// The file name.
     std::string m_outputFileName;
 
@@ -354,6 +379,10 @@ class FileAggregator : public DataCollectionObject
     std::string m_8dFormat;  //!< Format string for 8D C-style sprintf() function.
     std::string m_9dFormat;  //!< Format string for 9D C-style sprintf() function.
     std::string m_10dFormat; //!< Format string for 10D C-style sprintf() function.
+
+    std::vector<std::vector<double>> m_columns; //!< Values of the current COLUMNAR block.
+    uint32_t m_rows;                            //!< Number of rows of the current block.
+    bool m_hasHeaderBeenWritten;                //!< Whether the COLUMNAR header was written.
 };
 
 } // namespace ns3
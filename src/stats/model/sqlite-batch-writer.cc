@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "sqlite-batch-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SQLiteBatchWriter");
+
+SQLiteBatchWriter::SQLiteBatchWriter(const Ptr<SQLiteOutput>& db,
+                                     const std::string& insert,
+                                     uint32_t batchSize,
+                                     uint32_t maxBatches)
+    : m_db(db),
+      m_batchSize(batchSize),
+      m_maxBatches(maxBatches)
+{
+    NS_LOG_FUNCTION(this << db << insert << batchSize << maxBatches);
+    NS_ABORT_MSG_IF(batchSize == 0 || maxBatches == 0, "Invalid batch parameters");
+    bool ret = m_db->WaitPrepare(&m_stmt, insert);
+    NS_ABORT_MSG_UNLESS(ret, "Failed to prepare " << insert);
+    m_batch.reserve(m_batchSize);
+    m_thread = std::thread(&SQLiteBatchWriter::Run, this);
+}
+
+SQLiteBatchWriter::~SQLiteBatchWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    {
+        std::unique_lock lock{m_mutex};
+        m_stop = true;
+    }
+    m_queued.notify_one();
+    m_thread.join();
+    SQLiteOutput::SpinFinalize(m_stmt);
+}
+
+void
+SQLiteBatchWriter::AddRow(Row row)
+{
+    m_batch.push_back(std::move(row));
+    if (m_batch.size() >= m_batchSize)
+    {
+        Submit();
+    }
+}
+
+void
+SQLiteBatchWriter::Submit()
+{
+    NS_LOG_FUNCTION(this << m_batch.size());
+    std::vector<Row> batch;
+    batch.reserve(m_batchSize);
+    batch.swap(m_batch);
+    {
+        std::unique_lock lock{m_mutex};
+        m_written.wait(lock, [this] { return m_queue.size() < m_maxBatches; });
+        m_queue.push_back(std::move(batch));
+    }
+    m_queued.notify_one();
+}
+
+bool
+SQLiteBatchWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_batch.empty())
+    {
+        Submit();
+    }
+    std::unique_lock lock{m_mutex};
+    m_written.wait(lock, [this] { return m_queue.empty() && !m_writing; });
+    return m_ok;
+}
+
+uint64_t
+SQLiteBatchWriter::GetNRowsWritten() const
+{
+    std::unique_lock lock{m_mutex};
+    return m_rowsWritten;
+}
+
+void
+SQLiteBatchWriter::Run()
+{
+    std::unique_lock lock{m_mutex};
+    while (true)
+    {
+        m_queued.wait(lock, [this] { return !m_queue.empty() || m_stop; });
+        if (m_queue.empty())
+        {
+            return;
+        }
+        std::vector<Row> batch = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writing = true;
+
+        lock.unlock();
+        bool ok = Write(batch);
+        lock.lock();
+
+        m_writing = false;
+        m_ok = m_ok && ok;
+        if (ok)
+        {
+            m_rowsWritten += batch.size();
+        }
+        m_written.notify_all();
+    }
+}
+
+bool
+SQLiteBatchWriter::Write(const std::vector<Row>& batch) const
+{
+    return m_db->WaitExecBatch(m_stmt, batch.size(), [&](sqlite3_stmt* stmt, std::size_t i) {
+        int pos = 1;
+        for (const auto& value : batch[i])
+        {
+            bool ret = std::visit([&](const auto& v) { return m_db->Bind(stmt, pos, v); }, value);
+            if (!ret)
+            {
+                return false;
+            }
+            ++pos;
+        }
+        return true;
+    });
+}
+
+} // namespace ns3
@@ -0,0 +1,121 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SQLITE_BATCH_WRITER_H
+#define SQLITE_BATCH_WRITER_H
+
+#include "sqlite-output.h"
+
+#include "ns3/ptr.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup stats
+ *
+ * @brief Insert rows in an SQLITE table from a background thread
+ *
+ * The rows are grouped in batches, and each batch is written in a single
+ * transaction with the same prepared statement, by a thread dedicated to
+ * the writer, so that the caller does not wait for the database.  When
+ * the writer falls behind, AddRow() blocks until there is room for a new
+ * batch in the queue, which bounds the memory used by pending rows.
+ *
+ * The statements executed by others on the same database while the
+ * writer is running should use the "Wait" methods of SQLiteOutput.
+ */
+class SQLiteBatchWriter
+{
+  public:
+    /// The value of a column.
+    using Value = std::variant<int64_t, double, std::string>;
+    /// The values of a row, in the order of the statement parameters.
+    using Row = std::vector<Value>;
+
+    /**
+     * @brief SQLiteBatchWriter constructor
+     * @param db Database
+     * @param insert Statement inserting a row, with one parameter per column
+     * @param batchSize Number of rows written in each transaction
+     * @param maxBatches Maximum number of batches waiting to be written
+     */
+    SQLiteBatchWriter(const Ptr<SQLiteOutput>& db,
+                      const std::string& insert,
+                      uint32_t batchSize = 1000,
+                      uint32_t maxBatches = 4);
+
+    /**
+     * Destructor, writes the pending rows.
+     */
+    ~SQLiteBatchWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SQLiteBatchWriter(const SQLiteBatchWriter&) = delete;
+    SQLiteBatchWriter& operator=(const SQLiteBatchWriter&) = delete;
+
+    /**
+     * @brief Add a row to the table
+     * @param row Values of the row
+     */
+    void AddRow(Row row);
+
+    /**
+     * @brief Wait until all the rows added so far are written
+     * @return true if all the batches were written successfully
+     */
+    bool Flush();
+
+    /**
+     * @return The number of rows written so far
+     */
+    uint64_t GetNRowsWritten() const;
+
+  private:
+    /**
+     * @brief Queue the current batch, waiting for room in the queue
+     */
+    void Submit();
+
+    /**
+     * @brief Write the queued batches, in the writer thread
+     */
+    void Run();
+
+    /**
+     * @brief Write a batch in a single transaction
+     * @param batch Rows of the batch
+     * @return true in case of success
+     */
+    bool Write(const std::vector<Row>& batch) const;
+
+    Ptr<SQLiteOutput> m_db;               //!< Database
+    sqlite3_stmt* m_stmt{nullptr};        //!< Prepared insert statement
+    uint32_t m_batchSize;                 //!< Number of rows per transaction
+    uint32_t m_maxBatches;                //!< Maximum number of queued batches
+    std::vector<Row> m_batch;             //!< Batch being filled
+    std::thread m_thread;                 //!< The writer thread
+
+    mutable std::mutex m_mutex;           //!< Protects the members below
+    std::condition_variable m_queued;     //!< Signals a new batch, or the end
+    std::condition_variable m_written;    //!< Signals a written batch
+    std::deque<std::vector<Row>> m_queue; //!< Batches waiting to be written
+    bool m_writing{false};                //!< Whether a batch is being written
+    bool m_stop{false};                   //!< Whether the thread must end
+    bool m_ok{true};                      //!< Whether all the batches were written
+    uint64_t m_rowsWritten{0};            //!< Number of rows written
+};
+
+} // namespace ns3
+
+#endif /* SQLITE_BATCH_WRITER_H */
@@ -10,6 +10,7 @@
 
 #include "data-calculator.h"
 #include "data-collector.h"
+#include "sqlite-batch-writer.h"
 #include "sqlite-output.h"
 
 #include "ns3/log.h"
@@ -57,6 +58,7 @@ SqliteDataOutput::Output(DataCollector& dc)
     bool res;
 
     m_sqliteOut = new SQLiteOutput(m_dbFile);
+    m_sqliteOut->SetWriteAheadLog();
 
     res = m_sqliteOut->SpinExec("CREATE TABLE IF NOT EXISTS Experiments (run, experiment, "
                                 "strategy, input, description text)");
@@ -99,31 +101,22 @@ SqliteDataOutput::Output(DataCollector& dc)
                                 "Metadata ( run text, key text, value)");
     NS_ASSERT(res);
 
-    res = m_sqliteOut->WaitPrepare(&stmt,
+    {
+        SQLiteBatchWriter metadata(m_sqliteOut,
                                    "INSERT INTO Metadata "
                                    "(run, key, value)"
                                    "values (?, ?, ?)");
-    NS_ASSERT(res);
-
-    for (auto i = dc.MetadataBegin(); i != dc.MetadataEnd(); i++)
-    {
-        const auto& blob = (*i);
-        SQLiteOutput::SpinReset(stmt);
-        m_sqliteOut->Bind(stmt, 1, run);
-        m_sqliteOut->Bind(stmt, 2, blob.first);
-        m_sqliteOut->Bind(stmt, 3, blob.second);
-        SQLiteOutput::SpinStep(stmt);
-    }
-
-    SQLiteOutput::SpinFinalize(stmt);
-
-    m_sqliteOut->SpinExec("BEGIN");
-    SqliteOutputCallback callback(m_sqliteOut, run);
-    for (auto i = dc.DataCalculatorBegin(); i != dc.DataCalculatorEnd(); i++)
-    {
-        (*i)->Output(callback);
+        for (auto i = dc.MetadataBegin(); i != dc.MetadataEnd(); i++)
+        {
+            metadata.AddRow({run, i->first, i->second});
+        }
+
+        SqliteOutputCallback callback(m_sqliteOut, run);
+        for (auto i = dc.DataCalculatorBegin(); i != dc.DataCalculatorEnd(); i++)
+        {
+            (*i)->Output(callback);
+        }
     }
-    m_sqliteOut->SpinExec("COMMIT");
     // end SqliteDataOutput::Output
     m_sqliteOut->Unref();
 }
@@ -138,16 +131,14 @@ SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback(const Ptr<SQLiteOut
     m_db->WaitExec("CREATE TABLE IF NOT EXISTS Singletons "
                    "( run text, name text, variable text, value )");
 
-    m_db->WaitPrepare(&m_insertSingletonStatement,
-                      "INSERT INTO Singletons "
-                      "(run, name, variable, value)"
-                      "values (?, ?, ?, ?)");
-    m_db->Bind(m_insertSingletonStatement, 1, m_runLabel);
+    m_writer = std::make_unique<SQLiteBatchWriter>(m_db,
+                                                   "INSERT INTO Singletons "
+                                                   "(run, name, variable, value)"
+                                                   "values (?, ?, ?, ?)");
 }
 
 SqliteDataOutput::SqliteOutputCallback::~SqliteOutputCallback()
 {
-    SQLiteOutput::SpinFinalize(m_insertSingletonStatement);
 }
 
 void
@@ -187,11 +178,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_writer->AddRow({m_runLabel, key, variable, val});
 }
 
 void
@@ -201,11 +188,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_writer->AddRow({m_runLabel, key, variable, val});
 }
 
 void
@@ -215,11 +198,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_writer->AddRow({m_runLabel, key, variable, val});
 }
 
 void
@@ -229,11 +208,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_writer->AddRow({m_runLabel, key, variable, val});
 }
 
 void
@@ -243,11 +218,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    SQLiteOutput::SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val.GetTimeStep());
-    SQLiteOutput::SpinStep(m_insertSingletonStatement);
+    m_writer->AddRow({m_runLabel, key, variable, val.GetTimeStep()});
 }
 
 } // namespace ns3
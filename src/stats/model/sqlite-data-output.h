@@ -13,12 +13,13 @@
 
 #include "ns3/nstime.h"
 
-struct sqlite3_stmt;
+#include <memory>
 
 namespace ns3
 {
 
 class SQLiteOutput;
+class SQLiteBatchWriter;
 
 //------------------------------------------------------------
 //--------------------------------------------
@@ -116,8 +117,8 @@ class SqliteDataOutput : public DataOutputInterface
         Ptr<SQLiteOutput> m_db; //!< Db
         std::string m_runLabel; //!< Run label
 
-        /// Pointer to a Sqlite3 singleton statement
-        sqlite3_stmt* m_insertSingletonStatement;
+        /// Writer of the singletons
+        std::unique_ptr<SQLiteBatchWriter> m_writer;
     };
 
     Ptr<SQLiteOutput> m_sqliteOut; //!< Database
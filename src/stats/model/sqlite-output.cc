@@ -39,6 +39,23 @@ SQLiteOutput::SetJournalInMemory()
     SpinExec("PRAGMA journal_mode = MEMORY");
 }
 
+void
+SQLiteOutput::SetWriteAheadLog()
+{
+    NS_LOG_FUNCTION(this);
+    // The journal_mode pragma returns the new mode as a row: step it to
+    // completion, as a statement left in progress would keep the commits busy
+    sqlite3_stmt* stmt;
+    if (SpinPrepare(&stmt, "PRAGMA journal_mode = WAL"))
+    {
+        while (SpinStep(stmt) == SQLITE_ROW)
+        {
+        }
+        SpinFinalize(stmt);
+    }
+    SpinExec("PRAGMA synchronous = NORMAL");
+}
+
 bool
 SQLiteOutput::SpinExec(const std::string& cmd) const
 {
@@ -77,6 +94,38 @@ SQLiteOutput::SpinPrepare(sqlite3_stmt** stmt, const std::string& cmd) const
     return (SpinPrepare(m_db, stmt, cmd) == SQLITE_OK);
 }
 
+bool
+SQLiteOutput::WaitExecBatch(sqlite3_stmt* stmt,
+                            std::size_t rows,
+                            const std::function<bool(sqlite3_stmt*, std::size_t)>& bind) const
+{
+    std::unique_lock lock{m_mutex};
+
+    int rc = SpinExec(m_db, "BEGIN");
+    if (CheckError(m_db, rc, "BEGIN", false))
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        SpinReset(stmt);
+        if (!bind(stmt, i))
+        {
+            SpinExec(m_db, "ROLLBACK");
+            return false;
+        }
+        rc = SpinStep(stmt);
+        if (CheckError(m_db, rc, "", false))
+        {
+            SpinExec(m_db, "ROLLBACK");
+            return false;
+        }
+    }
+    SpinReset(stmt);
+    rc = SpinExec(m_db, "COMMIT");
+    return !CheckError(m_db, rc, "COMMIT", false);
+}
+
 template <typename T>
 T
 SQLiteOutput::RetrieveColumn(sqlite3_stmt* /* stmt */, int /* pos */) const
@@ -9,6 +9,7 @@
 
 #include "ns3/simple-ref-count.h"
 
+#include <functional>
 #include <mutex>
 #include <sqlite3.h>
 #include <string>
@@ -52,6 +53,12 @@ class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
      */
     void SetJournalInMemory();
 
+    /**
+     * @brief Instruct SQLite to use a write-ahead log, which is synchronized
+     * to disk only at checkpoints rather than at each commit.
+     */
+    void SetWriteAheadLog();
+
     /**
      * @brief Execute a command until the return value is OK or an ERROR
      *
@@ -99,6 +106,23 @@ class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
      */
     bool SpinPrepare(sqlite3_stmt** stmt, const std::string& cmd) const;
 
+    /**
+     * @brief Execute a prepared statement once per row, in a single transaction,
+     * waiting on a mutex
+     *
+     * The statement is reset before each row, and is not finalized, so that
+     * it can be used for the next batch.  The transaction is rolled back on
+     * the first error.
+     *
+     * @param stmt Sqlite statement
+     * @param rows Number of rows
+     * @param bind Function binding the values of a row, given its index, to the statement
+     * @return true in case of success
+     */
+    bool WaitExecBatch(sqlite3_stmt* stmt,
+                       std::size_t rows,
+                       const std::function<bool(sqlite3_stmt*, std::size_t)>& bind) const;
+
     /**
      * @brief Bind a value to a sqlite statement
      * @param stmt Sqlite statement
@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/file-aggregator.h"
+#include "ns3/test.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief Test the COLUMNAR file type of the FileAggregator
+ */
+class FileAggregatorColumnarTestCase : public TestCase
+{
+  public:
+    FileAggregatorColumnarTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read a 32-bit number from the file contents.
+     * @param [in,out] offset The offset of the number, moved past it.
+     * @returns The number.
+     */
+    uint32_t ReadUint32(std::size_t& offset) const;
+
+    /**
+     * Read a double from the file contents.
+     * @param [in,out] offset The offset of the double, moved past it.
+     * @returns The double.
+     */
+    double ReadDouble(std::size_t& offset) const;
+
+    std::string m_contents; //!< The contents of the file.
+};
+
+FileAggregatorColumnarTestCase::FileAggregatorColumnarTestCase()
+    : TestCase("Write time series in binary columns")
+{
+}
+
+uint32_t
+FileAggregatorColumnarTestCase::ReadUint32(std::size_t& offset) const
+{
+    uint32_t value = 0;
+    std::memcpy(&value, m_contents.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+}
+
+double
+FileAggregatorColumnarTestCase::ReadDouble(std::size_t& offset) const
+{
+    double value = 0;
+    std::memcpy(&value, m_contents.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+}
+
+void
+FileAggregatorColumnarTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("file-aggregator-columnar.bin");
+    const uint32_t nRows = 5000;
+    {
+        Ptr<FileAggregator> aggregator =
+            CreateObject<FileAggregator>(fileName, FileAggregator::COLUMNAR);
+        aggregator->SetHeading("Time Value");
+        aggregator->Enable();
+        for (uint32_t i = 0; i < nRows; ++i)
+        {
+            aggregator->Write2d("context", i * 0.5, i * 2.0);
+        }
+        aggregator->Write3d("context", 1, 2, 3);
+    }
+
+    std::ifstream file(fileName, std::ios::binary);
+    m_contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    NS_TEST_ASSERT_MSG_EQ(m_contents.compare(0, 8, std::string("NS3COLS\0", 8)),
+                          0,
+                          "Wrong magic number");
+    std::size_t offset = 8;
+    uint32_t headingLength = ReadUint32(offset);
+    NS_TEST_ASSERT_MSG_EQ(m_contents.substr(offset, headingLength), "Time Value", "Wrong heading");
+    offset += headingLength;
+
+    // The 2D values are split in a full block and the rest of the rows
+    uint32_t row = 0;
+    for (uint32_t expectedRows : {4096U, nRows - 4096})
+    {
+        NS_TEST_ASSERT_MSG_EQ(ReadUint32(offset), 2, "Wrong number of columns");
+        NS_TEST_ASSERT_MSG_EQ(ReadUint32(offset), expectedRows, "Wrong number of rows");
+        for (uint32_t i = 0; i < expectedRows; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(ReadDouble(offset), (row + i) * 0.5, "Wrong first column");
+        }
+        for (uint32_t i = 0; i < expectedRows; ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(ReadDouble(offset), (row + i) * 2.0, "Wrong second column");
+        }
+        row += expectedRows;
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(ReadUint32(offset), 3, "Wrong number of columns");
+    NS_TEST_ASSERT_MSG_EQ(ReadUint32(offset), 1, "Wrong number of rows");
+    for (double expected : {1.0, 2.0, 3.0})
+    {
+        NS_TEST_EXPECT_MSG_EQ(ReadDouble(offset), expected, "Wrong 3D value");
+    }
+    NS_TEST_EXPECT_MSG_EQ(offset, m_contents.size(), "Unexpected data at the end of the file");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief FileAggregator TestSuite
+ */
+class FileAggregatorTestSuite : public TestSuite
+{
+  public:
+    FileAggregatorTestSuite();
+};
+
+FileAggregatorTestSuite::FileAggregatorTestSuite()
+    : TestSuite("file-aggregator", Type::UNIT)
+{
+    AddTestCase(new FileAggregatorColumnarTestCase, TestCase::Duration::QUICK);
+}
+
+static FileAggregatorTestSuite g_fileAggregatorTestSuite; //!< Static variable for test init
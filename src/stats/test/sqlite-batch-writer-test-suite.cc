@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/sqlite-batch-writer.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief Test that the SQLiteBatchWriter writes all its rows
+ */
+class SQLiteBatchWriterTestCase : public TestCase
+{
+  public:
+    SQLiteBatchWriterTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SQLiteBatchWriterTestCase::SQLiteBatchWriterTestCase()
+    : TestCase("Write rows in batches from a background thread")
+{
+}
+
+void
+SQLiteBatchWriterTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("sqlite-batch-writer.db");
+    std::remove(fileName.c_str());
+    Ptr<SQLiteOutput> db = Create<SQLiteOutput>(fileName);
+    db->SetWriteAheadLog();
+    bool ret = db->WaitExec("CREATE TABLE Samples (id INTEGER, value REAL, name TEXT)");
+    NS_TEST_ASSERT_MSG_EQ(ret, true, "Cannot create the table");
+
+    const uint32_t nRows = 10007;
+    {
+        SQLiteBatchWriter writer(db, "INSERT INTO Samples VALUES (?, ?, ?)", 100, 2);
+        for (uint32_t i = 0; i < nRows; ++i)
+        {
+            writer.AddRow({static_cast<int64_t>(i), i * 0.25, "sample-" + std::to_string(i)});
+        }
+        NS_TEST_EXPECT_MSG_EQ(writer.Flush(), true, "Failed to write the rows");
+        NS_TEST_EXPECT_MSG_EQ(writer.GetNRowsWritten(), nRows, "Wrong number of rows written");
+        writer.AddRow({static_cast<int64_t>(nRows), 0.0, "last"});
+    }
+
+    sqlite3_stmt* stmt;
+    ret = db->WaitPrepare(&stmt, "SELECT COUNT(*), SUM(id), SUM(value) FROM Samples");
+    NS_TEST_ASSERT_MSG_EQ(ret, true, "Cannot prepare the query");
+    NS_TEST_ASSERT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "No result");
+    NS_TEST_EXPECT_MSG_EQ(db->RetrieveColumn<int>(stmt, 0), nRows + 1, "Wrong row count");
+    NS_TEST_EXPECT_MSG_EQ(db->RetrieveColumn<int>(stmt, 1),
+                          nRows * (nRows + 1) / 2,
+                          "Wrong sum of ids");
+    NS_TEST_EXPECT_MSG_EQ_TOL(db->RetrieveColumn<double>(stmt, 2),
+                              0.25 * nRows * (nRows - 1) / 2,
+                              1e-6,
+                              "Wrong sum of values");
+    SQLiteOutput::SpinFinalize(stmt);
+
+    ret = db->WaitPrepare(&stmt, "SELECT name FROM Samples WHERE id = 42");
+    NS_TEST_ASSERT_MSG_EQ(ret, true, "Cannot prepare the query");
+    NS_TEST_ASSERT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "No result");
+    std::string name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    NS_TEST_EXPECT_MSG_EQ(name, "sample-42", "Wrong text value");
+    SQLiteOutput::SpinFinalize(stmt);
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief SQLiteBatchWriter TestSuite
+ */
+class SQLiteBatchWriterTestSuite : public TestSuite
+{
+  public:
+    SQLiteBatchWriterTestSuite();
+};
+
+SQLiteBatchWriterTestSuite::SQLiteBatchWriterTestSuite()
+    : TestSuite("sqlite-batch-writer", Type::UNIT)
+{
+    AddTestCase(new SQLiteBatchWriterTestCase, TestCase::Duration::QUICK);
+}
+
+static SQLiteBatchWriterTestSuite g_sqliteBatchWriterTestSuite; //!< Static variable for test init
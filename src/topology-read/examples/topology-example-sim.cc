@@ -104,40 +104,13 @@ main(int argc, char* argv[])
     stack.SetRoutingHelper(nixRouting); // has effect on the next Install ()
     stack.Install(nodes);
 
-    NS_LOG_INFO("creating IPv4 addresses");
-    Ipv4AddressHelper address;
-    address.SetBase("10.0.0.0", "255.255.255.252");
-
-    int totlinks = inFile->LinksSize();
-
-    NS_LOG_INFO("creating node containers");
-    auto nc = new NodeContainer[totlinks];
-    TopologyReader::ConstLinksIterator iter;
-    int i = 0;
-    for (iter = inFile->LinksBegin(); iter != inFile->LinksEnd(); iter++, i++)
-    {
-        nc[i] = NodeContainer(iter->GetFromNode(), iter->GetToNode());
-    }
-
-    NS_LOG_INFO("creating net device containers");
-    auto ndc = new NetDeviceContainer[totlinks];
-    PointToPointHelper p2p;
-    for (int i = 0; i < totlinks; i++)
-    {
-        // p2p.SetChannelAttribute ("Delay", TimeValue(MilliSeconds(weight[i])));
-        p2p.SetChannelAttribute("Delay", StringValue("2ms"));
-        p2p.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
-        ndc[i] = p2p.Install(nc[i]);
-    }
-
-    // it crates little subnets, one for each couple of nodes.
-    NS_LOG_INFO("creating IPv4 interfaces");
-    auto ipic = new Ipv4InterfaceContainer[totlinks];
-    for (int i = 0; i < totlinks; i++)
-    {
-        ipic[i] = address.Assign(ndc[i]);
-        address.NewNetwork();
-    }
+    // it creates little subnets, one for each couple of nodes.
+    NS_LOG_INFO("creating links and IPv4 interfaces");
+    TopologyBuilderHelper builder;
+    builder.SetBase("10.0.0.0", "255.255.255.252");
+    builder.SetChannelAttribute("Delay", StringValue("2ms"));
+    builder.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    builder.Install(inFile);
 
     uint32_t totalNodes = nodes.GetN();
     Ptr<UniformRandomVariable> unifRandom = CreateObject<UniformRandomVariable>();
@@ -191,10 +164,6 @@ main(int argc, char* argv[])
     Simulator::Run();
     Simulator::Destroy();
 
-    delete[] ipic;
-    delete[] ndc;
-    delete[] nc;
-
     NS_LOG_INFO("Done.");
 
     return 0;
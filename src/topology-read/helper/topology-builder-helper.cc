@@ -0,0 +1,156 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "topology-builder-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4.h"
+#include "ns3/log.h"
+#include "ns3/mac48-address.h"
+#include "ns3/net-device-container.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/queue.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::TopologyBuilderHelper implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TopologyBuilderHelper");
+
+TopologyBuilderHelper::TopologyBuilderHelper()
+    : m_network(Ipv4Address("10.0.0.0").Get()),
+      m_mask("255.255.255.252")
+{
+    m_queueFactory.SetTypeId("ns3::DropTailQueue<Packet>");
+    m_deviceFactory.SetTypeId("ns3::PointToPointNetDevice");
+    m_channelFactory.SetTypeId("ns3::PointToPointChannel");
+}
+
+void
+TopologyBuilderHelper::SetDeviceAttribute(std::string name, const AttributeValue& value)
+{
+    m_deviceFactory.Set(name, value);
+}
+
+void
+TopologyBuilderHelper::SetChannelAttribute(std::string name, const AttributeValue& value)
+{
+    m_channelFactory.Set(name, value);
+}
+
+void
+TopologyBuilderHelper::SetBase(Ipv4Address network, Ipv4Mask mask)
+{
+    NS_LOG_FUNCTION(this << network << mask);
+    NS_ABORT_MSG_UNLESS(mask.GetPrefixLength() <= 30,
+                        "TopologyBuilderHelper::SetBase(): The subnets need two hosts");
+    NS_ABORT_MSG_UNLESS(network.CombineMask(mask) == network,
+                        "TopologyBuilderHelper::SetBase(): Network " << network
+                                                                     << " does not match mask "
+                                                                     << mask);
+    m_network = network.Get();
+    m_mask = mask;
+}
+
+Ipv4InterfaceContainer
+TopologyBuilderHelper::Install(Ptr<const TopologyReader> reader)
+{
+    NS_LOG_FUNCTION(this << reader);
+
+    uint32_t nLinks = reader->LinksSize();
+    Ipv4InterfaceContainer interfaces;
+    if (nLinks == 0)
+    {
+        return interfaces;
+    }
+
+    //
+    // Reserve the subnets of all the links at once
+    //
+    uint64_t subnetSize = static_cast<uint64_t>(~m_mask.Get()) + 1;
+    uint64_t last = m_network + subnetSize * nLinks - 1;
+    NS_ABORT_MSG_IF(last > 0xffffffff, "TopologyBuilderHelper::Install(): Address overflow");
+    Ipv4AddressGenerator::AddAllocatedRange(Ipv4Address(m_network),
+                                            Ipv4Address(static_cast<uint32_t>(last)));
+    uint32_t network = m_network;
+    m_network = static_cast<uint32_t>(last + 1);
+
+    //
+    // Create the devices and the channels of all the links
+    //
+    std::vector<Ptr<PointToPointNetDevice>> devices;
+    devices.reserve(2 * nLinks);
+    for (auto link = reader->LinksBegin(); link != reader->LinksEnd(); link++)
+    {
+        Ptr<PointToPointChannel> channel = m_channelFactory.Create<PointToPointChannel>();
+        for (Ptr<Node> node : {link->GetFromNode(), link->GetToNode()})
+        {
+            Ptr<PointToPointNetDevice> device = m_deviceFactory.Create<PointToPointNetDevice>();
+            device->SetAddress(Mac48Address::Allocate());
+            node->AddDevice(device);
+            Ptr<Queue<Packet>> queue = m_queueFactory.Create<Queue<Packet>>();
+            device->SetQueue(queue);
+            Ptr<NetDeviceQueueInterface> ndqi = CreateObject<NetDeviceQueueInterface>();
+            ndqi->GetTxQueue(0)->ConnectQueueTraces(queue);
+            device->AggregateObject(ndqi);
+            device->Attach(channel);
+            devices.push_back(device);
+        }
+    }
+
+    //
+    // Assign the addresses: the devices of the i-th link get the first two
+    // addresses of the i-th subnet
+    //
+    NetDeviceContainer tcDevices;
+    for (uint32_t i = 0; i < devices.size(); i++)
+    {
+        Ptr<Node> node = devices[i]->GetNode();
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        NS_ASSERT_MSG(ipv4,
+                      "TopologyBuilderHelper::Install(): Node "
+                          << node->GetId()
+                          << " has no IPv4 stack installed "
+                             "(maybe need to use InternetStackHelper?)");
+
+        Ipv4Address address(network + static_cast<uint32_t>(subnetSize * (i / 2)) + 1 + i % 2);
+        int32_t interface = ipv4->AddInterface(devices[i]);
+        ipv4->AddAddress(interface, Ipv4InterfaceAddress(address, m_mask));
+        ipv4->SetMetric(interface, 1);
+        ipv4->SetUp(interface);
+        interfaces.Add(ipv4, interface);
+
+        if (node->GetObject<TrafficControlLayer>())
+        {
+            tcDevices.Add(devices[i]);
+        }
+    }
+
+    //
+    // Install the default traffic control configuration, as Ipv4AddressHelper
+    // does, on all the devices at once
+    //
+    if (tcDevices.GetN() > 0)
+    {
+        TrafficControlHelper tcHelper = TrafficControlHelper::Default(1);
+        tcHelper.Install(tcDevices);
+    }
+
+    NS_LOG_INFO("Built " << nLinks << " links");
+    return interfaces;
+}
+
+} // namespace ns3
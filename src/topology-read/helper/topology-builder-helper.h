@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TOPOLOGY_BUILDER_HELPER_H
+#define TOPOLOGY_BUILDER_HELPER_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-interface-container.h"
+#include "ns3/object-factory.h"
+#include "ns3/topology-reader.h"
+
+#include <string>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::TopologyBuilderHelper declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup topology
+ *
+ * @brief Helper class which builds the links read by a TopologyReader.
+ *
+ * Each link of the topology is built as a point-to-point link, with a
+ * PointToPointNetDevice on each node, and gets its own IPv4 subnet.  The
+ * result is the same as installing the links one by one with
+ * PointToPointHelper and assigning their addresses with Ipv4AddressHelper,
+ * calling Ipv4AddressHelper::NewNetwork() after each link, but the links are
+ * built in batches: the devices and the channels of all the links are
+ * created first, then all the subnets are reserved in the
+ * Ipv4AddressGenerator at once, as a single range, and the addresses are
+ * computed from the index of the link instead of being allocated one at a
+ * time.  This avoids the cost of the address collision detection, which
+ * grows with the number of subnets, on topologies with many links.
+ *
+ * The nodes must have an IPv4 stack installed, e.g., with
+ * InternetStackHelper.  The default traffic control configuration is
+ * installed on the devices of the nodes with a traffic control layer, as
+ * Ipv4AddressHelper does.  Distributed simulations are not supported: the
+ * links are always built with a PointToPointChannel.
+ */
+class TopologyBuilderHelper
+{
+  public:
+    TopologyBuilderHelper();
+
+    /**
+     * @brief Sets an attribute of the PointToPointNetDevice created for
+     * each end of the links.
+     * @param [in] name The name of the attribute to set.
+     * @param [in] value The value of the attribute to set.
+     */
+    void SetDeviceAttribute(std::string name, const AttributeValue& value);
+
+    /**
+     * @brief Sets an attribute of the PointToPointChannel created for each
+     * link.
+     * @param [in] name The name of the attribute to set.
+     * @param [in] value The value of the attribute to set.
+     */
+    void SetChannelAttribute(std::string name, const AttributeValue& value);
+
+    /**
+     * @brief Sets the first subnet and the mask of the subnets of the links.
+     *
+     * The links get consecutive subnets, starting from the given one.  The
+     * default is 10.0.0.0/30.
+     *
+     * @param [in] network The first subnet.
+     * @param [in] mask The mask of the subnets, which must leave room for
+     *             two hosts.
+     */
+    void SetBase(Ipv4Address network, Ipv4Mask mask);
+
+    /**
+     * @brief Builds the links read by a topology reader.
+     *
+     * The subnets following the ones assigned are used by the next call.
+     *
+     * @param [in] reader The topology reader, whose Read() method has been
+     *             called.
+     * @return The interfaces created, two per link in the order of the
+     *         links: the one of the "from" node, then the one of the "to"
+     *         node.
+     */
+    Ipv4InterfaceContainer Install(Ptr<const TopologyReader> reader);
+
+  private:
+    ObjectFactory m_queueFactory;   //!< Queue Factory
+    ObjectFactory m_channelFactory; //!< Channel Factory
+    ObjectFactory m_deviceFactory;  //!< Device Factory
+    uint32_t m_network;             //!< Next subnet to assign
+    Ipv4Mask m_mask;                //!< Mask of the subnets
+};
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_BUILDER_HELPER_H */
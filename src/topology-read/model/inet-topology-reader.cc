@@ -13,9 +13,9 @@
 #include "ns3/names.h"
 #include "ns3/node-container.h"
 
-#include <cstdlib>
-#include <fstream>
-#include <sstream>
+#include <charconv>
+#include <string>
+#include <unordered_map>
 
 /**
  * @file
@@ -52,93 +52,87 @@ InetTopologyReader::~InetTopologyReader()
 NodeContainer
 InetTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
-    std::map<std::string, Ptr<Node>> nodeMap;
+    std::unordered_map<std::string, Ptr<Node>> nodeMap;
     NodeContainer nodes;
 
-    if (!topgen.is_open())
-    {
-        NS_LOG_WARN("Inet topology file object is not open, check file name and permissions");
-        return nodes;
-    }
-
-    std::string from;
-    std::string to;
-    std::string linkAttr;
-
     int linksNumber = 0;
     int nodesNumber = 0;
 
     int totnode = 0;
     int totlink = 0;
+    int lineNumber = 0;
 
-    std::istringstream lineBuffer;
-    std::string line;
-
-    getline(topgen, line);
-    lineBuffer.str(line);
-
-    lineBuffer >> totnode;
-    lineBuffer >> totlink;
-    NS_LOG_INFO("Inet topology should have " << totnode << " nodes and " << totlink << " links");
-
-    for (int i = 0; i < totnode && !topgen.eof(); i++)
-    {
-        getline(topgen, line);
-    }
-
-    for (int i = 0; i < totlink && !topgen.eof(); i++)
-    {
-        getline(topgen, line);
-        lineBuffer.clear();
-        lineBuffer.str(line);
+    bool opened = ForEachLine([&](std::string_view line) {
+        lineNumber++;
+        if (lineNumber == 1)
+        {
+            std::string_view nodesToken = NextToken(line);
+            std::string_view linksToken = NextToken(line);
+            std::from_chars(nodesToken.data(), nodesToken.data() + nodesToken.size(), totnode);
+            std::from_chars(linksToken.data(), linksToken.data() + linksToken.size(), totlink);
+            NS_LOG_INFO("Inet topology should have " << totnode << " nodes and " << totlink
+                                                     << " links");
+            return true;
+        }
+        if (lineNumber <= 1 + totnode)
+        {
+            return true;
+        }
+        if (lineNumber > 1 + totnode + totlink)
+        {
+            return false;
+        }
 
-        lineBuffer >> from;
-        lineBuffer >> to;
-        lineBuffer >> linkAttr;
+        std::string from(NextToken(line));
+        std::string to(NextToken(line));
+        std::string_view linkAttr = NextToken(line);
 
         if ((!from.empty()) && (!to.empty()))
         {
             NS_LOG_INFO("Link " << linksNumber << " from: " << from << " to: " << to);
 
-            if (!nodeMap[from])
+            Ptr<Node>& fromNode = nodeMap[from];
+            if (!fromNode)
             {
                 NS_LOG_INFO("Node " << nodesNumber << " name: " << from);
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodeName = "InetTopology/NodeName/" + from;
-                Names::Add(from, tmpNode);
-                nodeMap[from] = tmpNode;
-                nodes.Add(tmpNode);
+                fromNode = CreateObject<Node>();
+                Names::Add(from, fromNode);
+                nodes.Add(fromNode);
                 nodesNumber++;
             }
 
-            if (!nodeMap[to])
+            Ptr<Node>& toNode = nodeMap[to];
+            if (!toNode)
             {
                 NS_LOG_INFO("Node " << nodesNumber << " name: " << to);
-                Ptr<Node> tmpNode = CreateObject<Node>();
+                toNode = CreateObject<Node>();
                 std::string nodename = "InetTopology/NodeName/" + to;
-                Names::Add(nodename, tmpNode);
-                nodeMap[to] = tmpNode;
-                nodes.Add(tmpNode);
+                Names::Add(nodename, toNode);
+                nodes.Add(toNode);
                 nodesNumber++;
             }
 
-            Link link(nodeMap[from], from, nodeMap[to], to);
+            Link link(fromNode, from, toNode, to);
             if (!linkAttr.empty())
             {
                 NS_LOG_INFO("Link " << linksNumber << " weight: " << linkAttr);
-                link.SetAttribute("Weight", linkAttr);
+                link.SetAttribute("Weight", std::string(linkAttr));
             }
             AddLink(link);
 
             linksNumber++;
         }
+        return true;
+    });
+
+    if (!opened)
+    {
+        NS_LOG_WARN("Inet topology file object is not open, check file name and permissions");
+        return nodes;
     }
 
     NS_LOG_INFO("Inet topology created with " << nodesNumber << " nodes and " << linksNumber
                                               << " links");
-    topgen.close();
 
     return nodes;
 }
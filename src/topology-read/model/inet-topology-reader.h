@@ -56,7 +56,7 @@ class InetTopologyReader : public TopologyReader
     /**
      * @brief Main topology reading function.
      *
-     * This method opens an input stream and reads the Inet-format file.
+     * This method reads the Inet-format file.
      * From the first line it takes the total number of nodes and links.
      * Then discards a number of rows equals to total nodes (containing
      * useless geographical information).
@@ -13,9 +13,8 @@
 #include "ns3/names.h"
 #include "ns3/node-container.h"
 
-#include <cstdlib>
-#include <fstream>
-#include <sstream>
+#include <string>
+#include <unordered_map>
 
 /**
  * @file
@@ -53,68 +52,54 @@ OrbisTopologyReader::~OrbisTopologyReader()
 NodeContainer
 OrbisTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
-    std::map<std::string, Ptr<Node>> nodeMap;
+    std::unordered_map<std::string, Ptr<Node>> nodeMap;
     NodeContainer nodes;
 
-    if (!topgen.is_open())
-    {
-        return nodes;
-    }
-
-    std::string from;
-    std::string to;
-    std::istringstream lineBuffer;
-    std::string line;
-
     int linksNumber = 0;
     int nodesNumber = 0;
 
-    while (!topgen.eof())
-    {
-        line.clear();
-        lineBuffer.clear();
-        from.clear();
-        to.clear();
-
-        getline(topgen, line);
-        lineBuffer.str(line);
-        lineBuffer >> from;
-        lineBuffer >> to;
+    bool opened = ForEachLine([&](std::string_view line) {
+        std::string from(NextToken(line));
+        std::string to(NextToken(line));
 
         if ((!from.empty()) && (!to.empty()))
         {
             NS_LOG_INFO(linksNumber << " From: " << from << " to: " << to);
-            if (!nodeMap[from])
+            Ptr<Node>& fromNode = nodeMap[from];
+            if (!fromNode)
             {
-                Ptr<Node> tmpNode = CreateObject<Node>();
+                fromNode = CreateObject<Node>();
                 std::string nodename = "OrbisTopology/NodeName/" + from;
-                Names::Add(nodename, tmpNode);
-                nodeMap[from] = tmpNode;
-                nodes.Add(tmpNode);
+                Names::Add(nodename, fromNode);
+                nodes.Add(fromNode);
                 nodesNumber++;
             }
 
-            if (!nodeMap[to])
+            Ptr<Node>& toNode = nodeMap[to];
+            if (!toNode)
             {
-                Ptr<Node> tmpNode = CreateObject<Node>();
+                toNode = CreateObject<Node>();
                 std::string nodename = "OrbisTopology/NodeName/" + to;
-                Names::Add(nodename, tmpNode);
-                nodeMap[to] = tmpNode;
-                nodes.Add(tmpNode);
+                Names::Add(nodename, toNode);
+                nodes.Add(toNode);
                 nodesNumber++;
             }
 
-            Link link(nodeMap[from], from, nodeMap[to], to);
+            Link link(fromNode, from, toNode, to);
             AddLink(link);
 
             linksNumber++;
         }
+        return true;
+    });
+
+    if (!opened)
+    {
+        return nodes;
     }
+
     NS_LOG_INFO("Orbis topology created with " << nodesNumber << " nodes and " << linksNumber
                                                << " links");
-    topgen.close();
 
     return nodes;
 }
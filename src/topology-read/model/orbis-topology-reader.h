@@ -53,7 +53,7 @@ class OrbisTopologyReader : public TopologyReader
     /**
      * @brief Main topology reading function.
      *
-     * This method opens an input stream and reads the Orbis-format file.
+     * This method reads the Orbis-format file.
      * Every row represents a topology link (the ids of a couple of nodes),
      * so the input file is read line by line to figure out how many links
      * and nodes are in the topology.
@@ -12,10 +12,9 @@
 #include "ns3/names.h"
 #include "ns3/node-container.h"
 
+#include <algorithm>
 #include <cstdlib>
-#include <fstream>
-#include <iostream>
-#include <regex>
+#include <iterator>
 #include <string>
 
 /**
@@ -55,35 +54,245 @@ RocketfuelTopologyReader::~RocketfuelTopologyReader()
 
 /* uid @loc [+] [bb] (num_neigh) [&ext] -> <nuid-1> <nuid-2> ... {-euid} ... =name[!] rn */
 
-/// Start of a line
-#define START "^"
-/// End of a line
-#define END "$"
-/// One or more spaces
-#define SPACE "[ \t]+"
-/// Zero or more spaces
-#define MAYSPACE "[ \t]*"
+/**
+ * @brief Checks whether a character is a field separator.
+ * @param c the character
+ * @return true if the character is a space or a tab
+ */
+static inline bool
+IsSpace(char c)
+{
+    return c == ' ' || c == '\t';
+}
 
-/// Regex expression matching a MAP line
-#define ROCKETFUEL_MAPS_LINE                                                                       \
-    START "(-*[0-9]+)" SPACE "(@[?A-Za-z0-9,+-]+)" SPACE "(\\+)*" MAYSPACE "(bb)*" MAYSPACE        \
-          "\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE "->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE   \
-          "(\\{-[0-9\\{\\} \t-]+\\})*" SPACE "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" MAYSPACE END
+/**
+ * @brief Checks whether a character is a decimal digit.
+ * @param c the character
+ * @return true if the character is a digit
+ */
+static inline bool
+IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
 
-/// Regex expression matching a WEIGHT line
-#define ROCKETFUEL_WEIGHTS_LINE START "([^ \t]+)" SPACE "([^ \t]+)" SPACE "([0-9.]+)" MAYSPACE END
+/**
+ * @brief Skips the characters of a set.
+ * @param line the line
+ * @param pos the position of the first character, updated to the first
+ *        character not in the set
+ * @param inSet the predicate defining the set
+ * @return the number of characters skipped
+ */
+template <typename Predicate>
+static inline std::size_t
+Skip(std::string_view line, std::size_t& pos, Predicate inSet)
+{
+    std::size_t start = pos;
+    while (pos < line.size() && inSet(line[pos]))
+    {
+        pos++;
+    }
+    return pos - start;
+}
 
 /**
- * Build a Regex object for RocketFuel topology maps file type
- * @return a static regex object for maps file type
+ * @brief Splits a line of a MAP file into its fields.
+ *
+ * The line is checked against the format
+ * uid \@loc [+] [bb] (num_neigh) [&ext] -> <nuid-1> <nuid-2> ... {-euid} ... =name[!] rn
+ * with a single pass over its characters.
+ *
+ * @param line the line
+ * @param argv the fields: uid, location, "+", "bb", number of neighbors,
+ *        externals count, list of neighbors, list of externals, name and
+ *        radius, empty when an optional field is missing
+ * @return true if the line is in the MAP file format
  */
-static const std::regex rocketfuel_maps_regex(ROCKETFUEL_MAPS_LINE);
+static bool
+SplitMapsLine(std::string_view line, std::vector<std::string>& argv)
+{
+    argv.assign(10, std::string());
+    std::size_t pos = 0;
+    std::size_t start;
+    auto field = [&](std::size_t index) { argv[index].assign(line.substr(start, pos - start)); };
+
+    // uid
+    start = pos;
+    Skip(line, pos, [](char c) { return c == '-'; });
+    if (Skip(line, pos, IsDigit) == 0)
+    {
+        return false;
+    }
+    field(0);
+    if (Skip(line, pos, IsSpace) == 0)
+    {
+        return false;
+    }
+
+    // @loc
+    start = pos;
+    if (pos == line.size() || line[pos] != '@')
+    {
+        return false;
+    }
+    pos++;
+    if (Skip(line, pos, [](char c) {
+            return IsDigit(c) || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '?' ||
+                   c == ',' || c == '+' || c == '-';
+        }) == 0)
+    {
+        return false;
+    }
+    field(1);
+    if (Skip(line, pos, IsSpace) == 0)
+    {
+        return false;
+    }
+
+    // [+] [bb]
+    if (Skip(line, pos, [](char c) { return c == '+'; }) > 0)
+    {
+        argv[2] = "+";
+    }
+    Skip(line, pos, IsSpace);
+    while (line.substr(pos, 2) == "bb")
+    {
+        argv[3] = "bb";
+        pos += 2;
+    }
+    Skip(line, pos, IsSpace);
+
+    // (num_neigh)
+    if (pos == line.size() || line[pos] != '(')
+    {
+        return false;
+    }
+    start = ++pos;
+    if (Skip(line, pos, IsDigit) == 0 || pos == line.size() || line[pos] != ')')
+    {
+        return false;
+    }
+    field(4);
+    pos++;
+    if (Skip(line, pos, IsSpace) == 0)
+    {
+        return false;
+    }
+
+    // [&ext]
+    while (pos < line.size() && line[pos] == '&')
+    {
+        start = pos++;
+        if (Skip(line, pos, IsDigit) == 0)
+        {
+            return false;
+        }
+        field(5);
+    }
+    Skip(line, pos, IsSpace);
+
+    // ->
+    if (line.substr(pos, 2) != "->")
+    {
+        return false;
+    }
+    pos += 2;
+    Skip(line, pos, IsSpace);
+
+    // <nuid-1> <nuid-2> ...
+    if (pos < line.size() && line[pos] == '<')
+    {
+        start = pos;
+        Skip(line, pos, [](char c) { return IsDigit(c) || IsSpace(c) || c == '<' || c == '>'; });
+        pos = line.find_last_of('>', pos - 1) + 1;
+        if (pos < start + 3)
+        {
+            return false;
+        }
+        field(6);
+    }
+    Skip(line, pos, IsSpace);
+
+    // {-euid} ...
+    if (line.substr(pos, 2) == "{-")
+    {
+        start = pos;
+        Skip(line, pos, [](char c) {
+            return IsDigit(c) || IsSpace(c) || c == '{' || c == '}' || c == '-';
+        });
+        pos = line.find_last_of('}', pos - 1) + 1;
+        if (pos < start + 4)
+        {
+            return false;
+        }
+        field(7);
+    }
+    Skip(line, pos, IsSpace);
+
+    // =name[!]
+    if (pos == 0 || pos == line.size() || line[pos] != '=' || !IsSpace(line[pos - 1]))
+    {
+        return false;
+    }
+    start = ++pos;
+    if (Skip(line, pos, [](char c) {
+            return IsDigit(c) || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '.' ||
+                   c == '!' || c == '-';
+        }) == 0)
+    {
+        return false;
+    }
+    field(8);
+    if (Skip(line, pos, IsSpace) == 0)
+    {
+        return false;
+    }
+
+    // rn
+    if (pos + 1 >= line.size() || line[pos] != 'r' || !IsDigit(line[pos + 1]))
+    {
+        return false;
+    }
+    start = pos + 1;
+    pos += 2;
+    field(9);
+    Skip(line, pos, IsSpace);
+    return pos == line.size();
+}
 
 /**
- * Build a Regex object for RocketFuel topology weights file type
- * @return a static regex object for weights file type
+ * @brief Splits a line of a WEIGHTS file into its fields.
+ *
+ * The line is checked against the format "source target weight".
+ *
+ * @param line the line
+ * @param argv the fields: source, target and weight
+ * @return true if the line is in the WEIGHTS file format
  */
-static const std::regex rocketfuel_weights_regex(ROCKETFUEL_WEIGHTS_LINE);
+static bool
+SplitWeightsLine(std::string_view line, std::vector<std::string>& argv)
+{
+    argv.assign(3, std::string());
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < argv.size(); i++)
+    {
+        if (i > 0 && Skip(line, pos, IsSpace) == 0)
+        {
+            return false;
+        }
+        std::size_t start = pos;
+        if (Skip(line, pos, [](char c) { return !IsSpace(c); }) == 0)
+        {
+            return false;
+        }
+        argv[i].assign(line.substr(start, pos - start));
+    }
+    Skip(line, pos, IsSpace);
+    return pos == line.size() && std::all_of(argv[2].begin(), argv[2].end(), [](char c) {
+               return IsDigit(c) || c == '.';
+           });
+}
 
 /**
  * @brief Print node info
@@ -153,20 +362,17 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
     if (!argv[6].empty())
     {
         // Each line contains a list <.*>[ |\t]<.*>[ |\t]<.*>[ |\t]
-        // First remove < and >
+        // First remove < and >, then split the list
         std::string temp;
-        std::regex replace_regex("[<|>]");
-        std::regex_replace(std::back_inserter(temp),
-                           argv[6].begin(),
-                           argv[6].end(),
-                           replace_regex,
-                           "");
-
-        // Then split list
-        std::regex split_regex("[ |\t]");
-        std::sregex_token_iterator first{temp.begin(), temp.end(), split_regex, -1};
-        std::sregex_token_iterator last;
-        neigh_list = std::vector<std::string>{first, last};
+        std::remove_copy_if(argv[6].begin(),
+                            argv[6].end(),
+                            std::back_inserter(temp),
+                            [](char c) { return c == '<' || c == '>'; });
+        std::string_view list(temp);
+        for (auto nuid = NextToken(list); !nuid.empty(); nuid = NextToken(list))
+        {
+            neigh_list.emplace_back(nuid);
+        }
     }
     if (num_neigh != neigh_list.size())
     {
@@ -280,22 +486,13 @@ RocketfuelTopologyReader::GenerateFromWeightsFile(const std::vector<std::string>
         }
         NS_LOG_INFO(m_linksNumber << ":" << m_nodesNumber << " From: " << sname
                                   << " to: " << tname);
-        TopologyReader::ConstLinksIterator iter;
-        bool found = false;
-        for (iter = LinksBegin(); iter != LinksEnd(); iter++)
-        {
-            if ((iter->GetFromNode() == m_nodeMap[tname]) &&
-                (iter->GetToNode() == m_nodeMap[sname]))
-            {
-                found = true;
-                break;
-            }
-        }
+        bool found = m_linkSet.count({m_nodeMap[tname]->GetId(), m_nodeMap[sname]->GetId()}) > 0;
 
         if (!found)
         {
             Link link(m_nodeMap[sname], sname, m_nodeMap[tname], tname);
             AddLink(link);
+            m_linkSet.emplace(m_nodeMap[sname]->GetId(), m_nodeMap[tname]->GetId());
             m_linksNumber++;
         }
     }
@@ -307,17 +504,18 @@ RocketfuelTopologyReader::GenerateFromWeightsFile(const std::vector<std::string>
 }
 
 RocketfuelTopologyReader::RF_FileType
-RocketfuelTopologyReader::GetFileType(const std::string& line)
+RocketfuelTopologyReader::GetFileType(std::string_view line)
 {
+    std::vector<std::string> argv;
+
     // Check whether Maps file or not
-    std::smatch matches;
-    if (std::regex_match(line, matches, rocketfuel_maps_regex))
+    if (SplitMapsLine(line, argv))
     {
         return RF_MAPS;
     }
 
     // Check whether Weights file or not
-    if (std::regex_match(line, matches, rocketfuel_weights_regex))
+    if (SplitWeightsLine(line, argv))
     {
         return RF_WEIGHTS;
     }
@@ -328,30 +526,13 @@ RocketfuelTopologyReader::GetFileType(const std::string& line)
 NodeContainer
 RocketfuelTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
     NodeContainer nodes;
-
-    std::istringstream lineBuffer;
-    std::string line;
     int lineNumber = 0;
     RF_FileType ftype = RF_UNKNOWN;
+    std::vector<std::string> argv;
 
-    if (!topgen.is_open())
-    {
-        NS_LOG_WARN("Couldn't open the file " << GetFileName());
-        return nodes;
-    }
-
-    while (!topgen.eof())
-    {
-        std::vector<std::string> argv;
-
+    bool opened = ForEachLine([&](std::string_view line) {
         lineNumber++;
-        line.clear();
-        lineBuffer.clear();
-
-        getline(topgen, line);
 
         if (lineNumber == 1)
         {
@@ -359,61 +540,35 @@ RocketfuelTopologyReader::Read()
             if (ftype == RF_UNKNOWN)
             {
                 NS_LOG_INFO("Unknown File Format (" << GetFileName() << ")");
-                break;
+                return false;
             }
         }
 
-        std::smatch matches;
-
         if (ftype == RF_MAPS)
         {
-            bool ret = std::regex_match(line, matches, rocketfuel_maps_regex);
-            if (!ret || matches.empty())
+            if (!SplitMapsLine(line, argv))
             {
-                NS_LOG_WARN("match failed (maps file): %s" << line);
-                break;
+                NS_LOG_WARN("match failed (maps file): " << line);
+                return false;
             }
+            nodes.Add(GenerateFromMapsFile(argv));
         }
         else if (ftype == RF_WEIGHTS)
         {
-            bool ret = std::regex_match(line, matches, rocketfuel_weights_regex);
-            if (!ret || matches.empty())
-            {
-                NS_LOG_WARN("match failed (weights file): %s" << line);
-                break;
-            }
-        }
-
-        std::string matched_string;
-
-        for (auto it = matches.begin() + 1; it != matches.end(); it++)
-        {
-            if (it->matched)
-            {
-                matched_string = it->str();
-            }
-            else
+            if (!SplitWeightsLine(line, argv))
             {
-                matched_string = "";
+                NS_LOG_WARN("match failed (weights file): " << line);
+                return false;
             }
-            argv.push_back(matched_string);
-        }
-
-        if (ftype == RF_MAPS)
-        {
-            nodes.Add(GenerateFromMapsFile(argv));
-        }
-        else if (ftype == RF_WEIGHTS)
-        {
             nodes.Add(GenerateFromWeightsFile(argv));
         }
-        else
-        {
-            NS_LOG_WARN("Unsupported file format (only Maps/Weights are supported)");
-        }
-    }
+        return true;
+    });
 
-    topgen.close();
+    if (!opened)
+    {
+        NS_LOG_WARN("Couldn't open the file " << GetFileName());
+    }
 
     return nodes;
 }
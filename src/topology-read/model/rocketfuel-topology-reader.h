@@ -11,6 +11,10 @@
 
 #include "topology-reader.h"
 
+#include <set>
+#include <unordered_map>
+#include <utility>
+
 /**
  * @file
  * @ingroup topology
@@ -52,7 +56,7 @@ class RocketfuelTopologyReader : public TopologyReader
     /**
      * @brief Main topology reading function.
      *
-     * This method opens an input stream and reads the Rocketfuel-format file.
+     * This method reads the Rocketfuel-format file.
      * Every row represents a topology link (the ids of a couple of nodes),
      * so the input file is read line by line to figure out how many links
      * and nodes are in the topology.
@@ -100,11 +104,12 @@ class RocketfuelTopologyReader : public TopologyReader
      * @param buf the first line of the file being read
      * @return The file type (RF_MAPS, RF_WEIGHTS, or RF_UNKNOWN)
      */
-    RF_FileType GetFileType(const std::string& buf);
+    RF_FileType GetFileType(std::string_view buf);
 
-    int m_linksNumber;                          //!< Number of links.
-    int m_nodesNumber;                          //!< Number of nodes.
-    std::map<std::string, Ptr<Node>> m_nodeMap; //!< Map of the nodes (name, node).
+    int m_linksNumber;                                    //!< Number of links.
+    int m_nodesNumber;                                    //!< Number of nodes.
+    std::unordered_map<std::string, Ptr<Node>> m_nodeMap; //!< Map of the nodes (name, node).
+    std::set<std::pair<uint32_t, uint32_t>> m_linkSet;    //!< Links added, by node ids.
 
     // end class RocketfuelTopologyReader
 };
@@ -11,6 +11,16 @@
 
 #include "ns3/log.h"
 
+#include <fstream>
+#include <iterator>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 /**
  * @file
  * @ingroup topology
@@ -86,6 +96,95 @@ TopologyReader::AddLink(Link link)
     m_linksList.push_back(link);
 }
 
+bool
+TopologyReader::ForEachLine(const std::function<bool(std::string_view)>& callback) const
+{
+    NS_LOG_FUNCTION(this << m_fileName);
+
+    std::string_view content;
+    std::string buffer;
+    bool mapped = false;
+
+#ifndef __WIN32__
+    int fd = open(m_fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            content = std::string_view(static_cast<const char*>(data), st.st_size);
+            mapped = true;
+        }
+    }
+    close(fd);
+#endif
+
+    if (!mapped)
+    {
+        // Read the whole file at once instead
+        std::ifstream file(m_fileName, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        content = buffer;
+    }
+
+    std::size_t start = 0;
+    while (start < content.size())
+    {
+        std::size_t end = content.find('\n', start);
+        if (end == std::string_view::npos)
+        {
+            end = content.size();
+        }
+        std::string_view line = content.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        start = end + 1;
+        if (!callback(line))
+        {
+            break;
+        }
+    }
+
+#ifndef __WIN32__
+    if (mapped)
+    {
+        munmap(const_cast<char*>(content.data()), content.size());
+    }
+#endif
+    return true;
+}
+
+std::string_view
+TopologyReader::NextToken(std::string_view& line)
+{
+    std::size_t start = line.find_first_not_of(" \t");
+    if (start == std::string_view::npos)
+    {
+        line = std::string_view();
+        return line;
+    }
+    std::size_t end = line.find_first_of(" \t", start);
+    if (end == std::string_view::npos)
+    {
+        end = line.size();
+    }
+    std::string_view token = line.substr(start, end - start);
+    line.remove_prefix(end);
+    return token;
+}
+
 TopologyReader::Link::Link(Ptr<Node> fromPtr,
                            const std::string& fromName,
                            Ptr<Node> toPtr,
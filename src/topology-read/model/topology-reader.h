@@ -13,9 +13,11 @@
 #include "ns3/node.h"
 #include "ns3/object.h"
 
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
+#include <string_view>
 
 /**
  * @file
@@ -200,6 +202,32 @@ class TopologyReader : public Object
      */
     void AddLink(Link link);
 
+  protected:
+    /**
+     * @brief Calls a function on each line of the input file.
+     *
+     * The file is mapped in memory, where the platform allows it, instead of
+     * being read through a stream, and the lines are passed to the function
+     * without being copied.  The line terminators, including the carriage
+     * return of a CRLF terminator, are not part of the lines.
+     *
+     * @param [in] callback The function called on each line, in order; the
+     *             reading stops when it returns false.
+     * @return False if the input file could not be opened, true otherwise.
+     */
+    bool ForEachLine(const std::function<bool(std::string_view)>& callback) const;
+
+    /**
+     * @brief Extracts the next token of a line.
+     *
+     * The tokens are separated by spaces and tabs.
+     *
+     * @param [in,out] line The rest of the line, from which the token and the
+     *                 leading separators are removed.
+     * @return The token, or an empty string if there are no more tokens.
+     */
+    static std::string_view NextToken(std::string_view& line);
+
   private:
     /**
      * The name of the input file.
@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/inet-topology-reader.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4.h"
+#include "ns3/names.h"
+#include "ns3/node-container.h"
+#include "ns3/orbis-topology-reader.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/queue-disc.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/topology-builder-helper.h"
+#include "ns3/traffic-control-layer.h"
+
+/**
+ * @file
+ * @ingroup topology-test
+ * ns3::TopologyBuilderHelper test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Inet and Orbis Topology Readers Test
+ */
+class TopologyReadersTest : public TestCase
+{
+  public:
+    TopologyReadersTest();
+
+  private:
+    void DoRun() override;
+};
+
+TopologyReadersTest::TopologyReadersTest()
+    : TestCase("TopologyReadersTest")
+{
+}
+
+void
+TopologyReadersTest::DoRun()
+{
+    Ptr<InetTopologyReader> inet = CreateObject<InetTopologyReader>();
+    inet->SetFileName("./src/topology-read/examples/Inet_toposample.txt");
+    NodeContainer nodes = inet->Read();
+    NS_TEST_EXPECT_MSG_EQ(nodes.GetN(), 3037, "Inet nodes");
+    NS_TEST_EXPECT_MSG_EQ(inet->LinksSize(), 4788, "Inet links");
+    NS_TEST_EXPECT_MSG_EQ(inet->LinksBegin()->GetFromNodeName(), "0", "Inet first link");
+    NS_TEST_EXPECT_MSG_EQ(inet->LinksBegin()->GetToNodeName(), "1", "Inet first link");
+    NS_TEST_EXPECT_MSG_EQ(inet->LinksBegin()->GetAttribute("Weight"),
+                          "1973",
+                          "Inet first link weight");
+
+    // The nodes of both topologies would get the same names
+    Names::Clear();
+
+    Ptr<OrbisTopologyReader> orbis = CreateObject<OrbisTopologyReader>();
+    orbis->SetFileName("./src/topology-read/examples/Orbis_toposample.txt");
+    nodes = orbis->Read();
+    NS_TEST_EXPECT_MSG_EQ(nodes.GetN(), 1423, "Orbis nodes");
+    NS_TEST_EXPECT_MSG_EQ(orbis->LinksSize(), 2769, "Orbis links");
+
+    Ptr<OrbisTopologyReader> missing = CreateObject<OrbisTopologyReader>();
+    missing->SetFileName("./src/topology-read/examples/missing.txt");
+    nodes = missing->Read();
+    NS_TEST_EXPECT_MSG_EQ(nodes.GetN(), 0, "Nodes read from a missing file");
+
+    Names::Clear();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Topology Builder Helper Test
+ */
+class TopologyBuilderHelperTest : public TestCase
+{
+  public:
+    TopologyBuilderHelperTest();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+TopologyBuilderHelperTest::TopologyBuilderHelperTest()
+    : TestCase("TopologyBuilderHelperTest")
+{
+}
+
+void
+TopologyBuilderHelperTest::DoTeardown()
+{
+    Ipv4AddressGenerator::Reset();
+    Names::Clear();
+    Simulator::Destroy();
+}
+
+void
+TopologyBuilderHelperTest::DoRun()
+{
+    Ptr<InetTopologyReader> inet = CreateObject<InetTopologyReader>();
+    inet->SetFileName("./src/topology-read/examples/Inet_small_toposample.txt");
+    NodeContainer nodes = inet->Read();
+    NS_TEST_ASSERT_MSG_EQ(inet->LinksSize(), 9, "Inet links");
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    TopologyBuilderHelper builder;
+    builder.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    builder.SetChannelAttribute("Delay", StringValue("2ms"));
+    Ipv4InterfaceContainer interfaces = builder.Install(inet);
+    NS_TEST_ASSERT_MSG_EQ(interfaces.GetN(), 18, "Two interfaces per link");
+
+    uint32_t i = 0;
+    for (auto link = inet->LinksBegin(); link != inet->LinksEnd(); link++, i += 2)
+    {
+        auto [fromIpv4, fromIf] = interfaces.Get(i);
+        auto [toIpv4, toIf] = interfaces.Get(i + 1);
+        NS_TEST_EXPECT_MSG_EQ(fromIpv4, link->GetFromNode()->GetObject<Ipv4>(), "From node");
+        NS_TEST_EXPECT_MSG_EQ(toIpv4, link->GetToNode()->GetObject<Ipv4>(), "To node");
+
+        Ipv4Address network(Ipv4Address("10.0.0.0").Get() + 2 * i);
+        NS_TEST_EXPECT_MSG_EQ(interfaces.GetAddress(i),
+                              Ipv4Address(network.Get() + 1),
+                              "From address");
+        NS_TEST_EXPECT_MSG_EQ(interfaces.GetAddress(i + 1),
+                              Ipv4Address(network.Get() + 2),
+                              "To address");
+        NS_TEST_EXPECT_MSG_EQ(fromIpv4->IsUp(fromIf), true, "From interface down");
+
+        Ptr<NetDevice> fromDev = fromIpv4->GetNetDevice(fromIf);
+        Ptr<NetDevice> toDev = toIpv4->GetNetDevice(toIf);
+        NS_TEST_EXPECT_MSG_EQ(fromDev->GetChannel(), toDev->GetChannel(), "Not the same channel");
+        DataRateValue dataRate;
+        fromDev->GetAttribute("DataRate", dataRate);
+        NS_TEST_EXPECT_MSG_EQ(dataRate.Get(), DataRate("5Mbps"), "Device attribute not set");
+        Ptr<TrafficControlLayer> tc = link->GetFromNode()->GetObject<TrafficControlLayer>();
+        NS_TEST_EXPECT_MSG_NE(tc->GetRootQueueDiscOnDevice(fromDev),
+                              nullptr,
+                              "Default queue disc not installed");
+    }
+
+    // The subnets are reserved, and the next links get the following ones
+    Ipv4AddressGenerator::TestMode();
+    NS_TEST_EXPECT_MSG_EQ(Ipv4AddressGenerator::IsAddressAllocated("10.0.0.35"),
+                          true,
+                          "The subnets are not reserved");
+    NS_TEST_EXPECT_MSG_EQ(Ipv4AddressGenerator::IsAddressAllocated("10.0.0.36"),
+                          false,
+                          "Too many subnets reserved");
+    interfaces = builder.Install(inet);
+    NS_TEST_EXPECT_MSG_EQ(interfaces.GetAddress(0),
+                          Ipv4Address("10.0.0.37"),
+                          "The subnets are reused");
+}
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Topology Builder Helper TestSuite
+ */
+class TopologyBuilderHelperTestSuite : public TestSuite
+{
+  public:
+    TopologyBuilderHelperTestSuite();
+};
+
+TopologyBuilderHelperTestSuite::TopologyBuilderHelperTestSuite()
+    : TestSuite("topology-builder-helper", Type::UNIT)
+{
+    AddTestCase(new TopologyReadersTest(), TestCase::Duration::QUICK);
+    AddTestCase(new TopologyBuilderHelperTest(), TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup topology-test
+ * Static variable for test initialization
+ */
+static TopologyBuilderHelperTestSuite g_topologyBuilderHelperTestSuite;
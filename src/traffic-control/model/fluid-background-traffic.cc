@@ -0,0 +1,327 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fluid-background-traffic.h"
+
+#include "queue-disc.h"
+#include "traffic-control-layer.h"
+
+#include "ns3/abort.h"
+#include "ns3/channel.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/trace-source-accessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FluidBackgroundTraffic");
+
+NS_OBJECT_ENSURE_REGISTERED(FluidBackgroundTraffic);
+
+TypeId
+FluidBackgroundTraffic::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FluidBackgroundTraffic")
+            .SetParent<Object>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<FluidBackgroundTraffic>()
+            .AddAttribute("MaxLinkShare",
+                          "The maximum fraction of the data rate of a link given to the flows",
+                          DoubleValue(0.9),
+                          MakeDoubleAccessor(&FluidBackgroundTraffic::m_maxLinkShare),
+                          MakeDoubleChecker<double>(0, 0.999))
+            .AddAttribute("MaxBufferShare",
+                          "The fraction of the buffer of a saturated link occupied by the flows "
+                          "if they used its whole data rate",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&FluidBackgroundTraffic::m_maxBufferShare),
+                          MakeDoubleChecker<double>(0, 0.999))
+            .AddTraceSource("LinkRate",
+                            "The total rate of the flows of a link changed",
+                            MakeTraceSourceAccessor(&FluidBackgroundTraffic::m_linkRateTrace),
+                            "ns3::FluidBackgroundTraffic::LinkRateTracedCallback");
+    return tid;
+}
+
+FluidBackgroundTraffic::FluidBackgroundTraffic()
+    : m_nextFlowId(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FluidBackgroundTraffic::~FluidBackgroundTraffic()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FluidBackgroundTraffic::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_flows.clear();
+    m_links.clear();
+    m_linkIds.clear();
+    Object::DoDispose();
+}
+
+uint32_t
+FluidBackgroundTraffic::GetLink(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    auto it = m_linkIds.find(device);
+    if (it != m_linkIds.end())
+    {
+        return it->second;
+    }
+
+    // The data rate is an attribute of the device or of its channel
+    DataRateValue dataRate;
+    bool found = device->GetAttributeFailSafe("DataRate", dataRate) ||
+                 (device->GetChannel() &&
+                  device->GetChannel()->GetAttributeFailSafe("DataRate", dataRate));
+    NS_ABORT_MSG_UNLESS(found, "Cannot find the data rate of device " << device);
+
+    Link link;
+    link.device = device;
+    link.dataRate = dataRate.Get().GetBitRate();
+    link.rate = 0;
+    link.saturated = false;
+    m_links.push_back(link);
+    m_linkIds[device] = m_links.size() - 1;
+    return m_links.size() - 1;
+}
+
+uint32_t
+FluidBackgroundTraffic::AddFlow(const std::vector<Ptr<NetDevice>>& route, DataRate demand)
+{
+    NS_LOG_FUNCTION(this << route.size() << demand);
+    NS_ABORT_MSG_IF(route.empty(), "A flow needs a route");
+
+    Flow flow;
+    for (const auto& device : route)
+    {
+        flow.links.push_back(GetLink(device));
+    }
+    flow.demand = demand.GetBitRate();
+    flow.rate = 0;
+
+    uint32_t flowId = m_nextFlowId++;
+    for (auto link : flow.links)
+    {
+        m_links[link].flows.push_back(flowId);
+    }
+    auto links = flow.links;
+    m_flows[flowId] = std::move(flow);
+    Update(links);
+    return flowId;
+}
+
+void
+FluidBackgroundTraffic::SetFlowDemand(uint32_t flowId, DataRate demand)
+{
+    NS_LOG_FUNCTION(this << flowId << demand);
+    auto it = m_flows.find(flowId);
+    NS_ABORT_MSG_IF(it == m_flows.end(), "Unknown flow " << flowId);
+    it->second.demand = demand.GetBitRate();
+    Update(it->second.links);
+}
+
+void
+FluidBackgroundTraffic::RemoveFlow(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+    auto it = m_flows.find(flowId);
+    NS_ABORT_MSG_IF(it == m_flows.end(), "Unknown flow " << flowId);
+    auto links = std::move(it->second.links);
+    m_flows.erase(it);
+    for (auto link : links)
+    {
+        auto& flows = m_links[link].flows;
+        flows.erase(std::find(flows.begin(), flows.end(), flowId));
+    }
+    Update(links);
+}
+
+DataRate
+FluidBackgroundTraffic::GetFlowRate(uint32_t flowId) const
+{
+    auto it = m_flows.find(flowId);
+    NS_ABORT_MSG_IF(it == m_flows.end(), "Unknown flow " << flowId);
+    return DataRate(static_cast<uint64_t>(std::llround(it->second.rate)));
+}
+
+DataRate
+FluidBackgroundTraffic::GetLinkRate(Ptr<NetDevice> device) const
+{
+    auto it = m_linkIds.find(device);
+    if (it == m_linkIds.end())
+    {
+        return DataRate(0);
+    }
+    return DataRate(static_cast<uint64_t>(std::llround(m_links[it->second].rate)));
+}
+
+void
+FluidBackgroundTraffic::Update(const std::vector<uint32_t>& links)
+{
+    NS_LOG_FUNCTION(this << links.size());
+
+    //
+    // Find the flows and the links connected to the given links, whose
+    // allocation may change.
+    //
+    std::vector<uint32_t> compLinks;
+    std::vector<uint32_t> compFlows;
+    std::unordered_map<uint32_t, std::size_t> linkIndex;
+    std::unordered_set<uint32_t> visitedFlows;
+    for (auto link : links)
+    {
+        if (linkIndex.emplace(link, compLinks.size()).second)
+        {
+            compLinks.push_back(link);
+        }
+    }
+    for (std::size_t i = 0; i < compLinks.size(); ++i)
+    {
+        for (auto flowId : m_links[compLinks[i]].flows)
+        {
+            if (!visitedFlows.insert(flowId).second)
+            {
+                continue;
+            }
+            compFlows.push_back(flowId);
+            for (auto link : m_flows[flowId].links)
+            {
+                if (linkIndex.emplace(link, compLinks.size()).second)
+                {
+                    compLinks.push_back(link);
+                }
+            }
+        }
+    }
+    NS_LOG_LOGIC("Solving " << compFlows.size() << " flows over " << compLinks.size() << " links");
+
+    //
+    // Progressive filling: increase the rates of all the flows which are not
+    // limited yet by the same amount, until a flow reaches its demand or a
+    // link is saturated, which limits the flows crossing it.
+    //
+    std::vector<double> remaining(compLinks.size());
+    std::vector<uint32_t> nActive(compLinks.size(), 0);
+    std::vector<bool> saturated(compLinks.size(), false);
+    std::vector<Flow*> active;
+    for (std::size_t i = 0; i < compLinks.size(); ++i)
+    {
+        remaining[i] = m_links[compLinks[i]].dataRate * m_maxLinkShare;
+    }
+    for (auto flowId : compFlows)
+    {
+        Flow& flow = m_flows[flowId];
+        flow.rate = 0;
+        if (flow.demand > 0)
+        {
+            active.push_back(&flow);
+            for (auto link : flow.links)
+            {
+                nActive[linkIndex[link]]++;
+            }
+        }
+    }
+
+    while (!active.empty())
+    {
+        double increment = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < compLinks.size(); ++i)
+        {
+            if (nActive[i] > 0)
+            {
+                increment = std::min(increment, remaining[i] / nActive[i]);
+            }
+        }
+        for (const auto flow : active)
+        {
+            increment = std::min(increment, flow->demand - flow->rate);
+        }
+
+        for (auto flow : active)
+        {
+            flow->rate += increment;
+            for (auto link : flow->links)
+            {
+                remaining[linkIndex[link]] -= increment;
+            }
+        }
+
+        for (std::size_t i = 0; i < compLinks.size(); ++i)
+        {
+            if (nActive[i] > 0 && remaining[i] <= 1e-9 * m_links[compLinks[i]].dataRate)
+            {
+                saturated[i] = true;
+            }
+        }
+
+        std::vector<Flow*> stillActive;
+        for (auto flow : active)
+        {
+            bool limited = flow->rate >= flow->demand * (1 - 1e-9);
+            for (auto link : flow->links)
+            {
+                limited = limited || saturated[linkIndex[link]];
+            }
+            if (!limited)
+            {
+                stillActive.push_back(flow);
+                continue;
+            }
+            for (auto link : flow->links)
+            {
+                nActive[linkIndex[link]]--;
+            }
+        }
+        active.swap(stillActive);
+    }
+
+    for (std::size_t i = 0; i < compLinks.size(); ++i)
+    {
+        Link& link = m_links[compLinks[i]];
+        double rate = std::max(0.0, link.dataRate * m_maxLinkShare - remaining[i]);
+        if (rate != link.rate || saturated[i] != link.saturated)
+        {
+            link.rate = rate;
+            link.saturated = saturated[i];
+            Apply(compLinks[i]);
+        }
+    }
+}
+
+void
+FluidBackgroundTraffic::Apply(uint32_t index)
+{
+    const Link& link = m_links[index];
+    NS_LOG_FUNCTION(this << link.device << link.rate << link.saturated);
+
+    auto rate = static_cast<uint64_t>(std::llround(link.rate));
+    link.device->SetAttributeFailSafe("BackgroundDataRate", DataRateValue(DataRate(rate)));
+
+    Ptr<Node> node = link.device->GetNode();
+    Ptr<TrafficControlLayer> tc = node ? node->GetObject<TrafficControlLayer>() : nullptr;
+    Ptr<QueueDisc> qd = tc ? tc->GetRootQueueDiscOnDevice(link.device) : nullptr;
+    if (qd)
+    {
+        qd->SetBackgroundShare(link.saturated ? m_maxBufferShare * link.rate / link.dataRate
+                                              : 0);
+    }
+
+    m_linkRateTrace(link.device, rate);
+}
+
+} // namespace ns3
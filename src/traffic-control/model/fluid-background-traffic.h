@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FLUID_BACKGROUND_TRAFFIC_H
+#define FLUID_BACKGROUND_TRAFFIC_H
+
+#include "ns3/data-rate.h"
+#include "ns3/net-device.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic-control
+ *
+ * @brief Background traffic represented by fluid flows instead of packets.
+ *
+ * Each flow has a route, the sequence of the devices it is transmitted by,
+ * and a demand, the rate at which its source would send.  The rates of the
+ * flows are the max-min fair allocation of the capacity of the links to
+ * their demands: a flow gets its demand unless it crosses a saturated link,
+ * on which it gets at least as much as the other flows crossing that link.
+ * The capacity of a link is the DataRate attribute of its device, of which
+ * at most the MaxLinkShare fraction is given to the background traffic.
+ *
+ * When a flow is added, removed or changes its demand, the allocation is
+ * solved again, but only for the flows which share a link, directly or
+ * through other flows, with the modified one.  The result is applied to
+ * the packet-level simulation through two hooks, for the links whose
+ * background rate changed:
+ *
+ * - the BackgroundDataRate attribute of the device, if any (for instance
+ *   PointToPointNetDevice), is set to the total rate of the flows, so that
+ *   the packets are transmitted at the remaining data rate;
+ * - the background share of the root queue disc installed on the device, if
+ *   any, is set on the saturated links, where the fluid traffic builds a
+ *   standing queue.  The fluid traffic is assumed to occupy the MaxBufferShare
+ *   fraction of the buffer in proportion to its share of the data rate of the
+ *   link.  This is a coarse approximation of the queue built by long-lived
+ *   TCP flows, which the max-min model does not describe.
+ *
+ * The packets of the background traffic are therefore never simulated, and
+ * the cost of a flow is independent of its rate and duration.  The packet
+ * flows do not reduce the rates of the fluid flows in turn: the MaxLinkShare
+ * fraction of the capacity is only given to the fluid flows.
+ */
+class FluidBackgroundTraffic : public Object
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    FluidBackgroundTraffic();
+    ~FluidBackgroundTraffic() override;
+
+    /**
+     * @brief Add a flow.
+     *
+     * @param route the devices transmitting the flow, from the source to the
+     *        destination
+     * @param demand the rate at which the source of the flow sends
+     * @returns the identifier of the flow
+     */
+    uint32_t AddFlow(const std::vector<Ptr<NetDevice>>& route, DataRate demand);
+
+    /**
+     * @brief Change the demand of a flow.
+     *
+     * @param flowId the identifier of the flow
+     * @param demand the rate at which the source of the flow sends
+     */
+    void SetFlowDemand(uint32_t flowId, DataRate demand);
+
+    /**
+     * @brief Remove a flow.
+     *
+     * @param flowId the identifier of the flow
+     */
+    void RemoveFlow(uint32_t flowId);
+
+    /**
+     * @param flowId the identifier of the flow
+     * @returns the rate allocated to the flow
+     */
+    DataRate GetFlowRate(uint32_t flowId) const;
+
+    /**
+     * @param device the device transmitting the link
+     * @returns the total rate of the flows transmitted by the device
+     */
+    DataRate GetLinkRate(Ptr<NetDevice> device) const;
+
+    /**
+     * TracedCallback signature for changes of the background rate of a link.
+     *
+     * @param [in] device The device transmitting the link.
+     * @param [in] rate The new total rate of the flows, in bit/s.
+     */
+    typedef void (*LinkRateTracedCallback)(Ptr<NetDevice> device, uint64_t rate);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A fluid flow
+    struct Flow
+    {
+        std::vector<uint32_t> links; //!< Indexes of the links of the route
+        double demand;               //!< Demand, in bit/s
+        double rate;                 //!< Allocated rate, in bit/s
+    };
+
+    /// A link, transmitted by a device
+    struct Link
+    {
+        Ptr<NetDevice> device;       //!< Device transmitting the link
+        double dataRate;             //!< Data rate of the device, in bit/s
+        std::vector<uint32_t> flows; //!< Identifiers of the flows crossing the link
+        double rate;                 //!< Total rate of the flows, in bit/s
+        bool saturated;              //!< Whether the link limits the rate of a flow
+    };
+
+    /**
+     * @param device the device transmitting the link
+     * @returns the index of the link, which is created if needed
+     */
+    uint32_t GetLink(Ptr<NetDevice> device);
+
+    /**
+     * Solve the allocation of the flows connected to the given links, and
+     * apply it to the links whose rate changed.
+     *
+     * @param links the indexes of the links of the modified flow
+     */
+    void Update(const std::vector<uint32_t>& links);
+
+    /**
+     * Apply the background rate of a link to its device and queue disc.
+     *
+     * @param index the index of the link
+     */
+    void Apply(uint32_t index);
+
+    double m_maxLinkShare;   //!< Fraction of the capacity of a link given to the flows
+    double m_maxBufferShare; //!< Fraction of the buffer of a saturated link given to the flows
+
+    std::unordered_map<uint32_t, Flow> m_flows;   //!< Flows, by identifier
+    std::vector<Link> m_links;                    //!< Links
+    std::map<Ptr<NetDevice>, uint32_t> m_linkIds; //!< Link indexes, by device
+    uint32_t m_nextFlowId;                        //!< Identifier of the next flow
+
+    /// Trace fired when the background rate of a link changes
+    TracedCallback<Ptr<NetDevice>, uint64_t> m_linkRateTrace;
+};
+
+} // namespace ns3
+
+#endif /* FLUID_BACKGROUND_TRAFFIC_H */
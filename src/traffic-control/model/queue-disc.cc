@@ -308,6 +308,7 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
     : m_nPackets(0),
       m_nBytes(0),
       m_maxSize(QueueSize("1p")), // to avoid that setting the mode at construction time is ignored
+      m_backgroundShare(0),
       m_running(false),
       m_peeked(false),
       m_sizePolicy(policy),
@@ -505,17 +506,38 @@ QueueDisc::GetCurrentSize() const
 {
     NS_LOG_FUNCTION(this);
 
-    if (GetMaxSize().GetUnit() == QueueSizeUnit::PACKETS)
+    QueueSize maxSize = GetMaxSize();
+    uint32_t background = 0;
+    if (m_backgroundShare > 0)
     {
-        return QueueSize(QueueSizeUnit::PACKETS, m_nPackets);
+        background = static_cast<uint32_t>(m_backgroundShare * maxSize.GetValue());
     }
-    if (GetMaxSize().GetUnit() == QueueSizeUnit::BYTES)
+
+    if (maxSize.GetUnit() == QueueSizeUnit::PACKETS)
+    {
+        return QueueSize(QueueSizeUnit::PACKETS, m_nPackets + background);
+    }
+    if (maxSize.GetUnit() == QueueSizeUnit::BYTES)
     {
-        return QueueSize(QueueSizeUnit::BYTES, m_nBytes);
+        return QueueSize(QueueSizeUnit::BYTES, m_nBytes + background);
     }
     NS_ABORT_MSG("Unknown queue size unit");
 }
 
+void
+QueueDisc::SetBackgroundShare(double share)
+{
+    NS_LOG_FUNCTION(this << share);
+    NS_ASSERT_MSG(share >= 0 && share < 1, "The background share must be in [0, 1)");
+    m_backgroundShare = share;
+}
+
+double
+QueueDisc::GetBackgroundShare() const
+{
+    return m_backgroundShare;
+}
+
 void
 QueueDisc::SetNetDeviceQueueInterface(Ptr<NetDeviceQueueInterface> ndqi)
 {
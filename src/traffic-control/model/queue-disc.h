@@ -323,9 +323,34 @@ class QueueDisc : public Object
      * Do not call this method if the queue disc size is not limited.
      *
      * @returns The queue disc size in bytes or packets.
+     *
+     * The backlog of the background traffic, if any, is included.
      */
     QueueSize GetCurrentSize() const;
 
+    /**
+     * @brief Set the share of the queue disc occupied by the traffic which is
+     *        not simulated by packets.
+     *
+     * The background share is the fraction of the maximum size occupied by
+     * fluid background traffic (see FluidBackgroundTraffic).  The
+     * corresponding backlog is included in the current size of the queue
+     * disc, hence it is taken into account by the admission and the active
+     * queue management decisions based on it, but it is not included in the
+     * number of packets and bytes stored nor in the statistics.
+     *
+     * @param share the background share, in [0, 1).
+     */
+    void SetBackgroundShare(double share);
+
+    /**
+     * @brief Get the share of the queue disc occupied by the traffic which is
+     *        not simulated by packets.
+     *
+     * @returns the background share.
+     */
+    double GetBackgroundShare() const;
+
     /**
      * @brief Retrieve all the collected statistics.
      * @return the collected statistics.
@@ -684,6 +709,7 @@ class QueueDisc : public Object
     TracedValue<uint32_t> m_nBytes;   //!< Number of bytes in the queue
     TracedCallback<Time> m_sojourn;   //!< Sojourn time of the latest dequeued packet
     QueueSize m_maxSize;              //!< max queue size
+    double m_backgroundShare;         //!< share of the max size used by background traffic
 
     Stats m_stats;    //!< The collected statistics
     uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
@@ -0,0 +1,137 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/double.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/fluid-background-traffic.h"
+#include "ns3/node.h"
+#include "ns3/queue-size.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-layer.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Fluid background traffic test: checks the max-min fair allocation of
+ * the flows, its incremental update and the queue disc hook.
+ */
+class FluidBackgroundTrafficTestCase : public TestCase
+{
+  public:
+    FluidBackgroundTrafficTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Count the changes of the background rate of the links
+     * @param device the device transmitting the link
+     * @param rate the new total rate of the flows
+     */
+    void LinkRate(Ptr<NetDevice> device, uint64_t rate);
+
+    uint32_t m_linkRateChanges; //!< Number of changes of the background rate of the links
+};
+
+FluidBackgroundTrafficTestCase::FluidBackgroundTrafficTestCase()
+    : TestCase("Max-min fair allocation of fluid background flows"),
+      m_linkRateChanges(0)
+{
+}
+
+void
+FluidBackgroundTrafficTestCase::LinkRate(Ptr<NetDevice> device, uint64_t rate)
+{
+    m_linkRateChanges++;
+}
+
+void
+FluidBackgroundTrafficTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<TrafficControlLayer> tc = CreateObject<TrafficControlLayer>();
+    node->AggregateObject(tc);
+
+    auto createDevice = [node](std::string dataRate) {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAttribute("DataRate", DataRateValue(DataRate(dataRate)));
+        device->SetNode(node);
+        node->AddDevice(device);
+        return device;
+    };
+    Ptr<SimpleNetDevice> devA = createDevice("10Mb/s");
+    Ptr<SimpleNetDevice> devB = createDevice("5Mb/s");
+    Ptr<SimpleNetDevice> devC = createDevice("10Mb/s");
+
+    Ptr<QueueDisc> qdisc = CreateObject<FifoQueueDisc>();
+    qdisc->SetAttribute("MaxSize", StringValue("100p"));
+    qdisc->Initialize();
+    tc->SetRootQueueDiscOnDevice(devA, qdisc);
+
+    Ptr<FluidBackgroundTraffic> fluid = CreateObject<FluidBackgroundTraffic>();
+    fluid->SetAttribute("MaxLinkShare", DoubleValue(0.5));
+    fluid->SetAttribute("MaxBufferShare", DoubleValue(0.5));
+    fluid->TraceConnectWithoutContext(
+        "LinkRate",
+        MakeCallback(&FluidBackgroundTrafficTestCase::LinkRate, this));
+
+    // The flows get 5 Mb/s of A and 2.5 Mb/s of B. Flow 3 gets its demand,
+    // flow 1 the rest of B and flow 2 the rest of A.
+    uint32_t f1 = fluid->AddFlow({devA, devB}, DataRate("10Mb/s"));
+    uint32_t f2 = fluid->AddFlow({devA}, DataRate("10Mb/s"));
+    uint32_t f3 = fluid->AddFlow({devB}, DataRate("500kb/s"));
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f1), DataRate("2Mb/s"), "Wrong rate of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f2), DataRate("3Mb/s"), "Wrong rate of flow 2");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f3), DataRate("500kb/s"), "Wrong rate of flow 3");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetLinkRate(devA), DataRate("5Mb/s"), "Wrong rate of link A");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetLinkRate(devB), DataRate("2.5Mb/s"), "Wrong rate of link B");
+
+    // Link A is saturated and the flows use half of its data rate
+    NS_TEST_EXPECT_MSG_EQ_TOL(qdisc->GetBackgroundShare(), 0.25, 1e-9, "Wrong background share");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetCurrentSize(),
+                          QueueSize("25p"),
+                          "The background share is not included in the size");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetNPackets(), 0, "The background share is counted as packets");
+
+    fluid->RemoveFlow(f3);
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f1), DataRate("2.5Mb/s"), "Wrong rate of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f2), DataRate("2.5Mb/s"), "Wrong rate of flow 2");
+
+    // Link A is no longer saturated
+    fluid->SetFlowDemand(f2, DataRate("1Mb/s"));
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f1), DataRate("2.5Mb/s"), "Wrong rate of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f2), DataRate("1Mb/s"), "Wrong rate of flow 2");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetLinkRate(devA), DataRate("3.5Mb/s"), "Wrong rate of link A");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetBackgroundShare(), 0, "Link A is not saturated");
+
+    // A flow on an independent link does not update the other links
+    m_linkRateChanges = 0;
+    uint32_t f4 = fluid->AddFlow({devC}, DataRate("1Mb/s"));
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetFlowRate(f4), DataRate("1Mb/s"), "Wrong rate of flow 4");
+    NS_TEST_EXPECT_MSG_EQ(m_linkRateChanges, 1, "Unrelated links were updated");
+
+    fluid->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Fluid background traffic test suite
+ */
+static class FluidBackgroundTrafficTestSuite : public TestSuite
+{
+  public:
+    FluidBackgroundTrafficTestSuite()
+        : TestSuite("fluid-background-traffic", Type::UNIT)
+    {
+        AddTestCase(new FluidBackgroundTrafficTestCase(), TestCase::Duration::QUICK);
+    }
+} g_fluidBackgroundTrafficTestSuite; ///< the test suite
@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the MatrixArray operations used by the
+// MIMO channel models, on arrays of complex matrices of configurable size.
+// Sample usage:  ./ns3 run 'bench-matrix-array --rows=4 --cols=64 --pages=100'
+
+#include "ns3/command-line.h"
+#include "ns3/matrix-array.h"
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <functional>
+#include <iostream>
+#include <random>
+
+using namespace ns3;
+
+/**
+ * Fill a MatrixArray with random complex values.
+ *
+ * @param [in] matrix The MatrixArray to fill.
+ * @param [in] generator The random number generator.
+ */
+static void
+Randomize(ComplexMatrixArray& matrix, std::mt19937& generator)
+{
+    std::normal_distribution<double> normal;
+    for (size_t i = 0; i < matrix.GetSize(); i++)
+    {
+        matrix.GetPagePtr(0)[i] = std::complex<double>(normal(generator), normal(generator));
+    }
+}
+
+/**
+ * Run an operation several times, and print the best time over a number of
+ * repetitions.
+ *
+ * @param [in] operation The operation to benchmark.
+ * @param [in] n The number of times the operation is run in each repetition.
+ * @param [in] minIterations The number of repetitions.
+ * @param [in] name The name of the operation.
+ */
+static void
+RunBench(const std::function<void()>& operation,
+         uint32_t n,
+         uint32_t minIterations,
+         const char* name)
+{
+    // the operations are short, hence the time is measured with a clock finer
+    // than SystemWallClockMs
+    auto minDelay = std::chrono::steady_clock::duration::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t j = 0; j < n; j++)
+        {
+            operation();
+        }
+        minDelay = std::min(minDelay, std::chrono::steady_clock::now() - start);
+    }
+    double perOperation = std::chrono::duration<double, std::micro>(minDelay).count() / n;
+    std::cout << perOperation << " us/operation\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 100;
+    uint32_t minIterations = 20;
+    uint32_t rows = 4;
+    uint32_t cols = 64;
+    uint32_t pages = 100;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the MatrixArray operations on arrays of complex matrices");
+    cmd.AddValue("n", "number of times each operation is run", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.AddValue("rows", "number of rows of the matrices (receive antenna ports)", rows);
+    cmd.AddValue("cols", "number of columns of the matrices (transmit antenna ports)", cols);
+    cmd.AddValue("pages", "number of matrices (clusters or resource blocks)", pages);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-matrix-array with " << pages << " pages of " << rows << "x"
+              << cols << " complex matrices, n=" << n << std::endl;
+
+    std::mt19937 generator(1);
+    ComplexMatrixArray channel(rows, cols, pages);
+    ComplexMatrixArray precoding(cols, 2, pages);
+    ComplexMatrixArray rxBeam(1, rows);
+    ComplexMatrixArray txBeam(cols, 1);
+    ComplexMatrixArray rxPorts(2, rows);
+    Randomize(channel, generator);
+    Randomize(precoding, generator);
+    Randomize(rxBeam, generator);
+    Randomize(txBeam, generator);
+    Randomize(rxPorts, generator);
+
+    ComplexMatrixArray result;
+    RunBench([&]() { result = channel * precoding; }, n, minIterations, "Page-wise product");
+    RunBench([&]() { result = channel.HermitianTranspose(); },
+             n,
+             minIterations,
+             "Hermitian transpose");
+    RunBench([&]() { result = channel.MultiplyByLeftAndRightMatrix(rxBeam, txBeam); },
+             n,
+             minIterations,
+             "Beamforming gain (vector x pages x vector)");
+    ComplexMatrixArray txPorts = precoding.ExtractPage(0);
+    RunBench([&]() { result = channel.MultiplyByLeftAndRightMatrix(rxPorts, txPorts); },
+             n,
+             minIterations,
+             "Port combination (matrix x pages x matrix)");
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup netanim
+ * Convert a binary trace file written by ns3::AnimationInterface to the
+ * XML trace file read by NetAnim.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/netanim-module.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+    Time pollInterval = Seconds(0.25);
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary trace file written by ns3::AnimationInterface to the XML "
+              "trace file read by NetAnim.");
+    cmd.AddNonOption("input", "The binary trace file", input);
+    cmd.AddValue("output", "The XML trace file (default: standard output)", output);
+    cmd.AddValue("pollInterval",
+                 "The interval at which the positions of the moving nodes are interpolated, "
+                 "or zero to only write their course changes",
+                 pollInterval);
+    cmd.Parse(argc, argv);
+
+    std::ifstream is(input, std::ios::binary);
+    if (!is.is_open())
+    {
+        std::cerr << "Unable to open " << input << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+
+    if (!AnimationInterface::ConvertBinaryToXml(is, os, pollInterval))
+    {
+        std::cerr << input << " is not a valid binary trace file, or is truncated" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup logging
+ * Convert a binary log written by ns3::BinaryLogSink to text.
+ */
+
+#include "ns3/core-module.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary log written by ns3::BinaryLogSink to text.");
+    cmd.AddNonOption("input", "The binary log file", input);
+    cmd.AddValue("output", "The text log file (default: standard output)", output);
+    cmd.Parse(argc, argv);
+
+    std::ifstream is(input, std::ios::binary);
+    if (!is.is_open())
+    {
+        std::cerr << "Unable to open " << input << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty())
+    {
+        file.open(output);
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+
+    if (!BinaryLogSink::Format(is, os))
+    {
+        std::cerr << input << " is not a valid binary log, or is truncated" << std::endl;
+        return 1;
+    }
+    return 0;
+}